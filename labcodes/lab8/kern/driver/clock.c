@@ -2,6 +2,12 @@
 #include <trap.h>
 #include <stdio.h>
 #include <picirq.h>
+#include <clock.h>
+#include <sched.h>
+#include <lapic.h>
+#include <mp.h>
+#include <vmm.h>
+#include <vdso.h>
 
 /* *
  * Support for time-related hardware gadgets - the 8253 timer,
@@ -19,12 +25,37 @@
 #define TIMER_DIV(x)    ((TIMER_FREQ + (x) / 2) / (x))
 
 #define TIMER_MODE      (IO_TIMER1 + 3)         // timer mode port
+#define TIMER_CNTR2     (IO_TIMER1 + 2)         // timer counter 2 port
 #define TIMER_SEL0      0x00                    // select counter 0
+#define TIMER_SEL2      0x80                    // select counter 2
+#define TIMER_LATCH     0x00                    // latch counter for reading
+#define TIMER_INTTC     0x00                    // mode 0, intr on terminal cnt
 #define TIMER_RATEGEN   0x04                    // mode 2, rate generator
 #define TIMER_16BIT     0x30                    // r/w counter 16 bits, LSB first
 
+#define IO_PORTB        0x061                   // system control port B
+#define PORTB_GATE2     0x01                    // gate of counter 2
+#define PORTB_SPEAKER   0x02                    // counter 2 drives the speaker
+#define PORTB_OUT2      0x20                    // output of counter 2
+
+#define TICK_COUNT      TIMER_DIV(TICK_HZ)      // the 8253 counts of a tick
+
+// an idle application processor wakes up after at most so many ticks
+#define NOHZ_MAX_TICKS  TICK_HZ
+
 volatile size_t ticks;
 
+// the TSC is measured for so many milliseconds (<= 54) in clock_calibrate
+#define CALIBRATE_MS    50
+
+// the TSC cycles of a tick
+static uint32_t tick_cycles;
+
+// the monotonic clock: ns = (TSC - tsc_base) * ns_mult >> NS_SHIFT
+#define NS_SHIFT        22
+static uint64_t tsc_base;
+static uint32_t ns_mult;
+
 long SYSTEM_READ_TIMER( void ){
     return ticks;
 }
@@ -37,13 +68,139 @@ void
 clock_init(void) {
     // set 8253 timer-chip
     outb(TIMER_MODE, TIMER_SEL0 | TIMER_RATEGEN | TIMER_16BIT);
-    outb(IO_TIMER1, TIMER_DIV(100) % 256);
-    outb(IO_TIMER1, TIMER_DIV(100) / 256);
+    outb(IO_TIMER1, TICK_COUNT % 256);
+    outb(IO_TIMER1, TICK_COUNT / 256);
 
     // initialize time counter 'ticks' to zero
     ticks = 0;
+    // for tickless idle
+    clock_tick_cycles();
 
     cprintf("++ setup timer interrupts\n");
     pic_enable(IRQ_TIMER);
 }
 
+/* *
+ * clock_wait - busy wait ms (<= 54) milliseconds with 8253 counter 2, whose output
+ * is polled at port B. It needs no interrupt, and is used to calibrate the other
+ * timers and for the delays of starting the other cpus.
+ * */
+void
+clock_wait(unsigned int ms) {
+    uint16_t count = TIMER_FREQ / 1000 * ms;
+    uint8_t portb = inb(IO_PORTB) & ~(PORTB_SPEAKER | PORTB_GATE2);
+    outb(IO_PORTB, portb);
+    outb(TIMER_MODE, TIMER_SEL2 | TIMER_INTTC | TIMER_16BIT);
+    outb(TIMER_CNTR2, count % 256);
+    outb(TIMER_CNTR2, count / 256);
+    // counting starts when the gate is raised, the output goes high at the terminal count
+    outb(IO_PORTB, portb | PORTB_GATE2);
+    while (!(inb(IO_PORTB) & PORTB_OUT2)) {
+        /* do nothing */;
+    }
+}
+
+
+/* *
+ * clock_calibrate - measure the TSC rate with 8253 counter 2, and start the monotonic clock.
+ * The TSC is assumed to count at a constant rate, and the same on all cpus.
+ * */
+static void
+clock_calibrate(void) {
+    uint64_t start = read_tsc();
+    clock_wait(CALIBRATE_MS);
+    uint32_t cycles = read_tsc() - start;
+
+    tick_cycles = cycles / (CALIBRATE_MS * TICK_HZ / 1000);
+    uint64_t mult = (uint64_t)CALIBRATE_MS * 1000000 << NS_SHIFT;
+    do_div(mult, cycles);
+    ns_mult = mult;
+    tsc_base = start;
+
+    // for the monotonic clock of the user programs
+    vdso_data->tsc_base = tsc_base;
+    vdso_data->ns_mult = ns_mult;
+    vdso_data->ns_shift = NS_SHIFT;
+    vdso_data->tick_cycles = tick_cycles;
+    cprintf("clock: %u TSC cycles per tick.\n", tick_cycles);
+}
+
+/* clock_tick_cycles - the TSC cycles of a tick, the TSC is measured at the first call */
+uint32_t
+clock_tick_cycles(void) {
+    if (tick_cycles == 0) {
+        clock_calibrate();
+    }
+    return tick_cycles;
+}
+
+/* clock_ns - the nanoseconds since the TSC was measured, about the boot time */
+uint64_t
+clock_ns(void) {
+    return mul_u64_u32_shr(read_tsc() - tsc_base, ns_mult, NS_SHIFT);
+}
+
+/* *
+ * Tickless idle: before a cpu halts in cpu_idle, clock_nohz_enter stops its periodic tick and
+ * sets its timer to interrupt once, when the next timer of the wheel expires. An idle cpu then
+ * takes no interrupts until there is something to do. Woken up by any interrupt, the cpu runs
+ * clock_nohz_exit, which restarts the periodic tick and catches up the ticks it has skipped.
+ *
+ * The boot cpu keeps the ticks and the timers with 8253 counter 0, which counts at most 65535,
+ * about 5 ticks, so it still wakes up every 5 ticks. An application processor has the local
+ * APIC timer and no timers to run, it wakes up at least every NOHZ_MAX_TICKS ticks.
+ * Both are called with interrupts disabled, while holding the kernel lock.
+ * */
+void
+clock_nohz_enter(void) {
+    struct cpu *cpu = mycpu();
+    unsigned int nticks = (cpu == cpus) ? timer_next_expiry(NOHZ_MAX_TICKS) : NOHZ_MAX_TICKS;
+    if (nticks <= 1) {
+        return;
+    }
+    cpu->nohz = 1;
+    cpu->nohz_tsc = read_tsc();
+    if (cpu == cpus) {
+        // the counts left of this tick, then the skipped ticks
+        outb(TIMER_MODE, TIMER_SEL0 | TIMER_LATCH);
+        uint32_t count = inb(IO_TIMER1);
+        count |= inb(IO_TIMER1) << 8;
+        count += (nticks - 1) * TICK_COUNT;
+        if (count > 0xFFFF) {
+            count = 0xFFFF;
+        }
+        cpu->nohz_ticks = ticks;
+        outb(TIMER_MODE, TIMER_SEL0 | TIMER_INTTC | TIMER_16BIT);
+        outb(IO_TIMER1, count % 256);
+        outb(IO_TIMER1, count / 256);
+    }
+    else {
+        lapic_timer_oneshot(nticks);
+    }
+}
+
+void
+clock_nohz_exit(void) {
+    struct cpu *cpu = mycpu();
+    if (!cpu->nohz) {
+        return;
+    }
+    cpu->nohz = 0;
+    uint64_t elapsed = read_tsc() - cpu->nohz_tsc;
+    unsigned int nticks = (elapsed < 0xFFFFFFFF) ? (uint32_t)elapsed / clock_tick_cycles() : 0xFFFFFFFF / clock_tick_cycles();
+    if (cpu == cpus) {
+        outb(TIMER_MODE, TIMER_SEL0 | TIMER_RATEGEN | TIMER_16BIT);
+        outb(IO_TIMER1, TICK_COUNT % 256);
+        outb(IO_TIMER1, TICK_COUNT / 256);
+        // the one-shot interrupt (if it came) has counted a tick already
+        size_t counted = ticks - cpu->nohz_ticks;
+        if (nticks > counted) {
+            ticks += nticks - counted;
+            timer_catch_up(nticks - counted);
+        }
+    }
+    else {
+        lapic_timer_start();
+        cpu->ticks += nticks;
+    }
+}
@@ -6,6 +6,14 @@
 extern volatile size_t ticks;
 
 void clock_init(void);
+void clock_wait(unsigned int ms);
+#define TICK_HZ             100                 // the ticks per second
+#define TICK_NS             (1000000000 / TICK_HZ)
+
+uint32_t clock_tick_cycles(void);
+uint64_t clock_ns(void);
+void clock_nohz_enter(void);
+void clock_nohz_exit(void);
 
 long SYSTEM_READ_TIMER( void );
 
@@ -0,0 +1,82 @@
+#include <defs.h>
+#include <trap.h>
+#include <pmm.h>
+#include <assert.h>
+#include <ioapic.h>
+
+/* *
+ * The IO APIC delivers the interrupts of the ISA devices to the local APIC of a cpu,
+ * it takes the place of the 8259A when there are more cpus. See the 82093AA datasheet.
+ * */
+
+#define REG_ID          0x00        // Register index: ID
+#define REG_VER         0x01        // Register index: version
+#define REG_TABLE       0x10        // Redirection table base
+
+// The redirection table starts at REG_TABLE and uses two registers to configure
+// each interrupt. The first (low) register in a pair contains configuration bits.
+// The second (high) register contains a bitmask telling which cpus can serve that
+// interrupt.
+#define INT_DISABLED    0x00010000  // Interrupt disabled
+#define INT_LEVEL       0x00008000  // Level-triggered (vs edge-)
+#define INT_ACTIVELOW   0x00002000  // Active low (vs high)
+#define INT_LOGICAL     0x00000800  // Destination is CPU id (vs APIC ID)
+
+#define NR_ISA_IRQS     16
+
+// IO APIC MMIO structure: write reg, then read or write data.
+struct ioapic {
+    uint32_t reg;
+    uint32_t pad[3];
+    uint32_t data;
+};
+
+static volatile struct ioapic *ioapic;
+
+// the input pin of each ISA irq, they are the same unless the MP table tells otherwise
+static unsigned int irq_pin[NR_ISA_IRQS];
+
+static uint32_t
+ioapic_read(int reg) {
+    ioapic->reg = reg;
+    return ioapic->data;
+}
+
+static void
+ioapic_write(int reg, uint32_t data) {
+    ioapic->reg = reg;
+    ioapic->data = data;
+}
+
+/* ioapic_init - map the IO APIC at physical address pa, and mask all interrupts */
+void
+ioapic_init(uintptr_t pa) {
+    ioapic = mmio_map(pa, PGSIZE);
+
+    int i, maxintr = (ioapic_read(REG_VER) >> 16) & 0xFF;
+    for (i = 0; i <= maxintr; i ++) {
+        ioapic_write(REG_TABLE + 2 * i, INT_DISABLED | (IRQ_OFFSET + i));
+        ioapic_write(REG_TABLE + 2 * i + 1, 0);
+    }
+    for (i = 0; i < NR_ISA_IRQS; i ++) {
+        irq_pin[i] = i;
+    }
+}
+
+/* ioapic_route - the ISA irq is connected to pin of the IO APIC, e.g. the 8253 to pin 2 */
+void
+ioapic_route(unsigned int irq, unsigned int pin) {
+    if (irq < NR_ISA_IRQS) {
+        irq_pin[irq] = pin;
+    }
+}
+
+/* ioapic_enable - deliver the ISA irq as an edge-triggered, active high interrupt to the cpu of apic_id */
+void
+ioapic_enable(unsigned int irq, int apic_id) {
+    assert(irq < NR_ISA_IRQS);
+    unsigned int pin = irq_pin[irq];
+    ioapic_write(REG_TABLE + 2 * pin, IRQ_OFFSET + irq);
+    ioapic_write(REG_TABLE + 2 * pin + 1, apic_id << 24);
+}
+
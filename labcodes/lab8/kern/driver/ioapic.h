@@ -0,0 +1,11 @@
+#ifndef __KERN_DRIVER_IOAPIC_H__
+#define __KERN_DRIVER_IOAPIC_H__
+
+#include <defs.h>
+
+void ioapic_init(uintptr_t pa);
+void ioapic_route(unsigned int irq, unsigned int pin);
+void ioapic_enable(unsigned int irq, int apic_id);
+
+#endif /* !__KERN_DRIVER_IOAPIC_H__ */
+
@@ -0,0 +1,169 @@
+#include <defs.h>
+#include <x86.h>
+#include <trap.h>
+#include <stdio.h>
+#include <memlayout.h>
+#include <clock.h>
+#include <lapic.h>
+
+/* *
+ * The local APIC of each cpu: it receives the interrupts from the IO APIC and
+ * the other cpus, sends the inter-processor interrupts (IPI), and has a timer,
+ * which gives the ticks of the application processors (the boot cpu uses the 8253).
+ * */
+
+// local APIC registers, divided by 4 for use as uint32_t[] indices.
+#define ID          (0x0020 / 4)        // ID
+#define VER         (0x0030 / 4)        // Version
+#define TPR         (0x0080 / 4)        // Task Priority
+#define EOI         (0x00B0 / 4)        // EOI
+#define SVR         (0x00F0 / 4)        // Spurious Interrupt Vector
+#define ENABLE      0x00000100          // Unit Enable
+#define ESR         (0x0280 / 4)        // Error Status
+#define ICRLO       (0x0300 / 4)        // Interrupt Command
+#define INIT        0x00000500          // INIT/RESET
+#define STARTUP     0x00000600          // Startup IPI
+#define DELIVS      0x00001000          // Delivery status
+#define ASSERT      0x00004000          // Assert interrupt (vs deassert)
+#define DEASSERT    0x00000000
+#define LEVEL       0x00008000          // Level triggered
+#define BCAST       0x00080000          // Send to all APICs, including self.
+#define FIXED       0x00000000
+#define ICRHI       (0x0310 / 4)        // Interrupt Command [63:32]
+#define TIMER       (0x0320 / 4)        // Local Vector Table 0 (TIMER)
+#define X1          0x0000000B          // divide counts by 1
+#define PERIODIC    0x00020000          // Periodic
+#define PCINT       (0x0340 / 4)        // Performance Counter LVT
+#define LINT0       (0x0350 / 4)        // Local Vector Table 1 (LINT0)
+#define LINT1       (0x0360 / 4)        // Local Vector Table 2 (LINT1)
+#define ERROR       (0x0370 / 4)        // Local Vector Table 3 (ERROR)
+#define MASKED      0x00010000          // Interrupt masked
+#define TICR        (0x0380 / 4)        // Timer Initial Count
+#define TCCR        (0x0390 / 4)        // Timer Current Count
+#define TDCR        (0x03E0 / 4)        // Timer Divide Configuration
+
+#define CMOS_PORT   0x70                // CMOS RTC, the shutdown code is at offset 0xF
+#define WARM_RESET  0x467               // warm reset vector (segment:offset) in BIOS data area
+
+// the registers, mapped by mp_init
+volatile uint32_t *lapic;
+
+// the timer counts of a tick, measured by the boot cpu
+static uint32_t lapic_timer_count;
+
+static void
+lapicw(int index, uint32_t value) {
+    lapic[index] = value;
+    lapic[ID];  // wait for write to finish, by reading
+}
+
+/* lapic_init - enable the local APIC of this cpu, the timer is off */
+void
+lapic_init(void) {
+    // enable, and set the spurious interrupt vector
+    lapicw(SVR, ENABLE | (IRQ_OFFSET + IRQ_SPURIOUS));
+
+    lapicw(TDCR, X1);
+    lapicw(TIMER, MASKED | (IRQ_OFFSET + IRQ_APTIMER));
+
+    // the external interrupts come from the IO APIC, not the 8259A in virtual wire mode
+    lapicw(LINT0, MASKED);
+    lapicw(LINT1, MASKED);
+
+    // disable performance counter overflow interrupts on machines that provide that entry
+    if (((lapic[VER] >> 16) & 0xFF) >= 4) {
+        lapicw(PCINT, MASKED);
+    }
+
+    lapicw(ERROR, IRQ_OFFSET + IRQ_ERROR);
+
+    // clear error status register (requires back-to-back writes)
+    lapicw(ESR, 0);
+    lapicw(ESR, 0);
+
+    // ack any outstanding interrupts
+    lapicw(EOI, 0);
+
+    // send an init level de-assert to synchronise arbitration ID's
+    lapicw(ICRHI, 0);
+    lapicw(ICRLO, BCAST | INIT | LEVEL);
+    while (lapic[ICRLO] & DELIVS) {
+        /* do nothing */;
+    }
+
+    // enable interrupts on the APIC (but not on the processor)
+    lapicw(TPR, 0);
+}
+
+/* lapic_timer_calibrate - measure the timer counts of a tick with the 8253, on the boot cpu */
+void
+lapic_timer_calibrate(void) {
+    lapicw(TICR, 0xFFFFFFFF);
+    clock_wait(1000 / TICK_HZ);
+    lapic_timer_count = 0xFFFFFFFF - lapic[TCCR];
+    lapicw(TICR, 0);
+    cprintf("lapic: timer %u counts per tick.\n", lapic_timer_count);
+}
+
+/* lapic_timer_start - interrupt TICK_HZ times per second on this cpu */
+void
+lapic_timer_start(void) {
+    lapicw(TIMER, PERIODIC | (IRQ_OFFSET + IRQ_APTIMER));
+    lapicw(TICR, lapic_timer_count);
+}
+
+/* lapic_timer_oneshot - interrupt once after nticks ticks on this cpu, in place of the periodic ticks */
+void
+lapic_timer_oneshot(unsigned int nticks) {
+    uint32_t count = (nticks < 0xFFFFFFFF / lapic_timer_count) ? nticks * lapic_timer_count : 0xFFFFFFFF;
+    lapicw(TIMER, IRQ_OFFSET + IRQ_APTIMER);
+    lapicw(TICR, count);
+}
+
+/* lapic_eoi - acknowledge the interrupt */
+void
+lapic_eoi(void) {
+    lapicw(EOI, 0);
+}
+
+/* lapic_ipi - send an interrupt of vector to the cpu of apic_id */
+void
+lapic_ipi(int apic_id, int vector) {
+    lapicw(ICRHI, apic_id << 24);
+    lapicw(ICRLO, FIXED | ASSERT | vector);
+    while (lapic[ICRLO] & DELIVS) {
+        /* do nothing */;
+    }
+}
+
+/* *
+ * lapic_startap - start the application processor of apic_id running at physical
+ * address addr, see Appendix B of MultiProcessor Specification.
+ * */
+void
+lapic_startap(int apic_id, uintptr_t addr) {
+    // the BSP must initialize CMOS shutdown code to 0AH and the warm reset vector
+    // (DWORD based at 40:67) to point at the AP startup code prior to the INIT IPI
+    outb(CMOS_PORT, 0xF);
+    outb(CMOS_PORT + 1, 0x0A);
+    uint16_t *wrv = (uint16_t *)(WARM_RESET + KERNBASE);
+    wrv[0] = 0;
+    wrv[1] = addr >> 4;
+
+    // universal startup algorithm: send INIT (level-triggered) interrupt to reset other cpu
+    lapicw(ICRHI, apic_id << 24);
+    lapicw(ICRLO, INIT | LEVEL | ASSERT);
+    clock_wait(1);
+    lapicw(ICRLO, INIT | LEVEL);
+    clock_wait(10);
+
+    // send startup IPI (twice!) to enter code, regular hardware is supposed to only accept
+    // a STARTUP when it is in the halted state due to an INIT, so the second should be ignored
+    int i;
+    for (i = 0; i < 2; i ++) {
+        lapicw(ICRHI, apic_id << 24);
+        lapicw(ICRLO, STARTUP | (addr >> 12));
+        clock_wait(1);
+    }
+}
+
@@ -0,0 +1,17 @@
+#ifndef __KERN_DRIVER_LAPIC_H__
+#define __KERN_DRIVER_LAPIC_H__
+
+#include <defs.h>
+
+extern volatile uint32_t *lapic;
+
+void lapic_init(void);
+void lapic_timer_calibrate(void);
+void lapic_timer_start(void);
+void lapic_timer_oneshot(unsigned int nticks);
+void lapic_eoi(void);
+void lapic_ipi(int apic_id, int vector);
+void lapic_startap(int apic_id, uintptr_t addr);
+
+#endif /* !__KERN_DRIVER_LAPIC_H__ */
+
@@ -0,0 +1,320 @@
+#include <defs.h>
+#include <x86.h>
+#include <string.h>
+#include <stdio.h>
+#include <mmu.h>
+#include <memlayout.h>
+#include <pmm.h>
+#include <trap.h>
+#include <proc.h>
+#include <spinlock.h>
+#include <lapic.h>
+#include <ioapic.h>
+#include <mp.h>
+
+/* *
+ * Multiprocessor support, following the MultiProcessor Specification Version 1.4.
+ * The BIOS describes the cpus and the IO APIC in the MP configuration table, which
+ * is found by the MP floating pointer structure in one of the following places:
+ *   1) in the first KB of the EBDA;
+ *   2) in the last KB of system base memory;
+ *   3) in the BIOS ROM between 0xF0000 and 0xFFFFF.
+ * With one cpu (or no table), nothing here is used and the 8259A serves the interrupts.
+ * */
+
+struct mp {                     // floating pointer [MP 4.1]
+    uint8_t signature[4];       // "_MP_"
+    uint32_t physaddr;          // phys addr of MP config table
+    uint8_t length;             // 1
+    uint8_t specrev;            // [14]
+    uint8_t checksum;           // all bytes must add up to 0
+    uint8_t type;               // MP system config type
+    uint8_t imcrp;              // bit 7: IMCR present, the 8259A is connected to the BSP in PIC mode
+    uint8_t reserved[3];
+} __attribute__((packed));
+
+struct mpconf {                 // configuration table header [MP 4.2]
+    uint8_t signature[4];       // "PCMP"
+    uint16_t length;            // total table length
+    uint8_t version;            // [14]
+    uint8_t checksum;           // all bytes must add up to 0
+    uint8_t product[20];        // product id
+    uint32_t oemtable;          // OEM table pointer
+    uint16_t oemlength;         // OEM table length
+    uint16_t entry;             // entry count
+    uint32_t lapicaddr;         // address of local APIC
+    uint16_t xlength;           // extended table length
+    uint8_t xchecksum;          // extended table checksum
+    uint8_t reserved;
+} __attribute__((packed));
+
+struct mpproc {                 // processor table entry [MP 4.3.1]
+    uint8_t type;               // entry type (0)
+    uint8_t apicid;             // local APIC id
+    uint8_t version;            // local APIC version
+    uint8_t flags;              // CPU flags
+    uint8_t signature[4];       // CPU signature
+    uint32_t feature;           // feature flags from CPUID instruction
+    uint8_t reserved[8];
+} __attribute__((packed));
+
+struct mpbus {                  // bus table entry [MP 4.3.2]
+    uint8_t type;               // entry type (1)
+    uint8_t busid;              // bus id
+    char bustype[6];            // "ISA   ", "PCI   ", ...
+} __attribute__((packed));
+
+struct mpioapic {               // I/O APIC table entry [MP 4.3.3]
+    uint8_t type;               // entry type (2)
+    uint8_t apicno;             // I/O APIC id
+    uint8_t version;            // I/O APIC version
+    uint8_t flags;              // I/O APIC flags
+    uint32_t addr;              // I/O APIC address
+} __attribute__((packed));
+
+struct mpiointr {               // I/O interrupt assignment entry [MP 4.3.4]
+    uint8_t type;               // entry type (3)
+    uint8_t irqtype;            // 0: vectored interrupt
+    uint16_t irqflag;           // polarity and trigger mode
+    uint8_t srcbus;             // source bus id
+    uint8_t srcbusirq;          // source bus irq
+    uint8_t dstapic;            // destination I/O APIC id
+    uint8_t dstirq;             // destination I/O APIC input pin
+} __attribute__((packed));
+
+// table entry types
+#define MPPROC          0x00    // One per processor
+#define MPBUS           0x01    // One per bus
+#define MPIOAPIC        0x02    // One per I/O APIC
+#define MPIOINTR        0x03    // One per bus interrupt source
+#define MPLINTR         0x04    // One per system interrupt source
+
+#define MPPROC_EN       0x01    // This processor is usable
+#define MPPROC_BOOT     0x02    // This processor is the bootstrap processor
+
+#define MPIOINTR_INT    0x00    // vectored interrupt
+
+struct cpu cpus[NCPU];
+int ncpu = 1;
+// there are more cpus, the APICs are used
+bool ismp = 0;
+
+// the arguments of mpentry.S for the booting AP
+uint32_t mpentry_cr4;
+uintptr_t mpentry_kstack;
+static struct cpu *mpentry_cpu;
+// CR4 of the boot cpu, with PSE and PGE
+static uint32_t boot_cr4;
+
+static uint8_t
+sum(void *addr, int len) {
+    uint8_t *p = addr, sum = 0;
+    int i;
+    for (i = 0; i < len; i ++) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+// mp_search1 - look for an MP structure in the len bytes at physical address pa
+static struct mp *
+mp_search1(uintptr_t pa, int len) {
+    struct mp *mp = KADDR(pa), *end = KADDR(pa + len);
+    for (; mp < end; mp ++) {
+        if (memcmp(mp->signature, "_MP_", 4) == 0 && sum(mp, sizeof(*mp)) == 0) {
+            return mp;
+        }
+    }
+    return NULL;
+}
+
+// mp_search - search for the MP floating pointer structure in the three places
+static struct mp *
+mp_search(void) {
+    uint8_t *bda = KADDR(0x400);
+    uintptr_t pa;
+    struct mp *mp;
+    if ((pa = ((bda[0x0F] << 8) | bda[0x0E]) << 4) != 0) {
+        if ((mp = mp_search1(pa, 1024)) != NULL) {
+            return mp;
+        }
+    }
+    else {
+        pa = ((bda[0x14] << 8) | bda[0x13]) * 1024;
+        if ((mp = mp_search1(pa - 1024, 1024)) != NULL) {
+            return mp;
+        }
+    }
+    return mp_search1(0xF0000, 0x10000);
+}
+
+// mp_config - find and check the MP configuration table, the default configurations
+// (physaddr == 0) are not supported
+static struct mpconf *
+mp_config(struct mp **pmp) {
+    struct mp *mp;
+    struct mpconf *conf;
+    if ((mp = mp_search()) == NULL || mp->physaddr == 0 || mp->physaddr >= KMEMSIZE) {
+        return NULL;
+    }
+    conf = KADDR(mp->physaddr);
+    if (memcmp(conf->signature, "PCMP", 4) != 0) {
+        return NULL;
+    }
+    if (conf->version != 1 && conf->version != 4) {
+        return NULL;
+    }
+    if (sum(conf, conf->length) != 0) {
+        return NULL;
+    }
+    *pmp = mp;
+    return conf;
+}
+
+/* *
+ * mp_init - find the cpus and the IO APIC in the MP configuration table. With more
+ * cpus, init the APICs of the boot cpu, which becomes cpus[0].
+ * */
+void
+mp_init(void) {
+    struct mp *mp;
+    struct mpconf *conf;
+    if ((conf = mp_config(&mp)) == NULL) {
+        return;
+    }
+
+    uintptr_t ioapic_pa = 0;
+    int isa_bus = -1, i;
+    uint8_t *p = (uint8_t *)(conf + 1), *end = (uint8_t *)conf + conf->length;
+    for (i = 0; i < conf->entry && p < end; i ++) {
+        switch (*p) {
+        case MPPROC: {
+                struct mpproc *proc = (struct mpproc *)p;
+                if (proc->flags & MPPROC_BOOT) {
+                    cpus[0].apic_id = proc->apicid;
+                }
+                else if ((proc->flags & MPPROC_EN) && ncpu < NCPU) {
+                    cpus[ncpu ++].apic_id = proc->apicid;
+                }
+                p += sizeof(struct mpproc);
+            }
+            continue;
+        case MPBUS: {
+                struct mpbus *bus = (struct mpbus *)p;
+                if (memcmp(bus->bustype, "ISA", 3) == 0) {
+                    isa_bus = bus->busid;
+                }
+                p += sizeof(struct mpbus);
+            }
+            continue;
+        case MPIOAPIC:
+            if (ioapic_pa == 0) {
+                ioapic_pa = ((struct mpioapic *)p)->addr;
+            }
+            p += sizeof(struct mpioapic);
+            continue;
+        case MPIOINTR:
+        case MPLINTR:
+            p += sizeof(struct mpiointr);
+            continue;
+        default:
+            cprintf("mp_init: unknown config type %x.\n", *p);
+            ncpu = 1;
+            return;
+        }
+    }
+
+    if (ncpu == 1 || ioapic_pa == 0) {
+        ncpu = 1;
+        return;
+    }
+    ismp = 1;
+
+    lapic = mmio_map(conf->lapicaddr, PGSIZE);
+    ioapic_init(ioapic_pa);
+
+    // the second pass, for the ISA irqs which are not connected to the same IO APIC pins
+    p = (uint8_t *)(conf + 1);
+    for (i = 0; i < conf->entry && p < end; i ++) {
+        if (*p == MPIOINTR) {
+            struct mpiointr *intr = (struct mpiointr *)p;
+            if (intr->irqtype == MPIOINTR_INT && intr->srcbus == isa_bus) {
+                ioapic_route(intr->srcbusirq, intr->dstirq);
+            }
+        }
+        p += (*p == MPPROC) ? sizeof(struct mpproc) : sizeof(struct mpiointr);
+    }
+
+    if (mp->imcrp & 0x80) {
+        // the hardware implements PIC mode, switch to getting interrupts from the APICs
+        outb(0x22, 0x70);               // select IMCR
+        outb(0x23, inb(0x23) | 1);      // mask external interrupts
+    }
+
+    for (i = 0; i < ncpu; i ++) {
+        cpus[i].id = i;
+    }
+    cpus[0].started = 1;
+
+    lapic_init();
+    lapic_timer_calibrate();
+
+    cprintf("mp: %d cpus, local apic at 0x%08x, io apic at 0x%08x.\n", ncpu, conf->lapicaddr, ioapic_pa);
+}
+
+/* *
+ * boot_aps - start the application processors one by one. Each runs mpentry.S, copied
+ * to MPENTRY_PADDR, on the kernel stack of its idle process, and waits for the kernel
+ * lock in mp_main until the boot cpu goes idle.
+ * */
+void
+boot_aps(void) {
+    if (!ismp) {
+        return;
+    }
+    extern char mpentry_start[], mpentry_end[];
+
+    lock_kernel();
+
+    memmove(KADDR(MPENTRY_PADDR), mpentry_start, mpentry_end - mpentry_start);
+
+    // mpentry.S turns on paging with va 0 ~ 4M mapped to pa 0 ~ 4M, and without global pages,
+    // which would keep this temporary mapping in the TLB after it is removed
+    boot_pgdir[0] = boot_pgdir[PDX(KERNBASE)] & ~PTE_G;
+    boot_cr4 = rcr4();
+    mpentry_cr4 = boot_cr4 & ~CR4_PGE;
+
+    int i;
+    for (i = 1; i < ncpu; i ++) {
+        struct cpu *cpu = cpus + i;
+        mpentry_cpu = cpu;
+        mpentry_kstack = cpu->idle->kstack + KSTACKSIZE;
+        lapic_startap(cpu->apic_id, MPENTRY_PADDR);
+        while (!cpu->started) {
+            pause();
+        }
+    }
+
+    boot_pgdir[0] = 0;
+    lcr3(boot_cr3);
+}
+
+/* mp_main - the first C function of an application processor, called by mpentry.S */
+void
+mp_main(void) {
+    struct cpu *cpu = mpentry_cpu;
+
+    lcr4(boot_cr4);
+    gdt_init_cpu(cpu, cpu->idle->kstack + KSTACKSIZE);
+    idt_init_ap();
+
+    lapic_init();
+    lapic_timer_start();
+
+    cpu->started = 1;
+
+    lock_kernel();
+    cprintf("cpu%d: started, apic id %d.\n", cpu->id, cpu->apic_id);
+    cpu_idle();
+}
+
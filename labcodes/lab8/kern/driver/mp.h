@@ -0,0 +1,55 @@
+#ifndef __KERN_DRIVER_MP_H__
+#define __KERN_DRIVER_MP_H__
+
+#include <defs.h>
+#include <x86.h>
+#include <mmu.h>
+#include <memlayout.h>
+#include <sched.h>
+
+#define NCPU                8                   // the maximum number of cpus
+
+struct proc_struct;
+
+// the per-cpu state
+struct cpu {
+    int id;                                     // index in cpus
+    uint8_t apic_id;                            // local APIC ID
+    volatile bool started;                      // the cpu has started
+    volatile int tlb_flush;                     // another cpu asks this cpu to flush its TLB, see tlb_shootdown
+    uintptr_t loaded_cr3;                       // the PDT loaded by load_cr3, maybe of a process run before
+    struct proc_struct *proc;                   // the process running on this cpu (current)
+    struct proc_struct *idle;                   // the idle process of this cpu (idleproc)
+    unsigned int ticks;                         // the timer ticks of this cpu
+    bool nohz;                                  // halted in tickless idle, the periodic tick is stopped
+    uint64_t nohz_tsc;                          // the TSC when the tick was stopped
+    size_t nohz_ticks;                          // the ticks when the tick was stopped, of the boot cpu
+    struct run_queue rq;                        // the run queue of this cpu
+    struct taskstate ts;                        // the kernel stack (esp0) for the traps from user mode
+    struct segdesc gdt[NSEGS];                  // the GDT, the TSS and user tls segments are per-cpu
+    struct pseudodesc gdt_pd;
+};
+
+extern struct cpu cpus[NCPU];
+extern int ncpu;
+extern bool ismp;
+
+/* *
+ * mycpu - the cpu running this code, found by the address of its own GDT. Before
+ * gdt_init the boot cpu runs on the GDT of bootloader, and cpus[0] is returned.
+ * A process stays on the cpu unless it calls schedule or is preempted, so the result holds
+ * with the interrupts disabled or under preempt_disable.
+ * */
+static inline struct cpu *
+mycpu(void) {
+    struct pseudodesc pd;
+    asm volatile ("sgdt %0" : "=m" (pd));
+    uintptr_t offset = pd.pd_base - (uintptr_t)cpus;
+    return (offset < sizeof(cpus)) ? cpus + offset / sizeof(struct cpu) : cpus;
+}
+
+void mp_init(void);
+void boot_aps(void);
+
+#endif /* !__KERN_DRIVER_MP_H__ */
+
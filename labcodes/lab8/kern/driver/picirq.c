@@ -1,6 +1,8 @@
 #include <defs.h>
 #include <x86.h>
 #include <picirq.h>
+#include <ioapic.h>
+#include <mp.h>
 
 // I/O Addresses of the two programmable interrupt controllers
 #define IO_PIC1             0x20    // Master (IRQs 0-7)
@@ -16,7 +18,7 @@ static bool did_init = 0;
 static void
 pic_setmask(uint16_t mask) {
     irq_mask = mask;
-    if (did_init) {
+    if (did_init && !ismp) {
         outb(IO_PIC1 + 1, mask);
         outb(IO_PIC2 + 1, mask >> 8);
     }
@@ -25,6 +27,10 @@ pic_setmask(uint16_t mask) {
 void
 pic_enable(unsigned int irq) {
     pic_setmask(irq_mask & ~(1 << irq));
+    // with more cpus, the IO APIC delivers the irqs to the boot cpu
+    if (did_init && ismp) {
+        ioapic_enable(irq, cpus[0].apic_id);
+    }
 }
 
 /* pic_init - initialize the 8259A interrupt controllers */
@@ -79,7 +85,16 @@ pic_init(void) {
     outb(IO_PIC2, 0x68);    // OCW3
     outb(IO_PIC2, 0x0a);    // OCW3
 
-    if (irq_mask != 0xFFFF) {
+    if (ismp) {
+        // the 8259A stays masked, enable the irqs which are enabled before in the IO APIC
+        int irq;
+        for (irq = 0; irq < 16; irq ++) {
+            if (irq != IRQ_SLAVE && !(irq_mask & (1 << irq))) {
+                ioapic_enable(irq, cpus[0].apic_id);
+            }
+        }
+    }
+    else if (irq_mask != 0xFFFF) {
         pic_setmask(irq_mask);
     }
 }
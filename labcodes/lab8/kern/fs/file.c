@@ -135,6 +135,18 @@ fd2file(int fd, struct file **file_store) {
     return -E_INVAL;
 }
 
+// file_inode - get the inode of an opened file, no reference of the inode is taken
+int
+file_inode(int fd, struct inode **node_store) {
+    int ret;
+    struct file *file;
+    if ((ret = fd2file(fd, &file)) != 0) {
+        return ret;
+    }
+    *node_store = file->node;
+    return 0;
+}
+
 // file_testfd - test file is readble or writable?
 bool
 file_testfd(int fd, bool readable, bool writable) {
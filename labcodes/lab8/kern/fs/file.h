@@ -38,6 +38,7 @@ int file_fstat(int fd, struct stat *stat);
 int file_fsync(int fd);
 int file_getdirentry(int fd, struct dirent *dirent);
 int file_dup(int fd1, int fd2);
+int file_inode(int fd, struct inode **node_store);
 int file_pipe(int fd[]);
 int file_mkfifo(const char *name, uint32_t open_flags);
 
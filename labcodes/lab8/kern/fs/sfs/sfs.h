@@ -5,6 +5,7 @@
 #include <mmu.h>
 #include <list.h>
 #include <sem.h>
+#include <mutex.h>
 #include <unistd.h>
 
 /*
@@ -86,8 +87,8 @@ struct sfs_fs {
     struct bitmap *freemap;                         /* blocks in use are mared 0 */
     bool super_dirty;                               /* true if super/freemap modified */
     void *sfs_buffer;                               /* buffer for non-block aligned io */
-    semaphore_t fs_sem;                             /* semaphore for fs */
-    semaphore_t io_sem;                             /* semaphore for io */
+    mutex_t fs_mutex;                               /* mutex for fs */
+    mutex_t io_mutex;                               /* mutex for io */
     semaphore_t mutex_sem;                          /* semaphore for link/unlink and rename */
     list_entry_t inode_list;                        /* inode linked-list */
     list_entry_t *hash_list;                        /* inode hash linked-list */
@@ -123,6 +124,7 @@ int sfs_sync_super(struct sfs_fs *sfs);
 int sfs_sync_freemap(struct sfs_fs *sfs);
 int sfs_clear_block(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks);
 
+void sfs_inode_cache_init(void);
 int sfs_load_inode(struct sfs_fs *sfs, struct inode **node_store, uint32_t ino);
 
 #endif /* !__KERN_FS_SFS_SFS_H__ */
@@ -16,6 +16,20 @@
 static const struct inode_ops sfs_node_dirops;  // dir operations
 static const struct inode_ops sfs_node_fileops; // file operations
 
+static struct kmem_cache *sfs_din_cache;        // in-memory copies of disk inodes
+static struct kmem_cache *sfs_entry_cache;      // disk entries read in lookup/getdirentry
+
+/*
+ * sfs_inode_cache_init - create the caches of sfs inode structures
+ */
+void
+sfs_inode_cache_init(void) {
+    if ((sfs_din_cache = kmem_cache_create("sfs_disk_inode", sizeof(struct sfs_disk_inode))) == NULL
+        || (sfs_entry_cache = kmem_cache_create("sfs_disk_entry", sizeof(struct sfs_disk_entry))) == NULL) {
+        panic("sfs_inode_cache_init: create caches failed.\n");
+    }
+}
+
 /*
  * lock_sin - lock the process of inode Rd/Wr
  */
@@ -161,7 +175,7 @@ sfs_load_inode(struct sfs_fs *sfs, struct inode **node_store, uint32_t ino) {
 
     int ret = -E_NO_MEM;
     struct sfs_disk_inode *din;
-    if ((din = kmalloc(sizeof(struct sfs_disk_inode))) == NULL) {
+    if ((din = kmem_cache_alloc(sfs_din_cache)) == NULL) {
         goto failed_unlock;
     }
 
@@ -182,7 +196,7 @@ out_unlock:
     return 0;
 
 failed_cleanup_din:
-    kfree(din);
+    kmem_cache_free(sfs_din_cache, din);
 failed_unlock:
     unlock_sfs_fs(sfs);
     return ret;
@@ -441,7 +455,7 @@ static int
 sfs_dirent_search_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, const char *name, uint32_t *ino_store, int *slot, int *empty_slot) {
     assert(strlen(name) <= SFS_MAX_FNAME_LEN);
     struct sfs_disk_entry *entry;
-    if ((entry = kmalloc(sizeof(struct sfs_disk_entry))) == NULL) {
+    if ((entry = kmem_cache_alloc(sfs_entry_cache)) == NULL) {
         return -E_NO_MEM;
     }
 
@@ -465,7 +479,7 @@ sfs_dirent_search_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, const char *
 #undef set_pvalue
     ret = -E_NOENT;
 out:
-    kfree(entry);
+    kmem_cache_free(sfs_entry_cache, entry);
     return ret;
 }
 
@@ -589,16 +603,41 @@ sfs_io_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, void *buf, off_t offset
     uint32_t blkno = offset / SFS_BLKSIZE;          // The NO. of Rd/Wr begin block
     uint32_t nblks = endpos / SFS_BLKSIZE - blkno;  // The size of Rd/Wr blocks
 
-  //LAB8:EXERCISE1 YOUR CODE HINT: call sfs_bmap_load_nolock, sfs_rbuf, sfs_rblock,etc. read different kind of blocks in file
-	/*
-	 * (1) If offset isn't aligned with the first block, Rd/Wr some content from offset to the end of the first block
-	 *       NOTICE: useful function: sfs_bmap_load_nolock, sfs_buf_op
-	 *               Rd/Wr size = (nblks != 0) ? (SFS_BLKSIZE - blkoff) : (endpos - offset)
-	 * (2) Rd/Wr aligned blocks 
-	 *       NOTICE: useful function: sfs_bmap_load_nolock, sfs_block_op
-     * (3) If end position isn't aligned with the last block, Rd/Wr some content from begin to the (endpos % SFS_BLKSIZE) of the last block
-	 *       NOTICE: useful function: sfs_bmap_load_nolock, sfs_buf_op	
-	*/
+    if ((blkoff = offset % SFS_BLKSIZE) != 0) {
+        size = (nblks != 0) ? (SFS_BLKSIZE - blkoff) : (endpos - offset);
+        if ((ret = sfs_bmap_load_nolock(sfs, sin, blkno, &ino)) != 0) {
+            goto out;
+        }
+        if ((ret = sfs_buf_op(sfs, buf, size, ino, blkoff)) != 0) {
+            goto out;
+        }
+        alen += size;
+        if (nblks == 0) {
+            goto out;
+        }
+        buf += size, blkno ++, nblks --;
+    }
+
+    size = SFS_BLKSIZE;
+    while (nblks != 0) {
+        if ((ret = sfs_bmap_load_nolock(sfs, sin, blkno, &ino)) != 0) {
+            goto out;
+        }
+        if ((ret = sfs_block_op(sfs, buf, ino, 1)) != 0) {
+            goto out;
+        }
+        alen += size, buf += size, blkno ++, nblks --;
+    }
+
+    if ((size = endpos % SFS_BLKSIZE) != 0) {
+        if ((ret = sfs_bmap_load_nolock(sfs, sin, blkno, &ino)) != 0) {
+            goto out;
+        }
+        if ((ret = sfs_buf_op(sfs, buf, size, ino, 0)) != 0) {
+            goto out;
+        }
+        alen += size;
+    }
 out:
     *alenp = alen;
     if (offset + alen > sin->din->size) {
@@ -688,7 +727,7 @@ sfs_fsync(struct inode *node) {
 static int
 sfs_namefile(struct inode *node, struct iobuf *iob) {
     struct sfs_disk_entry *entry;
-    if (iob->io_resid <= 2 || (entry = kmalloc(sizeof(struct sfs_disk_entry))) == NULL) {
+    if (iob->io_resid <= 2 || (entry = kmem_cache_alloc(sfs_entry_cache)) == NULL) {
         return -E_NO_MEM;
     }
 
@@ -736,14 +775,14 @@ sfs_namefile(struct inode *node, struct iobuf *iob) {
     ptr = memmove(iob->io_base + 1, ptr, alen);
     ptr[-1] = '/', ptr[alen] = '\0';
     iobuf_skip(iob, alen);
-    kfree(entry);
+    kmem_cache_free(sfs_entry_cache, entry);
     return 0;
 
 failed_nomem:
     ret = -E_NO_MEM;
 failed:
     vop_ref_dec(node);
-    kfree(entry);
+    kmem_cache_free(sfs_entry_cache, entry);
     return ret;
 }
 
@@ -774,7 +813,7 @@ sfs_getdirentry_sub_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int slot,
 static int
 sfs_getdirentry(struct inode *node, struct iobuf *iob) {
     struct sfs_disk_entry *entry;
-    if ((entry = kmalloc(sizeof(struct sfs_disk_entry))) == NULL) {
+    if ((entry = kmem_cache_alloc(sfs_entry_cache)) == NULL) {
         return -E_NO_MEM;
     }
 
@@ -784,11 +823,11 @@ sfs_getdirentry(struct inode *node, struct iobuf *iob) {
     int ret, slot;
     off_t offset = iob->io_offset;
     if (offset < 0 || offset % sfs_dentry_size != 0) {
-        kfree(entry);
+        kmem_cache_free(sfs_entry_cache, entry);
         return -E_INVAL;
     }
     if ((slot = offset / sfs_dentry_size) > sin->din->blocks) {
-        kfree(entry);
+        kmem_cache_free(sfs_entry_cache, entry);
         return -E_NOENT;
     }
     lock_sin(sin);
@@ -799,7 +838,7 @@ sfs_getdirentry(struct inode *node, struct iobuf *iob) {
     unlock_sin(sin);
     ret = iobuf_move(iob, entry->name, sfs_dentry_size, 1, NULL);
 out:
-    kfree(entry);
+    kmem_cache_free(sfs_entry_cache, entry);
     return ret;
 }
 
@@ -837,7 +876,7 @@ sfs_reclaim(struct inode *node) {
             sfs_block_free(sfs, ent);
         }
     }
-    kfree(sin->din);
+    kmem_cache_free(sfs_din_cache, sin->din);
     vop_kill(node);
     return 0;
 
@@ -8,13 +8,26 @@
 #include <assert.h>
 #include <kmalloc.h>
 
+static struct kmem_cache *inode_cache;
+
+/* *
+ * inode_cache_init - create the cache of inode structures
+ * invoked by vfs_init
+ * */
+void
+inode_cache_init(void) {
+    if ((inode_cache = kmem_cache_create("inode", sizeof(struct inode))) == NULL) {
+        panic("inode_cache_init: create inode cache failed.\n");
+    }
+}
+
 /* *
  * __alloc_inode - alloc a inode structure and initialize in_type
  * */
 struct inode *
 __alloc_inode(int type) {
     struct inode *node;
-    if ((node = kmalloc(sizeof(struct inode))) != NULL) {
+    if ((node = kmem_cache_alloc(inode_cache)) != NULL) {
         node->in_type = type;
     }
     return node;
@@ -29,6 +42,7 @@ inode_init(struct inode *node, const struct inode_ops *ops, struct fs *fs) {
     node->ref_count = 0;
     node->open_count = 0;
     node->in_ops = ops, node->in_fs = fs;
+    list_init(&(node->filemap_list));
     vop_ref_inc(node);
 }
 
@@ -40,7 +54,7 @@ void
 inode_kill(struct inode *node) {
     assert(inode_ref_count(node) == 0);
     assert(inode_open_count(node) == 0);
-    kfree(node);
+    kmem_cache_free(inode_cache, node);
 }
 
 /* *
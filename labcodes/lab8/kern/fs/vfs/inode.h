@@ -2,6 +2,7 @@
 #define __KERN_FS_VFS_INODE_H__
 
 #include <defs.h>
+#include <list.h>
 #include <dev.h>
 #include <sfs.h>
 #include <atomic.h>
@@ -39,6 +40,7 @@ struct inode {
     int open_count;
     struct fs *in_fs;
     const struct inode_ops *in_ops;
+    list_entry_t filemap_list;      // the pages of this file in the executable page cache, see filemap.c
 };
 
 #define __in_type(type)                                             inode_type_##type##_info
@@ -57,6 +59,7 @@ struct inode {
 #define info2node(info, type)                                       \
     to_struct((info), struct inode, in_info.__##type##_info)
 
+void inode_cache_init(void);
 struct inode *__alloc_inode(int type);
 
 #define alloc_inode(type)                                           __alloc_inode(__in_type(type))
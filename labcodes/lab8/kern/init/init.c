@@ -14,6 +14,7 @@
 #include <proc.h>
 #include <fs.h>
 #include <kmonitor.h>
+#include <mp.h>
 
 int kern_init(void) __attribute__((noreturn));
 void grade_backtrace(void);
@@ -34,6 +35,7 @@ kern_init(void) {
     grade_backtrace();
 
     pmm_init();                 // init physical memory management
+    mp_init();                  // find the other cpus, init local APIC
 
     pic_init();                 // init interrupt controller
     idt_init();                 // init interrupt descriptor table
@@ -47,6 +49,7 @@ kern_init(void) {
     fs_init();                  // init fs
     
     clock_init();               // init clock interrupt
+    boot_aps();                 // start the other cpus
     intr_enable();              // enable irq interrupt
 
     //LAB1: CAHLLENGE 1 If you try to do it, uncomment lab1_switch_test()
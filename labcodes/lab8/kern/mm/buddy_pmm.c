@@ -0,0 +1,365 @@
+#include <pmm.h>
+#include <list.h>
+#include <string.h>
+#include <sync.h>
+#include <buddy_pmm.h>
+
+/* *
+ * Buddy System
+ *
+ * The free pages are kept in blocks of 2^order pages, and a block of order k always
+ * starts at a ppn which is a multiple of 2^k. So the buddy of a block (the other half
+ * of the block of order k+1 containing it) is found by ppn ^ (1 << k), and no search
+ * in a list is needed for both alloc and free:
+ *  - alloc_pages(n) takes a block from the free list of the smallest order which can
+ *    hold n pages, splits it and puts the upper halves back in the lower order lists.
+ *    The pages beyond n in the block are given back at once.
+ *  - free_pages(base, n) breaks [base, base + n) into aligned blocks, and merges every
+ *    block with its buddy as long as the buddy is a free block of the same order.
+ *
+ * The head page of a free block has PG_property set and the order in property.
+ * Every zone has its own free lists, the pages of a block are in the same zone.
+ * */
+
+struct zone {
+    const char *name;
+    free_area_t free_area[MAX_ORDER];       // free_area[k]: the free blocks of order k
+    size_t nr_free;                         // # of free pages in this zone
+};
+
+static struct zone zones[MAX_NR_ZONES] = {
+    [ZONE_DMA] = {.name = "DMA"},
+    [ZONE_NORMAL] = {.name = "Normal"},
+};
+
+#define free_list(zone, order)      ((zone)->free_area[order].free_list)
+#define nr_free(zone, order)        ((zone)->free_area[order].nr_free)
+
+static inline struct zone *
+ppn2zone(size_t ppn) {
+    return &zones[(ppn < PPN(DMA_LIMIT)) ? ZONE_DMA : ZONE_NORMAL];
+}
+
+// size2order - the smallest order whose block can hold n pages
+static inline int
+size2order(size_t n) {
+    int order = 0;
+    while ((1 << order) < n) {
+        order ++;
+    }
+    return order;
+}
+
+// block_add/block_del - add or remove a free block of order in the free list of zone
+static inline void
+block_add(struct zone *zone, struct Page *page, int order) {
+    page->property = order;
+    SetPageProperty(page);
+    list_add(&free_list(zone, order), &(page->page_link));
+    nr_free(zone, order) += (1 << order);
+    zone->nr_free += (1 << order);
+}
+
+static inline void
+block_del(struct zone *zone, struct Page *page, int order) {
+    list_del(&(page->page_link));
+    ClearPageProperty(page);
+    nr_free(zone, order) -= (1 << order);
+    zone->nr_free -= (1 << order);
+}
+
+// buddy_free_block - free the block of order at ppn, merge it with its buddies
+static void
+buddy_free_block(size_t ppn, int order) {
+    struct zone *zone = ppn2zone(ppn);
+    while (order + 1 < MAX_ORDER) {
+        size_t buddy = ppn ^ (1 << order);
+        if (buddy >= npage) {
+            break;
+        }
+        struct Page *p = pages + buddy;
+        if (!PageProperty(p) || p->property != order) {
+            break;
+        }
+        block_del(zone, p, order);
+        ppn &= ~(1 << order);
+        order ++;
+    }
+    block_add(zone, pages + ppn, order);
+}
+
+// buddy_free_range - free the pages [base, base + n) as the biggest aligned blocks
+static void
+buddy_free_range(struct Page *base, size_t n) {
+    size_t ppn = page2ppn(base), end = ppn + n;
+    while (ppn < end) {
+        int order = 0;
+        while (order + 1 < MAX_ORDER && ppn % (1 << (order + 1)) == 0 && ppn + (1 << (order + 1)) <= end) {
+            order ++;
+        }
+        buddy_free_block(ppn, order);
+        ppn += (1 << order);
+    }
+}
+
+// zone_alloc_pages - alloc n pages from zone, NULL if no block is big enough
+static struct Page *
+zone_alloc_pages(struct zone *zone, size_t n) {
+    int order = size2order(n), k = order;
+    if (order >= MAX_ORDER) {
+        return NULL;
+    }
+    while (list_empty(&free_list(zone, k))) {
+        if (++ k == MAX_ORDER) {
+            return NULL;
+        }
+    }
+    struct Page *page = le2page(list_next(&free_list(zone, k)), page_link);
+    block_del(zone, page, k);
+    while (k > order) {
+        k --;
+        block_add(zone, page + (1 << k), k);
+    }
+    if (n < (1 << order)) {
+        buddy_free_range(page + n, (1 << order) - n);
+    }
+    return page;
+}
+
+static void
+buddy_init(void) {
+    int i, order;
+    for (i = 0; i < MAX_NR_ZONES; i ++) {
+        for (order = 0; order < MAX_ORDER; order ++) {
+            list_init(&free_list(zones + i, order));
+            nr_free(zones + i, order) = 0;
+        }
+        zones[i].nr_free = 0;
+    }
+}
+
+static void
+buddy_init_memmap(struct Page *base, size_t n) {
+    assert(n > 0);
+    struct Page *p = base;
+    for (; p != base + n; p ++) {
+        assert(PageReserved(p));
+        p->flags = p->property = 0;
+        set_page_ref(p, 0);
+    }
+    buddy_free_range(base, n);
+}
+
+static struct Page *
+buddy_alloc_pages(size_t n) {
+    assert(n > 0);
+    struct Page *page;
+    if ((page = zone_alloc_pages(zones + ZONE_NORMAL, n)) == NULL) {
+        page = zone_alloc_pages(zones + ZONE_DMA, n);
+    }
+    return page;
+}
+
+static void
+buddy_free_pages(struct Page *base, size_t n) {
+    assert(n > 0);
+    struct Page *p = base;
+    for (; p != base + n; p ++) {
+        assert(!PageReserved(p) && !PageProperty(p));
+        p->flags = 0;
+        set_page_ref(p, 0);
+    }
+    buddy_free_range(base, n);
+}
+
+static size_t
+buddy_nr_free_pages(void) {
+    size_t ret = 0;
+    int i;
+    for (i = 0; i < MAX_NR_ZONES; i ++) {
+        ret += zones[i].nr_free;
+    }
+    return ret;
+}
+
+//alloc_pages_zone - alloc n continuous pages from the zone only
+struct Page *
+alloc_pages_zone(int zone, size_t n) {
+    assert(pmm_manager == &buddy_pmm_manager && 0 <= zone && zone < MAX_NR_ZONES && n > 0);
+    struct Page *page;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        page = zone_alloc_pages(zones + zone, n);
+    }
+    local_intr_restore(intr_flag);
+    return page;
+}
+
+//nr_free_pages_zone - the number of free pages in the zone
+size_t
+nr_free_pages_zone(int zone) {
+    assert(pmm_manager == &buddy_pmm_manager && 0 <= zone && zone < MAX_NR_ZONES);
+    return zones[zone].nr_free;
+}
+
+static struct zone zones_store[MAX_NR_ZONES];
+
+// zones_isolate - hide all free blocks, so the checks see only the pages they free
+static void
+zones_isolate(void) {
+    int i;
+    for (i = 0; i < MAX_NR_ZONES; i ++) {
+        zones_store[i] = zones[i];
+    }
+    buddy_init();
+}
+
+static void
+zones_restore(void) {
+    int i;
+    for (i = 0; i < MAX_NR_ZONES; i ++) {
+        assert(zones[i].nr_free == 0);
+        zones[i] = zones_store[i];
+    }
+}
+
+// count_free_blocks - check every free block is aligned & in its zone, return the number of them
+static int
+count_free_blocks(void) {
+    int i, order, count = 0;
+    size_t total = 0;
+    for (i = 0; i < MAX_NR_ZONES; i ++) {
+        size_t zone_total = 0;
+        for (order = 0; order < MAX_ORDER; order ++) {
+            size_t order_total = 0;
+            list_entry_t *le = &free_list(zones + i, order);
+            while ((le = list_next(le)) != &free_list(zones + i, order)) {
+                struct Page *p = le2page(le, page_link);
+                assert(PageProperty(p) && p->property == order);
+                assert(page2ppn(p) % (1 << order) == 0 && ppn2zone(page2ppn(p)) == zones + i);
+                count ++, order_total += (1 << order);
+            }
+            assert(order_total == nr_free(zones + i, order));
+            zone_total += order_total;
+        }
+        assert(zone_total == zones[i].nr_free);
+        total += zone_total;
+    }
+    assert(total == nr_free_pages());
+    return count;
+}
+
+static void
+buddy_basic_check(void) {
+    // the 4th page of the block stays allocated, so p0 ~ p2 never merge with the free blocks hidden
+    struct Page *base, *p0, *p1, *p2;
+    assert((base = alloc_pages(4)) != NULL);
+    p0 = base, p1 = base + 1, p2 = base + 2;
+    assert(page_ref(p0) == 0 && page_ref(p1) == 0 && page_ref(p2) == 0);
+    assert(page2pa(base + 3) < npage * PGSIZE);
+
+    zones_isolate();
+    assert(alloc_page() == NULL);
+
+    free_page(p0);
+    free_page(p1);
+    free_page(p2);
+    assert(nr_free_pages() == 3);
+
+    assert((p0 = alloc_page()) != NULL);
+    assert((p1 = alloc_page()) != NULL);
+    assert((p2 = alloc_page()) != NULL);
+    assert(p0 != p1 && p0 != p2 && p1 != p2);
+    assert(alloc_page() == NULL);
+
+    free_page(p0);
+    struct Page *p;
+    assert((p = alloc_page()) == p0);
+    assert(alloc_page() == NULL);
+
+    zones_restore();
+    free_pages(base, 4);
+}
+
+static void
+buddy_check(void) {
+    int count = count_free_blocks();
+    size_t total = nr_free_pages();
+
+    buddy_basic_check();
+
+    // the upper half of the order 4 block stays allocated, the checks use the lower half
+    struct Page *p0, *p1, *p2;
+    assert((p0 = alloc_pages(16)) != NULL && page2ppn(p0) % 16 == 0);
+    assert(!PageProperty(p0));
+
+    zones_isolate();
+    assert(alloc_page() == NULL);
+
+    free_pages(p0, 8);
+    assert(PageProperty(p0) && p0->property == 3 && nr_free_pages() == 8);
+    assert(alloc_pages(9) == NULL);
+
+    // a block is split into halves, the upper ones are kept free
+    assert((p1 = alloc_page()) == p0);
+    assert(PageProperty(p0 + 1) && p0[1].property == 0);
+    assert(PageProperty(p0 + 2) && p0[2].property == 1);
+    assert(PageProperty(p0 + 4) && p0[4].property == 2);
+
+    // 3 pages take an order 2 block, its last page is given back
+    assert((p2 = alloc_pages(3)) == p0 + 4);
+    assert(PageProperty(p0 + 7) && p0[7].property == 0 && nr_free_pages() == 4);
+
+    // the buddies merge when freed
+    free_pages(p2, 3);
+    assert(PageProperty(p0 + 4) && p0[4].property == 2);
+    free_page(p1);
+    assert(PageProperty(p0) && p0->property == 3 && nr_free_pages() == 8);
+
+    // free a part of a block, the rest is kept in aligned blocks
+    assert((p1 = alloc_pages(8)) == p0 && nr_free_pages() == 0);
+    free_pages(p0 + 1, 7);
+    assert(PageProperty(p0 + 1) && p0[1].property == 0);
+    assert(PageProperty(p0 + 2) && p0[2].property == 1);
+    assert(PageProperty(p0 + 4) && p0[4].property == 2);
+    assert((p2 = alloc_pages(4)) == p0 + 4);
+    free_page(p0);
+    assert(PageProperty(p0) && p0->property == 2 && !PageProperty(p0 + 2));
+    free_pages(p2, 4);
+    assert(PageProperty(p0) && p0->property == 3);
+
+    assert((p1 = alloc_pages(8)) == p0);
+    assert(alloc_page() == NULL);
+    zones_restore();
+    free_pages(p0, 16);
+
+    // the zones and the alignment of big blocks
+    if (nr_free_pages_zone(ZONE_DMA) != 0) {
+        assert((p0 = alloc_pages_zone(ZONE_DMA, 1)) != NULL && page2pa(p0) < DMA_LIMIT);
+        free_page(p0);
+    }
+    if (nr_free_pages_zone(ZONE_NORMAL) != 0) {
+        assert((p0 = alloc_pages_zone(ZONE_NORMAL, 1)) != NULL && page2pa(p0) >= DMA_LIMIT);
+        free_page(p0);
+    }
+    if ((p0 = alloc_pages(NPTEENTRY)) != NULL) {
+        assert(page2pa(p0) % PTSIZE == 0);
+        free_pages(p0, NPTEENTRY);
+    }
+    assert(alloc_pages(1 << MAX_ORDER) == NULL);
+
+    assert(count_free_blocks() == count);
+    assert(nr_free_pages() == total);
+}
+
+const struct pmm_manager buddy_pmm_manager = {
+    .name = "buddy_pmm_manager",
+    .init = buddy_init,
+    .init_memmap = buddy_init_memmap,
+    .alloc_pages = buddy_alloc_pages,
+    .free_pages = buddy_free_pages,
+    .nr_free_pages = buddy_nr_free_pages,
+    .check = buddy_check,
+};
+
@@ -0,0 +1,21 @@
+#ifndef __KERN_MM_BUDDY_PMM_H__
+#define  __KERN_MM_BUDDY_PMM_H__
+
+#include <pmm.h>
+
+#define MAX_ORDER           11                      // block orders 0 ~ MAX_ORDER-1, the biggest block is a PTSIZE large page
+
+// the physical memory is divided into zones, a block never crosses the border of zones
+#define ZONE_DMA            0                       // [0, DMA_LIMIT), for ISA devices which can only address 16M
+#define ZONE_NORMAL         1                       // [DMA_LIMIT, KMEMSIZE)
+#define MAX_NR_ZONES        2
+
+#define DMA_LIMIT           0x1000000
+
+extern const struct pmm_manager buddy_pmm_manager;
+
+struct Page *alloc_pages_zone(int zone, size_t n);
+size_t nr_free_pages_zone(int zone);
+
+#endif /* ! __KERN_MM_BUDDY_PMM_H__ */
+
@@ -0,0 +1,143 @@
+#include <defs.h>
+#include <list.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <kmalloc.h>
+#include <pmm.h>
+#include <sync.h>
+#include <inode.h>
+#include <filemap.h>
+
+/* *
+ * A cached page is described by a filemap_entry, which is linked in a hash list
+ * (by inode & offset) for lookup, and in the filemap_list of its inode for release.
+ * size is the number of file bytes in the page, the rest of the page is zero.
+ * */
+struct filemap_entry {
+    struct inode *node;             // the file of this page
+    off_t offset;                   // the file offset of the first byte of this page
+    size_t size;                    // bytes of file content in this page
+    struct Page *page;              // the cached page
+    list_entry_t hash_link;         // entry in hash list
+    list_entry_t list_link;         // entry in node->filemap_list
+};
+
+#define le2fmentry(le, member)              \
+    to_struct((le), struct filemap_entry, member)
+
+#define FILEMAP_HASH_SHIFT          8
+#define FILEMAP_HASH_SIZE           (1 << FILEMAP_HASH_SHIFT)
+#define filemap_hashfn(node, offset)                                                        \
+    (hash32((uint32_t)(node) ^ ((uint32_t)(offset) >> PGSHIFT), FILEMAP_HASH_SHIFT))
+
+static list_entry_t filemap_hash[FILEMAP_HASH_SIZE];
+static size_t nr_filemap;
+
+void
+filemap_init(void) {
+    int i;
+    for (i = 0; i < FILEMAP_HASH_SIZE; i ++) {
+        list_init(filemap_hash + i);
+    }
+    nr_filemap = 0;
+}
+
+// filemap_lookup - find the cached page of (node, offset), NULL if not cached
+struct Page *
+filemap_lookup(struct inode *node, off_t offset, size_t size) {
+    list_entry_t *list = filemap_hash + filemap_hashfn(node, offset), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct filemap_entry *entry = le2fmentry(le, hash_link);
+        if (entry->node == node && entry->offset == offset && entry->size == size) {
+            return entry->page;
+        }
+    }
+    return NULL;
+}
+
+/* *
+ * filemap_add - put a filled page into the cache, the cache takes a reference of page and node.
+ * If another process has cached (node, offset) meanwhile (the filling may sleep on disk I/O,
+ * and the kernel code may be preempted), the page in the cache is returned and the caller
+ * should drop its own page. The lookup and the insertion are done with the interrupts
+ * disabled, as filemap_release unlinks.
+ * return NULL if there is no memory for the entry.
+ * */
+struct Page *
+filemap_add(struct inode *node, off_t offset, size_t size, struct Page *page) {
+    struct Page *cached;
+    if ((cached = filemap_lookup(node, offset, size)) != NULL) {
+        return cached;
+    }
+    struct filemap_entry *entry;
+    if ((entry = kmalloc(sizeof(struct filemap_entry))) == NULL) {
+        return NULL;
+    }
+
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        // kmalloc may sleep, look again
+        if ((cached = filemap_lookup(node, offset, size)) != NULL) {
+            local_intr_restore(intr_flag);
+            kfree(entry);
+            return cached;
+        }
+        vop_ref_inc(node);
+        page_ref_inc(page);
+        entry->node = node;
+        entry->offset = offset;
+        entry->size = size;
+        entry->page = page;
+        list_add(filemap_hash + filemap_hashfn(node, offset), &(entry->hash_link));
+        list_add(&(node->filemap_list), &(entry->list_link));
+        nr_filemap ++;
+    }
+    local_intr_restore(intr_flag);
+    return page;
+}
+
+/* *
+ * filemap_release - drop the cached pages of node which are not mapped by any process
+ * (only referenced by the cache). Called when a vma backed by node goes away.
+ * The entries are unlinked first with the interrupts disabled, the kernel code may be
+ * preempted and vop_ref_dec may sleep, then dropped.
+ * */
+void
+filemap_release(struct inode *node) {
+    list_entry_t freed, *list = &(node->filemap_list), *le;
+    list_init(&freed);
+
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        le = list_next(list);
+        while (le != list) {
+            struct filemap_entry *entry = le2fmentry(le, list_link);
+            le = list_next(le);
+            if (page_ref(entry->page) == 1) {
+                list_del(&(entry->hash_link));
+                list_del(&(entry->list_link));
+                list_add(&freed, &(entry->list_link));
+                nr_filemap --;
+            }
+        }
+    }
+    local_intr_restore(intr_flag);
+
+    while ((le = list_next(&freed)) != &freed) {
+        struct filemap_entry *entry = le2fmentry(le, list_link);
+        list_del(le);
+        set_page_ref(entry->page, 0);
+        free_page(entry->page);
+        vop_ref_dec(node);
+        kfree(entry);
+    }
+}
+
+// filemap_count - the number of cached pages
+size_t
+filemap_count(void) {
+    return nr_filemap;
+}
+
@@ -0,0 +1,24 @@
+#ifndef __KERN_MM_FILEMAP_H__
+#define __KERN_MM_FILEMAP_H__
+
+#include <defs.h>
+
+struct inode;
+struct Page;
+
+/* *
+ * filemap - the executable page cache.
+ * The pages of read-only file-backed vmas (TEXT of user programs) are kept here,
+ * keyed by (inode, file offset), so all processes running the same binary map
+ * the same physical pages. The cache holds one reference of each page and one
+ * reference of the inode for each cached page.
+ * */
+
+void filemap_init(void);
+struct Page *filemap_lookup(struct inode *node, off_t offset, size_t size);
+struct Page *filemap_add(struct inode *node, off_t offset, size_t size, struct Page *page);
+void filemap_release(struct inode *node);
+size_t filemap_count(void);
+
+#endif /* !__KERN_MM_FILEMAP_H__ */
+
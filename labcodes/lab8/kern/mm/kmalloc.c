@@ -6,300 +6,381 @@
 #include <sync.h>
 #include <pmm.h>
 #include <stdio.h>
+#include <string.h>
 
-/*
- * SLOB Allocator: Simple List Of Blocks
+/* *
+ * Slab Allocator
  *
- * Matt Mackall <mpm@selenic.com> 12/30/03
+ * A kmem_cache hands out objects of one size. Its memory comes in slabs, a slab is
+ * 2^order continuous pages: a struct slab at the beginning, then the objects. The free
+ * objects of a slab are linked by their first word, so alloc & free are O(1):
+ *  - kmem_cache_alloc takes an object from a partial slab (some objects in use), or
+ *    from a free slab, or from a new slab if the cache has none.
+ *  - kmem_cache_free finds the slab of the object by the back-pointer in its struct
+ *    Page (PG_slab is set for all the pages of a slab). A slab becomes free when its
+ *    last object is freed, and a cache keeps at most one free slab.
  *
- * How SLOB works:
+ * kmalloc uses the caches of size 2^n (KMALLOC_MIN_SIZE ~ KMALLOC_MAX_SIZE), bigger
+ * blocks are allocated by alloc_pages directly, the number of pages is kept in the
+ * property of the first page.
  *
- * The core of SLOB is a traditional K&R style heap allocator, with
- * support for returning aligned objects. The granularity of this
- * allocator is 8 bytes on x86, though it's perhaps possible to reduce
- * this to 4 if it's deemed worth the effort. The slob heap is a
- * singly-linked list of pages from __get_free_page, grown on demand
- * and allocation from the heap is currently first-fit.
- *
- * Above this is an implementation of kmalloc/kfree. Blocks returned
- * from kmalloc are 8-byte aligned and prepended with a 8-byte header.
- * If kmalloc is asked for objects of PAGE_SIZE or larger, it calls
- * __get_free_pages directly so that it can return page-aligned blocks
- * and keeps a linked list of such pages and their orders. These
- * objects are detected in kfree() by their page alignment.
- *
- * SLAB is emulated on top of SLOB by simply calling constructors and
- * destructors for every SLAB allocation. Objects are returned with
- * the 8-byte alignment unless the SLAB_MUST_HWCACHE_ALIGN flag is
- * set, in which case the low-level allocator will fragment blocks to
- * create the proper alignment. Again, objects of page-size or greater
- * are allocated by calling __get_free_pages. As SLAB objects know
- * their size, no separate size bookkeeping is necessary and there is
- * essentially no allocation space overhead.
- */
-
-
-//some helper
-#define spin_lock_irqsave(l, f) local_intr_save(f)
-#define spin_unlock_irqrestore(l, f) local_intr_restore(f)
-typedef unsigned int gfp_t;
-#ifndef PAGE_SIZE
-#define PAGE_SIZE PGSIZE
-#endif
-
-#ifndef L1_CACHE_BYTES
-#define L1_CACHE_BYTES 64
-#endif
-
-#ifndef ALIGN
-#define ALIGN(addr,size)   (((addr)+(size)-1)&(~((size)-1))) 
-#endif
-
-
-struct slob_block {
-	int units;
-	struct slob_block *next;
+ * The caches of the frequently used kernel objects (proc_struct, mm_struct, vma_struct,
+ * inode ...) are created by kmem_cache_create in their subsystems.
+ * */
+
+#define SLAB_ALIGN              8
+#define SLAB_MIN_OBJS           8           // a slab holds at least so many objects, if order allows
+#define SLAB_MAX_ORDER          3
+
+#define KMALLOC_MIN_SHIFT       4
+#define KMALLOC_MAX_SHIFT       11
+#define KMALLOC_MIN_SIZE        (1 << KMALLOC_MIN_SHIFT)
+#define KMALLOC_MAX_SIZE        (1 << KMALLOC_MAX_SHIFT)
+#define NR_KMALLOC_CACHES       (KMALLOC_MAX_SHIFT - KMALLOC_MIN_SHIFT + 1)
+
+struct slab {
+    list_entry_t slab_link;     // the link in one of the slab lists of cache
+    struct kmem_cache *cache;   // the cache which the slab belongs to
+    void *freelist;             // the free objects, linked by their first word
+    size_t inuse;               // # of the objects in use
 };
-typedef struct slob_block slob_t;
-
-#define SLOB_UNIT sizeof(slob_t)
-#define SLOB_UNITS(size) (((size) + SLOB_UNIT - 1)/SLOB_UNIT)
-#define SLOB_ALIGN L1_CACHE_BYTES
 
-struct bigblock {
-	int order;
-	void *pages;
-	struct bigblock *next;
+struct kmem_cache {
+    const char *name;
+    size_t objsize;             // size of an object, aligned to SLAB_ALIGN
+    size_t num;                 // # of objects in a slab
+    int order;                  // a slab is 2^order pages
+    list_entry_t slabs_full;    // the slabs whose objects are all in use
+    list_entry_t slabs_partial; // the slabs which have both free objects and objects in use
+    list_entry_t slabs_free;    // the slabs whose objects are all free
+    size_t nr_active;           // # of objects in use
+    size_t nr_slabs;            // # of slabs
+    list_entry_t cache_link;    // the link in cache_chain
 };
-typedef struct bigblock bigblock_t;
 
-static slob_t arena = { .next = &arena, .units = 1 };
-static slob_t *slobfree = &arena;
-static bigblock_t *bigblocks;
+#define le2slab(le, member)                 \
+    to_struct((le), struct slab, member)
 
+#define le2cache(le, member)                \
+    to_struct((le), struct kmem_cache, member)
 
-static void* __slob_get_free_pages(gfp_t gfp, int order)
-{
-  struct Page * page = alloc_pages(1 << order);
-  if(!page)
-    return NULL;
-  return page2kva(page);
-}
+#define slab_objs(slab)                     \
+    ((void *)ROUNDUP((uintptr_t)(slab) + sizeof(struct slab), SLAB_ALIGN))
 
-#define __slob_get_free_page(gfp) __slob_get_free_pages(gfp, 0)
+// the cache of struct kmem_cache
+static struct kmem_cache cache_cache;
+static struct kmem_cache *kmalloc_caches[NR_KMALLOC_CACHES];
+static const char *kmalloc_names[NR_KMALLOC_CACHES] = {
+    "kmalloc-16", "kmalloc-32", "kmalloc-64", "kmalloc-128",
+    "kmalloc-256", "kmalloc-512", "kmalloc-1024", "kmalloc-2048",
+};
 
-static inline void __slob_free_pages(unsigned long kva, int order)
-{
-  free_pages(kva2page(kva), 1 << order);
-}
+static list_entry_t cache_chain;
+// # of pages of the big blocks of kmalloc
+static size_t kmalloc_big_pages;
 
-static void slob_free(void *b, int size);
-
-static void *slob_alloc(size_t size, gfp_t gfp, int align)
-{
-  assert( (size + SLOB_UNIT) < PAGE_SIZE );
-
-	slob_t *prev, *cur, *aligned = 0;
-	int delta = 0, units = SLOB_UNITS(size);
-	unsigned long flags;
-
-	spin_lock_irqsave(&slob_lock, flags);
-	prev = slobfree;
-	for (cur = prev->next; ; prev = cur, cur = cur->next) {
-		if (align) {
-			aligned = (slob_t *)ALIGN((unsigned long)cur, align);
-			delta = aligned - cur;
-		}
-		if (cur->units >= units + delta) { /* room enough? */
-			if (delta) { /* need to fragment head to align? */
-				aligned->units = cur->units - delta;
-				aligned->next = cur->next;
-				cur->next = aligned;
-				cur->units = delta;
-				prev = cur;
-				cur = aligned;
-			}
-
-			if (cur->units == units) /* exact fit? */
-				prev->next = cur->next; /* unlink */
-			else { /* fragment */
-				prev->next = cur + units;
-				prev->next->units = cur->units - units;
-				prev->next->next = cur->next;
-				cur->units = units;
-			}
-
-			slobfree = prev;
-			spin_unlock_irqrestore(&slob_lock, flags);
-			return cur;
-		}
-		if (cur == slobfree) {
-			spin_unlock_irqrestore(&slob_lock, flags);
-
-			if (size == PAGE_SIZE) /* trying to shrink arena? */
-				return 0;
-
-			cur = (slob_t *)__slob_get_free_page(gfp);
-			if (!cur)
-				return 0;
-
-			slob_free(cur, PAGE_SIZE);
-			spin_lock_irqsave(&slob_lock, flags);
-			cur = slobfree;
-		}
-	}
+// slab_capacity - the number of objects of objsize in a slab of 2^order pages
+static inline size_t
+slab_capacity(size_t objsize, int order) {
+    size_t head = ROUNDUP(sizeof(struct slab), SLAB_ALIGN);
+    return ((PGSIZE << order) - head) / objsize;
 }
 
-static void slob_free(void *block, int size)
-{
-	slob_t *cur, *b = (slob_t *)block;
-	unsigned long flags;
-
-	if (!block)
-		return;
-
-	if (size)
-		b->units = SLOB_UNITS(size);
-
-	/* Find reinsertion point */
-	spin_lock_irqsave(&slob_lock, flags);
-	for (cur = slobfree; !(b > cur && b < cur->next); cur = cur->next)
-		if (cur >= cur->next && (b > cur || b < cur->next))
-			break;
-
-	if (b + b->units == cur->next) {
-		b->units += cur->next->units;
-		b->next = cur->next->next;
-	} else
-		b->next = cur->next;
-
-	if (cur + cur->units == b) {
-		cur->units += b->units;
-		cur->next = b->next;
-	} else
-		cur->next = b;
-
-	slobfree = cur;
-
-	spin_unlock_irqrestore(&slob_lock, flags);
+// cache_init - setup a cache of objects of size, choose the smallest order holding SLAB_MIN_OBJS objects
+static void
+cache_init(struct kmem_cache *cachep, const char *name, size_t size) {
+    cachep->name = name;
+    cachep->objsize = ROUNDUP((size < sizeof(void *)) ? sizeof(void *) : size, SLAB_ALIGN);
+    cachep->order = 0;
+    while (cachep->order < SLAB_MAX_ORDER && slab_capacity(cachep->objsize, cachep->order) < SLAB_MIN_OBJS) {
+        cachep->order ++;
+    }
+    cachep->num = slab_capacity(cachep->objsize, cachep->order);
+    list_init(&(cachep->slabs_full));
+    list_init(&(cachep->slabs_partial));
+    list_init(&(cachep->slabs_free));
+    cachep->nr_active = cachep->nr_slabs = 0;
+    list_add(&cache_chain, &(cachep->cache_link));
 }
 
+// slab_create - alloc the pages of a new slab of cachep, and link all the objects into its freelist
+static struct slab *
+slab_create(struct kmem_cache *cachep) {
+    struct Page *page;
+    size_t i, n = (1 << cachep->order);
+    if ((page = alloc_pages(n)) == NULL) {
+        return NULL;
+    }
+    struct slab *slab = page2kva(page);
+    for (i = 0; i < n; i ++) {
+        SetPageSlab(page + i);
+        page[i].slab = slab;
+    }
+    slab->cache = cachep;
+    slab->inuse = 0;
+    slab->freelist = NULL;
+    char *obj = (char *)slab_objs(slab) + cachep->num * cachep->objsize;
+    for (i = 0; i < cachep->num; i ++) {
+        obj -= cachep->objsize;
+        *(void **)obj = slab->freelist;
+        slab->freelist = obj;
+    }
+    return slab;
+}
 
-
-void
-slob_init(void) {
-  cprintf("use SLOB allocator\n");
+// slab_destroy - give the pages of a free slab back to pmm
+static void
+slab_destroy(struct slab *slab) {
+    assert(slab->inuse == 0);
+    struct Page *page = kva2page(slab);
+    size_t i, n = (1 << slab->cache->order);
+    for (i = 0; i < n; i ++) {
+        ClearPageSlab(page + i);
+    }
+    free_pages(page, n);
 }
 
-inline void 
-kmalloc_init(void) {
-    slob_init();
-    cprintf("kmalloc_init() succeeded!\n");
+struct kmem_cache *
+kmem_cache_create(const char *name, size_t size) {
+    struct kmem_cache *cachep;
+    if (slab_capacity(ROUNDUP(size, SLAB_ALIGN), SLAB_MAX_ORDER) == 0) {
+        return NULL;
+    }
+    if ((cachep = kmem_cache_alloc(&cache_cache)) != NULL) {
+        bool intr_flag;
+        local_intr_save(intr_flag);
+        {
+            cache_init(cachep, name, size);
+        }
+        local_intr_restore(intr_flag);
+    }
+    return cachep;
 }
 
-size_t
-slob_allocated(void) {
-  return 0;
+void
+kmem_cache_destroy(struct kmem_cache *cachep) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        assert(cachep->nr_active == 0);
+        list_entry_t *le;
+        while ((le = list_next(&(cachep->slabs_free))) != &(cachep->slabs_free)) {
+            list_del(le);
+            slab_destroy(le2slab(le, slab_link));
+        }
+        list_del(&(cachep->cache_link));
+    }
+    local_intr_restore(intr_flag);
+    kmem_cache_free(&cache_cache, cachep);
 }
 
-size_t
-kallocated(void) {
-   return slob_allocated();
+void *
+kmem_cache_alloc(struct kmem_cache *cachep) {
+    struct slab *slab;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    while (1) {
+        list_entry_t *le;
+        if ((le = list_next(&(cachep->slabs_partial))) != &(cachep->slabs_partial)
+            || (le = list_next(&(cachep->slabs_free))) != &(cachep->slabs_free)) {
+            slab = le2slab(le, slab_link);
+            break;
+        }
+        // alloc_pages may swap out pages, so don't keep the interrupt disabled
+        local_intr_restore(intr_flag);
+        if ((slab = slab_create(cachep)) == NULL) {
+            return NULL;
+        }
+        local_intr_save(intr_flag);
+        list_add(&(cachep->slabs_free), &(slab->slab_link));
+        cachep->nr_slabs ++;
+    }
+
+    void *objp = slab->freelist;
+    slab->freelist = *(void **)objp;
+    slab->inuse ++, cachep->nr_active ++;
+    list_del(&(slab->slab_link));
+    if (slab->inuse == cachep->num) {
+        list_add(&(cachep->slabs_full), &(slab->slab_link));
+    }
+    else {
+        list_add(&(cachep->slabs_partial), &(slab->slab_link));
+    }
+    local_intr_restore(intr_flag);
+    return objp;
 }
 
-static int find_order(int size)
-{
-	int order = 0;
-	for ( ; size > 4096 ; size >>=1)
-		order++;
-	return order;
+void
+kmem_cache_free(struct kmem_cache *cachep, void *objp) {
+    struct Page *page = kva2page(objp);
+    assert(PageSlab(page));
+    struct slab *slab = page->slab, *release = NULL;
+    assert(slab->cache == cachep && slab->inuse > 0);
+
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        *(void **)objp = slab->freelist;
+        slab->freelist = objp;
+        slab->inuse --, cachep->nr_active --;
+        list_del(&(slab->slab_link));
+        if (slab->inuse != 0) {
+            list_add(&(cachep->slabs_partial), &(slab->slab_link));
+        }
+        else if (list_empty(&(cachep->slabs_free))) {
+            list_add(&(cachep->slabs_free), &(slab->slab_link));
+        }
+        else {
+            release = slab;
+            cachep->nr_slabs --;
+        }
+    }
+    local_intr_restore(intr_flag);
+    if (release != NULL) {
+        slab_destroy(release);
+    }
 }
 
-static void *__kmalloc(size_t size, gfp_t gfp)
-{
-	slob_t *m;
-	bigblock_t *bb;
-	unsigned long flags;
-
-	if (size < PAGE_SIZE - SLOB_UNIT) {
-		m = slob_alloc(size + SLOB_UNIT, gfp, 0);
-		return m ? (void *)(m + 1) : 0;
-	}
-
-	bb = slob_alloc(sizeof(bigblock_t), gfp, 0);
-	if (!bb)
-		return 0;
-
-	bb->order = find_order(size);
-	bb->pages = (void *)__slob_get_free_pages(gfp, bb->order);
-
-	if (bb->pages) {
-		spin_lock_irqsave(&block_lock, flags);
-		bb->next = bigblocks;
-		bigblocks = bb;
-		spin_unlock_irqrestore(&block_lock, flags);
-		return bb->pages;
-	}
-
-	slob_free(bb, sizeof(bigblock_t));
-	return 0;
+static inline int
+kmalloc_index(size_t size) {
+    int i = 0;
+    while ((KMALLOC_MIN_SIZE << i) < size) {
+        i ++;
+    }
+    return i;
 }
 
 void *
-kmalloc(size_t size)
-{
-  return __kmalloc(size, 0);
+kmalloc(size_t size) {
+    if (size <= KMALLOC_MAX_SIZE) {
+        return kmem_cache_alloc(kmalloc_caches[kmalloc_index(size)]);
+    }
+    size_t n = ROUNDUP(size, PGSIZE) / PGSIZE;
+    struct Page *page;
+    if (n > (1 << KMALLOC_MAX_ORDER) || (page = alloc_pages(n)) == NULL) {
+        return NULL;
+    }
+    page->property = n;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        kmalloc_big_pages += n;
+    }
+    local_intr_restore(intr_flag);
+    return page2kva(page);
 }
 
-
-void kfree(void *block)
-{
-	bigblock_t *bb, **last = &bigblocks;
-	unsigned long flags;
-
-	if (!block)
-		return;
-
-	if (!((unsigned long)block & (PAGE_SIZE-1))) {
-		/* might be on the big block list */
-		spin_lock_irqsave(&block_lock, flags);
-		for (bb = bigblocks; bb; last = &bb->next, bb = bb->next) {
-			if (bb->pages == block) {
-				*last = bb->next;
-				spin_unlock_irqrestore(&block_lock, flags);
-				__slob_free_pages((unsigned long)block, bb->order);
-				slob_free(bb, sizeof(bigblock_t));
-				return;
-			}
-		}
-		spin_unlock_irqrestore(&block_lock, flags);
-	}
-
-	slob_free((slob_t *)block - 1, 0);
-	return;
+void
+kfree(void *objp) {
+    if (objp == NULL) {
+        return ;
+    }
+    struct Page *page = kva2page(objp);
+    if (PageSlab(page)) {
+        kmem_cache_free(page->slab->cache, objp);
+        return ;
+    }
+    size_t n = page->property;
+    assert((uintptr_t)objp % PGSIZE == 0 && 0 < n && n <= (1 << KMALLOC_MAX_ORDER));
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        kmalloc_big_pages -= n;
+    }
+    local_intr_restore(intr_flag);
+    free_pages(page, n);
 }
 
-
-unsigned int ksize(const void *block)
-{
-	bigblock_t *bb;
-	unsigned long flags;
-
-	if (!block)
-		return 0;
-
-	if (!((unsigned long)block & (PAGE_SIZE-1))) {
-		spin_lock_irqsave(&block_lock, flags);
-		for (bb = bigblocks; bb; bb = bb->next)
-			if (bb->pages == block) {
-				spin_unlock_irqrestore(&slob_lock, flags);
-				return PAGE_SIZE << bb->order;
-			}
-		spin_unlock_irqrestore(&block_lock, flags);
-	}
-
-	return ((slob_t *)block - 1)->units * SLOB_UNIT;
+// kallocated - the bytes of all the objects in use
+size_t
+kallocated(void) {
+    size_t ret;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        ret = kmalloc_big_pages * PGSIZE;
+        list_entry_t *le = &cache_chain;
+        while ((le = list_next(le)) != &cache_chain) {
+            struct kmem_cache *cachep = le2cache(le, cache_link);
+            ret += cachep->nr_active * cachep->objsize;
+        }
+    }
+    local_intr_restore(intr_flag);
+    return ret;
 }
 
+#define CHECK_NR_OBJS           128
+
+static void *check_objs[CHECK_NR_OBJS];
+
+static void
+check_slab(void) {
+    size_t nr_free_pages_store = nr_free_pages();
+    size_t kallocated_store = kallocated();
+    struct kmem_cache *cachep;
+    int i, n;
+
+    assert((cachep = kmem_cache_create("check_slab", 100)) != NULL);
+    assert(cachep->objsize == 104 && cachep->order == 0);
+    size_t kallocated_cache = kallocated();
+
+    // fill more than 2 slabs, every object is in its own place
+    n = 2 * cachep->num + 1;
+    assert(n <= CHECK_NR_OBJS);
+    for (i = 0; i < n; i ++) {
+        assert((check_objs[i] = kmem_cache_alloc(cachep)) != NULL);
+        assert((uintptr_t)check_objs[i] % SLAB_ALIGN == 0);
+        assert(PageSlab(kva2page(check_objs[i])) && kva2page(check_objs[i])->slab->cache == cachep);
+        memset(check_objs[i], i, 100);
+    }
+    assert(cachep->nr_slabs == 3 && cachep->nr_active == n);
+    assert(kallocated() == kallocated_cache + n * cachep->objsize);
+    for (i = 0; i < n; i ++) {
+        assert(((char *)check_objs[i])[99] == (char)i);
+    }
+
+    // free in a different order, only one free slab is kept
+    for (i = 0; i < n; i += 2) {
+        kmem_cache_free(cachep, check_objs[i]);
+    }
+    for (i = 1; i < n; i += 2) {
+        kmem_cache_free(cachep, check_objs[i]);
+    }
+    assert(cachep->nr_slabs == 1 && cachep->nr_active == 0);
+    assert(kallocated() == kallocated_cache);
+    kmem_cache_destroy(cachep);
+    assert(nr_free_pages_store == nr_free_pages());
+
+    // kmalloc of all sizes, the big ones are page aligned
+    size_t sizes[] = {1, 16, 17, 100, 2048, 2049, PGSIZE, 5 * PGSIZE + 1};
+    n = sizeof(sizes) / sizeof(sizes[0]);
+    for (i = 0; i < n; i ++) {
+        assert((check_objs[i] = kmalloc(sizes[i])) != NULL);
+        memset(check_objs[i], 0x5a, sizes[i]);
+        if (sizes[i] > KMALLOC_MAX_SIZE) {
+            assert((uintptr_t)check_objs[i] % PGSIZE == 0 && !PageSlab(kva2page(check_objs[i])));
+        }
+    }
+    assert(kva2page(check_objs[n - 1])->property == 6);
+    for (i = 0; i < n; i ++) {
+        kfree(check_objs[i]);
+    }
+    assert(kallocated_store == kallocated());
+
+    cprintf("check_slab() succeeded!\n");
+}
 
+void
+kmalloc_init(void) {
+    int i;
+    list_init(&cache_chain);
+    cache_init(&cache_cache, "kmem_cache", sizeof(struct kmem_cache));
+    for (i = 0; i < NR_KMALLOC_CACHES; i ++) {
+        if ((kmalloc_caches[i] = kmem_cache_create(kmalloc_names[i], KMALLOC_MIN_SIZE << i)) == NULL) {
+            panic("kmalloc_init: create %s failed.\n", kmalloc_names[i]);
+        }
+    }
+    check_slab();
+    cprintf("kmalloc_init() succeeded!\n");
+}
 
@@ -5,11 +5,18 @@
 
 #define KMALLOC_MAX_ORDER       10
 
+struct kmem_cache;
+
 void kmalloc_init(void);
 
 void *kmalloc(size_t n);
 void kfree(void *objp);
 
+struct kmem_cache *kmem_cache_create(const char *name, size_t size);
+void kmem_cache_destroy(struct kmem_cache *cachep);
+void *kmem_cache_alloc(struct kmem_cache *cachep);
+void kmem_cache_free(struct kmem_cache *cachep, void *objp);
+
 size_t kallocated(void);
 
 #endif /* !__KERN_MM_KMALLOC_H__ */
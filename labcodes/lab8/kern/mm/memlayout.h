@@ -9,6 +9,9 @@
 #define SEG_UTEXT   3
 #define SEG_UDATA   4
 #define SEG_TSS     5
+// SEG_UTLS, the user tls segment, and its selector USER_TLS are in libs/unistd.h
+
+#define NSEGS       7                       // # of descriptors in the GDT of a cpu
 
 /* global descrptor numbers */
 #define GD_KTEXT    ((SEG_KTEXT) << 3)      // kernel text
@@ -30,14 +33,17 @@
  *                                                              kernel/user
  *
  *     4G ------------------> +---------------------------------+
- *                            |                                 |
+ *                            |  Local APIC, IO APIC (SMP only) | RW/--
+ *     MMIOBASE ------------> +---------------------------------+ 0xFEC00000
  *                            |         Empty Memory (*)        |
  *                            |                                 |
  *                            +---------------------------------+ 0xFB000000
  *                            |   Cur. Page Table (Kern, RW)    | RW/-- PTSIZE
  *     VPT -----------------> +---------------------------------+ 0xFAC00000
  *                            |        Invalid Memory (*)       | --/--
- *     KERNTOP -------------> +---------------------------------+ 0xF8000000
+ *                            +---------------------------------+
+ *                            |  Sparse memmap (struct Page[])  | RW/-- MEMMAPSIZE
+ *     VMEMMAP, KERNTOP ----> +---------------------------------+ 0xF8000000
  *                            |                                 |
  *                            |    Remapped Physical Memory     | RW/-- KMEMSIZE
  *                            |                                 |
@@ -79,6 +85,22 @@
  * */
 #define VPT                 0xFAC00000
 
+/* *
+ * The array of struct Page for all the physical memory is mapped at VMEMMAP, only the parts
+ * for the sections (PTSIZE of physical memory) which have usable memory are backed by pages.
+ * */
+#define VMEMMAP             KERNTOP
+#define MEMMAPSIZE          (KMEMSIZE / PGSIZE * sizeof(struct Page))
+
+/* *
+ * The registers of the local APIC and the IO APIC are mapped at their physical
+ * addresses, which are above MMIOBASE. They are mapped only if there are more cpus.
+ * */
+#define MMIOBASE            0xFEC00000
+
+/* The application processors start running the code copied to this physical address. */
+#define MPENTRY_PADDR       0x7000
+
 #define KSTACKPAGE          2                           // # of pages in kernel stack
 #define KSTACKSIZE          (KSTACKPAGE * PGSIZE)       // sizeof kernel stack
 
@@ -125,19 +147,33 @@ struct e820map {
  * struct Page - Page descriptor structures. Each Page describes one
  * physical page. In kern/mm/pmm.h, you can find lots of useful functions
  * that convert Page to other data types, such as phyical address.
+ * A page is either managed by the allocators (free, kmalloc, slab) or mapped as a user
+ * page, so their fields share the storage and a struct Page is 20 bytes.
  * */
 struct Page {
     int ref;                        // page frame's reference counter
     uint32_t flags;                 // array of flags that describe the status of the page frame
-    unsigned int property;          // the num of free block, used in first fit pm manager
-    list_entry_t page_link;         // free list link
-    list_entry_t pra_page_link;     // used for pra (page replace algorithm)
-    uintptr_t pra_vaddr;            // used for pra (page replace algorithm)
+    union {
+        // a free block of pmm_manager, or a block allocated by the kernel
+        struct {
+            list_entry_t page_link;         // free list link
+            unsigned int property;          // the num of free block, used in first fit pm manager
+        };
+        // a user page in the swap manager, if PG_swappable is set
+        struct {
+            list_entry_t pra_page_link;     // used for pra (page replace algorithm)
+            uintptr_t pra_vaddr;            // used for pra (page replace algorithm)
+        };
+        struct slab *slab;                  // the slab which the page belongs to, if PG_slab is set
+    };
 };
 
 /* Flags describing the status of a page frame */
 #define PG_reserved                 0       // if this bit=1: the Page is reserved for kernel, cannot be used in alloc/free_pages; otherwise, this bit=0 
 #define PG_property                 1       // if this bit=1: the Page is the head page of a free memory block(contains some continuous_addrress pages), and can be used in alloc_pages; if this bit=0: if the Page is the the head page of a free memory block, then this Page and the memory block is alloced. Or this Page isn't the head page.
+#define PG_shmem                    2       // if this bit=1: the Page belongs to a shared memory segment, it may be mapped in many mm_structs
+#define PG_slab                     3       // if this bit=1: the Page is a part of a slab of kmalloc
+#define PG_swappable                4       // if this bit=1: the Page is linked in the swap manager of an mm by pra_page_link
 
 #define SetPageReserved(page)       set_bit(PG_reserved, &((page)->flags))
 #define ClearPageReserved(page)     clear_bit(PG_reserved, &((page)->flags))
@@ -145,6 +181,15 @@ struct Page {
 #define SetPageProperty(page)       set_bit(PG_property, &((page)->flags))
 #define ClearPageProperty(page)     clear_bit(PG_property, &((page)->flags))
 #define PageProperty(page)          test_bit(PG_property, &((page)->flags))
+#define SetPageShmem(page)          set_bit(PG_shmem, &((page)->flags))
+#define ClearPageShmem(page)        clear_bit(PG_shmem, &((page)->flags))
+#define PageShmem(page)             test_bit(PG_shmem, &((page)->flags))
+#define SetPageSlab(page)           set_bit(PG_slab, &((page)->flags))
+#define ClearPageSlab(page)         clear_bit(PG_slab, &((page)->flags))
+#define PageSlab(page)              test_bit(PG_slab, &((page)->flags))
+#define SetPageSwappable(page)      set_bit(PG_swappable, &((page)->flags))
+#define ClearPageSwappable(page)    clear_bit(PG_swappable, &((page)->flags))
+#define PageSwappable(page)         test_bit(PG_swappable, &((page)->flags))
 
 // convert list entry to page
 #define le2page(le, member)                 \
@@ -219,6 +219,9 @@ struct taskstate {
 #define PTE_ADDR(pte)   ((uintptr_t)(pte) & ~0xFFF)
 #define PDE_ADDR(pde)   PTE_ADDR(pde)
 
+// address in a page directory entry which maps a 4M large page (PTE_PS)
+#define PDE_LADDR(pde)  ((uintptr_t)(pde) & ~(PTSIZE - 1))
+
 /* page directory and page table constants */
 #define NPDEENTRY       1024                    // page directory entries per page directory
 #define NPTEENTRY       1024                    // page table entries per page table
@@ -240,6 +243,7 @@ struct taskstate {
 #define PTE_A           0x020                   // Accessed
 #define PTE_D           0x040                   // Dirty
 #define PTE_PS          0x080                   // Page Size
+#define PTE_G           0x100                   // Global, kept in TLB when CR3 is reloaded (CR4.PGE)
 #define PTE_MBZ         0x180                   // Bits must be zero
 #define PTE_AVAIL       0xE00                   // Available for software use
                                                 // The PTE_AVAIL bits aren't used by the kernel or interpreted by the
@@ -261,6 +265,7 @@ struct taskstate {
 #define CR0_PG          0x80000000              // Paging
 
 #define CR4_PCE         0x00000100              // Performance counter enable
+#define CR4_PGE         0x00000080              // Page Global Enable
 #define CR4_MCE         0x00000040              // Machine Check Enable
 #define CR4_PSE         0x00000010              // Page Size Extensions
 #define CR4_DE          0x00000008              // Debugging Extensions
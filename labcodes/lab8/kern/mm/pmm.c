@@ -6,11 +6,17 @@
 #include <memlayout.h>
 #include <pmm.h>
 #include <default_pmm.h>
+#include <buddy_pmm.h>
 #include <sync.h>
 #include <error.h>
 #include <swap.h>
 #include <vmm.h>
 #include <kmalloc.h>
+#include <unistd.h>
+#include <trap.h>
+#include <proc.h>
+#include <lapic.h>
+#include <mp.h>
 
 /* *
  * Task State Segment:
@@ -31,8 +37,9 @@
  * contains the new ESP value for CPL = 0. When an interrupt happens in protected
  * mode, the x86 CPU will look in the TSS for SS0 and ESP0 and load their value
  * into SS and ESP respectively.
+ *
+ * Every cpu has its own TSS (struct cpu), as it runs on its own kernel stack.
  * */
-static struct taskstate ts = {0};
 
 // virtual address of physicall page array
 struct Page *pages;
@@ -48,6 +55,18 @@ uintptr_t boot_cr3;
 // physical memory management
 const struct pmm_manager *pmm_manager;
 
+// the shared zero page, mapped read-only for the untouched anonymous memory,
+// it holds a permanent reference so it is never freed
+struct Page *zero_page;
+
+// 4M large pages (CR4.PSE) are usable
+bool pse_enabled = 0;
+// the system calls may enter with SYSENTER, see __sysenter in trapentry.S
+bool sysenter_enabled = 0;
+// PTE_G if the cpu supports global pages, the kernel mappings are the same in every PDT,
+// so they are global and survive the TLB flush of a CR3 reload
+static uint32_t pte_global = 0;
+
 /* *
  * The page directory entry corresponding to the virtual address range
  * [VPT, VPT + PTSIZE) points to the page directory itself. Thus, the page
@@ -76,23 +95,30 @@ pde_t * const vpd = (pde_t *)PGADDR(PDX(VPT), PDX(VPT), 0);
  *   - 0x18:  user code segment
  *   - 0x20:  user data segment
  *   - 0x28:  defined for tss, initialized in gdt_init
+ *   - 0x30:  user tls segment, its base is reloaded by load_tls on process switch
+ *
+ * Every cpu has its own copy of the GDT (struct cpu), since the TSS and the user
+ * tls segment differ between cpus.
  * */
-static struct segdesc gdt[] = {
+static const struct segdesc gdt[NSEGS] = {
     SEG_NULL,
     [SEG_KTEXT] = SEG(STA_X | STA_R, 0x0, 0xFFFFFFFF, DPL_KERNEL),
     [SEG_KDATA] = SEG(STA_W, 0x0, 0xFFFFFFFF, DPL_KERNEL),
     [SEG_UTEXT] = SEG(STA_X | STA_R, 0x0, 0xFFFFFFFF, DPL_USER),
     [SEG_UDATA] = SEG(STA_W, 0x0, 0xFFFFFFFF, DPL_USER),
     [SEG_TSS]   = SEG_NULL,
+    [SEG_UTLS]  = SEG(STA_W, 0x0, 0xFFFFFFFF, DPL_USER),
 };
 
-static struct pseudodesc gdt_pd = {
-    sizeof(gdt) - 1, (uintptr_t)gdt
-};
-
+static void zero_page_init(void);
+static void pse_init(void);
+static void pge_init(void);
+static void sysenter_init(void);
 static void check_alloc_page(void);
 static void check_pgdir(void);
 static void check_boot_pgdir(void);
+static void check_large_page(void);
+static void check_zero_pool(void);
 
 /* *
  * lgdt - load the global descriptor table register and reset the
@@ -117,30 +143,58 @@ lgdt(struct pseudodesc *pd) {
  * */
 void
 load_esp0(uintptr_t esp0) {
-    ts.ts_esp0 = esp0;
+    mycpu()->ts.ts_esp0 = esp0;
 }
 
-/* gdt_init - initialize the default GDT and TSS */
-static void
-gdt_init(void) {
-    // set boot kernel stack and default SS0
-    load_esp0((uintptr_t)bootstacktop);
-    ts.ts_ss0 = KERNEL_DS;
+/* *
+ * load_tls - change the base of the user tls segment, so the user thread
+ * which loads USER_TLS into %gs finds its thread local storage at %gs:0.
+ * The new base takes effect when %gs is reloaded on the return to user mode.
+ * */
+void
+load_tls(uintptr_t base) {
+    mycpu()->gdt[SEG_UTLS] = SEG(STA_W, base, 0xFFFFFFFF, DPL_USER);
+}
+
+/* gdt_init_cpu - initialize the GDT and TSS of cpu with kernel stack esp0, and load them */
+void
+gdt_init_cpu(struct cpu *cpu, uintptr_t esp0) {
+    memcpy(cpu->gdt, gdt, sizeof(gdt));
+
+    // set kernel stack and default SS0
+    cpu->ts.ts_esp0 = esp0;
+    cpu->ts.ts_ss0 = KERNEL_DS;
 
     // initialize the TSS filed of the gdt
-    gdt[SEG_TSS] = SEGTSS(STS_T32A, (uintptr_t)&ts, sizeof(ts), DPL_KERNEL);
+    cpu->gdt[SEG_TSS] = SEGTSS(STS_T32A, (uintptr_t)&(cpu->ts), sizeof(cpu->ts), DPL_KERNEL);
 
-    // reload all segment registers
-    lgdt(&gdt_pd);
+    // reload all segment registers, mycpu works from now on
+    cpu->gdt_pd.pd_lim = sizeof(cpu->gdt) - 1;
+    cpu->gdt_pd.pd_base = (uintptr_t)cpu->gdt;
+    lgdt(&(cpu->gdt_pd));
 
     // load the TSS
     ltr(GD_TSS);
+
+    // SYSENTER finds the kernel stack in ts_esp0, which load_esp0 changes for every process
+    if (sysenter_enabled) {
+        extern char __sysenter[];
+        wrmsr(MSR_SYSENTER_CS, KERNEL_CS);
+        wrmsr(MSR_SYSENTER_ESP, (uintptr_t)&(cpu->ts.ts_esp0));
+        wrmsr(MSR_SYSENTER_EIP, (uintptr_t)__sysenter);
+    }
+}
+
+/* gdt_init - initialize the GDT and TSS of the boot cpu */
+static void
+gdt_init(void) {
+    gdt_init_cpu(cpus, (uintptr_t)bootstacktop);
 }
 
 //init_pmm_manager - initialize a pmm_manager instance
 static void
 init_pmm_manager(void) {
-    pmm_manager = &default_pmm_manager;
+    pmm_manager = &buddy_pmm_manager;
     cprintf("memory management: %s\n", pmm_manager->name);
     pmm_manager->init();
 }
@@ -151,25 +205,133 @@ init_memmap(struct Page *base, size_t n) {
     pmm_manager->init_memmap(base, n);
 }
 
+/* *
+ * The pool of zero-filled pages. cpu_idle fills it when there is nothing to run, so the
+ * allocations which need clean memory (PTs, PDTs, anonymous pages) skip the memset.
+ * The pages in the pool are still counted as free, alloc_pages drains the pool before
+ * it reclaims, and cpu_idle stops filling it when the free memory is short.
+ * */
+#define ZERO_POOL_MAX               64
+
+static list_entry_t zero_pool;
+static size_t nr_zero_pool;
+
+// zero_pool_drain - give all the pages in the zeroed page pool back to pmm_manager
+// return value: the number of pages given back
+static size_t
+zero_pool_drain(void) {
+    size_t n;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        list_entry_t *le;
+        while ((le = list_next(&zero_pool)) != &zero_pool) {
+            list_del(le);
+            pmm_manager->free_pages(le2page(le, page_link), 1);
+        }
+        n = nr_zero_pool, nr_zero_pool = 0;
+    }
+    local_intr_restore(intr_flag);
+    return n;
+}
+
+// zero_pool_fill - clear one free page into the zeroed page pool, called by cpu_idle
+// return value: 1 if a page is added, 0 if the pool is full or the free memory is short
+bool
+zero_pool_fill(void) {
+    struct Page *page = NULL;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        if (nr_zero_pool < ZERO_POOL_MAX && pmm_manager->nr_free_pages() > watermark_high) {
+            page = pmm_manager->alloc_pages(1);
+        }
+    }
+    local_intr_restore(intr_flag);
+    if (page == NULL) {
+        return 0;
+    }
+    // clear the page with interrupts on, the page belongs to nobody yet
+    memset(page2kva(page), 0, PGSIZE);
+    local_intr_save(intr_flag);
+    {
+        list_add(&zero_pool, &(page->page_link));
+        nr_zero_pool ++;
+    }
+    local_intr_restore(intr_flag);
+    return 1;
+}
+
+//alloc_zeroed_page - alloc a zero-filled page, take it from the zeroed page pool if possible
+struct Page *
+alloc_zeroed_page(void) {
+    struct Page *page = NULL;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        list_entry_t *le;
+        if ((le = list_next(&zero_pool)) != &zero_pool) {
+            list_del(le);
+            nr_zero_pool --;
+            page = le2page(le, page_link);
+        }
+    }
+    local_intr_restore(intr_flag);
+    if (page == NULL && (page = alloc_page()) != NULL) {
+        memset(page2kva(page), 0, PGSIZE);
+    }
+    return page;
+}
+
+/* *
+ * The watermarks of the free pages, they are set by swap_init once the swap disk is ready.
+ *   - below watermark_low, the allocating process itself calls swap_reclaim to swap out pages
+ *     until watermark_high; there is no background reclaim
+ *   - the last watermark_reserve pages are kept for the single page requests, which any
+ *     caller may take down to the last free page: the page faults, the PTs, the one-page
+ *     slabs, and the swap out path itself. A multi-page request (kernel stacks, bigger slabs,
+ *     large kmalloc blocks) never takes them
+ * */
+size_t watermark_reserve, watermark_low, watermark_high;
+
+// the max number of the reclaim rounds for one request, a multi-page request may need many
+// rounds since the reclaimed pages are scattered
+#define MAX_RECLAIM_RETRY           8
+
 //alloc_pages - call pmm->alloc_pages to allocate a continuous n*PAGESIZE memory 
+//            - if the free memory is short, reclaim pages from the mm_structs of all processes,
+//            - return NULL if nothing can be reclaimed, then the callers give -E_NO_MEM
 struct Page *
 alloc_pages(size_t n) {
     struct Page *page=NULL;
     bool intr_flag;
+    int retry = 0;
     
     while (1)
     {
-         local_intr_save(intr_flag);
-         {
-              page = pmm_manager->alloc_pages(n);
+         size_t nr_free = nr_free_pages();
+         if (n == 1 || nr_free >= watermark_reserve + n) {
+              local_intr_save(intr_flag);
+              {
+                   page = pmm_manager->alloc_pages(n);
+              }
+              local_intr_restore(intr_flag);
+              // the pages in the zeroed page pool are free memory too
+              if (page == NULL && zero_pool_drain() != 0) {
+                   continue;
+              }
          }
-         local_intr_restore(intr_flag);
-
-         if (page != NULL || n > 1 || swap_init_ok == 0) break;
-         
-         extern struct mm_struct *check_mm_struct;
-         //cprintf("page %x, call swap_out in alloc_pages %d\n",page, n);
-         swap_out(check_mm_struct, n, 0);
+         if (!swap_init_ok) break;
+
+         if (page != NULL) {
+              // reclaim now, before the free memory runs out
+              if (nr_free - n < watermark_low) {
+                   swap_reclaim(watermark_high - (nr_free - n));
+              }
+              break;
+         }
+         size_t want = (nr_free < watermark_high + n) ? watermark_high + n - nr_free : n;
+         if (++ retry > MAX_RECLAIM_RETRY || swap_reclaim(want) == 0) break;
     }
     //cprintf("n %d,get page %x, No %d in alloc_pages\n",n,page,(page-pages));
     return page;
@@ -194,12 +356,87 @@ nr_free_pages(void) {
     bool intr_flag;
     local_intr_save(intr_flag);
     {
-        ret = pmm_manager->nr_free_pages();
+        ret = pmm_manager->nr_free_pages() + nr_zero_pool;
     }
     local_intr_restore(intr_flag);
     return ret;
 }
 
+/* *
+ * The memmap is sparse: pages[] is mapped at VMEMMAP, and a section (PTSIZE of physical memory)
+ * gets the pages for its descriptors only if the e820 map has usable memory in it. pages[ppn]
+ * is still the descriptor of ppn, so the holes cost no memory and page2ppn stays a subtraction.
+ * A buddy block never crosses a section, the pmm_managers never touch a missing descriptor.
+ * */
+#define PAGES_PER_SECTION           (PTSIZE / PGSIZE)
+#define NR_SECTIONS                 (KMEMSIZE / PTSIZE)
+
+static bool section_present[NR_SECTIONS];
+
+// boot_take_page - take the physical page at *freemem, before pmm_manager works
+static uintptr_t
+boot_take_page(uintptr_t *freemem) {
+    uintptr_t pa = *freemem;
+    *freemem += PGSIZE;
+    return pa;
+}
+
+// memmap_init - map the descriptors of the present sections at VMEMMAP, mark them reserved
+static void
+memmap_init(uintptr_t *freemem) {
+    static_assert(VMEMMAP + MEMMAPSIZE <= VPT);
+    size_t s, nr_present = 0, nr_memmap = 0;
+    uintptr_t va, start, end;
+
+    // the PTs first, they are written through KADDR, so they must be in the first 4M mapped
+    // by entry.S, the descriptor pages after them are written through VMEMMAP
+    for (s = 0; s < NR_SECTIONS; s ++) {
+        if (!section_present[s]) {
+            continue;
+        }
+        start = (uintptr_t)(pages + s * PAGES_PER_SECTION);
+        end = (uintptr_t)(pages + (s + 1) * PAGES_PER_SECTION);
+        for (va = ROUNDDOWN(start, PTSIZE); va < end; va += PTSIZE) {
+            pde_t *pdep = &boot_pgdir[PDX(va)];
+            if (!(*pdep & PTE_P)) {
+                uintptr_t pa = boot_take_page(freemem);
+                assert(*freemem <= PTSIZE);
+                memset(KADDR(pa), 0, PGSIZE);
+                *pdep = pa | PTE_P | PTE_W;
+            }
+        }
+        nr_present ++;
+    }
+    for (s = 0; s < NR_SECTIONS; s ++) {
+        if (!section_present[s]) {
+            continue;
+        }
+        start = (uintptr_t)(pages + s * PAGES_PER_SECTION);
+        end = (uintptr_t)(pages + (s + 1) * PAGES_PER_SECTION);
+        for (va = ROUNDDOWN(start, PGSIZE); va < end; va += PGSIZE) {
+            pte_t *ptep = (pte_t *)KADDR(PDE_ADDR(boot_pgdir[PDX(va)])) + PTX(va);
+            if (!(*ptep & PTE_P)) {
+                *ptep = boot_take_page(freemem) | PTE_P | PTE_W | pte_global;
+                nr_memmap ++;
+            }
+        }
+    }
+    lcr3(boot_cr3);
+
+    for (s = 0; s < NR_SECTIONS; s ++) {
+        if (section_present[s]) {
+            struct Page *base = pages + s * PAGES_PER_SECTION, *p;
+            memset(base, 0, sizeof(struct Page) * PAGES_PER_SECTION);
+            for (p = base; p < base + PAGES_PER_SECTION; p ++) {
+                SetPageReserved(p);
+            }
+        }
+    }
+    cprintf("memmap: %d of %d sections present, %d KB for %d byte struct Page.\n",
+            nr_present, ROUNDUP(npage, PAGES_PER_SECTION) / PAGES_PER_SECTION,
+            nr_memmap * PGSIZE / 1024, sizeof(struct Page));
+}
+
 /* pmm_init - initialize the physical memory management */
 static void
 page_init(void) {
@@ -225,17 +462,31 @@ page_init(void) {
     extern char end[];
 
     npage = maxpa / PGSIZE;
-    pages = (struct Page *)ROUNDUP((void *)end, PGSIZE);
+    pages = (struct Page *)VMEMMAP;
 
-    for (i = 0; i < npage; i ++) {
-        SetPageReserved(pages + i);
+    for (i = 0; i < memmap->nr_map; i ++) {
+        uint64_t begin = memmap->map[i].addr, end = begin + memmap->map[i].size;
+        if (memmap->map[i].type == E820_ARM && begin < maxpa) {
+            if (end > maxpa) {
+                end = maxpa;
+            }
+            size_t s;
+            for (s = begin / PTSIZE; s < (end + PTSIZE - 1) / PTSIZE; s ++) {
+                section_present[s] = 1;
+            }
+        }
     }
 
-    uintptr_t freemem = PADDR((uintptr_t)pages + sizeof(struct Page) * npage);
+    uintptr_t kernmem = PADDR(ROUNDUP((uintptr_t)end, PGSIZE)), freemem = kernmem;
+    memmap_init(&freemem);
 
     for (i = 0; i < memmap->nr_map; i ++) {
         uint64_t begin = memmap->map[i].addr, end = begin + memmap->map[i].size;
         if (memmap->map[i].type == E820_ARM) {
+            // the memmap pages are taken from the usable range right after the kernel
+            if (begin <= kernmem && kernmem < end && end < freemem) {
+                panic("no memory for the memmap.\n");
+            }
             if (begin < freemem) {
                 begin = freemem;
             }
@@ -265,13 +516,31 @@ boot_map_segment(pde_t *pgdir, uintptr_t la, size_t size, uintptr_t pa, uint32_t
     size_t n = ROUNDUP(size + PGOFF(la), PGSIZE) / PGSIZE;
     la = ROUNDDOWN(la, PGSIZE);
     pa = ROUNDDOWN(pa, PGSIZE);
-    for (; n > 0; n --, la += PGSIZE, pa += PGSIZE) {
+    perm |= pte_global;
+    while (n > 0) {
+        // use a 4M large page when la, pa and the rest size are all PTSIZE aligned
+        if (pse_enabled && la % PTSIZE == 0 && pa % PTSIZE == 0 && n >= NPTEENTRY) {
+            pgdir[PDX(la)] = pa | PTE_P | PTE_PS | perm;
+            n -= NPTEENTRY, la += PTSIZE, pa += PTSIZE;
+            continue;
+        }
         pte_t *ptep = get_pte(pgdir, la, 1);
         assert(ptep != NULL);
         *ptep = pa | PTE_P | perm;
+        n --, la += PGSIZE, pa += PGSIZE;
     }
 }
 
+//mmio_map - map the device registers at physical address pa ~ pa + size to the same linear address,
+//         - uncached, in boot_pgdir. It must be done before the first process is created, whose PDT
+//         - copies the kernel part of boot_pgdir
+void *
+mmio_map(uintptr_t pa, size_t size) {
+    assert(pa >= MMIOBASE);
+    boot_map_segment(boot_pgdir, pa, size, pa, PTE_W | PTE_PCD | PTE_PWT);
+    return (void *)pa;
+}
+
 //boot_alloc_page - allocate one page using pmm->alloc_pages(1) 
 // return value: the kernel virtual address of this allocated page
 //note: this function is used to get the memory for PDT(Page Directory Table)&PT(Page Table)
@@ -291,6 +560,11 @@ pmm_init(void) {
     // We've already enabled paging
     boot_cr3 = PADDR(boot_pgdir);
 
+    // enable global pages before the kernel mappings are built
+    pge_init();
+    // before gdt_init, which sets up SYSENTER
+    sysenter_init();
+
     //We need to alloc/free the physical memory (granularity is 4KB or other size). 
     //So a framework of physical memory manager (struct pmm_manager)is defined in pmm.h
     //First we should init a physical memory manager(pmm) based on the framework.
@@ -298,6 +572,9 @@ pmm_init(void) {
     //Now the first_fit/best_fit/worst_fit/buddy_system pmm are available.
     init_pmm_manager();
 
+    // the zeroed page pool stays empty until cpu_idle fills it
+    list_init(&zero_pool);
+
     // detect physical memory space, reserve already used memory,
     // then use pmm->init_memmap to create free page list
     page_init();
@@ -309,6 +586,9 @@ pmm_init(void) {
 
     static_assert(KERNBASE % PTSIZE == 0 && KERNTOP % PTSIZE == 0);
 
+    // enable 4M large pages if the cpu supports PSE
+    pse_init();
+
     // recursively insert boot_pgdir in itself
     // to form a virtual page table at virtual address VPT
     boot_pgdir[PDX(VPT)] = PADDR(boot_pgdir) | PTE_P | PTE_W;
@@ -317,6 +597,9 @@ pmm_init(void) {
     // linear_addr KERNBASE ~ KERNBASE + KMEMSIZE = phy_addr 0 ~ KMEMSIZE
     boot_map_segment(boot_pgdir, KERNBASE, KMEMSIZE, 0, PTE_W);
 
+    // the pde of KERNBASE ~ KERNBASE + 4M may be replaced by a large page, flush tlb
+    lcr3(boot_cr3);
+
     // Since we are using bootloader's GDT,
     // we should reload gdt (second time, the last time) to get user segments and the TSS
     // map virtual_addr 0 ~ 4G = linear_addr 0 ~ 4G
@@ -331,10 +614,127 @@ pmm_init(void) {
     
     kmalloc_init();
 
+    zero_page_init();
+
+    check_zero_pool();
+}
+
+//zero_page_init - alloc & clear the shared zero page
+static void
+zero_page_init(void) {
+    if ((zero_page = alloc_page()) == NULL) {
+        panic("zero_page_init failed.\n");
+    }
+    memset(page2kva(zero_page), 0, PGSIZE);
+    set_page_ref(zero_page, 1);
+}
+
+//pse_init - check the PSE feature of cpu, and turn on CR4.PSE if available
+static void
+pse_init(void) {
+    uint32_t edx;
+    cpuid(1, NULL, NULL, NULL, &edx);
+    if (edx & CPUID_FEAT_PSE) {
+        lcr4(rcr4() | CR4_PSE);
+        pse_enabled = 1;
+    }
+    cprintf("pse: 4M large pages %s.\n", pse_enabled ? "enabled" : "not supported");
+}
+
+//pge_init - check the PGE feature of cpu, and turn on CR4.PGE if available
+static void
+pge_init(void) {
+    uint32_t edx;
+    cpuid(1, NULL, NULL, NULL, &edx);
+    if (edx & CPUID_FEAT_PGE) {
+        lcr4(rcr4() | CR4_PGE);
+        pte_global = PTE_G;
+    }
+    cprintf("pge: global kernel pages %s.\n", pte_global ? "enabled" : "not supported");
+}
+
+//sysenter_init - check the SEP feature of cpu, gdt_init_cpu sets up SYSENTER if available
+static void
+sysenter_init(void) {
+    uint32_t edx;
+    cpuid(1, NULL, NULL, NULL, &edx);
+    if (edx & CPUID_FEAT_SEP) {
+        sysenter_enabled = 1;
+    }
+    cprintf("sysenter: fast system calls %s.\n", sysenter_enabled ? "enabled" : "not supported");
+}
+
+//alloc_large_page - alloc NPTEENTRY continuous pages whose physical address is PTSIZE aligned,
+//                 - which can be mapped by a single 4M pde
+// return value: the first page of the large page, the ref of other pages is not used
+struct Page *
+alloc_large_page(void) {
+    struct Page *page, *base;
+    // the blocks of buddy_pmm_manager are aligned to their size
+    if ((page = alloc_pages(NPTEENTRY)) == NULL || page2pa(page) % PTSIZE == 0) {
+        return page;
+    }
+    free_pages(page, NPTEENTRY);
+    // alloc twice the size (minus one page), then give back the unaligned head and tail
+    size_t n = 2 * NPTEENTRY - 1;
+    if ((page = alloc_pages(n)) == NULL) {
+        return NULL;
+    }
+    base = pa2page(ROUNDUP(page2pa(page), PTSIZE));
+    size_t head = base - page, tail = n - head - NPTEENTRY;
+    if (head != 0) {
+        free_pages(page, head);
+    }
+    if (tail != 0) {
+        free_pages(base + NPTEENTRY, tail);
+    }
+    return base;
+}
+
+//free_large_page - free a large page got from alloc_large_page
+void
+free_large_page(struct Page *base) {
+    assert(page2pa(base) % PTSIZE == 0);
+    free_pages(base, NPTEENTRY);
+}
+
+//split_large_pde - replace the 4M large page pde of la by a PT with 1024 ptes which map the same memory
+//                - for a user large page, every 4K page gets the ref of the large page
+// return value: 0 - success, -E_NO_MEM - no memory for PT
+static int
+split_large_pde(pde_t *pgdir, uintptr_t la) {
+    pde_t *pdep = &pgdir[PDX(la)];
+    assert(*pdep & PTE_PS);
+    struct Page *pt;
+    if ((pt = alloc_page()) == NULL) {
+        return -E_NO_MEM;
+    }
+    set_page_ref(pt, 1);
+    uintptr_t pa = PDE_LADDR(*pdep);
+    // keep the flags of the large page (global, cache control, accessed/dirty, ...), except
+    // PTE_PS, which is the PAT bit in a pte
+    uint32_t perm = (*pdep & 0xFFF & ~PTE_PS);
+    pte_t *ptep = page2kva(pt);
+    int i;
+    for (i = 0; i < NPTEENTRY; i ++) {
+        ptep[i] = (pa + i * PGSIZE) | perm;
+    }
+    if (perm & PTE_U) {
+        struct Page *base = pa2page(pa);
+        int ref = page_ref(base);
+        for (i = 1; i < NPTEENTRY; i ++) {
+            set_page_ref(base + i, ref);
+        }
+    }
+    *pdep = page2pa(pt) | PTE_U | PTE_W | PTE_P;
+    tlb_invalidate(pgdir, la);
+    return 0;
 }
 
 //get_pte - get pte and return the kernel virtual address of this pte for la
 //        - if the PT contians this pte didn't exist, alloc a page for PT
+//        - if la is mapped by a 4M large page (PTE_PS), the pde itself is returned when create is 0;
+//        - otherwise the large page is split into 4K pages first
 // parameter:
 //  pgdir:  the kernel virtual base address of PDT
 //  la:     the linear address need to map
@@ -375,6 +775,25 @@ get_pte(pde_t *pgdir, uintptr_t la, bool create) {
     }
     return NULL;          // (8) return page table entry
 #endif
+    pde_t *pdep = &pgdir[PDX(la)];
+    if (*pdep & PTE_PS) {
+        if (!create) {
+            return (pte_t *)pdep;
+        }
+        if (split_large_pde(pgdir, la) != 0) {
+            return NULL;
+        }
+    }
+    if (!(*pdep & PTE_P)) {
+        struct Page *page;
+        if (!create || (page = alloc_zeroed_page()) == NULL) {
+            return NULL;
+        }
+        set_page_ref(page, 1);
+        uintptr_t pa = page2pa(page);
+        *pdep = pa | PTE_U | PTE_W | PTE_P;
+    }
+    return &((pte_t *)KADDR(PDE_ADDR(*pdep)))[PTX(la)];
 }
 
 //get_page - get related Page struct for linear address la using PDT pgdir
@@ -385,6 +804,9 @@ get_page(pde_t *pgdir, uintptr_t la, pte_t **ptep_store) {
         *ptep_store = ptep;
     }
     if (ptep != NULL && *ptep & PTE_P) {
+        if (*ptep & PTE_PS) {
+            return pa2page(PDE_LADDR(*ptep) + PTX(la) * PGSIZE);
+        }
         return pte2page(*ptep);
     }
     return NULL;
@@ -392,6 +814,7 @@ get_page(pde_t *pgdir, uintptr_t la, pte_t **ptep_store) {
 
 //page_remove_pte - free an Page sturct which is related linear address la
 //                - and clean(invalidate) pte which is related linear address la
+//                - if ptep is a 4M large page pde, the whole large page is removed
 //note: PT is changed, so the TLB need to be invalidate 
 static inline void
 page_remove_pte(pde_t *pgdir, uintptr_t la, pte_t *ptep) {
@@ -420,6 +843,28 @@ page_remove_pte(pde_t *pgdir, uintptr_t la, pte_t *ptep) {
                                   //(6) flush tlb
     }
 #endif
+    if (*ptep & PTE_P) {
+        if (*ptep & PTE_PS) {
+            struct Page *base = pa2page(PDE_LADDR(*ptep));
+            if (page_ref_dec(base) == 0) {
+                free_large_page(base);
+            }
+        }
+        else {
+            struct Page *page = pte2page(*ptep);
+            if (page_ref_dec(page) == 0) {
+                swap_remove_page(page);
+                free_page(page);
+            }
+        }
+        *ptep = 0;
+        tlb_invalidate(pgdir, la);
+    }
+    else if (*ptep != 0) {
+        // a swap entry, the content of the page is on the swap disk
+        swap_free(*ptep);
+        *ptep = 0;
+    }
 }
 
 void
@@ -433,6 +878,18 @@ unmap_range(pde_t *pgdir, uintptr_t start, uintptr_t end) {
             start = ROUNDDOWN(start + PTSIZE, PTSIZE);
             continue ;
         }
+        if (*ptep & PTE_PS) {
+            // the whole large page is in range: remove it at once, or split it to remove a part
+            if (start % PTSIZE == 0 && end - start >= PTSIZE) {
+                page_remove_pte(pgdir, start, ptep);
+                start += PTSIZE;
+                continue ;
+            }
+            if (split_large_pde(pgdir, start) != 0) {
+                panic("unmap_range: no memory to split large page.\n");
+            }
+            ptep = get_pte(pgdir, start, 0);
+        }
         if (*ptep != 0) {
             page_remove_pte(pgdir, start, ptep);
         }
@@ -448,7 +905,7 @@ exit_range(pde_t *pgdir, uintptr_t start, uintptr_t end) {
     start = ROUNDDOWN(start, PTSIZE);
     do {
         int pde_idx = PDX(start);
-        if (pgdir[pde_idx] & PTE_P) {
+        if ((pgdir[pde_idx] & PTE_P) && !(pgdir[pde_idx] & PTE_PS)) {
             free_page(pde2page(pgdir[pde_idx]));
             pgdir[pde_idx] = 0;
         }
@@ -474,6 +931,25 @@ copy_range(pde_t *to, pde_t *from, uintptr_t start, uintptr_t end, bool share) {
             start = ROUNDDOWN(start + PTSIZE, PTSIZE);
             continue ;
         }
+        // a large page of process A is copied to a new large page of process B
+        if (*ptep & PTE_PS) {
+            struct Page *page = pa2page(PDE_LADDR(*ptep)), *npage;
+            if ((npage = alloc_large_page()) == NULL) {
+                return -E_NO_MEM;
+            }
+            memcpy(page2kva(npage), page2kva(page), PTSIZE);
+            set_page_ref(npage, 1);
+            to[PDX(start)] = page2pa(npage) | (*ptep & (PTE_USER | PTE_PS));
+            start = ROUNDDOWN(start + PTSIZE, PTSIZE);
+            continue ;
+        }
+        // a swapped out page of process A, process B shares the swap entry
+        if (!(*ptep & PTE_P) && *ptep != 0) {
+            if ((nptep = get_pte(to, start, 1)) == NULL || swap_duplicate(*ptep) != 0) {
+                return -E_NO_MEM;
+            }
+            *nptep = *ptep;
+        }
         //call get_pte to find process B's pte according to the addr start. If pte is NULL, just alloc a PT
         if (*ptep & PTE_P) {
             if ((nptep = get_pte(to, start, 1)) == NULL) {
@@ -482,11 +958,21 @@ copy_range(pde_t *to, pde_t *from, uintptr_t start, uintptr_t end, bool share) {
         uint32_t perm = (*ptep & PTE_USER);
         //get page from ptep
         struct Page *page = pte2page(*ptep);
-        // alloc a page for process B
-        struct Page *npage=alloc_page();
         assert(page!=NULL);
-        assert(npage!=NULL);
         int ret=0;
+        // the shared zero page is mapped read-only in both processes, not copied
+        if (page == zero_page) {
+            if ((ret = page_insert(to, page, start, perm & ~PTE_W)) != 0) {
+                return ret;
+            }
+            start += PGSIZE;
+            continue ;
+        }
+        // alloc a page for process B
+        struct Page *npage=alloc_page();
+        if (npage == NULL) {
+            return -E_NO_MEM;
+        }
         /* LAB5:EXERCISE2 YOUR CODE
          * replicate content of page to npage, build the map of phy addr of nage with the linear addr start
          *
@@ -501,7 +987,13 @@ copy_range(pde_t *to, pde_t *from, uintptr_t start, uintptr_t end, bool share) {
          * (3) memory copy from src_kvaddr to dst_kvaddr, size is PGSIZE
          * (4) build the map of phy addr of  nage with the linear addr start
          */
-        assert(ret == 0);
+        void *src_kvaddr = page2kva(page);
+        void *dst_kvaddr = page2kva(npage);
+        memcpy(dst_kvaddr, src_kvaddr, PGSIZE);
+        if ((ret = page_insert(to, npage, start, perm)) != 0) {
+            free_page(npage);
+            return ret;
+        }
         }
         start += PGSIZE;
     } while (start != 0 && start < end);
@@ -541,6 +1033,9 @@ page_insert(pde_t *pgdir, struct Page *page, uintptr_t la, uint32_t perm) {
             page_remove_pte(pgdir, la, ptep);
         }
     }
+    else if (*ptep != 0) {
+        page_remove_pte(pgdir, la, ptep);
+    }
     *ptep = page2pa(page) | PTE_P | perm;
     tlb_invalidate(pgdir, la);
     return 0;
@@ -553,6 +1048,70 @@ tlb_invalidate(pde_t *pgdir, uintptr_t la) {
     if (rcr3() == PADDR(pgdir)) {
         invlpg((void *)la);
     }
+    if (ismp) {
+        tlb_shootdown(pgdir);
+    }
+}
+
+// load_cr3 - switch to the PDT cr3 on this cpu, which tlb_shootdown and tlb_release look for
+void
+load_cr3(uintptr_t cr3) {
+    lcr3(cr3);
+    mycpu()->loaded_cr3 = cr3;
+}
+
+#define TLB_FLUSH               1       // flush the TLB
+#define TLB_RELEASE             2       // switch to boot_cr3, the PDT is going to be freed
+
+/* *
+ * tlb_request - ask the other cpus which have pgdir loaded to do req, and wait until they
+ * are done. A cpu running a kernel thread keeps the PDT of the process run before loaded
+ * (see proc_run), so the cpus are found by loaded_cr3 rather than by their process.
+ * The caller holds the kernel lock, so such a cpu runs in user mode and takes
+ * the IPI, or waits for the kernel lock and answers in spin_lock.
+ * */
+static void
+tlb_request(pde_t *pgdir, int req) {
+    struct cpu *cpu;
+    // stay on this cpu, which is skipped
+    preempt_disable();
+    for (cpu = cpus; cpu < cpus + ncpu; cpu ++) {
+        if (cpu != mycpu() && cpu->started && cpu->loaded_cr3 == PADDR(pgdir)) {
+            cpu->tlb_flush = req;
+            lapic_ipi(cpu->apic_id, IRQ_OFFSET + IRQ_IPI);
+        }
+    }
+    for (cpu = cpus; cpu < cpus + ncpu; cpu ++) {
+        while (cpu->tlb_flush) {
+            pause();
+        }
+    }
+    preempt_enable();
+}
+
+// tlb_shootdown - flush the TLB of the other cpus on pgdir
+void
+tlb_shootdown(pde_t *pgdir) {
+    tlb_request(pgdir, TLB_FLUSH);
+}
+
+// tlb_release - move the other cpus off pgdir before it is freed
+void
+tlb_release(pde_t *pgdir) {
+    tlb_request(pgdir, TLB_RELEASE);
+}
+
+// tlb_shootdown_ack - answer tlb_shootdown or tlb_release, if asked
+void
+tlb_shootdown_ack(void) {
+    struct cpu *cpu = mycpu();
+    if (cpu->tlb_flush == TLB_RELEASE) {
+        load_cr3(boot_cr3);
+    }
+    else if (cpu->tlb_flush == TLB_FLUSH) {
+        lcr3(rcr3());
+    }
+    cpu->tlb_flush = 0;
 }
 
 // pgdir_alloc_page - call alloc_page & page_insert functions to 
@@ -586,9 +1145,86 @@ pgdir_alloc_page(pde_t *pgdir, uintptr_t la, uint32_t perm) {
     return page;
 }
 
+// check_zero_pool - the pages in the zeroed page pool are clean, and still counted as free memory
+static void
+check_zero_pool(void) {
+    size_t nr_free_pages_store = nr_free_pages();
+    struct Page *p, *pool[ZERO_POOL_MAX];
+    int i, j;
+
+    assert((p = alloc_page()) != NULL);
+    memset(page2kva(p), 0xff, PGSIZE);
+    free_page(p);
+
+    for (i = 0; i < ZERO_POOL_MAX; i ++) {
+        assert(zero_pool_fill());
+    }
+    assert(!zero_pool_fill() && nr_zero_pool == ZERO_POOL_MAX);
+    assert(nr_free_pages() == nr_free_pages_store);
+
+    for (i = 0; i < ZERO_POOL_MAX; i ++) {
+        assert((pool[i] = alloc_zeroed_page()) != NULL);
+        uint32_t *kva = page2kva(pool[i]);
+        for (j = 0; j < PGSIZE / sizeof(uint32_t); j ++) {
+            assert(kva[j] == 0);
+        }
+    }
+    assert(nr_zero_pool == 0);
+    for (i = 0; i < ZERO_POOL_MAX; i ++) {
+        free_page(pool[i]);
+    }
+
+    assert(zero_pool_fill() && zero_pool_fill());
+    assert(zero_pool_drain() == 2 && nr_zero_pool == 0);
+    assert(nr_free_pages() == nr_free_pages_store);
+
+    cprintf("check_zero_pool() succeeded!\n");
+}
+
+#define PERF_NR_HOLE        512
+#define PERF_NR_BLOCK       128
+#define PERF_ROUNDS         16
+
+static struct Page *perf_pages[PERF_NR_HOLE], *perf_blocks[PERF_NR_BLOCK];
+
+// check_alloc_perf - measure alloc/free of small blocks when the free memory is fragmented
+static void
+check_alloc_perf(void) {
+    size_t nr_free_pages_store = nr_free_pages();
+    int i, j;
+
+    // free every other page of a run, which leaves PERF_NR_HOLE / 2 single page holes
+    for (i = 0; i < PERF_NR_HOLE; i ++) {
+        assert((perf_pages[i] = alloc_page()) != NULL);
+    }
+    for (i = 0; i < PERF_NR_HOLE; i += 2) {
+        free_page(perf_pages[i]);
+    }
+
+    uint64_t start = read_tsc();
+    for (j = 0; j < PERF_ROUNDS; j ++) {
+        for (i = 0; i < PERF_NR_BLOCK; i ++) {
+            assert((perf_blocks[i] = alloc_pages(i % 4 + 1)) != NULL);
+        }
+        for (i = 0; i < PERF_NR_BLOCK; i ++) {
+            int k = i * 37 % (PERF_NR_BLOCK);
+            free_pages(perf_blocks[k], k % 4 + 1);
+        }
+    }
+    uint32_t cycles = read_tsc() - start;
+
+    for (i = 1; i < PERF_NR_HOLE; i += 2) {
+        free_page(perf_pages[i]);
+    }
+    assert(nr_free_pages_store == nr_free_pages());
+    cprintf("alloc_pages: %s, %u cycles per alloc & free of 1~4 pages\n",
+            pmm_manager->name, cycles / (PERF_ROUNDS * PERF_NR_BLOCK));
+}
+
 static void
 check_alloc_page(void) {
     pmm_manager->check();
+    check_alloc_perf();
     cprintf("check_alloc_page() succeeded!\n");
 }
 
@@ -646,7 +1282,12 @@ check_boot_pgdir(void) {
     int i;
     for (i = 0; i < npage; i += PGSIZE) {
         assert((ptep = get_pte(boot_pgdir, (uintptr_t)KADDR(i), 0)) != NULL);
-        assert(PTE_ADDR(*ptep) == i);
+        if (*ptep & PTE_PS) {
+            assert(PDE_LADDR(*ptep) + PTX(i) * PGSIZE == i);
+        }
+        else {
+            assert(PTE_ADDR(*ptep) == i);
+        }
     }
 
     assert(PDE_ADDR(boot_pgdir[PDX(VPT)]) == PADDR(boot_pgdir));
@@ -671,9 +1312,56 @@ check_boot_pgdir(void) {
     free_page(pde2page(boot_pgdir[0]));
     boot_pgdir[0] = 0;
 
+    if (pse_enabled) {
+        check_large_page();
+    }
+
     cprintf("check_boot_pgdir() succeeded!\n");
 }
 
+static void
+check_large_page(void) {
+    size_t nr_free_pages_store = nr_free_pages();
+    struct Page *base;
+    int i;
+
+    // map a large page, then remove it at once
+    assert((base = alloc_large_page()) != NULL && page2pa(base) % PTSIZE == 0);
+    set_page_ref(base, 1);
+    boot_pgdir[0] = page2pa(base) | PTE_P | PTE_PS | PTE_W;
+    tlb_invalidate(boot_pgdir, 0);
+
+    *(int *)(3 * PGSIZE + 0x100) = 0x5a5a;
+    assert(*(int *)(page2kva(base + 3) + 0x100) == 0x5a5a);
+    assert(get_page(boot_pgdir, 3 * PGSIZE + 0x100, NULL) == base + 3);
+
+    page_remove(boot_pgdir, 0);
+    assert(boot_pgdir[0] == 0);
+    assert(nr_free_pages_store == nr_free_pages());
+
+    // map a large page, split it into 4K pages, then remove them one by one
+    assert((base = alloc_large_page()) != NULL);
+    set_page_ref(base, 1);
+    boot_pgdir[0] = page2pa(base) | PTE_P | PTE_PS | PTE_W | PTE_U;
+    tlb_invalidate(boot_pgdir, 0);
+    *(int *)(3 * PGSIZE + 0x100) = 0xa5a5;
+
+    pte_t *ptep;
+    assert((ptep = get_pte(boot_pgdir, 3 * PGSIZE, 1)) != NULL);
+    assert(!(boot_pgdir[0] & PTE_PS) && PTE_ADDR(*ptep) == page2pa(base + 3));
+    assert(page_ref(base + 3) == 1);
+    assert(*(int *)(3 * PGSIZE + 0x100) == 0xa5a5);
+
+    for (i = 0; i < NPTEENTRY; i ++) {
+        page_remove(boot_pgdir, i * PGSIZE);
+    }
+    free_page(pde2page(boot_pgdir[0]));
+    boot_pgdir[0] = 0;
+    assert(nr_free_pages_store == nr_free_pages());
+
+    cprintf("check_large_page() succeeded!\n");
+}
+
 //perm2str - use string 'u,r,w,-' to present the permission
 static const char *
 perm2str(int perm) {
@@ -708,8 +1396,8 @@ get_pgtable_items(size_t left, size_t right, size_t start, uintptr_t *table, siz
         if (left_store != NULL) {
             *left_store = start;
         }
-        int perm = (table[start ++] & PTE_USER);
-        while (start < right && (table[start] & PTE_USER) == perm) {
+        int perm = (table[start ++] & (PTE_USER | PTE_PS));
+        while (start < right && (table[start] & (PTE_USER | PTE_PS)) == perm) {
             start ++;
         }
         if (right_store != NULL) {
@@ -726,8 +1414,13 @@ print_pgdir(void) {
     cprintf("-------------------- BEGIN --------------------\n");
     size_t left, right = 0, perm;
     while ((perm = get_pgtable_items(0, NPDEENTRY, right, vpd, &left, &right)) != 0) {
-        cprintf("PDE(%03x) %08x-%08x %08x %s\n", right - left,
-                left * PTSIZE, right * PTSIZE, (right - left) * PTSIZE, perm2str(perm));
+        cprintf("PDE(%03x) %08x-%08x %08x %s%s\n", right - left,
+                left * PTSIZE, right * PTSIZE, (right - left) * PTSIZE, perm2str(perm),
+                (perm & PTE_PS) ? " 4M" : "");
+        // a large page pde has no PT, don't walk it through vpt
+        if (perm & PTE_PS) {
+            continue;
+        }
         size_t l, r = left * NPTEENTRY;
         while ((perm = get_pgtable_items(left * NPTEENTRY, right * NPTEENTRY, r, vpt, &l, &r)) != 0) {
             cprintf("  |-- PTE(%05x) %08x-%08x %08x %s\n", r - l,
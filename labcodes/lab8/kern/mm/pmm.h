@@ -23,8 +23,12 @@ struct pmm_manager {
 };
 
 extern const struct pmm_manager *pmm_manager;
+extern struct Page *zero_page;
+extern bool pse_enabled;
+extern bool sysenter_enabled;
 extern pde_t *boot_pgdir;
 extern uintptr_t boot_cr3;
+extern size_t watermark_reserve, watermark_low, watermark_high;
 
 void pmm_init(void);
 
@@ -35,13 +39,28 @@ size_t nr_free_pages(void);
 #define alloc_page() alloc_pages(1)
 #define free_page(page) free_pages(page, 1)
 
+struct Page *alloc_zeroed_page(void);
+bool zero_pool_fill(void);
+
+struct Page *alloc_large_page(void);
+void free_large_page(struct Page *base);
+
 pte_t *get_pte(pde_t *pgdir, uintptr_t la, bool create);
 struct Page *get_page(pde_t *pgdir, uintptr_t la, pte_t **ptep_store);
 void page_remove(pde_t *pgdir, uintptr_t la);
 int page_insert(pde_t *pgdir, struct Page *page, uintptr_t la, uint32_t perm);
 
+struct cpu;
+
+void gdt_init_cpu(struct cpu *cpu, uintptr_t esp0);
 void load_esp0(uintptr_t esp0);
+void load_tls(uintptr_t base);
+void load_cr3(uintptr_t cr3);
 void tlb_invalidate(pde_t *pgdir, uintptr_t la);
+void tlb_shootdown(pde_t *pgdir);
+void tlb_release(pde_t *pgdir);
+void tlb_shootdown_ack(void);
+void *mmio_map(uintptr_t pa, size_t size);
 struct Page *pgdir_alloc_page(pde_t *pgdir, uintptr_t la, uint32_t perm);
 void unmap_range(pde_t *pgdir, uintptr_t start, uintptr_t end);
 void exit_range(pde_t *pgdir, uintptr_t start, uintptr_t end);
@@ -0,0 +1,148 @@
+#include <defs.h>
+#include <list.h>
+#include <string.h>
+#include <assert.h>
+#include <error.h>
+#include <unistd.h>
+#include <kmalloc.h>
+#include <pmm.h>
+#include <sem.h>
+#include <shmem.h>
+
+#define le2shmem(le, member)                \
+    to_struct((le), struct shmem_struct, member)
+
+// the segments with a key, protected by shmem_sem with the pages of all segments
+static list_entry_t shmem_list;
+static semaphore_t shmem_sem;
+
+void
+shmem_init(void) {
+    list_init(&shmem_list);
+    sem_init(&shmem_sem, 1);
+}
+
+// shmem_create - alloc a segment of len bytes, no page is allocated here
+static struct shmem_struct *
+shmem_create(int key, size_t len) {
+    struct shmem_struct *shmem;
+    size_t npage = len / PGSIZE;
+    if ((shmem = kmalloc(sizeof(struct shmem_struct))) != NULL) {
+        if ((shmem->pages = kmalloc(sizeof(struct Page *) * npage)) == NULL) {
+            kfree(shmem);
+            return NULL;
+        }
+        memset(shmem->pages, 0, sizeof(struct Page *) * npage);
+        shmem->key = key;
+        shmem->len = len;
+        shmem->shmem_count = 0;
+    }
+    return shmem;
+}
+
+// shmem_destroy - free the pages of segment & the segment, no vma attaches it now
+static void
+shmem_destroy(struct shmem_struct *shmem) {
+    size_t i, npage = shmem->len / PGSIZE;
+    for (i = 0; i < npage; i ++) {
+        struct Page *page;
+        if ((page = shmem->pages[i]) != NULL) {
+            ClearPageShmem(page);
+            if (page_ref_dec(page) == 0) {
+                free_page(page);
+            }
+        }
+    }
+    kfree(shmem->pages);
+    kfree(shmem);
+}
+
+/* *
+ * shmem_get - find the segment of key, or create one of len bytes if SHMEM_CREAT is set
+ * (SHMEM_EXCL: fail if the segment exists). The segment is returned with a reference
+ * taken, the caller drops it by shmem_ref_dec.
+ * */
+int
+shmem_get(int key, size_t len, uint32_t flags, struct shmem_struct **shmem_store) {
+    len = ROUNDUP(len, PGSIZE);
+    if (len == 0 || len > USERTOP) {
+        return -E_INVAL;
+    }
+
+    int ret = 0;
+    struct shmem_struct *shmem = NULL;
+
+    down(&shmem_sem);
+    if (key != SHMEM_PRIVATE) {
+        list_entry_t *list = &shmem_list, *le = list;
+        while ((le = list_next(le)) != list) {
+            if (le2shmem(le, shmem_link)->key == key) {
+                shmem = le2shmem(le, shmem_link);
+                break;
+            }
+        }
+    }
+    if (shmem != NULL) {
+        if ((flags & (SHMEM_CREAT | SHMEM_EXCL)) == (SHMEM_CREAT | SHMEM_EXCL)) {
+            ret = -E_EXISTS;
+            goto out;
+        }
+        if (len > shmem->len) {
+            ret = -E_INVAL;
+            goto out;
+        }
+    }
+    else {
+        if (key != SHMEM_PRIVATE && !(flags & SHMEM_CREAT)) {
+            ret = -E_NOENT;
+            goto out;
+        }
+        if ((shmem = shmem_create(key, len)) == NULL) {
+            ret = -E_NO_MEM;
+            goto out;
+        }
+        list_add(&shmem_list, &(shmem->shmem_link));
+    }
+    shmem->shmem_count ++;
+    *shmem_store = shmem;
+out:
+    up(&shmem_sem);
+    return ret;
+}
+
+void
+shmem_ref_inc(struct shmem_struct *shmem) {
+    down(&shmem_sem);
+    shmem->shmem_count ++;
+    up(&shmem_sem);
+}
+
+// shmem_ref_dec - drop a reference of segment, the last one destroys the segment
+void
+shmem_ref_dec(struct shmem_struct *shmem) {
+    down(&shmem_sem);
+    assert(shmem->shmem_count > 0);
+    if (-- shmem->shmem_count == 0) {
+        list_del(&(shmem->shmem_link));
+        shmem_destroy(shmem);
+    }
+    up(&shmem_sem);
+}
+
+// shmem_get_page - get the page at index of segment, alloc a zero-filled one if not touched yet
+struct Page *
+shmem_get_page(struct shmem_struct *shmem, size_t index) {
+    assert(index < shmem->len / PGSIZE);
+    struct Page *page;
+    down(&shmem_sem);
+    if ((page = shmem->pages[index]) == NULL) {
+        if ((page = alloc_zeroed_page()) != NULL) {
+            set_page_ref(page, 1);
+            SetPageShmem(page);
+            shmem->pages[index] = page;
+        }
+    }
+    up(&shmem_sem);
+    return page;
+}
+
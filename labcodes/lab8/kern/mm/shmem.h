@@ -0,0 +1,33 @@
+#ifndef __KERN_MM_SHMEM_H__
+#define __KERN_MM_SHMEM_H__
+
+#include <defs.h>
+#include <list.h>
+
+struct Page;
+
+/* *
+ * shmem - the shared memory segments.
+ * A segment is a set of pages found by a user key, every vma which attaches it
+ * (VM_SHARE) holds a reference of the segment. The pages are allocated on the
+ * first fault in any process and mapped into all the attaching mm_structs, the
+ * segment holds one reference of each page (see PG_shmem), so the pages stay
+ * until the last vma detaches. A segment of key SHMEM_PRIVATE has no key, it is
+ * shared only by the children of the creator (through dup_mmap).
+ * */
+struct shmem_struct {
+    int key;                        // the user key of the segment
+    size_t len;                     // bytes of the segment (page aligned)
+    struct Page **pages;            // the pages of the segment, NULL if not touched yet
+    int shmem_count;                // the number of vmas which attach the segment
+    list_entry_t shmem_link;        // entry in shmem_list
+};
+
+void shmem_init(void);
+int shmem_get(int key, size_t len, uint32_t flags, struct shmem_struct **shmem_store);
+void shmem_ref_inc(struct shmem_struct *shmem);
+void shmem_ref_dec(struct shmem_struct *shmem);
+struct Page *shmem_get_page(struct shmem_struct *shmem, size_t index);
+
+#endif /* !__KERN_MM_SHMEM_H__ */
+
@@ -6,8 +6,10 @@
 #include <memlayout.h>
 #include <pmm.h>
 #include <mmu.h>
-#include <default_pmm.h>
 #include <kdebug.h>
+#include <kmalloc.h>
+#include <sched.h>
+#include <error.h>
 
 // the valid vaddr for check is between 0~CHECK_VALID_VADDR-1
 #define CHECK_VALID_VIR_PAGE_NUM 5
@@ -23,11 +25,26 @@ size_t max_swap_offset;
 
 volatile int swap_init_ok = 0;
 
+// swap_map - the reference count of every swap entry (the number of ptes holding it),
+// 0 means the entry is free. The entry of offset 0 is never used, it looks like an empty pte.
+static uint8_t *swap_map;
+static size_t swap_cursor, nr_free_swap;
+
+#define SWAP_MAP_MAX            0xFF
+
+// the mm_structs whose pages can be swapped out, swap_reclaim scans them round-robin
+static list_entry_t swap_mm_list;
+static size_t nr_swap_mm;
+
+// the max number of pages swap_reclaim takes from one mm before moving on to the next one
+#define SWAP_CLUSTER            16
+
 unsigned int swap_page[CHECK_VALID_VIR_PAGE_NUM];
 
 unsigned int swap_in_seq_no[MAX_SEQ_NO],swap_out_seq_no[MAX_SEQ_NO];
 
 static void check_swap(void);
+static void check_reclaim(void);
 
 int
 swap_init(void)
@@ -38,7 +55,13 @@ swap_init(void)
      {
           panic("bad max_swap_offset %08x.\n", max_swap_offset);
      }
-     
+     if ((swap_map = kmalloc(max_swap_offset)) == NULL) {
+          panic("no memory for swap_map.\n");
+     }
+     memset(swap_map, 0, max_swap_offset);
+     swap_cursor = 1, nr_free_swap = max_swap_offset - 1;
+     list_init(&swap_mm_list);
+     nr_swap_mm = 0;
 
      sm = &swap_manager_fifo;
      int r = sm->init();
@@ -48,6 +71,16 @@ swap_init(void)
           swap_init_ok = 1;
           cprintf("SWAP: manager = %s\n", sm->name);
           check_swap();
+          check_reclaim();
+
+          size_t reserve = nr_free_pages() / 128;
+          if (reserve < SWAP_CLUSTER) {
+               reserve = SWAP_CLUSTER;
+          }
+          watermark_reserve = reserve;
+          watermark_low = reserve + reserve / 4;
+          watermark_high = reserve + reserve / 2;
+          cprintf("SWAP: watermark reserve %u, low %u, high %u pages\n", watermark_reserve, watermark_low, watermark_high);
      }
 
      return r;
@@ -56,7 +89,20 @@ swap_init(void)
 int
 swap_init_mm(struct mm_struct *mm)
 {
-     return sm->init_mm(mm);
+     int ret = sm->init_mm(mm);
+     if (ret == 0) {
+          list_add_before(&swap_mm_list, &(mm->swap_link));
+          nr_swap_mm ++;
+     }
+     return ret;
+}
+
+void
+swap_exit_mm(struct mm_struct *mm)
+{
+     list_del(&(mm->swap_link));
+     nr_swap_mm --;
+     sm->exit_mm(mm);
 }
 
 int
@@ -68,7 +114,18 @@ swap_tick_event(struct mm_struct *mm)
 int
 swap_map_swappable(struct mm_struct *mm, uintptr_t addr, struct Page *page, int swap_in)
 {
-     return sm->map_swappable(mm, addr, page, swap_in);
+     // a shared memory page may be mapped in many mm_structs, but swap_out can only
+     // replace the pte of one mm by the swap entry, so it is never swapped out.
+     // for the same reason, only a page mapped by one pte is swappable.
+     if (PageShmem(page) || PageSwappable(page) || page_ref(page) != 1 || mm->sm_priv == NULL) {
+          return 0;
+     }
+     int ret = sm->map_swappable(mm, addr, page, swap_in);
+     if (ret == 0) {
+          SetPageSwappable(page);
+          page->pra_vaddr = addr;
+     }
+     return ret;
 }
 
 int
@@ -77,43 +134,109 @@ swap_set_unswappable(struct mm_struct *mm, uintptr_t addr)
      return sm->set_unswappable(mm, addr);
 }
 
+// swap_remove_page - unlink the page from the swap manager before it is freed
+void
+swap_remove_page(struct Page *page)
+{
+     if (PageSwappable(page)) {
+          list_del(&(page->pra_page_link));
+          ClearPageSwappable(page);
+     }
+}
+
+// swap_entry_alloc - take a free swap entry, searching from swap_cursor
+// return value: the swap entry, 0 if the swap disk is full
+static swap_entry_t
+swap_entry_alloc(void)
+{
+     if (nr_free_swap == 0) {
+          return 0;
+     }
+     while (swap_map[swap_cursor] != 0) {
+          if (++ swap_cursor == max_swap_offset) {
+               swap_cursor = 1;
+          }
+     }
+     swap_map[swap_cursor] = 1;
+     nr_free_swap --;
+     return swap_cursor << 8;
+}
+
+// swap_duplicate - one more pte holds the swap entry (fork)
+int
+swap_duplicate(swap_entry_t entry)
+{
+     size_t offset = swap_offset(entry);
+     assert(swap_map[offset] != 0);
+     if (swap_map[offset] == SWAP_MAP_MAX) {
+          return -E_NO_MEM;
+     }
+     swap_map[offset] ++;
+     return 0;
+}
+
+// swap_free - a pte drops the swap entry, the entry is free when no pte holds it
+void
+swap_free(swap_entry_t entry)
+{
+     size_t offset = swap_offset(entry);
+     assert(swap_map[offset] != 0);
+     if (-- swap_map[offset] == 0) {
+          nr_free_swap ++;
+     }
+}
+
 volatile unsigned int swap_out_num=0;
 
+// swap_out - write at most n pages of mm to the swap disk and free them
+// return value: the number of pages swapped out
 int
 swap_out(struct mm_struct *mm, int n, int in_tick)
 {
-     int i;
-     for (i = 0; i != n; ++ i)
+     int i = 0;
+     while (i != n)
      {
           uintptr_t v;
           //struct Page **ptr_page=NULL;
           struct Page *page;
+          swap_entry_t entry;
           // cprintf("i %d, SWAP: call swap_out_victim\n",i);
           int r = sm->swap_out_victim(mm, &page, in_tick);
           if (r != 0) {
-                    cprintf("i %d, swap_out: call swap_out_victim failed\n",i);
                   break;
           }          
-          //assert(!PageReserved(page));
+          ClearPageSwappable(page);
 
           //cprintf("SWAP: choose victim page 0x%08x\n", page);
           
           v=page->pra_vaddr; 
           pte_t *ptep = get_pte(mm->pgdir, v, 0);
-          assert((*ptep & PTE_P) != 0);
-
-          if (swapfs_write( (page->pra_vaddr/PGSIZE+1)<<8, page) != 0) {
-                    cprintf("SWAP: failed to save\n");
-                    sm->map_swappable(mm, v, page, 0);
+          // the page is not mapped by the only pte at pra_vaddr any more, drop it
+          if (ptep == NULL || !(*ptep & PTE_P) || pte2page(*ptep) != page || page_ref(page) != 1) {
                     continue;
           }
-          else {
-                    cprintf("swap_out: i %d, store page in vaddr 0x%x to disk swap entry %d\n", i, v, page->pra_vaddr/PGSIZE+1);
-                    *ptep = (page->pra_vaddr/PGSIZE+1)<<8;
-                    free_page(page);
+
+          if ((entry = swap_entry_alloc()) == 0) {
+                    swap_map_swappable(mm, v, page, 0);
+                    break;
+          }
+          // write-protect the page on all cpus before saving it, swapfs_write may sleep and
+          // the threads of mm may run meanwhile; a write faults and waits for lock_mm
+          pte_t pte = *ptep;
+          *ptep &= ~PTE_W;
+          tlb_invalidate(mm->pgdir, v);
+          if (swapfs_write(entry, page) != 0) {
+                    cprintf("SWAP: failed to save\n");
+                    *ptep = pte;
+                    swap_free(entry);
+                    swap_map_swappable(mm, v, page, 0);
+                    break;
           }
-          
+          *ptep = entry;
           tlb_invalidate(mm->pgdir, v);
+          page_ref_dec(page);
+          free_page(page);
+          i ++;
      }
      return i;
 }
@@ -122,7 +245,9 @@ int
 swap_in(struct mm_struct *mm, uintptr_t addr, struct Page **ptr_result)
 {
      struct Page *result = alloc_page();
-     assert(result!=NULL);
+     if (result == NULL) {
+          return -E_NO_MEM;
+     }
 
      pte_t *ptep = get_pte(mm->pgdir, addr, 0);
      // cprintf("SWAP: load ptep %x swap entry %d to vaddr 0x%08x, page %x, No %d\n", ptep, (*ptep)>>8, addr, result, (result-pages));
@@ -130,14 +255,56 @@ swap_in(struct mm_struct *mm, uintptr_t addr, struct Page **ptr_result)
      int r;
      if ((r = swapfs_read((*ptep), result)) != 0)
      {
-        assert(r!=0);
+          free_page(result);
+          return r;
      }
-     cprintf("swap_in: load disk swap entry %d with swap_page in vadr 0x%x\n", (*ptep)>>8, addr);
      *ptr_result=result;
      return 0;
 }
 
-
+/* *
+ * swap_reclaim - swap out about n pages from the mm_structs of all processes
+ * The mm_structs are scanned round-robin, every mm gives at most SWAP_CLUSTER pages a time,
+ * and a scanned mm moves to the tail, so the next reclaim starts from another process.
+ * An mm locked by its owner (mmap, fork, exit, ...) is skipped. An mm is picked and locked
+ * without preemption, an exiting process takes it off the list under the lock, see put_mm.
+ * return value: the number of pages reclaimed, less than n if nothing more can be swapped out
+ * */
+size_t
+swap_reclaim(size_t n)
+{
+     size_t reclaimed = 0;
+     while (reclaimed < n) {
+          size_t i, nr_scan = nr_swap_mm, last = reclaimed;
+          for (i = 0; i < nr_scan && reclaimed < n; i ++) {
+               preempt_disable();
+               list_entry_t *le = list_next(&swap_mm_list);
+               if (le == &swap_mm_list) {
+                    // the mm_structs have exited meanwhile
+                    preempt_enable();
+                    break;
+               }
+               struct mm_struct *mm = le2mm(le, swap_link);
+               list_del(le);
+               list_add_before(&swap_mm_list, le);
+               if (mm->pgdir == NULL || !try_lock_mm(mm)) {
+                    preempt_enable();
+                    continue;
+               }
+               preempt_enable();
+               size_t batch = n - reclaimed;
+               if (batch > SWAP_CLUSTER) {
+                    batch = SWAP_CLUSTER;
+               }
+               reclaimed += swap_out(mm, batch, 0);
+               unlock_mm(mm);
+          }
+          if (reclaimed == last) {
+               break;
+          }
+     }
+     return reclaimed;
+}
 
 static inline void
 check_content_set(void)
@@ -171,24 +338,47 @@ struct Page * check_rp[CHECK_VALID_PHY_PAGE_NUM];
 pte_t * check_ptep[CHECK_VALID_PHY_PAGE_NUM];
 unsigned int check_swap_addr[CHECK_VALID_VIR_PAGE_NUM];
 
-extern free_area_t free_area;
+// the free memory hidden from check_swap, kept as allocated blocks linked by page_link
+static list_entry_t check_hold_list;
 
-#define free_list (free_area.free_list)
-#define nr_free (free_area.nr_free)
+// check_hold_free - alloc all the free memory, return the number of blocks
+// the blocks are taken from pmm_manager directly, or alloc_pages would try to swap out
+static int
+check_hold_free(void)
+{
+     int count = 0;
+     size_t n;
+     list_init(&check_hold_list);
+     while ((n = nr_free_pages()) > 0) {
+          struct Page *p;
+          while ((p = pmm_manager->alloc_pages(n)) == NULL) {
+               n /= 2;
+          }
+          p->property = n;
+          list_add(&check_hold_list, &(p->page_link));
+          count ++;
+     }
+     return count;
+}
+
+static void
+check_release_free(void)
+{
+     list_entry_t *le;
+     while ((le = list_next(&check_hold_list)) != &check_hold_list) {
+          struct Page *p = le2page(le, page_link);
+          list_del(le);
+          free_pages(p, p->property);
+     }
+}
 
 static void
 check_swap(void)
 {
     //backup mem env
-     int ret, count = 0, total = 0, i;
-     list_entry_t *le = &free_list;
-     while ((le = list_next(le)) != &free_list) {
-        struct Page *p = le2page(le, page_link);
-        assert(PageProperty(p));
-        count ++, total += p->property;
-     }
-     assert(total == nr_free_pages());
-     cprintf("BEGIN check_swap: count %d, total %d\n",count,total);
+     int ret, count, total, i;
+     total = nr_free_pages();
+     cprintf("BEGIN check_swap: total %d\n",total);
      
      //now we set the phy pages env     
      struct mm_struct *mm = mm_create();
@@ -219,18 +409,13 @@ check_swap(void)
           assert(check_rp[i] != NULL );
           assert(!PageProperty(check_rp[i]));
      }
-     list_entry_t free_list_store = free_list;
-     list_init(&free_list);
-     assert(list_empty(&free_list));
-     
-     //assert(alloc_page() == NULL);
+     count = check_hold_free();
+     assert(nr_free_pages() == 0);
      
-     unsigned int nr_free_store = nr_free;
-     nr_free = 0;
      for (i=0;i<CHECK_VALID_PHY_PAGE_NUM;i++) {
         free_pages(check_rp[i],1);
      }
-     assert(nr_free==CHECK_VALID_PHY_PAGE_NUM);
+     assert(nr_free_pages()==CHECK_VALID_PHY_PAGE_NUM);
      
      cprintf("set up init env for check_swap begin!\n");
      //setup initial vir_page<->phy_page environment for page relpacement algorithm 
@@ -239,7 +424,7 @@ check_swap(void)
      pgfault_num=0;
      
      check_content_set();
-     assert( nr_free == 0);         
+     assert( nr_free_pages() == 0);         
      for(i = 0; i<MAX_SEQ_NO ; i++) 
          swap_out_seq_no[i]=swap_in_seq_no[i]=-1;
      
@@ -257,6 +442,12 @@ check_swap(void)
      assert(ret==0);
      
      //restore kernel mem env
+     for (i=0;i<CHECK_VALID_VIR_PAGE_NUM;i++) {
+         pte_t *ptep = get_pte(pgdir, (i+1)*0x1000, 0);
+         if (!(*ptep & PTE_P)) {
+             swap_free(*ptep);
+         }
+     }
      for (i=0;i<CHECK_VALID_PHY_PAGE_NUM;i++) {
          free_pages(check_rp[i],1);
      } 
@@ -268,17 +459,94 @@ check_swap(void)
      mm_destroy(mm);
      check_mm_struct = NULL;
      
-     nr_free = nr_free_store;
-     free_list = free_list_store;
-
-     
-     le = &free_list;
-     while ((le = list_next(le)) != &free_list) {
-         struct Page *p = le2page(le, page_link);
-         count --, total -= p->property;
-     }
-     cprintf("count is %d, total is %d\n",count,total);
-     //assert(count == 0);
+     check_release_free();
+     cprintf("count is %d, total is %d\n",count,total - (int)nr_free_pages());
      
      cprintf("check_swap() succeeded!\n");
 }
+
+#define CHECK_RECLAIM_NR_MM         2
+#define CHECK_RECLAIM_NR_PAGE       (SWAP_CLUSTER * 2)
+
+// check_reclaim - the pages of all the mm_structs are reclaimed round-robin when the free memory
+//                 runs out, the content survives swap out/in, and fork shares the swap entries
+static void
+check_reclaim(void)
+{
+     size_t nr_free_swap_store = nr_free_swap;
+     // the last one is forked from mm[0]
+     struct mm_struct *mm[CHECK_RECLAIM_NR_MM + 1], *child;
+     struct Page *page, *held[CHECK_RECLAIM_NR_MM * CHECK_RECLAIM_NR_PAGE];
+     int i, j, k;
+
+     for (i = 0; i < CHECK_RECLAIM_NR_MM; i ++) {
+          assert((mm[i] = mm_create()) != NULL && mm[i]->sm_priv != NULL);
+          assert((page = alloc_page()) != NULL);
+          mm[i]->pgdir = page2kva(page);
+          memcpy(mm[i]->pgdir, boot_pgdir, PGSIZE);
+
+          struct vma_struct *vma = vma_create(UTEXT, UTEXT + CHECK_RECLAIM_NR_PAGE * PGSIZE, VM_READ | VM_WRITE);
+          assert(vma != NULL);
+          insert_vma_struct(mm[i], vma);
+          for (j = 0; j < CHECK_RECLAIM_NR_PAGE; j ++) {
+               assert(do_pgfault(mm[i], 2, UTEXT + j * PGSIZE) == 0);
+               page = get_page(mm[i]->pgdir, UTEXT + j * PGSIZE, NULL);
+               assert(page != NULL && PageSwappable(page));
+               *(int *)page2kva(page) = i * CHECK_RECLAIM_NR_PAGE + j;
+          }
+     }
+
+     // take all the free memory, then every page must be reclaimed from the mm_structs
+     check_hold_free();
+     assert(nr_free_pages() == 0);
+     for (k = 0; k < CHECK_RECLAIM_NR_MM * CHECK_RECLAIM_NR_PAGE; k ++) {
+          assert((held[k] = alloc_page()) != NULL);
+          // one page from each mm in turn
+          for (i = 0; i < CHECK_RECLAIM_NR_MM; i ++) {
+               pte_t *ptep = get_pte(mm[i]->pgdir, UTEXT + (k / CHECK_RECLAIM_NR_MM) * PGSIZE, 0);
+               assert(((*ptep & PTE_P) != 0) == (i > k % CHECK_RECLAIM_NR_MM));
+          }
+     }
+     // nothing can be reclaimed any more, the requests fail cleanly
+     assert(alloc_page() == NULL && alloc_pages(2) == NULL);
+
+     // a forked mm shares the swap entries
+     for (k = 0; k < CHECK_RECLAIM_NR_PAGE; k ++) {
+          free_page(held[k]);
+     }
+     assert((child = mm[CHECK_RECLAIM_NR_MM] = mm_create()) != NULL);
+     assert((page = alloc_page()) != NULL);
+     child->pgdir = page2kva(page);
+     memcpy(child->pgdir, boot_pgdir, PGSIZE);
+     assert(dup_mmap(child, mm[0]) == 0);
+     assert(nr_free_swap == nr_free_swap_store - CHECK_RECLAIM_NR_MM * CHECK_RECLAIM_NR_PAGE);
+
+     // load the pages back by page faults, the content survives swap out & in
+     for (i = 0; i < CHECK_RECLAIM_NR_MM; i ++) {
+          for (j = 0; j < CHECK_RECLAIM_NR_PAGE / 2; j ++) {
+               assert(do_pgfault(mm[i], 2, UTEXT + j * PGSIZE) == 0);
+               page = get_page(mm[i]->pgdir, UTEXT + j * PGSIZE, NULL);
+               assert(page != NULL && *(int *)page2kva(page) == i * CHECK_RECLAIM_NR_PAGE + j);
+          }
+     }
+     for (j = 0; j < CHECK_RECLAIM_NR_PAGE; j ++) {
+          assert(do_pgfault(child, 2, UTEXT + j * PGSIZE) == 0);
+          page = get_page(child->pgdir, UTEXT + j * PGSIZE, NULL);
+          assert(page != NULL && *(int *)page2kva(page) == j);
+     }
+
+     for (k = CHECK_RECLAIM_NR_PAGE; k < CHECK_RECLAIM_NR_MM * CHECK_RECLAIM_NR_PAGE; k ++) {
+          free_page(held[k]);
+     }
+     check_release_free();
+     for (i = 0; i <= CHECK_RECLAIM_NR_MM; i ++) {
+          exit_mmap(mm[i]);
+          free_page(kva2page(mm[i]->pgdir));
+          mm[i]->pgdir = NULL;
+          mm_destroy(mm[i]);
+     }
+     assert(nr_free_swap == nr_free_swap_store);
+
+     cprintf("check_reclaim() succeeded!\n");
+}
+
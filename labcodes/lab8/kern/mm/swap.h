@@ -37,6 +37,8 @@ struct swap_manager
      int (*init)            (void);
      /* Initialize the priv data inside mm_struct */
      int (*init_mm)         (struct mm_struct *mm);
+     /* Release the priv data inside mm_struct */
+     int (*exit_mm)         (struct mm_struct *mm);
      /* Called when tick interrupt occured */
      int (*tick_event)      (struct mm_struct *mm);
      /* Called when map a swappable page into the mm_struct */
@@ -53,11 +55,16 @@ struct swap_manager
 extern volatile int swap_init_ok;
 int swap_init(void);
 int swap_init_mm(struct mm_struct *mm);
+void swap_exit_mm(struct mm_struct *mm);
 int swap_tick_event(struct mm_struct *mm);
 int swap_map_swappable(struct mm_struct *mm, uintptr_t addr, struct Page *page, int swap_in);
 int swap_set_unswappable(struct mm_struct *mm, uintptr_t addr);
 int swap_out(struct mm_struct *mm, int n, int in_tick);
 int swap_in(struct mm_struct *mm, uintptr_t addr, struct Page **ptr_result);
+void swap_remove_page(struct Page *page);
+int swap_duplicate(swap_entry_t entry);
+void swap_free(swap_entry_t entry);
+size_t swap_reclaim(size_t n);
 
 //#define MEMBER_OFFSET(m,t) ((int)(&((t *)0)->m))
 //#define FROM_MEMBER(m,t,a) ((t *)((char *)(a) - MEMBER_OFFSET(m,t)))
@@ -5,6 +5,8 @@
 #include <swap.h>
 #include <swap_fifo.h>
 #include <list.h>
+#include <kmalloc.h>
+#include <error.h>
 
 /* [wikipedia]The simplest Page Replacement Algorithm(PRA) is a FIFO algorithm. The first-in, first-out
  * page replacement algorithm is a low-overhead algorithm that requires little book-keeping on
@@ -25,19 +27,32 @@
  *              le2page (in memlayout.h), (in future labs: le2vma (in vmm.h), le2proc (in proc.h),etc.
  */
 
-list_entry_t pra_list_head;
 /*
  * (2) _fifo_init_mm: init pra_list_head and let  mm->sm_priv point to the addr of pra_list_head.
  *              Now, From the memory control struct mm_struct, we can access FIFO PRA
+ *              Every mm has its own pra_list_head, so the pages of all the processes can be swapped out.
  */
 static int
 _fifo_init_mm(struct mm_struct *mm)
 {     
-     list_init(&pra_list_head);
-     mm->sm_priv = &pra_list_head;
+     list_entry_t *pra_list_head;
+     if ((pra_list_head = kmalloc(sizeof(list_entry_t))) == NULL) {
+          mm->sm_priv = NULL;
+          return -E_NO_MEM;
+     }
+     list_init(pra_list_head);
+     mm->sm_priv = pra_list_head;
      //cprintf(" mm->sm_priv %x in fifo_init_mm\n",mm->sm_priv);
      return 0;
 }
+
+static int
+_fifo_exit_mm(struct mm_struct *mm)
+{
+     kfree(mm->sm_priv);
+     mm->sm_priv = NULL;
+     return 0;
+}
 /*
  * (3)_fifo_map_swappable: According FIFO PRA, we should link the most recent arrival page at the back of pra_list_head qeueue
  */
@@ -51,6 +66,7 @@ _fifo_map_swappable(struct mm_struct *mm, uintptr_t addr, struct Page *page, int
     //record the page access situlation
     /*LAB3 EXERCISE 2: YOUR CODE*/ 
     //(1)link the most recent arrival page at the back of the pra_list_head qeueue.
+    list_add_before(head, entry);
     return 0;
 }
 /*
@@ -67,6 +83,13 @@ _fifo_swap_out_victim(struct mm_struct *mm, struct Page ** ptr_page, int in_tick
      /*LAB3 EXERCISE 2: YOUR CODE*/ 
      //(1)  unlink the  earliest arrival page in front of pra_list_head qeueue
      //(2)  assign the value of *ptr_page to the addr of this page
+     list_entry_t *le = list_next(head);
+     if (le == head) {
+          *ptr_page = NULL;
+          return -E_NO_MEM;
+     }
+     list_del(le);
+     *ptr_page = le2page(le, pra_page_link);
      return 0;
 }
 
@@ -135,6 +158,7 @@ struct swap_manager swap_manager_fifo =
      .name            = "fifo swap manager",
      .init            = &_fifo_init,
      .init_mm         = &_fifo_init_mm,
+     .exit_mm         = &_fifo_exit_mm,
      .tick_event      = &_fifo_tick_event,
      .map_swappable   = &_fifo_map_swappable,
      .set_unswappable = &_fifo_set_unswappable,
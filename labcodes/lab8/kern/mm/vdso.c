@@ -0,0 +1,92 @@
+#include <defs.h>
+#include <memlayout.h>
+#include <string.h>
+#include <assert.h>
+#include <error.h>
+#include <pmm.h>
+#include <vmm.h>
+#include <vdso.h>
+
+/* *
+ * The vdso vma (VM_VDSO) of an address space maps two pages at VDSO_BASE: the data page,
+ * which the kernel holds a reference of for ever, and the page of the mm (mm->vdso_page),
+ * which mm holds a reference of until mm_destroy. The vma is read-only for the user, its
+ * pages are mapped on demand by do_pgfault, never swapped out, and not copied by dup_mmap:
+ * the child gets a page of its own with vdso_dup.
+ * */
+
+struct vdso_data *vdso_data;
+static struct Page *vdso_data_page;
+
+void
+vdso_init(void) {
+    static_assert(VDSO_BASE == USTACKTOP - USTACKSIZE - VDSO_SIZE);
+    static_assert(VDSO_SIZE == 2 * PGSIZE);
+    static_assert(sizeof(struct vdso_data) <= VDSO_SYSENTER - VDSO_BASE);
+
+    if ((vdso_data_page = alloc_zeroed_page()) == NULL) {
+        panic("vdso_init: no memory for the vdso page.\n");
+    }
+    set_page_ref(vdso_data_page, 1);
+    vdso_data = page2kva(vdso_data_page);
+
+    // the user entry of the fast system calls
+    if (sysenter_enabled) {
+        extern char __vdso_sysenter[], __vdso_sysenter_end[];
+        size_t size = __vdso_sysenter_end - __vdso_sysenter;
+        assert(VDSO_SYSENTER - VDSO_BASE + size <= PGSIZE);
+        memcpy((void *)vdso_data + (VDSO_SYSENTER - VDSO_BASE), __vdso_sysenter, size);
+    }
+}
+
+// vdso_dup - alloc the page of mm, the pid is set by vdso_set_pid
+int
+vdso_dup(struct mm_struct *mm) {
+    struct Page *page;
+    assert(mm->vdso_page == NULL);
+    if ((page = alloc_zeroed_page()) == NULL) {
+        return -E_NO_MEM;
+    }
+    set_page_ref(page, 1);
+    mm->vdso_page = page;
+    return 0;
+}
+
+// vdso_map - map the vdso vma into the new address space mm, called by load_icode
+int
+vdso_map(struct mm_struct *mm) {
+    int ret;
+    if ((ret = mm_map(mm, VDSO_BASE, VDSO_SIZE, VM_READ | VM_EXEC | VM_VDSO, NULL)) != 0) {
+        return ret;
+    }
+    return vdso_dup(mm);
+}
+
+// vdso_set_pid - publish the pid of the process of mm, 0 if mm is shared by threads
+void
+vdso_set_pid(struct mm_struct *mm, int pid) {
+    if (mm->vdso_page != NULL) {
+        ((struct vdso_proc *)page2kva(mm->vdso_page))->pid = pid;
+    }
+}
+
+// vdso_get_page - the page to map at addr of the vdso vma of mm, NULL if there isn't one
+struct Page *
+vdso_get_page(struct mm_struct *mm, uintptr_t addr) {
+    if (addr < VDSO_BASE || addr >= VDSO_BASE + VDSO_SIZE) {
+        return NULL;
+    }
+    return (addr < VDSO_BASE + PGSIZE) ? vdso_data_page : mm->vdso_page;
+}
+
+// vdso_exit - drop the reference of mm to its page, the pages have been unmapped by exit_mmap
+void
+vdso_exit(struct mm_struct *mm) {
+    struct Page *page;
+    if ((page = mm->vdso_page) != NULL) {
+        mm->vdso_page = NULL;
+        if (page_ref_dec(page) == 0) {
+            free_page(page);
+        }
+    }
+}
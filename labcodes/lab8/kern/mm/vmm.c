@@ -8,6 +8,10 @@
 #include <x86.h>
 #include <swap.h>
 #include <kmalloc.h>
+#include <inode.h>
+#include <iobuf.h>
+#include <filemap.h>
+#include <shmem.h>
 
 /* 
   vmm design include two parts: mm_struct (mm) & vma_struct (vma)
@@ -26,35 +30,50 @@
      struct vma_struct * vma_create (uintptr_t vm_start, uintptr_t vm_end,...)
      void insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma)
      struct vma_struct * find_vma(struct mm_struct *mm, uintptr_t addr)
+     struct vma_struct * find_vma_intersection(struct mm_struct *mm, uintptr_t start, uintptr_t end)
+     struct vma_struct * vma_merge(struct mm_struct *mm, struct vma_struct *vma)
    local functions
+     void remove_vma_struct(struct mm_struct *mm, struct vma_struct *vma)
+     void vma_resize(struct vma_struct *vma, uintptr_t start, uintptr_t end)
      inline void check_vma_overlap(struct vma_struct *prev, struct vma_struct *next)
+     inline struct vma_struct * find_vma_rb(rb_tree *tree, uintptr_t addr)
+     inline void insert_vma_rb(rb_tree *tree, struct vma_struct *vma, list_entry_t **le_prev_store)
+   the redblack tree of vma is built when the count of vma reaches RB_MIN_MAP_COUNT,
+   then find_vma & insert_vma_struct cost O(log n) instead of walking the linear list.
 ---------------
    check correctness functions
      void check_vmm(void);
      void check_vma_struct(void);
+     void check_find_vma_perf(void);
      void check_pgfault(void);
 */
 
+static struct kmem_cache *mm_cache, *vma_cache;
+
 static void check_vmm(void);
 static void check_vma_struct(void);
+static void check_find_vma_perf(void);
 static void check_pgfault(void);
 
 // mm_create -  alloc a mm_struct & initialize it.
 struct mm_struct *
 mm_create(void) {
-    struct mm_struct *mm = kmalloc(sizeof(struct mm_struct));
+    struct mm_struct *mm = kmem_cache_alloc(mm_cache);
 
     if (mm != NULL) {
         list_init(&(mm->mmap_list));
+        mm->mmap_tree = NULL;
         mm->mmap_cache = NULL;
         mm->pgdir = NULL;
         mm->map_count = 0;
+        mm->brk_start = mm->brk = 0;
+        mm->vdso_page = NULL;
 
         if (swap_init_ok) swap_init_mm(mm);
         else mm->sm_priv = NULL;
         
         set_mm_count(mm, 0);
-        sem_init(&(mm->mm_sem), 1);
+        mutex_init(&(mm->mm_mutex));
     }    
     return mm;
 }
@@ -62,16 +81,104 @@ mm_create(void) {
 // vma_create - alloc a vma_struct & initialize it. (addr range: vm_start~vm_end)
 struct vma_struct *
 vma_create(uintptr_t vm_start, uintptr_t vm_end, uint32_t vm_flags) {
-    struct vma_struct *vma = kmalloc(sizeof(struct vma_struct));
+    struct vma_struct *vma = kmem_cache_alloc(vma_cache);
 
     if (vma != NULL) {
         vma->vm_start = vm_start;
         vma->vm_end = vm_end;
         vma->vm_flags = vm_flags;
+        vma->vm_file = NULL;
+        vma->vm_fileoff = 0;
+        vma->vm_filesz = 0;
+        vma->vm_shmem = NULL;
+        vma->vm_shmoff = 0;
+    }
+    return vma;
+}
+
+// vma_destroy - drop the backing file of vma (if any) & free vma
+//             - the shared pages of file which are no longer mapped leave the filemap
+static void
+vma_destroy(struct vma_struct *vma) {
+    if (vma->vm_file != NULL) {
+        if (!(vma->vm_flags & VM_WRITE)) {
+            filemap_release(vma->vm_file);
+        }
+        vop_ref_dec(vma->vm_file);
+    }
+    if (vma->vm_shmem != NULL) {
+        shmem_ref_dec(vma->vm_shmem);
+    }
+    kmem_cache_free(vma_cache, vma);
+}
+
+// vma_set_file - make vma a file-backed area, the pages of vma are not loaded here,
+//              - do_pgfault fills them from node (or zero after filesz) on first touch.
+// offset: the file offset which is mapped at vma->vm_start
+// filesz: bytes of file content from vma->vm_start
+void
+vma_set_file(struct vma_struct *vma, struct inode *node, off_t offset, size_t filesz) {
+    assert(vma->vm_file == NULL && node != NULL);
+    vop_ref_inc(node);
+    vma->vm_file = node;
+    vma->vm_fileoff = offset;
+    vma->vm_filesz = filesz;
+}
+
+// vma_set_shmem - make vma an attachment of the shared memory segment, the pages are
+//               - mapped by do_pgfault on first touch.
+// offset: the segment offset which is mapped at vma->vm_start
+void
+vma_set_shmem(struct vma_struct *vma, struct shmem_struct *shmem, size_t offset) {
+    assert(vma->vm_shmem == NULL && (vma->vm_flags & VM_SHARE));
+    assert(offset + (vma->vm_end - vma->vm_start) <= shmem->len);
+    shmem_ref_inc(shmem);
+    vma->vm_shmem = shmem;
+    vma->vm_shmoff = offset;
+}
+
+// vma_compare - compare the vm_start of vma1 & vma2, used by the redblack tree
+static inline int
+vma_compare(rb_node *node1, rb_node *node2) {
+    struct vma_struct *vma1 = rbn2vma(node1, rb_link);
+    struct vma_struct *vma2 = rbn2vma(node2, rb_link);
+    uintptr_t start1 = vma1->vm_start, start2 = vma2->vm_start;
+    return (start1 < start2) ? -1 : (start1 > start2) ? 1 : 0;
+}
+
+// find_vma_rb - find the first vma whose vm_end > addr in the redblack tree
+static inline struct vma_struct *
+find_vma_rb(rb_tree *tree, uintptr_t addr) {
+    rb_node *node = rb_node_root(tree);
+    struct vma_struct *vma = NULL, *tmp;
+    while (node != NULL) {
+        tmp = rbn2vma(node, rb_link);
+        if (tmp->vm_end > addr) {
+            vma = tmp;
+            if (tmp->vm_start <= addr) {
+                break;
+            }
+            node = rb_node_left(tree, node);
+        }
+        else {
+            node = rb_node_right(tree, node);
+        }
     }
     return vma;
 }
 
+// find_vma_list - find the first vma whose vm_end > addr in the linear list
+static inline struct vma_struct *
+find_vma_list(list_entry_t *list, uintptr_t addr) {
+    list_entry_t *le = list;
+    while ((le = list_next(le)) != list) {
+        struct vma_struct *vma = le2vma(le, list_link);
+        if (vma->vm_end > addr) {
+            return vma;
+        }
+    }
+    return NULL;
+}
 
 // find_vma - find a vma  (vma->vm_start <= addr <= vma_vm_end)
 struct vma_struct *
@@ -80,18 +187,15 @@ find_vma(struct mm_struct *mm, uintptr_t addr) {
     if (mm != NULL) {
         vma = mm->mmap_cache;
         if (!(vma != NULL && vma->vm_start <= addr && vma->vm_end > addr)) {
-                bool found = 0;
-                list_entry_t *list = &(mm->mmap_list), *le = list;
-                while ((le = list_next(le)) != list) {
-                    vma = le2vma(le, list_link);
-                    if (vma->vm_start<=addr && addr < vma->vm_end) {
-                        found = 1;
-                        break;
-                    }
-                }
-                if (!found) {
-                    vma = NULL;
-                }
+            if (mm->mmap_tree != NULL) {
+                vma = find_vma_rb(mm->mmap_tree, addr);
+            }
+            else {
+                vma = find_vma_list(&(mm->mmap_list), addr);
+            }
+            if (vma != NULL && vma->vm_start > addr) {
+                vma = NULL;
+            }
         }
         if (vma != NULL) {
             mm->mmap_cache = vma;
@@ -100,6 +204,21 @@ find_vma(struct mm_struct *mm, uintptr_t addr) {
     return vma;
 }
 
+// find_vma_intersection - find the first vma which overlaps [start, end)
+struct vma_struct *
+find_vma_intersection(struct mm_struct *mm, uintptr_t start, uintptr_t end) {
+    struct vma_struct *vma;
+    if (mm->mmap_tree != NULL) {
+        vma = find_vma_rb(mm->mmap_tree, start);
+    }
+    else {
+        vma = find_vma_list(&(mm->mmap_list), start);
+    }
+    if (vma != NULL && end <= vma->vm_start) {
+        vma = NULL;
+    }
+    return vma;
+}
 
 // check_vma_overlap - check if vma1 overlaps vma2 ?
 static inline void
@@ -110,13 +229,29 @@ check_vma_overlap(struct vma_struct *prev, struct vma_struct *next) {
 }
 
 
-// insert_vma_struct -insert vma in mm's list link
+// insert_vma_rb - insert vma in the redblack tree, and find the list link of the vma before it
+static inline void
+insert_vma_rb(rb_tree *tree, struct vma_struct *vma, list_entry_t **le_prev_store) {
+    rb_node *node = &(vma->rb_link), *prev;
+    rb_insert(tree, node);
+    if (le_prev_store != NULL) {
+        if ((prev = rb_node_prev(tree, node)) != NULL) {
+            *le_prev_store = &(rbn2vma(prev, rb_link)->list_link);
+        }
+    }
+}
+
+// insert_vma_struct -insert vma in mm's list link (and redblack tree link)
 void
 insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
     assert(vma->vm_start < vma->vm_end);
     list_entry_t *list = &(mm->mmap_list);
     list_entry_t *le_prev = list, *le_next;
 
+    if (mm->mmap_tree != NULL) {
+        insert_vma_rb(mm->mmap_tree, vma, &le_prev);
+    }
+    else {
         list_entry_t *le = list;
         while ((le = list_next(le)) != list) {
             struct vma_struct *mmap_prev = le2vma(le, list_link);
@@ -125,6 +260,7 @@ insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
             }
             le_prev = le;
         }
+    }
 
     le_next = list_next(le_prev);
 
@@ -140,6 +276,83 @@ insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
     list_add_after(le_prev, &(vma->list_link));
 
     mm->map_count ++;
+    if (mm->mmap_tree == NULL && mm->map_count >= RB_MIN_MAP_COUNT) {
+
+        /* try to build red-black tree now, but may fail. */
+        mm->mmap_tree = rb_tree_create(vma_compare);
+
+        if (mm->mmap_tree != NULL) {
+            list_entry_t *list = &(mm->mmap_list), *le = list;
+            while ((le = list_next(le)) != list) {
+                insert_vma_rb(mm->mmap_tree, le2vma(le, list_link), NULL);
+            }
+        }
+    }
+}
+
+// remove_vma_struct - remove vma from mm's list link (and redblack tree link)
+static void
+remove_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
+    assert(mm == vma->vm_mm);
+    if (mm->mmap_tree != NULL) {
+        rb_delete(mm->mmap_tree, &(vma->rb_link));
+    }
+    list_del(&(vma->list_link));
+    if (vma == mm->mmap_cache) {
+        mm->mmap_cache = NULL;
+    }
+    mm->map_count --;
+}
+
+// vma_resize - shrink vma to [start, end), the file range (or segment offset) of vma follows vm_start
+static void
+vma_resize(struct vma_struct *vma, uintptr_t start, uintptr_t end) {
+    assert(start % PGSIZE == 0 && end % PGSIZE == 0);
+    assert(vma->vm_start <= start && start < end && end <= vma->vm_end);
+    if (vma->vm_file != NULL) {
+        size_t skip = start - vma->vm_start;
+        vma->vm_fileoff += skip;
+        vma->vm_filesz = (vma->vm_filesz > skip) ? vma->vm_filesz - skip : 0;
+        if (vma->vm_filesz > end - start) {
+            vma->vm_filesz = end - start;
+        }
+    }
+    if (vma->vm_shmem != NULL) {
+        vma->vm_shmoff += start - vma->vm_start;
+    }
+    vma->vm_start = start;
+    vma->vm_end = end;
+}
+
+#define vma_anonymous(vma)          ((vma)->vm_file == NULL && (vma)->vm_shmem == NULL && !((vma)->vm_flags & VM_VDSO))
+
+// vma_merge - merge the anonymous vma with its adjacent vmas which have the same flags
+// return value: the merged vma (vma itself or its prev)
+struct vma_struct *
+vma_merge(struct mm_struct *mm, struct vma_struct *vma) {
+    list_entry_t *le;
+    struct vma_struct *prev, *next;
+    if (!vma_anonymous(vma)) {
+        return vma;
+    }
+    if ((le = list_prev(&(vma->list_link))) != &(mm->mmap_list)) {
+        prev = le2vma(le, list_link);
+        if (vma_anonymous(prev) && prev->vm_flags == vma->vm_flags && prev->vm_end == vma->vm_start) {
+            prev->vm_end = vma->vm_end;
+            remove_vma_struct(mm, vma);
+            vma_destroy(vma);
+            vma = prev;
+        }
+    }
+    if ((le = list_next(&(vma->list_link))) != &(mm->mmap_list)) {
+        next = le2vma(le, list_link);
+        if (vma_anonymous(next) && next->vm_flags == vma->vm_flags && vma->vm_end == next->vm_start) {
+            vma->vm_end = next->vm_end;
+            remove_vma_struct(mm, next);
+            vma_destroy(next);
+        }
+    }
+    return vma;
 }
 
 // mm_destroy - free mm and mm internal fields
@@ -150,9 +363,16 @@ mm_destroy(struct mm_struct *mm) {
     list_entry_t *list = &(mm->mmap_list), *le;
     while ((le = list_next(list)) != list) {
         list_del(le);
-        kfree(le2vma(le, list_link));  //kfree vma        
+        vma_destroy(le2vma(le, list_link));  //kfree vma        
+    }
+    if (mm->mmap_tree != NULL) {
+        rb_tree_destroy(mm->mmap_tree);
     }
-    kfree(mm); //kfree mm
+    if (mm->sm_priv != NULL) {
+        swap_exit_mm(mm);
+    }
+    vdso_exit(mm);
+    kmem_cache_free(mm_cache, mm); //kfree mm
     mm=NULL;
 }
 
@@ -169,7 +389,7 @@ mm_map(struct mm_struct *mm, uintptr_t addr, size_t len, uint32_t vm_flags,
     int ret = -E_INVAL;
 
     struct vma_struct *vma;
-    if ((vma = find_vma(mm, start)) != NULL && end > vma->vm_start) {
+    if (find_vma_intersection(mm, start, end) != NULL) {
         goto out;
     }
     ret = -E_NO_MEM;
@@ -187,9 +407,112 @@ out:
     return ret;
 }
 
+// mm_unmap - remove the vmas in [addr, addr + len), the vmas across the boundaries are split.
+//          - the pages are freed, so are the page tables which only cover the removed range
+int
+mm_unmap(struct mm_struct *mm, uintptr_t addr, size_t len) {
+    uintptr_t start = ROUNDDOWN(addr, PGSIZE), end = ROUNDUP(addr + len, PGSIZE);
+    if (!USER_ACCESS(start, end)) {
+        return -E_INVAL;
+    }
+
+    assert(mm != NULL);
+
+    struct vma_struct *vma, *nvma;
+    if ((vma = find_vma_intersection(mm, start, end)) == NULL) {
+        return 0;
+    }
+
+    // split the vma which covers [start, end) in the middle
+    if (vma->vm_start < start && end < vma->vm_end) {
+        if ((nvma = vma_create(vma->vm_start, start, vma->vm_flags)) == NULL) {
+            return -E_NO_MEM;
+        }
+        if (vma->vm_file != NULL) {
+            vma_set_file(nvma, vma->vm_file, vma->vm_fileoff, vma->vm_filesz);
+            vma_resize(nvma, nvma->vm_start, nvma->vm_end);
+        }
+        if (vma->vm_shmem != NULL) {
+            vma_set_shmem(nvma, vma->vm_shmem, vma->vm_shmoff);
+        }
+        vma_resize(vma, end, vma->vm_end);
+        insert_vma_struct(mm, nvma);
+        unmap_range(mm->pgdir, start, end);
+        goto free_pt;
+    }
+
+    list_entry_t free_list, *le;
+    list_init(&free_list);
+    while (vma->vm_start < end) {
+        le = list_next(&(vma->list_link));
+        remove_vma_struct(mm, vma);
+        list_add(&free_list, &(vma->list_link));
+        if (le == &(mm->mmap_list)) {
+            break;
+        }
+        vma = le2vma(le, list_link);
+    }
+
+    le = list_next(&free_list);
+    while (le != &free_list) {
+        vma = le2vma(le, list_link);
+        le = list_next(le);
+        uintptr_t un_start, un_end;
+        if (vma->vm_start < start) {
+            un_start = start, un_end = vma->vm_end;
+            vma_resize(vma, vma->vm_start, un_start);
+            insert_vma_struct(mm, vma);
+        }
+        else {
+            un_start = vma->vm_start, un_end = vma->vm_end;
+            if (end < un_end) {
+                un_end = end;
+                vma_resize(vma, un_end, vma->vm_end);
+                insert_vma_struct(mm, vma);
+            }
+            else {
+                // unmap the pages first, so the filemap can release the pages of vma
+                unmap_range(mm->pgdir, un_start, un_end);
+                vma_destroy(vma);
+                continue ;
+            }
+        }
+        unmap_range(mm->pgdir, un_start, un_end);
+    }
+
+free_pt:
+    // no vma is left in [start, end), free the page tables inside it
+    uintptr_t pt_start = ROUNDUP(start, PTSIZE), pt_end = ROUNDDOWN(end, PTSIZE);
+    if (pt_start < pt_end) {
+        exit_range(mm->pgdir, pt_start, pt_end);
+    }
+    return 0;
+}
+
+// swap_map_range - make the pages of [start, end) in mm swappable, they are copied by copy_range
+static void
+swap_map_range(struct mm_struct *mm, uintptr_t start, uintptr_t end) {
+    if (!swap_init_ok) {
+        return ;
+    }
+    while (start < end) {
+        pte_t *ptep = get_pte(mm->pgdir, start, 0);
+        if (ptep == NULL || (*ptep & PTE_PS)) {
+            start = ROUNDDOWN(start + PTSIZE, PTSIZE);
+            continue ;
+        }
+        if (*ptep & PTE_P) {
+            swap_map_swappable(mm, start, pte2page(*ptep), 0);
+        }
+        start += PGSIZE;
+    }
+}
+
 int
 dup_mmap(struct mm_struct *to, struct mm_struct *from) {
     assert(to != NULL && from != NULL);
+    to->brk_start = from->brk_start;
+    to->brk = from->brk;
     list_entry_t *list = &(from->mmap_list), *le = list;
     while ((le = list_prev(le)) != list) {
         struct vma_struct *vma, *nvma;
@@ -200,11 +523,31 @@ dup_mmap(struct mm_struct *to, struct mm_struct *from) {
         }
 
         insert_vma_struct(to, nvma);
+        if (vma->vm_file != NULL) {
+            vma_set_file(nvma, vma->vm_file, vma->vm_fileoff, vma->vm_filesz);
+            // the read-only pages are in filemap, the child maps them on demand
+            if (!(vma->vm_flags & VM_WRITE)) {
+                continue ;
+            }
+        }
+        // the child attaches the same segment, and maps its pages on demand
+        if (vma->vm_shmem != NULL) {
+            vma_set_shmem(nvma, vma->vm_shmem, vma->vm_shmoff);
+            continue ;
+        }
+        // the child has a vdso page of its own, do_fork sets the pid in it
+        if (vma->vm_flags & VM_VDSO) {
+            if (to->vdso_page == NULL && vdso_dup(to) != 0) {
+                return -E_NO_MEM;
+            }
+            continue ;
+        }
 
         bool share = 0;
         if (copy_range(to->pgdir, from->pgdir, vma->vm_start, vma->vm_end, share) != 0) {
             return -E_NO_MEM;
         }
+        swap_map_range(to, vma->vm_start, vma->vm_end);
     }
     return 0;
 }
@@ -224,6 +567,52 @@ exit_mmap(struct mm_struct *mm) {
     }
 }
 
+// get_unmapped_area - find a free range of len bytes in mm, searching down from USERTOP
+// return value: the start of the range, 0 if there is no such range
+uintptr_t
+get_unmapped_area(struct mm_struct *mm, size_t len) {
+    if (len == 0 || len > USERTOP) {
+        return 0;
+    }
+    uintptr_t start = USERTOP - len;
+    list_entry_t *list = &(mm->mmap_list), *le = list;
+    while ((le = list_prev(le)) != list) {
+        struct vma_struct *vma = le2vma(le, list_link);
+        if (start >= vma->vm_end) {
+            return start;
+        }
+        if (start + len > vma->vm_start) {
+            if (len >= vma->vm_start) {
+                return 0;
+            }
+            start = vma->vm_start - len;
+        }
+    }
+    return (start >= UTEXT) ? start : 0;
+}
+
+// mm_brk - map [addr, addr + len) as anonymous read/write memory of the heap,
+//        - the new range is merged with the heap vma below it
+int
+mm_brk(struct mm_struct *mm, uintptr_t addr, size_t len) {
+    uintptr_t start = ROUNDDOWN(addr, PGSIZE), end = ROUNDUP(addr + len, PGSIZE);
+    if (!USER_ACCESS(start, end)) {
+        return -E_INVAL;
+    }
+
+    int ret;
+    if ((ret = mm_unmap(mm, start, end - start)) != 0) {
+        return ret;
+    }
+    struct vma_struct *vma;
+    if ((vma = vma_create(start, end, VM_READ | VM_WRITE)) == NULL) {
+        return -E_NO_MEM;
+    }
+    insert_vma_struct(mm, vma);
+    vma_merge(mm, vma);
+    return 0;
+}
+
 bool
 copy_from_user(struct mm_struct *mm, void *dst, const void *src, size_t len, bool writable) {
     if (!user_mem_check(mm, (uintptr_t)src, len, writable)) {
@@ -243,9 +632,16 @@ copy_to_user(struct mm_struct *mm, void *dst, const void *src, size_t len) {
 }
 
 // vmm_init - initialize virtual memory management
-//          - now just call check_vmm to check correctness of vmm
+//          - init the executable page cache, shared memory & vdso, then call check_vmm to check correctness of vmm
 void
 vmm_init(void) {
+    if ((mm_cache = kmem_cache_create("mm_struct", sizeof(struct mm_struct))) == NULL
+        || (vma_cache = kmem_cache_create("vma_struct", sizeof(struct vma_struct))) == NULL) {
+        panic("vmm_init: create caches failed.\n");
+    }
+    filemap_init();
+    shmem_init();
+    vdso_init();
     check_vmm();
 }
 
@@ -254,6 +650,7 @@ static void
 check_vmm(void) {
     size_t nr_free_pages_store = nr_free_pages();
     
+    check_rb_tree();
     check_vma_struct();
     check_pgfault();
 
@@ -315,11 +712,66 @@ check_vma_struct(void) {
         assert(vma_below_5 == NULL);
     }
 
+    // [i+2, i+5) is a hole between two vmas, [i+2, i+6) overlaps the next one
+    for (i = 5; i < 5 * step2; i += 5) {
+        assert(find_vma_intersection(mm, i + 2, i + 5) == NULL);
+        struct vma_struct *vma = find_vma_intersection(mm, i + 2, i + 6);
+        assert(vma != NULL && vma->vm_start == i + 5);
+    }
+
+    assert(mm->mmap_tree != NULL);
+
     mm_destroy(mm);
 
+    check_find_vma_perf();
+
     cprintf("check_vma_struct() succeeded!\n");
 }
 
+// check_find_vma_perf - microbenchmark of find_vma, the redblack tree vs the linear list
+static void
+check_find_vma_perf(void) {
+    struct mm_struct *mm = mm_create();
+    assert(mm != NULL);
+
+    int nr_vma = 1024, rounds = 4, i, j;
+    for (i = 0; i < nr_vma; i ++) {
+        struct vma_struct *vma = vma_create(i * 2 * PGSIZE, i * 2 * PGSIZE + PGSIZE, 0);
+        assert(vma != NULL);
+        insert_vma_struct(mm, vma);
+    }
+
+    rb_tree *tree = mm->mmap_tree;
+    assert(tree != NULL);
+
+    uint64_t start;
+    uint32_t tree_cycles, list_cycles;
+
+    start = read_tsc();
+    for (j = 0; j < rounds; j ++) {
+        for (i = 0; i < nr_vma; i ++) {
+            assert(find_vma(mm, (i * 7 % nr_vma) * 2 * PGSIZE) != NULL);
+        }
+    }
+    tree_cycles = read_tsc() - start;
+
+    // the same lookups by walking the linear list
+    mm->mmap_tree = NULL;
+    start = read_tsc();
+    for (j = 0; j < rounds; j ++) {
+        for (i = 0; i < nr_vma; i ++) {
+            assert(find_vma(mm, (i * 7 % nr_vma) * 2 * PGSIZE) != NULL);
+        }
+    }
+    list_cycles = read_tsc() - start;
+    mm->mmap_tree = tree;
+
+    mm_destroy(mm);
+
+    cprintf("find_vma: %d vmas, %u cycles per lookup with rb_tree, %u with list\n",
+            nr_vma, tree_cycles / (rounds * nr_vma), list_cycles / (rounds * nr_vma));
+}
+
 struct mm_struct *check_mm_struct;
 
 // check_pgfault - check correctness of pgfault handler
@@ -367,6 +819,117 @@ check_pgfault(void) {
 //page fault number
 volatile unsigned int pgfault_num=0;
 
+/* do_anonpage - alloc a zero-filled page for the anonymous memory at la and map it,
+ *               it replaces the shared zero page if the zero page is mapped at la.
+ * The page is cleared before page_insert, so the other users of mm never see stale data.
+ */
+static int
+do_anonpage(struct mm_struct *mm, uintptr_t la, uint32_t perm) {
+    struct Page *page;
+    if ((page = alloc_zeroed_page()) == NULL) {
+        return -E_NO_MEM;
+    }
+    if (page_insert(mm->pgdir, page, la, perm) != 0) {
+        free_page(page);
+        return -E_NO_MEM;
+    }
+    if (swap_init_ok) {
+        swap_map_swappable(mm, la, page, 0);
+    }
+    return 0;
+}
+
+/* do_largepage - map a zero-filled 4M large page for the anonymous VM_LARGE vma at la.
+ * The large page is used only if the 4M aligned range around la lies in the vma and has no
+ * PT yet, otherwise -E_INVAL is returned and the fault is handled with 4K pages.
+ * Large pages are never swapped out.
+ */
+static int
+do_largepage(struct mm_struct *mm, struct vma_struct *vma, uintptr_t la, uint32_t perm) {
+    la = ROUNDDOWN(la, PTSIZE);
+    if (!pse_enabled || !(vma->vm_flags & VM_LARGE) || vma->vm_file != NULL) {
+        return -E_INVAL;
+    }
+    if (la < vma->vm_start || la + PTSIZE > vma->vm_end || mm->pgdir[PDX(la)] != 0) {
+        return -E_INVAL;
+    }
+    struct Page *base;
+    if ((base = alloc_large_page()) == NULL) {
+        return -E_NO_MEM;
+    }
+    memset(page2kva(base), 0, PTSIZE);
+    set_page_ref(base, 1);
+    mm->pgdir[PDX(la)] = page2pa(base) | PTE_P | PTE_PS | perm;
+    tlb_invalidate(mm->pgdir, la);
+    return 0;
+}
+
+/* do_filepage - map the page at la of the file-backed vma, the page is filled with the file
+ *               content (or zero after vm_filesz).
+ * The pages of read-only vmas (TEXT) are shared through the executable page cache (filemap),
+ * so the processes running the same binary use one copy of the code. The pages of writable
+ * vmas (DATA/BSS) are private.
+ * The page is filled before page_insert, so the other users of mm never see a half-loaded page.
+ * The pages past the file content (BSS) are anonymous memory: the zero page on read, or a
+ * private zero-filled page on write.
+ */
+static int
+do_filepage(struct mm_struct *mm, struct vma_struct *vma, uintptr_t la, uint32_t perm, bool write) {
+    size_t off = la - vma->vm_start, size = 0, copied = 0;
+    if (off < vma->vm_filesz) {
+        if ((size = vma->vm_filesz - off) > PGSIZE) {
+            size = PGSIZE;
+        }
+    }
+    if (size == 0) {
+        if (!write) {
+            return page_insert(mm->pgdir, zero_page, la, perm & ~PTE_W);
+        }
+        return do_anonpage(mm, la, perm);
+    }
+    bool shared = !(vma->vm_flags & VM_WRITE);
+    struct Page *page, *cached;
+    if (shared && (page = filemap_lookup(vma->vm_file, vma->vm_fileoff + off, size)) != NULL) {
+        return page_insert(mm->pgdir, page, la, perm);
+    }
+
+    if ((page = alloc_page()) == NULL) {
+        return -E_NO_MEM;
+    }
+    void *kva = page2kva(page);
+    int ret;
+    if (size != 0) {
+        struct iobuf __iob, *iob = iobuf_init(&__iob, kva, size, vma->vm_fileoff + off);
+        if ((ret = vop_read(vma->vm_file, iob)) != 0) {
+            goto failed_free_page;
+        }
+        copied = iobuf_used(iob);
+    }
+    memset(kva + copied, 0, PGSIZE - copied);
+    // a short read (the file is truncated) gives a private page, which never enters the cache
+    if (shared && copied == size) {
+        if ((cached = filemap_add(vma->vm_file, vma->vm_fileoff + off, size, page)) != NULL && cached != page) {
+            free_page(page);
+            page = cached;
+        }
+    }
+    if ((ret = page_insert(mm->pgdir, page, la, perm)) != 0) {
+        if (page_ref(page) == 0) {
+            goto failed_free_page;
+        }
+        return ret;
+    }
+    // a private page is anonymous memory now, which can be swapped out
+    if (!shared && swap_init_ok) {
+        swap_map_swappable(mm, la, page, 0);
+    }
+    return 0;
+
+failed_free_page:
+    free_page(page);
+    return ret;
+}
+
 /* do_pgfault - interrupt handler to process the page fault execption
  * @mm         : the control struct for a set of vma using the same PDT
  * @error_code : the error code recorded in trapframe->tf_err which is setted by x86 hardware
@@ -387,6 +950,7 @@ volatile unsigned int pgfault_num=0;
  *            was a read (0) or write (1).
  *         -- The U/S flag (bit 2) indicates whether the processor was executing at user mode (1)
  *            or supervisor mode (0) at the time of the exception.
+ * The faults on the mm of a process are handled under lock_mm(mm), see pgfault_handler.
  */
 int
 do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
@@ -434,66 +998,97 @@ do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
     ret = -E_NO_MEM;
 
     pte_t *ptep=NULL;
-    /*LAB3 EXERCISE 1: YOUR CODE
-    * Maybe you want help comment, BELOW comments can help you finish the code
-    *
-    * Some Useful MACROs and DEFINEs, you can use them in below implementation.
-    * MACROs or Functions:
-    *   get_pte : get an pte and return the kernel virtual address of this pte for la
-    *             if the PT contians this pte didn't exist, alloc a page for PT (notice the 3th parameter '1')
-    *   pgdir_alloc_page : call alloc_page & page_insert functions to allocate a page size memory & setup
-    *             an addr map pa<--->la with linear address la and the PDT pgdir
-    * DEFINES:
-    *   VM_WRITE  : If vma->vm_flags & VM_WRITE == 1/0, then the vma is writable/non writable
-    *   PTE_W           0x002                   // page table/directory entry flags bit : Writeable
-    *   PTE_U           0x004                   // page table/directory entry flags bit : User can access
-    * VARIABLES:
-    *   mm->pgdir : the PDT of these vma
-    *
-    */
-#if 0
-    /*LAB3 EXERCISE 1: YOUR CODE*/
-    ptep = ???              //(1) try to find a pte, if pte's PT(Page Table) isn't existed, then create a PT.
-    if (*ptep == 0) {
-                            //(2) if the phy addr isn't exist, then alloc a page & map the phy addr with logical addr
+    // the anonymous vma prefers large pages, fall back to 4K pages if no large page fits here
+    if (do_largepage(mm, vma, addr, perm) == 0) {
+        return 0;
+    }
+    // try to find a pte, if pte's PT(Page Table) isn't existed, then create a PT.
+    // (notice the 3th parameter '1')
+    if ((ptep = get_pte(mm->pgdir, addr, 1)) == NULL) {
+        cprintf("get_pte in do_pgfault failed\n");
+        goto failed;
+    }
+    // the page is mapped meanwhile, while the fault waited for lock_mm (the swap out
+    // gives a write-protected page back if the disk write fails), retry the access
+    if ((*ptep & PTE_P) && ((*ptep & PTE_W) || !(error_code & 2))) {
+        return 0;
+    }
 
+    if (*ptep == 0) { // if the phy addr isn't exist, then alloc a page & map the phy addr with logical addr
+        if (vma->vm_flags & VM_VDSO) {
+            // the vdso pages are always there, the user can only read them
+            struct Page *page = vdso_get_page(mm, addr);
+            if (page == NULL || (ret = page_insert(mm->pgdir, page, addr, perm & ~PTE_W)) != 0) {
+                cprintf("vdso page in do_pgfault failed\n");
+                goto failed;
+            }
+        }
+        else if (vma->vm_shmem != NULL) {
+            // map the page of the shared memory segment, the segment allocates it on first touch
+            struct Page *page = shmem_get_page(vma->vm_shmem, (addr - vma->vm_start + vma->vm_shmoff) / PGSIZE);
+            if (page == NULL || (ret = page_insert(mm->pgdir, page, addr, perm)) != 0) {
+                ret = -E_NO_MEM;
+                cprintf("shmem page in do_pgfault failed\n");
+                goto failed;
+            }
+        }
+        else if (vma->vm_file != NULL) {
+            // demand paging for file-backed vma (TEXT/DATA/BSS of an executable)
+            if ((ret = do_filepage(mm, vma, addr, perm, error_code & 2)) != 0) {
+                cprintf("do_filepage in do_pgfault failed: %e\n", ret);
+                goto failed;
+            }
+        }
+        else if (!(error_code & 2)) {
+            // read an untouched anonymous page, map the zero page read-only until the first write
+            if ((ret = page_insert(mm->pgdir, zero_page, addr, perm & ~PTE_W)) != 0) {
+                cprintf("page_insert zero page in do_pgfault failed\n");
+                goto failed;
+            }
+        }
+        else if ((ret = do_anonpage(mm, addr, perm)) != 0) {
+            cprintf("do_anonpage in do_pgfault failed\n");
+            goto failed;
+        }
+    }
+    else if ((*ptep & PTE_P) && pte2page(*ptep) == zero_page) {
+        // the first write to a page which was read before, replace the zero page by a private one
+        if ((ret = do_anonpage(mm, addr, perm)) != 0) {
+            cprintf("do_anonpage in do_pgfault failed\n");
+            goto failed;
+        }
     }
     else {
-    /*LAB3 EXERCISE 2: YOUR CODE
-    * Now we think this pte is a  swap entry, we should load data from disk to a page with phy addr,
-    * and map the phy addr with logical addr, trigger swap manager to record the access situation of this page.
-    *
-    *  Some Useful MACROs and DEFINEs, you can use them in below implementation.
-    *  MACROs or Functions:
-    *    swap_in(mm, addr, &page) : alloc a memory page, then according to the swap entry in PTE for addr,
-    *                               find the addr of disk page, read the content of disk page into this memroy page
-    *    page_insert ： build the map of phy addr of an Page with the linear addr la
-    *    swap_map_swappable ： set the page swappable
-    */
-    /*
-     * LAB5 CHALLENGE ( the implmentation Copy on Write)
-		There are 2 situlations when code comes here.
-		  1) *ptep & PTE_P == 1, it means one process try to write a readonly page. 
-		     If the vma includes this addr is writable, then we can set the page writable by rewrite the *ptep.
-		     This method could be used to implement the Copy on Write (COW) thchnology(a fast fork process method).
-		  2) *ptep & PTE_P == 0 & but *ptep!=0, it means this pte is a  swap entry.
-		     We should add the LAB3's results here.
-     */
-        if(swap_init_ok) {
-            struct Page *page=NULL;
-                                    //(1）According to the mm AND addr, try to load the content of right disk page
-                                    //    into the memory which page managed.
-                                    //(2) According to the mm, addr AND page, setup the map of phy addr <---> logical addr
-                                    //(3) make the page swappable.
-                                    //(4) [NOTICE]: you myabe need to update your lab3's implementation for LAB5's normal execution.
+        struct Page *page=NULL;
+        if (*ptep & PTE_P) {
+            // a write to a present read-only page of a writable vma: there is no copy on write,
+            // the fault is a bad access
+            cprintf("do_pgfault failed: write a non-writable pte %x\n", *ptep);
+            ret = -E_INVAL;
+            goto failed;
         }
         else {
-            cprintf("no swap_init_ok but ptep is %x, failed\n",*ptep);
+            // if this pte is a swap entry, then load data from disk to a page with phy addr
+            // and call page_insert to map the phy addr with logical addr
+            if (swap_init_ok) {
+                if ((ret = swap_in(mm, addr, &page)) != 0) {
+                    cprintf("swap_in in do_pgfault failed\n");
+                    goto failed;
+                }
+            }
+            else {
+                cprintf("no swap_init_ok but ptep is %x, failed\n",*ptep);
+                goto failed;
+            }
+        }
+        // page_insert drops the swap entry in the pte
+        if ((ret = page_insert(mm->pgdir, page, addr, perm)) != 0) {
+            free_page(page);
             goto failed;
         }
-   }
-#endif
-   ret = 0;
+        swap_map_swappable(mm, addr, page, 1);
+    }
+    ret = 0;
 failed:
     return ret;
 }
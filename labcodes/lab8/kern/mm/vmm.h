@@ -3,13 +3,18 @@
 
 #include <defs.h>
 #include <list.h>
+#include <rb_tree.h>
 #include <memlayout.h>
 #include <sync.h>
 #include <proc.h>
-#include <sem.h>
+#include <mutex.h>
 
 //pre define
 struct mm_struct;
+struct inode;
+struct shmem_struct;
+struct vdso_data;
+struct Page;
 
 // the virtual continuous memory area(vma), [vm_start, vm_end), 
 // addr belong to a vma means  vma.vm_start<= addr <vma.vm_end 
@@ -19,32 +24,57 @@ struct vma_struct {
     uintptr_t vm_end;        // end addr of vma, not include the vm_end itself
     uint32_t vm_flags;       // flags of vma
     list_entry_t list_link;  // linear list link which sorted by start addr of vma
+    rb_node rb_link;         // redblack tree link which sorted by start addr of vma
+    struct inode *vm_file;   // the backing file of vma, NULL for an anonymous vma
+    off_t vm_fileoff;        // the file offset which is mapped at vm_start
+    size_t vm_filesz;        // bytes of file content from vm_start, the rest of vma is zero-filled
+    struct shmem_struct *vm_shmem; // the shared memory segment of a VM_SHARE vma
+    size_t vm_shmoff;        // the segment offset which is mapped at vm_start
 };
 
 #define le2vma(le, member)                  \
     to_struct((le), struct vma_struct, member)
 
+#define rbn2vma(node, member)               \
+    to_struct((node), struct vma_struct, member)
+
 #define VM_READ                 0x00000001
 #define VM_WRITE                0x00000002
 #define VM_EXEC                 0x00000004
 #define VM_STACK                0x00000008
+#define VM_LARGE                0x00000010      // anonymous memory, map with 4M large pages if possible
+#define VM_SHARE                0x00000020      // shared memory segment (vm_shmem)
+#define VM_VDSO                 0x00000040      // the vdso pages at VDSO_BASE, see vdso.c
+
+#define RB_MIN_MAP_COUNT        32 // If the count of vma >32 then redblack tree link is used
 
 // the control struct for a set of vma using the same PDT
 struct mm_struct {
     list_entry_t mmap_list;        // linear list link which sorted by start addr of vma
+    rb_tree *mmap_tree;            // redblack tree link which sorted by start addr of vma
     struct vma_struct *mmap_cache; // current accessed vma, used for speed purpose
     pde_t *pgdir;                  // the PDT of these vma
     int map_count;                 // the count of these vma
+    uintptr_t brk_start, brk;      // the heap [brk_start, brk) after the data of program, grows by brk
     void *sm_priv;                 // the private data for swap manager
+    list_entry_t swap_link;        // the link in the list of mm_structs which swap_reclaim scans
     int mm_count;                  // the number ofprocess which shared the mm
-    semaphore_t mm_sem;            // mutex for using dup_mmap fun to duplicat the mm 
+    mutex_t mm_mutex;              // mutex for using dup_mmap fun to duplicat the mm
     int locked_by;                 // the lock owner process's pid
+    struct Page *vdso_page;        // the vdso page of this mm (struct vdso_proc)
 
 };
 
+#define le2mm(le, member)                   \
+    to_struct((le), struct mm_struct, member)
+
 struct vma_struct *find_vma(struct mm_struct *mm, uintptr_t addr);
+struct vma_struct *find_vma_intersection(struct mm_struct *mm, uintptr_t start, uintptr_t end);
 struct vma_struct *vma_create(uintptr_t vm_start, uintptr_t vm_end, uint32_t vm_flags);
 void insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma);
+void vma_set_file(struct vma_struct *vma, struct inode *node, off_t offset, size_t filesz);
+void vma_set_shmem(struct vma_struct *vma, struct shmem_struct *shmem, size_t offset);
+struct vma_struct *vma_merge(struct mm_struct *mm, struct vma_struct *vma);
 
 struct mm_struct *mm_create(void);
 void mm_destroy(struct mm_struct *mm);
@@ -60,6 +90,15 @@ void exit_mmap(struct mm_struct *mm);
 uintptr_t get_unmapped_area(struct mm_struct *mm, size_t len);
 int mm_brk(struct mm_struct *mm, uintptr_t addr, size_t len);
 
+extern struct vdso_data *vdso_data;
+
+void vdso_init(void);
+int vdso_map(struct mm_struct *mm);
+int vdso_dup(struct mm_struct *mm);
+void vdso_set_pid(struct mm_struct *mm, int pid);
+struct Page *vdso_get_page(struct mm_struct *mm, uintptr_t addr);
+void vdso_exit(struct mm_struct *mm);
+
 extern volatile unsigned int pgfault_num;
 extern struct mm_struct *check_mm_struct;
 
@@ -93,18 +132,31 @@ mm_count_dec(struct mm_struct *mm) {
 static inline void
 lock_mm(struct mm_struct *mm) {
     if (mm != NULL) {
-        down(&(mm->mm_sem));
+        mutex_lock(&(mm->mm_mutex));
+        if (current != NULL) {
+            mm->locked_by = current->pid;
+        }
+    }
+}
+
+static inline bool
+try_lock_mm(struct mm_struct *mm) {
+    if (mm != NULL) {
+        if (!mutex_trylock(&(mm->mm_mutex))) {
+            return 0;
+        }
         if (current != NULL) {
             mm->locked_by = current->pid;
         }
     }
+    return 1;
 }
 
 static inline void
 unlock_mm(struct mm_struct *mm) {
     if (mm != NULL) {
-        up(&(mm->mm_sem));
         mm->locked_by = 0;
+        mutex_unlock(&(mm->mm_mutex));
     }
 }
 
@@ -15,6 +15,13 @@
 #include <fs.h>
 #include <vfs.h>
 #include <sysfile.h>
+#include <file.h>
+#include <shmem.h>
+#include <swap.h>
+#include <spinlock.h>
+#include <mutex.h>
+#include <clock.h>
+#include <time.h>
 
 /* ------------- process/thread mechanism design&implementation -------------
 (an simplified Linux process/thread mechanism )
@@ -72,15 +79,13 @@ list_entry_t proc_list;
 // has list for process set based on pid
 static list_entry_t hash_list[HASH_LIST_SIZE];
 
-// idle proc
-struct proc_struct *idleproc = NULL;
 // init proc
 struct proc_struct *initproc = NULL;
-// current proc
-struct proc_struct *current = NULL;
 
 static int nr_process = 0;
 
+static struct kmem_cache *proc_cache;
+
 void kernel_thread_entry(void);
 void forkrets(struct trapframe *tf);
 void switch_to(struct context *from, struct context *to);
@@ -88,7 +93,7 @@ void switch_to(struct context *from, struct context *to);
 // alloc_proc - alloc a proc_struct and init all fields of proc_struct
 static struct proc_struct *
 alloc_proc(void) {
-    struct proc_struct *proc = kmalloc(sizeof(struct proc_struct));
+    struct proc_struct *proc = kmem_cache_alloc(proc_cache);
     if (proc != NULL) {
     //LAB4:EXERCISE1 YOUR CODE
     /*
@@ -123,6 +128,35 @@ alloc_proc(void) {
      *     uint32_t lab6_priority;                     // FOR LAB6 ONLY: the priority of process, set by lab6_set_priority(uint32_t)
      */
     //LAB8:EXERCISE2 YOUR CODE HINT:need add some code to init fs in proc_struct, ...
+        proc->state = PROC_UNINIT;
+        proc->pid = -1;
+        proc->runs = 0;
+        proc->kstack = 0;
+        proc->need_resched = 0;
+        proc->parent = NULL;
+        proc->mm = NULL;
+        memset(&(proc->context), 0, sizeof(struct context));
+        proc->tf = NULL;
+        proc->cr3 = boot_cr3;
+        proc->flags = 0;
+        memset(proc->name, 0, PROC_NAME_LEN);
+        proc->wait_state = 0;
+        proc->cptr = proc->optr = proc->yptr = NULL;
+        proc->rq = NULL;
+        list_init(&(proc->run_link));
+        proc->time_slice = 0;
+        proc->lab6_run_pool.left = proc->lab6_run_pool.right = proc->lab6_run_pool.parent = NULL;
+        proc->lab6_stride = 0;
+        proc->lab6_priority = 0;
+        proc->pi_priority = 0;
+        list_init(&(proc->mutex_list));
+        proc->mutex_wait = NULL;
+        proc->cfs_vruntime = proc->cfs_exec_start = proc->cfs_slice_start = 0;
+        proc->cfs_weight = 0;
+        proc->mlfq_level = proc->mlfq_allot = 0;
+        proc->filesp = NULL;
+        proc->tls = 0;
+        proc->preempt_count = 0;
     }
     return proc;
 }
@@ -216,7 +250,12 @@ proc_run(struct proc_struct *proc) {
         {
             current = proc;
             load_esp0(next->kstack + KSTACKSIZE);
-            lcr3(next->cr3);
+            load_tls(next->tls);
+            // a kernel thread uses only the kernel mappings, which are the same in every PDT,
+            // so it keeps the PDT of prev loaded (lazy TLB), and switching back costs no flush
+            if (next->mm != NULL && next->cr3 != rcr3()) {
+                load_cr3(next->cr3);
+            }
             switch_to(&(prev->context), &(next->context));
         }
         local_intr_restore(intr_flag);
@@ -228,6 +267,10 @@ proc_run(struct proc_struct *proc) {
 //       after switch_to, the current proc will execute here.
 static void
 forkret(void) {
+    // a new process going to user mode gives up the kernel lock, as trap does
+    if (!trap_in_kernel(current->tf)) {
+        unlock_kernel();
+    }
     forkrets(current->tf);
 }
 
@@ -294,11 +337,12 @@ put_kstack(struct proc_struct *proc) {
 static int
 setup_pgdir(struct mm_struct *mm) {
     struct Page *page;
-    if ((page = alloc_page()) == NULL) {
+    if ((page = alloc_zeroed_page()) == NULL) {
         return -E_NO_MEM;
     }
+    // the user part of a zero-filled PDT is empty already, only the kernel part is copied
     pde_t *pgdir = page2kva(page);
-    memcpy(pgdir, boot_pgdir, PGSIZE);
+    memcpy(pgdir + PDX(KERNBASE), boot_pgdir + PDX(KERNBASE), PGSIZE - PDX(KERNBASE) * sizeof(pde_t));
     pgdir[PDX(VPT)] = PADDR(pgdir) | PTE_P | PTE_W;
     mm->pgdir = pgdir;
     return 0;
@@ -307,9 +351,28 @@ setup_pgdir(struct mm_struct *mm) {
 // put_pgdir - free the memory space of PDT
 static void
 put_pgdir(struct mm_struct *mm) {
+    // another cpu may have it loaded still, by a kernel thread run after the last process on mm
+    if (ismp) {
+        tlb_release(mm->pgdir);
+    }
     free_page(kva2page(mm->pgdir));
 }
 
+// put_mm - free the memory space of mm, which no process uses any more. swap_reclaim may be
+//          swapping out mm and sleep in the disk io, so mm is taken off the swap list and
+//          torn down under lock_mm
+static void
+put_mm(struct mm_struct *mm) {
+    lock_mm(mm);
+    if (mm->sm_priv != NULL) {
+        swap_exit_mm(mm);
+    }
+    exit_mmap(mm);
+    put_pgdir(mm);
+    unlock_mm(mm);
+    mm_destroy(mm);
+}
+
 // copy_mm - process "proc" duplicate OR share process "current"'s mm according clone_flags
 //         - if clone_flags & CLONE_VM, then "share" ; else "duplicate"
 static int
@@ -349,8 +412,8 @@ good_mm:
     proc->cr3 = PADDR(mm->pgdir);
     return 0;
 bad_dup_cleanup_mmap:
-    exit_mmap(mm);
-    put_pgdir(mm);
+    put_mm(mm);
+    goto bad_mm;
 bad_pgdir_cleanup_mm:
     mm_destroy(mm);
 bad_mm:
@@ -371,6 +434,20 @@ copy_thread(struct proc_struct *proc, uintptr_t esp, struct trapframe *tf) {
     proc->context.esp = (uintptr_t)(proc->tf);
 }
 
+// copy_tls - the child inherits the tls base of current, or if CLONE_SETTLS is set,
+//          - uses the tls base passed in %ebx (the 3th argument of SYS_clone) and
+//          - starts with %gs = USER_TLS
+static void
+copy_tls(uint32_t clone_flags, struct proc_struct *proc, struct trapframe *tf) {
+    if (clone_flags & CLONE_SETTLS) {
+        proc->tls = tf->tf_regs.reg_ebx;
+        proc->tf->tf_gs = USER_TLS;
+    }
+    else {
+        proc->tls = current->tls;
+    }
+}
+
 //copy_files&put_files function used by do_fork in LAB8
 //copy the files_struct from current to proc
 static int
@@ -461,7 +538,42 @@ do_fork(uint32_t clone_flags, uintptr_t stack, struct trapframe *tf) {
 	*    update step 1: set child proc's parent to current process, make sure current process's wait_state is 0
 	*    update step 5: insert proc_struct into hash_list && proc_list, set the relation links of process
     */
-	
+    if ((proc = alloc_proc()) == NULL) {
+        goto fork_out;
+    }
+
+    proc->parent = current;
+    assert(current->wait_state == 0);
+
+    if (setup_kstack(proc) != 0) {
+        goto bad_fork_cleanup_proc;
+    }
+    if (copy_files(clone_flags, proc) != 0) {
+        goto bad_fork_cleanup_kstack;
+    }
+    if (copy_mm(clone_flags, proc) != 0) {
+        goto bad_fork_cleanup_fs;
+    }
+    copy_thread(proc, stack, tf);
+    copy_tls(clone_flags, proc, tf);
+
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        proc->pid = get_pid();
+        hash_proc(proc);
+        set_links(proc);
+    }
+    local_intr_restore(intr_flag);
+
+    // the threads of an mm ask the kernel for their pids
+    if (proc->mm != NULL) {
+        vdso_set_pid(proc->mm, (clone_flags & CLONE_VM) ? 0 : proc->pid);
+    }
+
+    wakeup_proc(proc);
+
+    ret = proc->pid;
 fork_out:
     return ret;
 
@@ -470,7 +582,7 @@ bad_fork_cleanup_fs:  //for LAB8
 bad_fork_cleanup_kstack:
     put_kstack(proc);
 bad_fork_cleanup_proc:
-    kfree(proc);
+    kmem_cache_free(proc_cache, proc);
     goto fork_out;
 }
 
@@ -489,11 +601,9 @@ do_exit(int error_code) {
     
     struct mm_struct *mm = current->mm;
     if (mm != NULL) {
-        lcr3(boot_cr3);
+        load_cr3(boot_cr3);
         if (mm_count_dec(mm) == 0) {
-            exit_mmap(mm);
-            put_pgdir(mm);
-            mm_destroy(mm);
+            put_mm(mm);
         }
         current->mm = NULL;
     }
@@ -573,6 +683,137 @@ load_icode(int fd, int argc, char **kargv) {
      * (7) setup trapframe for user environment
      * (8) if up steps failed, you should cleanup the env.
      */
+    assert(argc >= 0 && argc <= EXEC_MAX_ARG_NUM);
+
+    if (current->mm != NULL) {
+        panic("load_icode: current->mm must be empty.\n");
+    }
+
+    int ret = -E_NO_MEM;
+    struct mm_struct *mm;
+    //(1) create a new mm for current process
+    if ((mm = mm_create()) == NULL) {
+        goto bad_mm;
+    }
+    //(2) create a new PDT, and mm->pgdir= kernel virtual addr of PDT
+    if (setup_pgdir(mm) != 0) {
+        goto bad_pgdir_cleanup_mm;
+    }
+    //(3) build vmas for TEXT/DATA/BSS parts, the pages are loaded on demand by do_pgfault
+    struct inode *node;
+    if ((ret = file_inode(fd, &node)) != 0) {
+        goto bad_elf_cleanup_pgdir;
+    }
+    //(3.1) read raw data content in file and resolve elfhdr
+    struct elfhdr __elf, *elf = &__elf;
+    if ((ret = load_icode_read(fd, elf, sizeof(struct elfhdr), 0)) != 0) {
+        goto bad_elf_cleanup_pgdir;
+    }
+    if (elf->e_magic != ELF_MAGIC) {
+        ret = -E_INVAL_ELF;
+        goto bad_elf_cleanup_pgdir;
+    }
+
+    struct proghdr __ph, *ph = &__ph;
+    struct vma_struct *vma;
+    uint32_t vm_flags, phnum;
+    for (phnum = 0; phnum < elf->e_phnum; phnum ++) {
+    //(3.2) read raw data content in file and resolve proghdr based on info in elfhdr
+        off_t phoff = elf->e_phoff + sizeof(struct proghdr) * phnum;
+        if ((ret = load_icode_read(fd, ph, sizeof(struct proghdr), phoff)) != 0) {
+            goto bad_cleanup_mmap;
+        }
+        if (ph->p_type != ELF_PT_LOAD) {
+            continue ;
+        }
+        if (ph->p_filesz > ph->p_memsz || ph->p_offset < PGOFF(ph->p_va)) {
+            ret = -E_INVAL_ELF;
+            goto bad_cleanup_mmap;
+        }
+        if (ph->p_memsz == 0) {
+            continue ;
+        }
+    //(3.3) call mm_map to build vma related to TEXT/DATA/BSS
+        vm_flags = 0;
+        if (ph->p_flags & ELF_PF_X) vm_flags |= VM_EXEC;
+        if (ph->p_flags & ELF_PF_W) vm_flags |= VM_WRITE;
+        if (ph->p_flags & ELF_PF_R) vm_flags |= VM_READ;
+        if ((ret = mm_map(mm, ph->p_va, ph->p_memsz, vm_flags, &vma)) != 0) {
+            goto bad_cleanup_mmap;
+        }
+    //(3.4) record the file range backing this vma, vm_start is ROUNDDOWN(p_va, PGSIZE),
+    //      so the file range starts PGOFF(p_va) bytes before p_offset. BSS is zero-filled on fault.
+        vma_set_file(vma, node, ph->p_offset - PGOFF(ph->p_va), ph->p_filesz + PGOFF(ph->p_va));
+    //(3.5) the heap starts after the highest segment
+        if (mm->brk_start < vma->vm_end) {
+            mm->brk_start = vma->vm_end;
+        }
+    }
+    sysfile_close(fd);
+    mm->brk = mm->brk_start;
+
+    //(4) call mm_map to setup user stack, and put parameters into user stack
+    vm_flags = VM_READ | VM_WRITE | VM_STACK;
+    if ((ret = mm_map(mm, USTACKTOP - USTACKSIZE, USTACKSIZE, vm_flags, NULL)) != 0) {
+        goto bad_cleanup_mmap;
+    }
+    ret = -E_NO_MEM;
+    if (pgdir_alloc_page(mm->pgdir, USTACKTOP-PGSIZE , PTE_USER) == NULL ||
+        pgdir_alloc_page(mm->pgdir, USTACKTOP-2*PGSIZE , PTE_USER) == NULL ||
+        pgdir_alloc_page(mm->pgdir, USTACKTOP-3*PGSIZE , PTE_USER) == NULL ||
+        pgdir_alloc_page(mm->pgdir, USTACKTOP-4*PGSIZE , PTE_USER) == NULL) {
+        goto bad_cleanup_mmap;
+    }
+    //(4.1) map the vdso pages below the user stack
+    if ((ret = vdso_map(mm)) != 0) {
+        goto bad_cleanup_mmap;
+    }
+    vdso_set_pid(mm, current->pid);
+
+    //(5) setup current process's mm, cr3, reset pgidr (using lcr3 MARCO)
+    mm_count_inc(mm);
+    current->mm = mm;
+    current->cr3 = PADDR(mm->pgdir);
+    load_cr3(PADDR(mm->pgdir));
+
+    //(6) setup uargc and uargv in user stacks
+    uint32_t argv_size = 0, i;
+    for (i = 0; i < argc; i ++) {
+        argv_size += strnlen(kargv[i], EXEC_MAX_ARG_LEN + 1) + 1;
+    }
+
+    uintptr_t stacktop = USTACKTOP - (argv_size / sizeof(long) + 1) * sizeof(long);
+    char **uargv = (char **)(stacktop - argc * sizeof(char *));
+
+    argv_size = 0;
+    for (i = 0; i < argc; i ++) {
+        uargv[i] = strcpy((char *)(stacktop + argv_size), kargv[i]);
+        argv_size += strnlen(kargv[i], EXEC_MAX_ARG_LEN + 1) + 1;
+    }
+
+    stacktop = (uintptr_t)uargv - sizeof(int);
+    *(int *)stacktop = argc;
+
+    //(7) setup trapframe for user environment
+    struct trapframe *tf = current->tf;
+    memset(tf, 0, sizeof(struct trapframe));
+    tf->tf_cs = USER_CS;
+    tf->tf_ds = tf->tf_es = tf->tf_ss = USER_DS;
+    tf->tf_esp = stacktop;
+    tf->tf_eip = elf->e_entry;
+    tf->tf_eflags = FL_IF;
+    ret = 0;
+out:
+    return ret;
+    //(8) if up steps failed, you should cleanup the env.
+bad_cleanup_mmap:
+bad_elf_cleanup_pgdir:
+    put_mm(mm);
+    goto out;
+bad_pgdir_cleanup_mm:
+    mm_destroy(mm);
+bad_mm:
+    goto out;
 }
 
 // this function isn't very correct in LAB8
@@ -651,11 +892,9 @@ do_execve(const char *name, int argc, const char **argv) {
         goto execve_exit;
     }
     if (mm != NULL) {
-        lcr3(boot_cr3);
+        load_cr3(boot_cr3);
         if (mm_count_dec(mm) == 0) {
-            exit_mmap(mm);
-            put_pgdir(mm);
-            mm_destroy(mm);
+            put_mm(mm);
         }
         current->mm = NULL;
     }
@@ -673,6 +912,184 @@ execve_exit:
     panic("already exit: %e.\n", ret);
 }
 
+// do_brk - set the end of the heap of current to *brk_store (page aligned),
+//        - then store the new (or unchanged if failed) end of the heap in *brk_store
+int
+do_brk(uintptr_t *brk_store) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call sys_brk!!.\n");
+    }
+    if (brk_store == NULL) {
+        return -E_INVAL;
+    }
+
+    uintptr_t brk;
+
+    lock_mm(mm);
+    if (!copy_from_user(mm, &brk, brk_store, sizeof(uintptr_t), 1)) {
+        unlock_mm(mm);
+        return -E_INVAL;
+    }
+
+    if (brk < mm->brk_start) {
+        goto out_unlock;
+    }
+    uintptr_t newbrk = ROUNDUP(brk, PGSIZE), oldbrk = mm->brk;
+    assert(oldbrk % PGSIZE == 0);
+    if (newbrk == oldbrk) {
+        goto out_unlock;
+    }
+    if (newbrk < oldbrk) {
+        if (mm_unmap(mm, newbrk, oldbrk - newbrk) != 0) {
+            goto out_unlock;
+        }
+    }
+    else {
+        // keep a guard page between the heap and the next vma
+        if (find_vma_intersection(mm, oldbrk, newbrk + PGSIZE) != NULL) {
+            goto out_unlock;
+        }
+        if (mm_brk(mm, oldbrk, newbrk - oldbrk) != 0) {
+            goto out_unlock;
+        }
+    }
+    mm->brk = newbrk;
+out_unlock:
+    copy_to_user(mm, brk_store, &(mm->brk), sizeof(uintptr_t));
+    unlock_mm(mm);
+    return 0;
+}
+
+// do_mmap - map len bytes of anonymous memory at *addr_store (0 means anywhere),
+//         - then store the start address in *addr_store
+int
+do_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call mmap!!.\n");
+    }
+    if (addr_store == NULL || len == 0) {
+        return -E_INVAL;
+    }
+
+    int ret = -E_INVAL;
+
+    uintptr_t addr;
+
+    lock_mm(mm);
+    if (!copy_from_user(mm, &addr, addr_store, sizeof(uintptr_t), 1)) {
+        goto out_unlock;
+    }
+
+    uintptr_t start = ROUNDDOWN(addr, PGSIZE), end = ROUNDUP(addr + len, PGSIZE);
+    addr = start, len = end - start;
+
+    uint32_t vm_flags = VM_READ;
+    if (mmap_flags & MMAP_WRITE) vm_flags |= VM_WRITE;
+    if (mmap_flags & MMAP_STACK) vm_flags |= VM_STACK;
+    if (mmap_flags & MMAP_LARGE) vm_flags |= VM_LARGE;
+
+    ret = -E_NO_MEM;
+    if (addr == 0) {
+        // a large mapping is placed on 4M boundary, so that large pages fit in it
+        if (mmap_flags & MMAP_LARGE) {
+            if ((addr = get_unmapped_area(mm, len + PTSIZE)) != 0) {
+                addr = ROUNDUP(addr, PTSIZE);
+            }
+        }
+        else {
+            addr = get_unmapped_area(mm, len);
+        }
+        if (addr == 0) {
+            goto out_unlock;
+        }
+    }
+    struct vma_struct *vma;
+    if ((ret = mm_map(mm, addr, len, vm_flags, &vma)) == 0) {
+        vma_merge(mm, vma);
+        copy_to_user(mm, addr_store, &addr, sizeof(uintptr_t));
+    }
+out_unlock:
+    unlock_mm(mm);
+    return ret;
+}
+
+// do_munmap - unmap [addr, addr + len) of current, the pages are freed
+int
+do_munmap(uintptr_t addr, size_t len) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call munmap!!.\n");
+    }
+    if (len == 0) {
+        return -E_INVAL;
+    }
+    int ret;
+    lock_mm(mm);
+    {
+        ret = mm_unmap(mm, addr, len);
+    }
+    unlock_mm(mm);
+    return ret;
+}
+
+// do_shmem_attach - attach the shared memory segment of key (created if SHMEM_CREAT is set) to current,
+//                 - then store the start address in *addr_store
+int
+do_shmem_attach(uintptr_t *addr_store, int key, size_t len, uint32_t flags) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call shmem!!.\n");
+    }
+    if (addr_store == NULL || len == 0) {
+        return -E_INVAL;
+    }
+
+    int ret;
+    struct shmem_struct *shmem;
+    if ((ret = shmem_get(key, len, flags, &shmem)) != 0) {
+        return ret;
+    }
+
+    uint32_t vm_flags = VM_READ | VM_SHARE;
+    if (flags & MMAP_WRITE) vm_flags |= VM_WRITE;
+
+    lock_mm(mm);
+    uintptr_t addr;
+    struct vma_struct *vma;
+    ret = -E_NO_MEM;
+    if ((addr = get_unmapped_area(mm, shmem->len)) == 0) {
+        goto out_unlock;
+    }
+    if ((ret = mm_map(mm, addr, shmem->len, vm_flags, &vma)) != 0) {
+        goto out_unlock;
+    }
+    vma_set_shmem(vma, shmem, 0);
+    copy_to_user(mm, addr_store, &addr, sizeof(uintptr_t));
+out_unlock:
+    unlock_mm(mm);
+    shmem_ref_dec(shmem);
+    return ret;
+}
+
+// do_shmem_detach - detach the shared memory segment attached at addr from current
+int
+do_shmem_detach(uintptr_t addr) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call shmem!!.\n");
+    }
+    int ret = -E_INVAL;
+    struct vma_struct *vma;
+    lock_mm(mm);
+    if ((vma = find_vma(mm, addr)) != NULL && vma->vm_shmem != NULL) {
+        ret = mm_unmap(mm, vma->vm_start, vma->vm_end - vma->vm_start);
+    }
+    unlock_mm(mm);
+    return ret;
+}
+
 // do_yield - ask the scheduler to reschedule
 int
 do_yield(void) {
@@ -739,7 +1156,7 @@ found:
     }
     local_intr_restore(intr_flag);
     put_kstack(proc);
-    kfree(proc);
+    kmem_cache_free(proc_cache, proc);
     return 0;
 }
 
@@ -820,6 +1237,7 @@ init_main(void *arg) {
     if (pid <= 0) {
         panic("create user_main failed.\n");
     }
+    check_mutex();
  extern void check_sync(void);
     check_sync();                // check philosopher sync problem
 
@@ -850,6 +1268,10 @@ proc_init(void) {
         list_init(hash_list + i);
     }
 
+    if ((proc_cache = kmem_cache_create("proc_struct", sizeof(struct proc_struct))) == NULL) {
+        panic("cannot create proc_cache.\n");
+    }
+
     if ((idleproc = alloc_proc()) == NULL) {
         panic("cannot alloc idleproc.\n");
     }
@@ -869,6 +1291,21 @@ proc_init(void) {
 
     current = idleproc;
 
+    // the idle processes of the other cpus, each cpu starts on the kernel stack of its own
+    for (i = 1; i < ncpu; i ++) {
+        struct proc_struct *proc;
+        if ((proc = alloc_proc()) == NULL || setup_kstack(proc) != 0) {
+            panic("cannot alloc idleproc of cpu%d.\n", i);
+        }
+        proc->pid = 0;
+        proc->state = PROC_RUNNABLE;
+        proc->need_resched = 1;
+        proc->filesp = idleproc->filesp;
+        files_count_inc(proc->filesp);
+        set_proc_name(proc, "idle");
+        cpus[i].idle = cpus[i].proc = proc;
+    }
+
     int pid = kernel_thread(init_main, NULL, 0);
     if (pid <= 0) {
         panic("create init_main failed.\n");
@@ -888,6 +1325,25 @@ cpu_idle(void) {
         if (current->need_resched) {
             schedule();
         }
+        // nothing to run: clear a page for the zeroed page pool, or halt until the next interrupt
+        else if (!zero_pool_fill()) {
+            cli();
+            if (!current->need_resched) {
+                // let the other cpus run kernel code while halted. The PDT of the last
+                // process may be freed meanwhile, so switch to boot_cr3 before
+                if (ismp && rcr3() != boot_cr3) {
+                    load_cr3(boot_cr3);
+                }
+                clock_nohz_enter();
+                unlock_kernel();
+                sti_hlt();
+                lock_kernel();
+                clock_nohz_exit();
+            }
+            else {
+                sti();
+            }
+        }
     }
 }
 
@@ -920,3 +1376,54 @@ do_sleep(unsigned int time) {
     del_timer(timer);
     return 0;
 }
+
+// do_clock_gettime - store the time of clock_id in the user timespec ts
+int
+do_clock_gettime(int clock_id, struct timespec *ts) {
+    if (clock_id != CLOCK_MONOTONIC) {
+        return -E_INVAL;
+    }
+    struct timespec kts;
+    uint64_t ns = clock_ns();
+    kts.tv_nsec = do_div(ns, NSEC_PER_SEC);
+    kts.tv_sec = ns;
+
+    struct mm_struct *mm = current->mm;
+    int ret = 0;
+    lock_mm(mm);
+    if (!copy_to_user(mm, ts, &kts, sizeof(struct timespec))) {
+        ret = -E_INVAL;
+    }
+    unlock_mm(mm);
+    return ret;
+}
+
+/* *
+ * do_nanosleep - sleep until the time of the user timespec req has passed. The sleep is done
+ * with the timers, so the deadline is rounded up to the next tick: the process wakes up less
+ * than one tick (TICK_NS) after it, and the cpu may halt meanwhile.
+ * */
+int
+do_nanosleep(const struct timespec *req) {
+    struct mm_struct *mm = current->mm;
+    struct timespec kreq;
+    lock_mm(mm);
+    if (!copy_from_user(mm, &kreq, req, sizeof(struct timespec), 0)) {
+        unlock_mm(mm);
+        return -E_INVAL;
+    }
+    unlock_mm(mm);
+    if (kreq.tv_nsec >= NSEC_PER_SEC) {
+        return -E_INVAL;
+    }
+
+    uint64_t deadline = clock_ns() + (uint64_t)kreq.tv_sec * NSEC_PER_SEC + kreq.tv_nsec, now;
+    while (!(current->flags & PF_EXITING) && (now = clock_ns()) < deadline) {
+        uint64_t nticks = deadline - now + TICK_NS - 1;
+        do_div(nticks, TICK_NS);
+        // wakes up at the nticks-th tick from now, after nticks - 1 ticks at least, so the
+        // last round sleeps until the first tick past the deadline
+        do_sleep((nticks < 0xFFFFFFFF) ? nticks : 0xFFFFFFFF);
+    }
+    return 0;
+}
@@ -6,6 +6,8 @@
 #include <trap.h>
 #include <memlayout.h>
 #include <skew_heap.h>
+#include <rb_tree.h>
+#include <mp.h>
 
 
 // process's state in his life cycle
@@ -41,6 +43,7 @@ struct context {
 extern list_entry_t proc_list;
 
 struct inode;
+struct mutex;
 
 struct proc_struct {
     enum proc_state state;                      // Process state
@@ -48,6 +51,7 @@ struct proc_struct {
     int runs;                                   // the running times of Proces
     uintptr_t kstack;                           // Process kernel stack
     volatile bool need_resched;                 // bool value: need to be rescheduled to release CPU?
+    int preempt_count;                          // the kernel code of the process may be preempted if 0
     struct proc_struct *parent;                 // the parent process
     struct mm_struct *mm;                       // Process's memory management field
     struct context context;                     // Switch here to run process
@@ -66,7 +70,18 @@ struct proc_struct {
     skew_heap_entry_t lab6_run_pool;            // FOR LAB6 ONLY: the entry in the run pool
     uint32_t lab6_stride;                       // FOR LAB6 ONLY: the current stride of the process
     uint32_t lab6_priority;                     // FOR LAB6 ONLY: the priority of process, set by lab6_set_priority(uint32_t)
+    uint32_t pi_priority;                       // the priority inherited from the waiters of the mutexes held
+    list_entry_t mutex_list;                    // the mutexes held
+    struct mutex *mutex_wait;                   // the mutex waited for
+    rb_node cfs_node;                           // the node in the cfs tree of the run queue
+    uint64_t cfs_vruntime;                      // the virtual runtime: TSC cycles run, divided by the weight
+    uint64_t cfs_exec_start;                    // the TSC when the run time was charged last
+    uint64_t cfs_slice_start;                   // the TSC when the process was picked to run
+    uint32_t cfs_weight;                        // the weight added to the cfs_weight of the run queue
+    int mlfq_level;                             // the priority level in mlfq, 0 is the highest
+    int mlfq_allot;                             // the ticks run at mlfq_level
     struct files_struct *filesp;                // the file related info(pwd, files_count, files_array, fs_semaphore) of process
+    uintptr_t tls;                              // the base of user tls segment (USER_TLS)
 };
 
 #define PF_EXITING                  0x00000001      // getting shutdown
@@ -74,13 +89,26 @@ struct proc_struct {
 #define WT_INTERRUPTED               0x80000000                    // the wait state could be interrupted
 #define WT_CHILD                    (0x00000001 | WT_INTERRUPTED)  // wait child process
 #define WT_KSEM                      0x00000100                    // wait kernel semaphore
+#define WT_KMUTEX                    0x00000200                    // wait kernel mutex
 #define WT_TIMER                    (0x00000002 | WT_INTERRUPTED)  // wait timer
 #define WT_KBD                      (0x00000004 | WT_INTERRUPTED)  // wait the input of keyboard
 
 #define le2proc(le, member)         \
     to_struct((le), struct proc_struct, member)
 
-extern struct proc_struct *idleproc, *initproc, *current;
+extern struct proc_struct *initproc;
+
+// proc_priority - the priority the scheduler sees: lab6_priority (at least 1), or the one
+// inherited from the waiters of the mutexes proc holds, if higher
+static inline uint32_t
+proc_priority(struct proc_struct *proc) {
+    uint32_t priority = (proc->lab6_priority != 0) ? proc->lab6_priority : 1;
+    return (proc->pi_priority > priority) ? proc->pi_priority : priority;
+}
+
+// the process running on this cpu, and the idle process of this cpu
+#define current                     (mycpu()->proc)
+#define idleproc                    (mycpu()->idle)
 
 void proc_init(void);
 void proc_run(struct proc_struct *proc);
@@ -100,5 +128,13 @@ int do_kill(int pid);
 //FOR LAB6, set the process's priority (bigger value will get more CPU time)
 void lab6_set_priority(uint32_t priority);
 int do_sleep(unsigned int time);
+struct timespec;
+int do_clock_gettime(int clock_id, struct timespec *ts);
+int do_nanosleep(const struct timespec *req);
+int do_brk(uintptr_t *brk_store);
+int do_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags);
+int do_munmap(uintptr_t addr, size_t len);
+int do_shmem_attach(uintptr_t *addr_store, int key, size_t len, uint32_t flags);
+int do_shmem_detach(uintptr_t addr);
 #endif /* !__KERN_PROCESS_PROC_H__ */
 
@@ -0,0 +1,188 @@
+#include <defs.h>
+#include <x86.h>
+#include <proc.h>
+#include <clock.h>
+#include <rb_tree.h>
+#include <assert.h>
+#include <cfs_sched.h>
+
+/* *
+ * The completely fair scheduler, after the one of Linux.
+ *
+ * Every process has a virtual runtime: the TSC cycles it has run, divided by its weight
+ * (proc_priority, which a mutex holder may inherit from its waiters). The run queue is a red-black tree ordered by the virtual
+ * runtime, and the process with the smallest one runs next. There is no fixed time slice,
+ * a process runs for its share (by weight) of CFS_LATENCY ticks among the runnable
+ * processes, but at least CFS_MIN_GRANULARITY ticks.
+ *
+ * A woken process starts from the min_vruntime of the run queue, less half the latency, if
+ * its own virtual runtime is smaller. So it runs soon, but a long sleep doesn't save up cpu
+ * time; it preempts the running process at the next tick, see cfs_proc_tick.
+ *
+ * The cycles are charged at every tick and when the running process is preempted, but the
+ * part of a tick before a process sleeps is not charged.
+ * */
+
+#define CFS_LATENCY             4       // the ticks in which every runnable process runs once
+#define CFS_MIN_GRANULARITY     1       // the ticks a process runs at least
+
+// the TSC cycles of a tick
+static uint32_t tick_cycles;
+
+#define rb2proc(node)           to_struct((node), struct proc_struct, cfs_node)
+
+static inline uint32_t
+proc_weight(struct proc_struct *proc) {
+    return proc_priority(proc);
+}
+
+// the virtual runtimes only grow, compare them as the TCP sequence numbers
+static inline bool
+vruntime_before(uint64_t a, uint64_t b) {
+    return (int64_t)(a - b) < 0;
+}
+
+static int
+cfs_compare(rb_node *node1, rb_node *node2) {
+    uint64_t a = rb2proc(node1)->cfs_vruntime, b = rb2proc(node2)->cfs_vruntime;
+    return vruntime_before(a, b) ? -1 : (vruntime_before(b, a) ? 1 : 0);
+}
+
+// cfs_leftmost - the process with the smallest virtual runtime in rq, or NULL
+static struct proc_struct *
+cfs_leftmost(struct run_queue *rq) {
+    rb_node *node, *left;
+    if ((node = rb_node_root(rq->cfs_tree)) == NULL) {
+        return NULL;
+    }
+    while ((left = rb_node_left(rq->cfs_tree, node)) != NULL) {
+        node = left;
+    }
+    return rb2proc(node);
+}
+
+// update_curr - charge the cycles the running proc has run since cfs_exec_start
+static void
+update_curr(struct proc_struct *proc, uint64_t now) {
+    uint64_t delta = now - proc->cfs_exec_start;
+    if ((int64_t)delta <= 0) {
+        return;
+    }
+    // divided in 32 bits, the kernel has no 64 bit division
+    if (delta > 0xFFFFFFFF) {
+        delta = 0xFFFFFFFF;
+    }
+    proc->cfs_vruntime += (uint32_t)delta / proc_weight(proc);
+    proc->cfs_exec_start = now;
+}
+
+// update_min_vruntime - min_vruntime follows the smallest virtual runtime of rq and of the
+// running process curr, but never goes back
+static void
+update_min_vruntime(struct run_queue *rq, struct proc_struct *curr) {
+    struct proc_struct *proc = cfs_leftmost(rq);
+    uint64_t vruntime = curr->cfs_vruntime;
+    if (proc != NULL && vruntime_before(proc->cfs_vruntime, vruntime)) {
+        vruntime = proc->cfs_vruntime;
+    }
+    if (vruntime_before(rq->cfs_min_vruntime, vruntime)) {
+        rq->cfs_min_vruntime = vruntime;
+    }
+}
+
+// cfs_slice - the cycles proc runs for, its share of CFS_LATENCY by weight
+static uint32_t
+cfs_slice(struct run_queue *rq, struct proc_struct *proc) {
+    uint32_t weight = proc_weight(proc);
+    uint32_t slice = CFS_LATENCY * tick_cycles / (rq->cfs_weight + weight) * weight;
+    if (slice < CFS_MIN_GRANULARITY * tick_cycles) {
+        slice = CFS_MIN_GRANULARITY * tick_cycles;
+    }
+    return slice;
+}
+
+static void
+cfs_init(struct run_queue *rq) {
+    tick_cycles = clock_tick_cycles();
+    list_init(&(rq->run_list));
+    if ((rq->cfs_tree = rb_tree_create(cfs_compare)) == NULL) {
+        panic("cfs_init: no memory for the run queue.\n");
+    }
+    rq->cfs_min_vruntime = 0;
+    rq->cfs_weight = 0;
+    rq->proc_num = 0;
+}
+
+static void
+cfs_enqueue(struct run_queue *rq, struct proc_struct *proc) {
+    if (proc == current) {
+        // preempted or yielding
+        update_curr(proc, read_tsc());
+        update_min_vruntime(rq, proc);
+    }
+    else if (proc->rq != NULL && proc->rq != rq) {
+        // moved by load_balance, keep its distance to the min_vruntime
+        proc->cfs_vruntime += rq->cfs_min_vruntime - proc->rq->cfs_min_vruntime;
+    }
+    else {
+        // woken, or a new process which starts at min_vruntime
+        uint64_t vruntime = rq->cfs_min_vruntime;
+        if (proc->runs != 0) {
+            vruntime -= CFS_LATENCY * tick_cycles / 2;
+        }
+        if (vruntime_before(proc->cfs_vruntime, vruntime)) {
+            proc->cfs_vruntime = vruntime;
+        }
+    }
+    rb_insert(rq->cfs_tree, &(proc->cfs_node));
+    proc->rq = rq;
+    // the priority may change while proc is queued, take off the same weight in cfs_dequeue
+    proc->cfs_weight = proc_weight(proc);
+    rq->cfs_weight += proc->cfs_weight;
+    rq->proc_num ++;
+}
+
+static void
+cfs_dequeue(struct run_queue *rq, struct proc_struct *proc) {
+    assert(proc->rq == rq && rq->proc_num != 0);
+    rb_delete(rq->cfs_tree, &(proc->cfs_node));
+    rq->cfs_weight -= proc->cfs_weight;
+    rq->proc_num --;
+    // picked to run, or moved by load_balance and picked later again
+    proc->cfs_exec_start = proc->cfs_slice_start = read_tsc();
+}
+
+static struct proc_struct *
+cfs_pick_next(struct run_queue *rq) {
+    return cfs_leftmost(rq);
+}
+
+/* *
+ * cfs_proc_tick - charge the running proc, which is rescheduled when its slice is used up,
+ * or when it is a tick of virtual runtime ahead of the leftmost process, e.g. a woken one.
+ * */
+static void
+cfs_proc_tick(struct run_queue *rq, struct proc_struct *proc) {
+    uint64_t now = read_tsc();
+    update_curr(proc, now);
+    update_min_vruntime(rq, proc);
+
+    struct proc_struct *next;
+    if ((next = cfs_leftmost(rq)) == NULL) {
+        return;
+    }
+    if (now - proc->cfs_slice_start >= cfs_slice(rq, proc)
+        || vruntime_before(next->cfs_vruntime + tick_cycles, proc->cfs_vruntime)) {
+        proc->need_resched = 1;
+    }
+}
+
+struct sched_class cfs_sched_class = {
+    .name = "cfs_scheduler",
+    .init = cfs_init,
+    .enqueue = cfs_enqueue,
+    .dequeue = cfs_dequeue,
+    .pick_next = cfs_pick_next,
+    .proc_tick = cfs_proc_tick,
+};
+
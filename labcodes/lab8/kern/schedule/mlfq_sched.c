@@ -0,0 +1,144 @@
+#include <defs.h>
+#include <list.h>
+#include <proc.h>
+#include <assert.h>
+#include <mlfq_sched.h>
+
+/* *
+ * The multi-level feedback queue scheduler, see the rules in OSTEP chapter 8 and the model
+ * in related_info/ostep/ostep9-mlfq.py:
+ *   1) a process of a higher level runs first, the processes of a level run round robin,
+ *      with the quantum of the level;
+ *   2) a new process starts at the highest level;
+ *   3) a process that has used up the allotment of its level, whether it gives up the cpu
+ *      in between or not, moves down a level;
+ *   4) a woken process (from the keyboard, the disk, a timer, ...) moves up a level to the
+ *      front of the queue, and preempts a process of a lower level;
+ *   5) every MLFQ_BOOST_INTERVAL ticks all processes go back to the highest level, so the
+ *      cpu-bound processes don't starve.
+ * */
+
+#define MLFQ_BOOST_INTERVAL     100     // the ticks between two priority boosts
+
+// the time slice and the allotment of each level, in ticks
+static const int mlfq_quantum[MLFQ_LEVELS] = {1, 2, 4};
+static const int mlfq_allotment[MLFQ_LEVELS] = {2, 4, 0};
+
+static void
+MLFQ_init(struct run_queue *rq) {
+    int level;
+    list_init(&(rq->run_list));
+    for (level = 0; level < MLFQ_LEVELS; level ++) {
+        list_init(&(rq->mlfq_run_list[level]));
+    }
+    rq->mlfq_ticks = 0;
+    rq->proc_num = 0;
+}
+
+static void
+MLFQ_enqueue(struct run_queue *rq, struct proc_struct *proc) {
+    assert(list_empty(&(proc->run_link)));
+    if (proc == current || (proc->rq != NULL && proc->rq != rq)) {
+        // preempted, yielding, or moved by load_balance
+        list_add_before(&(rq->mlfq_run_list[proc->mlfq_level]), &(proc->run_link));
+    }
+    else if (proc->runs == 0) {
+        // a new process, the level is set by alloc_proc
+        list_add_before(&(rq->mlfq_run_list[proc->mlfq_level]), &(proc->run_link));
+    }
+    else {
+        // woken
+        if (proc->mlfq_level > 0) {
+            proc->mlfq_level --;
+            proc->mlfq_allot = 0;
+        }
+        proc->time_slice = 0;
+        list_add_after(&(rq->mlfq_run_list[proc->mlfq_level]), &(proc->run_link));
+        if (rq == &(mycpu()->rq) && current != idleproc && current->mlfq_level > proc->mlfq_level) {
+            current->need_resched = 1;
+        }
+    }
+    if (proc->time_slice == 0) {
+        proc->time_slice = mlfq_quantum[proc->mlfq_level];
+    }
+    proc->rq = rq;
+    rq->proc_num ++;
+}
+
+static void
+MLFQ_dequeue(struct run_queue *rq, struct proc_struct *proc) {
+    assert(!list_empty(&(proc->run_link)) && proc->rq == rq);
+    list_del_init(&(proc->run_link));
+    rq->proc_num --;
+}
+
+static struct proc_struct *
+MLFQ_pick_next(struct run_queue *rq) {
+    int level;
+    for (level = 0; level < MLFQ_LEVELS; level ++) {
+        list_entry_t *le = list_next(&(rq->mlfq_run_list[level]));
+        if (le != &(rq->mlfq_run_list[level])) {
+            return le2proc(le, run_link);
+        }
+    }
+    return NULL;
+}
+
+// MLFQ_boost - move all processes of rq and the running proc to the highest level
+static void
+MLFQ_boost(struct run_queue *rq, struct proc_struct *proc) {
+    int level;
+    list_entry_t *top = &(rq->mlfq_run_list[0]);
+    for (level = 1; level < MLFQ_LEVELS; level ++) {
+        list_entry_t *list = &(rq->mlfq_run_list[level]), *le;
+        while ((le = list_next(list)) != list) {
+            struct proc_struct *p = le2proc(le, run_link);
+            list_del(le);
+            list_add_before(top, le);
+            p->mlfq_level = p->mlfq_allot = 0;
+            p->time_slice = mlfq_quantum[0];
+        }
+    }
+    proc->mlfq_level = proc->mlfq_allot = 0;
+    if (proc->time_slice > mlfq_quantum[0]) {
+        proc->time_slice = mlfq_quantum[0];
+    }
+}
+
+static void
+MLFQ_proc_tick(struct run_queue *rq, struct proc_struct *proc) {
+    if (++ rq->mlfq_ticks % MLFQ_BOOST_INTERVAL == 0) {
+        MLFQ_boost(rq, proc);
+    }
+    if (proc->time_slice > 0) {
+        proc->time_slice --;
+    }
+    if (mlfq_allotment[proc->mlfq_level] != 0 && ++ proc->mlfq_allot >= mlfq_allotment[proc->mlfq_level]) {
+        proc->mlfq_level ++;
+        proc->mlfq_allot = 0;
+        proc->time_slice = 0;
+    }
+    if (proc->time_slice == 0) {
+        proc->need_resched = 1;
+    }
+    else {
+        // a process of a higher level is waiting
+        int level;
+        for (level = 0; level < proc->mlfq_level; level ++) {
+            if (!list_empty(&(rq->mlfq_run_list[level]))) {
+                proc->need_resched = 1;
+                break;
+            }
+        }
+    }
+}
+
+struct sched_class mlfq_sched_class = {
+    .name = "mlfq_scheduler",
+    .init = MLFQ_init,
+    .enqueue = MLFQ_enqueue,
+    .dequeue = MLFQ_dequeue,
+    .pick_next = MLFQ_pick_next,
+    .proc_tick = MLFQ_proc_tick,
+};
+
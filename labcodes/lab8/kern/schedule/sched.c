@@ -5,56 +5,157 @@
 #include <stdio.h>
 #include <assert.h>
 #include <default_sched.h>
+#include <cfs_sched.h>
+#include <mlfq_sched.h>
+#include <lapic.h>
+#include <mp.h>
+#include <clock.h>
+#include <vmm.h>
+#include <vdso.h>
 
-// the list of timer
-static list_entry_t timer_list;
+#define BALANCE_INTERVAL        10      // the ticks between two periodic load balancings of a cpu
+
+/* *
+ * The timers are kept in a hierarchical timing wheel, after the one of Linux. tv1 has a
+ * slot for each of the next TVR_SIZE ticks. The slots of the level n of tvn hold the timers
+ * expiring later, each slot TVR_SIZE * TVN_SIZE^n ticks, and are cascaded into the lower
+ * level when the wheel gets there. Adding and deleting a timer is O(1), and a tick only
+ * runs the timers of a slot, however many processes are sleeping.
+ * */
+#define TVR_BITS                8
+#define TVN_BITS                6
+#define TVR_SIZE                (1 << TVR_BITS)
+#define TVN_SIZE                (1 << TVN_BITS)
+#define TVR_MASK                (TVR_SIZE - 1)
+#define TVN_MASK                (TVN_SIZE - 1)
+#define TVN_LEVELS              4       // with tv1, the wheel covers 32 bits of ticks
+
+static struct timer_wheel {
+    unsigned int jiffies;                   // the next tick to run
+    list_entry_t tv1[TVR_SIZE];
+    list_entry_t tvn[TVN_LEVELS][TVN_SIZE];
+} timer_wheel;
+
+// the slot of level n to be cascaded at jiffies
+#define TVN_INDEX(n)            ((timer_wheel.jiffies >> (TVR_BITS + (n) * TVN_BITS)) & TVN_MASK)
+
+static void check_timer(void);
 
 static struct sched_class *sched_class;
 
-static struct run_queue *rq;
+// every cpu has its own run queue, the processes are moved between them by load_balance
+#define this_rq()               (&(mycpu()->rq))
+#define rq2cpu(rq)              to_struct((rq), struct cpu, rq)
 
 static inline void
-sched_class_enqueue(struct proc_struct *proc) {
+sched_class_enqueue(struct run_queue *rq, struct proc_struct *proc) {
     if (proc != idleproc) {
         sched_class->enqueue(rq, proc);
     }
 }
 
 static inline void
-sched_class_dequeue(struct proc_struct *proc) {
+sched_class_dequeue(struct run_queue *rq, struct proc_struct *proc) {
     sched_class->dequeue(rq, proc);
 }
 
 static inline struct proc_struct *
-sched_class_pick_next(void) {
+sched_class_pick_next(struct run_queue *rq) {
     return sched_class->pick_next(rq);
 }
 
 static void
 sched_class_proc_tick(struct proc_struct *proc) {
     if (proc != idleproc) {
-        sched_class->proc_tick(rq, proc);
+        sched_class->proc_tick(this_rq(), proc);
     }
     else {
         proc->need_resched = 1;
     }
 }
 
-static struct run_queue __rq;
-
 void
 sched_init(void) {
-    list_init(&timer_list);
+    int i, n;
+    for (i = 0; i < TVR_SIZE; i ++) {
+        list_init(&(timer_wheel.tv1[i]));
+    }
+    for (n = 0; n < TVN_LEVELS; n ++) {
+        for (i = 0; i < TVN_SIZE; i ++) {
+            list_init(&(timer_wheel.tvn[n][i]));
+        }
+    }
+    check_timer();
 
+#if defined(SCHED_CLASS_cfs)
+    sched_class = &cfs_sched_class;
+#elif defined(SCHED_CLASS_mlfq)
+    sched_class = &mlfq_sched_class;
+#else
     sched_class = &default_sched_class;
+#endif
 
-    rq = &__rq;
-    rq->max_time_slice = MAX_TIME_SLICE;
-    sched_class->init(rq);
+    for (i = 0; i < ncpu; i ++) {
+        struct run_queue *rq = &(cpus[i].rq);
+        rq->max_time_slice = MAX_TIME_SLICE;
+        sched_class->init(rq);
+    }
 
     cprintf("sched class: %s\n", sched_class->name);
 }
 
+// cpu_load - the number of runnable processes of cpu, the running one included
+static inline int
+cpu_load(struct cpu *cpu) {
+    return cpu->rq.proc_num + (cpu->proc != cpu->idle);
+}
+
+/* *
+ * load_balance - move the next process of the busiest cpu to the run queue of this cpu,
+ * if the load of the busiest cpu is at least min_load. An idle cpu steals any queued
+ * process; the periodic balancing asks for 2 more than the load of this cpu, so that
+ * a process doesn't bounce between two cpus.
+ * */
+static bool
+load_balance(int min_load) {
+    struct cpu *cpu, *busiest = NULL;
+    for (cpu = cpus; cpu < cpus + ncpu; cpu ++) {
+        if (cpu != mycpu() && cpu->started && cpu->rq.proc_num != 0) {
+            if (busiest == NULL || cpu_load(cpu) > cpu_load(busiest)) {
+                busiest = cpu;
+            }
+        }
+    }
+    if (busiest == NULL || cpu_load(busiest) < min_load) {
+        return 0;
+    }
+    struct proc_struct *proc = sched_class_pick_next(&(busiest->rq));
+    sched_class_dequeue(&(busiest->rq), proc);
+    sched_class_enqueue(this_rq(), proc);
+    return 1;
+}
+
+/* *
+ * kick_idle_cpu - a process is queued on rq, wake up the cpu of rq if it is idle, or else
+ * another idle cpu, which steals the process. The woken cpu was halted in cpu_idle, or
+ * is waiting for the kernel lock.
+ * */
+static void
+kick_idle_cpu(struct run_queue *rq) {
+    struct cpu *cpu = rq2cpu(rq);
+    if (cpu->proc != cpu->idle) {
+        for (cpu = cpus; cpu < cpus + ncpu; cpu ++) {
+            if (cpu->started && cpu->proc == cpu->idle) {
+                break;
+            }
+        }
+    }
+    if (cpu < cpus + ncpu && cpu != mycpu() && !cpu->idle->need_resched) {
+        cpu->idle->need_resched = 1;
+        lapic_ipi(cpu->apic_id, IRQ_OFFSET + IRQ_IPI);
+    }
+}
+
 void
 wakeup_proc(struct proc_struct *proc) {
     assert(proc->state != PROC_ZOMBIE);
@@ -65,7 +166,12 @@ wakeup_proc(struct proc_struct *proc) {
             proc->state = PROC_RUNNABLE;
             proc->wait_state = 0;
             if (proc != current) {
-                sched_class_enqueue(proc);
+                // back to the cpu it ran on, or a new process starts on this cpu
+                struct run_queue *rq = (proc->rq != NULL) ? proc->rq : this_rq();
+                sched_class_enqueue(rq, proc);
+                if (ismp) {
+                    kick_idle_cpu(rq);
+                }
             }
         }
         else {
@@ -81,12 +187,16 @@ schedule(void) {
     struct proc_struct *next;
     local_intr_save(intr_flag);
     {
+        struct run_queue *rq = this_rq();
         current->need_resched = 0;
         if (current->state == PROC_RUNNABLE) {
-            sched_class_enqueue(current);
+            sched_class_enqueue(rq, current);
+        }
+        if ((next = sched_class_pick_next(rq)) == NULL && ismp && load_balance(1)) {
+            next = sched_class_pick_next(rq);
         }
-        if ((next = sched_class_pick_next()) != NULL) {
-            sched_class_dequeue(next);
+        if (next != NULL) {
+            sched_class_dequeue(rq, next);
         }
         if (next == NULL) {
             next = idleproc;
@@ -99,77 +209,214 @@ schedule(void) {
     local_intr_restore(intr_flag);
 }
 
+/* *
+ * Kernel preemption: the kernel code of a process, which runs with interrupts enabled, is
+ * rescheduled when an interrupt returns to it and the process needs it (see trap), unless
+ * its preempt_count is not zero. The count is raised by local_intr_save and spin_lock, and
+ * by trap while it handles an interrupt. It belongs to the process rather than the cpu: a
+ * process switches inside such a section (schedule runs with the interrupts disabled), and
+ * gets its own count back when it is switched back; a new process starts from 0 in forkret.
+ * There is no process before proc_init, nor anything to preempt.
+ * */
+void
+preempt_disable(void) {
+    struct proc_struct *proc = current;
+    if (proc != NULL) {
+        proc->preempt_count ++;
+    }
+}
+
+void
+preempt_enable(void) {
+    struct proc_struct *proc = current;
+    if (proc != NULL) {
+        assert(proc->preempt_count > 0);
+        proc->preempt_count --;
+    }
+}
+
+// wheel_add - put timer, which expires at tick timer->expires, in the slot of the wheel
+static void
+wheel_add(timer_t *timer) {
+    unsigned int expires = timer->expires, idx = expires - timer_wheel.jiffies;
+    list_entry_t *slot;
+    if (idx < TVR_SIZE) {
+        slot = timer_wheel.tv1 + (expires & TVR_MASK);
+    }
+    else {
+        int n = 0;
+        while (n < TVN_LEVELS - 1 && idx >= (1 << (TVR_BITS + (n + 1) * TVN_BITS))) {
+            n ++;
+        }
+        slot = timer_wheel.tvn[n] + ((expires >> (TVR_BITS + n * TVN_BITS)) & TVN_MASK);
+    }
+    list_add_before(slot, &(timer->timer_link));
+}
+
+// cascade - move the timers in the slot index of level n down the wheel
+static int
+cascade(int n, int index) {
+    list_entry_t *slot = &(timer_wheel.tvn[n][index]), *le;
+    while ((le = list_next(slot)) != slot) {
+        list_del(le);
+        wheel_add(le2timer(le, timer_link));
+    }
+    return index;
+}
+
+// wheel_run - run the timers of the next tick, with interrupts disabled
+static void
+wheel_run(void) {
+    int index = timer_wheel.jiffies & TVR_MASK, n;
+    if (index == 0) {
+        for (n = 0; n < TVN_LEVELS && cascade(n, TVN_INDEX(n)) == 0; n ++) {
+            /* cascade the next level too */;
+        }
+    }
+    timer_wheel.jiffies ++;
+
+    // take the slot away first: a timer added by func may go to the same slot
+    list_entry_t work, *le;
+    if (list_empty(&(timer_wheel.tv1[index]))) {
+        return;
+    }
+    list_add(&(timer_wheel.tv1[index]), &work);
+    list_del_init(&(timer_wheel.tv1[index]));
+    while ((le = list_next(&work)) != &work) {
+        timer_t *timer = le2timer(le, timer_link);
+        list_del_init(le);
+        timer->func(timer->arg);
+    }
+}
+
 void
 add_timer(timer_t *timer) {
     bool intr_flag;
     local_intr_save(intr_flag);
     {
-        assert(timer->expires > 0 && timer->proc != NULL);
+        assert(timer->expires > 0 && timer->func != NULL);
         assert(list_empty(&(timer->timer_link)));
-        list_entry_t *le = list_next(&timer_list);
-        while (le != &timer_list) {
-            timer_t *next = le2timer(le, timer_link);
-            if (timer->expires < next->expires) {
-                next->expires -= timer->expires;
-                break;
-            }
-            timer->expires -= next->expires;
-            le = list_next(le);
+        // expires ticks from now, the jiffies is run at the next tick
+        timer->expires += timer_wheel.jiffies - 1;
+        wheel_add(timer);
+        // the boot cpu, which runs the timers, is in tickless idle and may sleep past it
+        if (ismp && mycpu() != cpus && cpus[0].nohz) {
+            lapic_ipi(cpus[0].apic_id, IRQ_OFFSET + IRQ_IPI);
         }
-        list_add_before(le, &(timer->timer_link));
     }
     local_intr_restore(intr_flag);
 }
 
-// del timer from timer_list
+// del timer from the timer wheel
 void
 del_timer(timer_t *timer) {
     bool intr_flag;
     local_intr_save(intr_flag);
     {
-        if (!list_empty(&(timer->timer_link))) {
-            if (timer->expires != 0) {
-                list_entry_t *le = list_next(&(timer->timer_link));
-                if (le != &timer_list) {
-                    timer_t *next = le2timer(le, timer_link);
-                    next->expires += timer->expires;
-                }
-            }
-            list_del_init(&(timer->timer_link));
+        list_del_init(&(timer->timer_link));
+    }
+    local_intr_restore(intr_flag);
+}
+
+/* *
+ * timer_next_expiry - the number of ticks until a timer may expire, at most max: 1 is the
+ * next tick. At the wrap of tv1 the timers of the higher levels are cascaded down, and may
+ * expire at once, so the wrap counts as an expiry.
+ * */
+unsigned int
+timer_next_expiry(unsigned int max) {
+    unsigned int nticks;
+    for (nticks = 1; nticks < max; nticks ++) {
+        int index = (timer_wheel.jiffies + nticks - 1) & TVR_MASK;
+        if (index == 0 || !list_empty(&(timer_wheel.tv1[index]))) {
+            break;
         }
     }
+    return nticks;
+}
+
+// timer_catch_up - run the timers of the ticks which the boot cpu skipped in tickless idle
+void
+timer_catch_up(unsigned int nticks) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        while (nticks -- > 0) {
+            wheel_run();
+        }
+        vdso_data->ticks = ticks;
+        // the idle process checks the run queue, a process may be woken
+        current->need_resched = 1;
+    }
     local_intr_restore(intr_flag);
 }
 
-// call scheduler to update tick related info, and check the timer is expired? If expired, then wakup proc
+// timer_wakeup_proc - the func of the timers of timer_init, wake up the sleeping process arg
+void
+timer_wakeup_proc(void *arg) {
+    struct proc_struct *proc = arg;
+    if (proc->wait_state != 0) {
+        assert(proc->wait_state & WT_INTERRUPTED);
+    }
+    else {
+        warn("process %d's wait_state == 0.\n", proc->pid);
+    }
+    wakeup_proc(proc);
+}
+
+// call scheduler to update tick related info, and run the expired timers
+// NOTE: it is called on every tick of every cpu, but the timers count the ticks of the boot cpu
 void
 run_timer_list(void) {
     bool intr_flag;
     local_intr_save(intr_flag);
     {
-        list_entry_t *le = list_next(&timer_list);
-        if (le != &timer_list) {
-            timer_t *timer = le2timer(le, timer_link);
-            assert(timer->expires != 0);
-            timer->expires --;
-            while (timer->expires == 0) {
-                le = list_next(le);
-                struct proc_struct *proc = timer->proc;
-                if (proc->wait_state != 0) {
-                    assert(proc->wait_state & WT_INTERRUPTED);
-                }
-                else {
-                    warn("process %d's wait_state == 0.\n", proc->pid);
-                }
-                wakeup_proc(proc);
-                del_timer(timer);
-                if (le == &timer_list) {
-                    break;
-                }
-                timer = le2timer(le, timer_link);
-            }
+        struct cpu *cpu = mycpu();
+        if (cpu == cpus) {
+            wheel_run();
+            vdso_data->ticks = ticks;
         }
         sched_class_proc_tick(current);
+        if (ismp && ++ cpu->ticks % BALANCE_INTERVAL == 0) {
+            load_balance(cpu_load(cpu) + 2);
+        }
     }
     local_intr_restore(intr_flag);
 }
+
+static unsigned int check_fired[8];
+
+static void
+check_timer_func(void *arg) {
+    check_fired[(int)arg] = timer_wheel.jiffies;
+}
+
+// check_timer - run the wheel across its levels and its wrap around, without the clock
+static void
+check_timer(void) {
+    static const unsigned int expires[] = {1, 255, 256, 257, 1000, 20000, 1100000};
+    const int nr = sizeof(expires) / sizeof(expires[0]);
+    timer_t timers[sizeof(expires) / sizeof(expires[0]) + 1];
+    unsigned int start = timer_wheel.jiffies = -2000;
+    int i;
+
+    for (i = 0; i < nr; i ++) {
+        check_fired[i] = 0;
+        add_timer(timer_init_func(timers + i, check_timer_func, (void *)i, expires[i]));
+    }
+    check_fired[nr] = 0;
+    add_timer(timer_init_func(timers + nr, check_timer_func, (void *)nr, 500));
+    del_timer(timers + nr);
+    assert(!timer_pending(timers + nr));
+
+    while (timer_wheel.jiffies != start + expires[nr - 1]) {
+        wheel_run();
+    }
+    for (i = 0; i < nr; i ++) {
+        assert(!timer_pending(timers + i) && check_fired[i] == start + expires[i]);
+    }
+    assert(check_fired[nr] == 0);
+
+    timer_wheel.jiffies = 0;
+    cprintf("check_timer() succeeded!\n");
+}
@@ -4,29 +4,47 @@
 #include <defs.h>
 #include <list.h>
 #include <skew_heap.h>
+#include <rb_tree.h>
 
 #define MAX_TIME_SLICE 5
+#define MLFQ_LEVELS 3
 
 struct proc_struct;
 
 typedef struct {
-    unsigned int expires;       //the expire time
-    struct proc_struct *proc;   //the proc wait in this timer. If the expire time is end, then this proc will be scheduled
-    list_entry_t timer_link;    //the timer list
+    unsigned int expires;       //the expire time, in ticks from now until add_timer, then the tick of the timer wheel
+    void (*func)(void *arg);    //called with arg when the timer expires, in the timer interrupt
+    void *arg;                  //the argument of func
+    list_entry_t timer_link;    //the entry linked in a slot of the timer wheel
 } timer_t;
 
 #define le2timer(le, member)            \
 to_struct((le), timer_t, member)
 
-// init a timer
+// init a timer which calls func(arg) after expires ticks, e.g. the timeout of a driver
 static inline timer_t *
-timer_init(timer_t *timer, struct proc_struct *proc, int expires) {
+timer_init_func(timer_t *timer, void (*func)(void *arg), void *arg, int expires) {
     timer->expires = expires;
-    timer->proc = proc;
+    timer->func = func;
+    timer->arg = arg;
     list_init(&(timer->timer_link));
     return timer;
 }
 
+void timer_wakeup_proc(void *arg);
+
+// init a timer which wakes up proc after expires ticks
+static inline timer_t *
+timer_init(timer_t *timer, struct proc_struct *proc, int expires) {
+    return timer_init_func(timer, timer_wakeup_proc, proc, expires);
+}
+
+// the timer is added and not expired yet
+static inline bool
+timer_pending(timer_t *timer) {
+    return !list_empty(&(timer->timer_link));
+}
+
 struct run_queue;
 
 // The introduction of scheduling classes is borrrowed from Linux, and makes the 
@@ -45,12 +63,9 @@ struct sched_class {
     struct proc_struct *(*pick_next)(struct run_queue *rq);
     // dealer of the time-tick
     void (*proc_tick)(struct run_queue *rq, struct proc_struct *proc);
-    /* for SMP support in the future
-     *  load_balance
-     *     void (*load_balance)(struct rq* rq);
-     *  get some proc from this rq, used in load_balance,
-     *  return value is the num of gotten proc
-     *  int (*get_proc)(struct rq* rq, struct proc* procs_moved[]);
+    /* for SMP, every cpu has its own run queue, load_balance in sched.c moves the
+     * next process (pick_next) of the busiest run queue to an idle or less loaded
+     * cpu with dequeue and enqueue, so a sched_class needs no more methods.
      */
 };
 
@@ -60,14 +75,25 @@ struct run_queue {
     int max_time_slice;
     // For LAB6 ONLY
     skew_heap_entry_t *lab6_run_pool;
+    // for the cfs scheduler: the processes ordered by virtual runtime, and their total weight
+    rb_tree *cfs_tree;
+    uint64_t cfs_min_vruntime;
+    uint32_t cfs_weight;
+    // for the mlfq scheduler: a queue per priority level, the ticks since the last boost
+    list_entry_t mlfq_run_list[MLFQ_LEVELS];
+    unsigned int mlfq_ticks;
 };
 
 void sched_init(void);
 void wakeup_proc(struct proc_struct *proc);
 void schedule(void);
-void add_timer(timer_t *timer);     // add timer to timer_list
-void del_timer(timer_t *timer);     // del timer from timer_list
-void run_timer_list(void);          // call scheduler to update tick related info, and check the timer is expired? If expired, then wakup proc
+void add_timer(timer_t *timer);     // add timer to the timer wheel
+void del_timer(timer_t *timer);     // del timer from the timer wheel
+unsigned int timer_next_expiry(unsigned int max);
+void timer_catch_up(unsigned int nticks);
+void run_timer_list(void);          // call scheduler to update tick related info, and run the expired timers
+void preempt_disable(void);
+void preempt_enable(void);
 
 #endif /* !__KERN_SCHEDULE_SCHED_H__ */
 
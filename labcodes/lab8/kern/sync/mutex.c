@@ -0,0 +1,221 @@
+#include <defs.h>
+#include <list.h>
+#include <wait.h>
+#include <sync.h>
+#include <proc.h>
+#include <sched.h>
+#include <mutex.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* *
+ * The mutex, a semaphore of 1 which knows its owner, against priority inversion:
+ *   - the waiters queue by proc_priority, FIFO among the same priority, and the first
+ *     one gets the mutex handed over by mutex_unlock;
+ *   - the owner inherits the priority of the first waiter of every mutex it holds, so
+ *     a low priority owner isn't starved by the processes of a middle priority while a
+ *     high priority process waits; it gives the priority up when it unlocks;
+ *   - an owner waiting for another mutex passes the priority on to the owner of that
+ *     one, along a chain of at most MUTEX_PI_DEPTH owners.
+ * The priority is the weight of the cfs scheduler; RR and MLFQ only see the wait order.
+ * */
+
+#define MUTEX_PI_DEPTH          8       // the longest chain of owners the priority is passed along
+
+void
+mutex_init(mutex_t *mutex) {
+    mutex->locked = 0;
+    mutex->owner = NULL;
+    wait_queue_init(&(mutex->wait_queue));
+    list_init(&(mutex->held_link));
+}
+
+// mutex_wait_add - queue wait behind the waiters of the same or a higher priority
+static void
+mutex_wait_add(mutex_t *mutex, wait_t *wait) {
+    uint32_t priority = proc_priority(wait->proc);
+    wait_t *next = wait_queue_first(&(mutex->wait_queue));
+    while (next != NULL && proc_priority(next->proc) >= priority) {
+        next = wait_queue_next(&(mutex->wait_queue), next);
+    }
+    wait_queue_add_before(&(mutex->wait_queue), next, wait);
+}
+
+// mutex_wait_find - the wait of proc in the wait queue of mutex
+static wait_t *
+mutex_wait_find(mutex_t *mutex, struct proc_struct *proc) {
+    wait_t *wait = wait_queue_first(&(mutex->wait_queue));
+    while (wait != NULL && wait->proc != proc) {
+        wait = wait_queue_next(&(mutex->wait_queue), wait);
+    }
+    assert(wait != NULL);
+    return wait;
+}
+
+/* *
+ * mutex_pi_update - recompute the inherited priority of proc from the first waiters of the
+ * mutexes it holds. If it changes and proc waits for a mutex itself, requeue proc there and
+ * go on with the owner of that mutex.
+ * */
+static void
+mutex_pi_update(struct proc_struct *proc) {
+    int depth;
+    for (depth = 0; proc != NULL && depth < MUTEX_PI_DEPTH; depth ++) {
+        uint32_t priority = 0;
+        list_entry_t *list = &(proc->mutex_list), *le = list;
+        while ((le = list_next(le)) != list) {
+            wait_t *wait = wait_queue_first(&(le2mutex(le, held_link)->wait_queue));
+            if (wait != NULL && proc_priority(wait->proc) > priority) {
+                priority = proc_priority(wait->proc);
+            }
+        }
+        if (proc->pi_priority == priority) {
+            break;
+        }
+        proc->pi_priority = priority;
+
+        mutex_t *mutex;
+        if ((mutex = proc->mutex_wait) == NULL) {
+            break;
+        }
+        wait_t *wait = mutex_wait_find(mutex, proc);
+        wait_queue_del(&(mutex->wait_queue), wait);
+        mutex_wait_add(mutex, wait);
+        proc = mutex->owner;
+    }
+}
+
+static void
+mutex_set_owner(mutex_t *mutex, struct proc_struct *proc) {
+    mutex->locked = 1;
+    mutex->owner = proc;
+    if (proc != NULL) {
+        list_add(&(proc->mutex_list), &(mutex->held_link));
+    }
+}
+
+void
+mutex_lock(mutex_t *mutex) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    if (!mutex->locked) {
+        mutex_set_owner(mutex, current);
+        local_intr_restore(intr_flag);
+        return;
+    }
+    if (current == NULL || mutex->owner == current) {
+        panic("mutex_lock: deadlock.\n");
+    }
+    wait_t __wait, *wait = &__wait;
+    wait_init(wait, current);
+    current->state = PROC_SLEEPING;
+    current->wait_state = WT_KMUTEX;
+    current->mutex_wait = mutex;
+    mutex_wait_add(mutex, wait);
+    mutex_pi_update(mutex->owner);
+    local_intr_restore(intr_flag);
+
+    schedule();
+
+    // handed over by mutex_unlock
+    assert(mutex->owner == current && !wait_in_queue(wait));
+}
+
+bool
+mutex_trylock(mutex_t *mutex) {
+    bool intr_flag, ret = 0;
+    local_intr_save(intr_flag);
+    if (!mutex->locked) {
+        mutex_set_owner(mutex, current);
+        ret = 1;
+    }
+    local_intr_restore(intr_flag);
+    return ret;
+}
+
+void
+mutex_unlock(mutex_t *mutex) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        struct proc_struct *owner = mutex->owner;
+        if (!mutex->locked || owner != current) {
+            panic("mutex_unlock: not held by the current process.\n");
+        }
+        if (owner != NULL) {
+            list_del_init(&(mutex->held_link));
+        }
+        mutex->locked = 0;
+        mutex->owner = NULL;
+
+        wait_t *wait;
+        if ((wait = wait_queue_first(&(mutex->wait_queue))) != NULL) {
+            assert(wait->proc->wait_state == WT_KMUTEX);
+            wait_queue_del(&(mutex->wait_queue), wait);
+            wait->proc->mutex_wait = NULL;
+            mutex_set_owner(mutex, wait->proc);
+            mutex_pi_update(wait->proc);
+            wakeup_wait(&(mutex->wait_queue), wait, WT_KMUTEX, 0);
+        }
+        // give up the priority inherited through mutex
+        mutex_pi_update(owner);
+    }
+    local_intr_restore(intr_flag);
+}
+
+static int check_mutex_order[2], check_mutex_count;
+
+static int
+check_mutex_thread(void *arg) {
+    mutex_t *mutex = arg;
+    mutex_lock(mutex);
+    check_mutex_order[check_mutex_count ++] = current->pid;
+    mutex_unlock(mutex);
+    return 0;
+}
+
+// check_mutex_waiter - start a kernel thread of priority, and wait until it waits for mutex
+static struct proc_struct *
+check_mutex_waiter(mutex_t *mutex, uint32_t priority) {
+    int pid = kernel_thread(check_mutex_thread, mutex, 0);
+    assert(pid > 0);
+    struct proc_struct *proc = find_proc(pid);
+    proc->lab6_priority = priority;
+    while (proc->mutex_wait != mutex) {
+        do_sleep(1);
+    }
+    return proc;
+}
+
+void
+check_mutex(void) {
+    mutex_t mutex;
+    mutex_init(&mutex);
+    uint32_t priority = proc_priority(current);
+
+    mutex_lock(&mutex);
+    assert(mutex.owner == current && mutex_trylock(&mutex) == 0);
+
+    struct proc_struct *low = check_mutex_waiter(&mutex, priority + 1);
+    assert(proc_priority(current) == priority + 1);
+    struct proc_struct *high = check_mutex_waiter(&mutex, priority + 4);
+    assert(proc_priority(current) == priority + 4);
+    assert(wait_queue_first(&(mutex.wait_queue))->proc == high);
+
+    int low_pid = low->pid, high_pid = high->pid;
+    check_mutex_count = 0;
+    // not preempted by high before the handover is checked
+    preempt_disable();
+    mutex_unlock(&mutex);
+    assert(proc_priority(current) == priority);
+    assert(mutex.owner == high && high->pi_priority == priority + 1);
+    preempt_enable();
+
+    assert(do_wait(high_pid, NULL) == 0 && do_wait(low_pid, NULL) == 0);
+    assert(check_mutex_count == 2);
+    assert(check_mutex_order[0] == high_pid && check_mutex_order[1] == low_pid);
+    assert(!mutex.locked && list_empty(&(current->mutex_list)));
+
+    cprintf("check_mutex() succeeded!\n");
+}
+
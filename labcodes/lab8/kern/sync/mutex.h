@@ -0,0 +1,29 @@
+#ifndef __KERN_SYNC_MUTEX_H__
+#define __KERN_SYNC_MUTEX_H__
+
+#include <defs.h>
+#include <list.h>
+#include <wait.h>
+
+struct proc_struct;
+
+// a sleeping lock with an owner, which inherits the priority of its waiters, see mutex.c
+typedef struct mutex {
+    bool locked;                    // is the mutex held?
+    struct proc_struct *owner;      // the process holding the mutex, NULL before the first process
+    wait_queue_t wait_queue;        // the waiters, the highest priority first
+    list_entry_t held_link;         // the entry linked in the mutex_list of the owner
+} mutex_t;
+
+#define le2mutex(le, member)        \
+    to_struct((le), mutex_t, member)
+
+void mutex_init(mutex_t *mutex);
+void mutex_lock(mutex_t *mutex);
+bool mutex_trylock(mutex_t *mutex);
+void mutex_unlock(mutex_t *mutex);
+
+void check_mutex(void);
+
+#endif /* !__KERN_SYNC_MUTEX_H__ */
+
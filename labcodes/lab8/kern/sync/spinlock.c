@@ -0,0 +1,109 @@
+#include <defs.h>
+#include <x86.h>
+#include <mp.h>
+#include <pmm.h>
+#include <sched.h>
+#include <spinlock.h>
+#include <assert.h>
+
+void
+spinlock_init(spinlock_t *lock, const char *name) {
+    lock->locked = 0;
+    lock->name = name;
+    lock->cpu = NULL;
+}
+
+bool
+spin_holding(spinlock_t *lock) {
+    return lock->locked && lock->cpu == mycpu();
+}
+
+static bool
+__spin_trylock(spinlock_t *lock) {
+    if (xchg(&(lock->locked), 1) == 0) {
+        lock->cpu = mycpu();
+        return 1;
+    }
+    return 0;
+}
+
+// __spin_lock - spin until the lock is acquired. The cpu may spin with interrupts disabled,
+// so it answers the TLB shootdown of the lock holder here instead of in the IPI handler
+static void
+__spin_lock(spinlock_t *lock) {
+    if (spin_holding(lock)) {
+        panic("spin_lock: %s is held by this cpu.\n", lock->name);
+    }
+    while (!__spin_trylock(lock)) {
+        while (lock->locked) {
+            tlb_shootdown_ack();
+            pause();
+        }
+    }
+}
+
+static void
+__spin_unlock(spinlock_t *lock) {
+    if (!spin_holding(lock)) {
+        panic("spin_unlock: %s is not held by this cpu.\n", lock->name);
+    }
+    lock->cpu = NULL;
+    xchg(&(lock->locked), 0);
+}
+
+// a spin lock is held by the cpu, so its holder isn't preempted, see preempt_disable
+bool
+spin_trylock(spinlock_t *lock) {
+    preempt_disable();
+    if (__spin_trylock(lock)) {
+        return 1;
+    }
+    preempt_enable();
+    return 0;
+}
+
+void
+spin_lock(spinlock_t *lock) {
+    preempt_disable();
+    __spin_lock(lock);
+}
+
+void
+spin_unlock(spinlock_t *lock) {
+    __spin_unlock(lock);
+    preempt_enable();
+}
+
+/* *
+ * The kernel lock: only one cpu runs kernel code at a time, while the other cpus run
+ * user processes in parallel or wait for the lock, so the kernel code written for one
+ * cpu (local_intr_save, wait queues, ...) stays correct.
+ *
+ * The lock is held by the cpu rather than by a process, it stays held across a process
+ * switch. A cpu takes it when it traps from user mode or from the idle halt, and gives
+ * it up on the way back to user mode (trap, forkret) and in the idle halt (cpu_idle).
+ * Nothing is done with one cpu. Unlike the other spin locks it doesn't stop preemption:
+ * it stays with the cpu when a process is preempted in kernel code, see trap.
+ * */
+static spinlock_t kernel_lock = {0, "kernel_lock", NULL};
+
+void
+lock_kernel(void) {
+    if (ismp) {
+        __spin_lock(&kernel_lock);
+    }
+}
+
+void
+unlock_kernel(void) {
+    if (ismp) {
+        __spin_unlock(&kernel_lock);
+    }
+}
+
+// kernel_locked - test if this cpu may run kernel code
+bool
+kernel_locked(void) {
+    return !ismp || spin_holding(&kernel_lock);
+}
+
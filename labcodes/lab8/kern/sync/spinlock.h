@@ -0,0 +1,25 @@
+#ifndef __KERN_SYNC_SPINLOCK_H__
+#define __KERN_SYNC_SPINLOCK_H__
+
+#include <defs.h>
+
+struct cpu;
+
+typedef struct {
+    volatile uint32_t locked;   // is the lock held?
+    const char *name;           // name of lock, for debugging
+    struct cpu *cpu;            // the cpu holding the lock
+} spinlock_t;
+
+void spinlock_init(spinlock_t *lock, const char *name);
+void spin_lock(spinlock_t *lock);
+bool spin_trylock(spinlock_t *lock);
+void spin_unlock(spinlock_t *lock);
+bool spin_holding(spinlock_t *lock);
+
+void lock_kernel(void);
+void unlock_kernel(void);
+bool kernel_locked(void);
+
+#endif /* !__KERN_SYNC_SPINLOCK_H__ */
+
@@ -8,8 +8,10 @@
 #include <atomic.h>
 #include <sched.h>
 
+// the interrupts are disabled and the process isn't preempted, see preempt_disable
 static inline bool
 __intr_save(void) {
+    preempt_disable();
     if (read_eflags() & FL_IF) {
         intr_disable();
         return 1;
@@ -22,6 +24,7 @@ __intr_restore(bool flag) {
     if (flag) {
         intr_enable();
     }
+    preempt_enable();
 }
 
 #define local_intr_save(x)      do { x = __intr_save(); } while (0)
@@ -23,6 +23,15 @@ wait_queue_add(wait_queue_t *queue, wait_t *wait) {
     list_add_before(&(queue->wait_head), &(wait->wait_link));
 }
 
+// wait_queue_add_before - add wait in front of next, or at the tail of queue if next is NULL
+void
+wait_queue_add_before(wait_queue_t *queue, wait_t *next, wait_t *wait) {
+    assert(list_empty(&(wait->wait_link)) && wait->proc != NULL);
+    assert(next == NULL || next->wait_queue == queue);
+    wait->wait_queue = queue;
+    list_add_before((next != NULL) ? &(next->wait_link) : &(queue->wait_head), &(wait->wait_link));
+}
+
 void
 wait_queue_del(wait_queue_t *queue, wait_t *wait) {
     assert(!list_empty(&(wait->wait_link)) && wait->wait_queue == queue);
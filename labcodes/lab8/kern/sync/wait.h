@@ -22,6 +22,7 @@ typedef struct {
 void wait_init(wait_t *wait, struct proc_struct *proc);
 void wait_queue_init(wait_queue_t *queue);
 void wait_queue_add(wait_queue_t *queue, wait_t *wait);
+void wait_queue_add_before(wait_queue_t *queue, wait_t *next, wait_t *wait);
 void wait_queue_del(wait_queue_t *queue, wait_t *wait);
 
 wait_t *wait_queue_next(wait_queue_t *queue, wait_t *wait);
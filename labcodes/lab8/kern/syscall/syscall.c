@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <pmm.h>
 #include <assert.h>
+#include <error.h>
 #include <clock.h>
 #include <stat.h>
 #include <dirent.h>
@@ -24,6 +25,22 @@ sys_fork(uint32_t arg[]) {
     return do_fork(0, stack, tf);
 }
 
+/* sys_clone - create a thread (or a process) according to clone_flags
+ * arg[0]: clone_flags, CLONE_VM & CLONE_FS share the mm and the files with current
+ * arg[1]: the user stack of the child, 0 means using the stack of current
+ * arg[2]: the tls base of the child, used if CLONE_SETTLS is set (see copy_tls)
+ */
+static int
+sys_clone(uint32_t arg[]) {
+    struct trapframe *tf = current->tf;
+    uint32_t clone_flags = (uint32_t)arg[0];
+    uintptr_t stack = (uintptr_t)arg[1];
+    if (stack == 0) {
+        stack = tf->tf_esp;
+    }
+    return do_fork(clone_flags, stack, tf);
+}
+
 static int
 sys_wait(uint32_t arg[]) {
     int pid = (int)arg[0];
@@ -72,6 +89,56 @@ static int
 sys_gettime(uint32_t arg[]) {
     return (int)ticks;
 }
+
+static int
+sys_clock_gettime(uint32_t arg[]) {
+    int clock_id = (int)arg[0];
+    struct timespec *ts = (struct timespec *)arg[1];
+    return do_clock_gettime(clock_id, ts);
+}
+
+static int
+sys_nanosleep(uint32_t arg[]) {
+    const struct timespec *req = (const struct timespec *)arg[0];
+    return do_nanosleep(req);
+}
+
+static int
+sys_brk(uint32_t arg[]) {
+    uintptr_t *brk_store = (uintptr_t *)arg[0];
+    return do_brk(brk_store);
+}
+
+static int
+sys_mmap(uint32_t arg[]) {
+    uintptr_t *addr_store = (uintptr_t *)arg[0];
+    size_t len = (size_t)arg[1];
+    uint32_t mmap_flags = (uint32_t)arg[2];
+    return do_mmap(addr_store, len, mmap_flags);
+}
+
+static int
+sys_munmap(uint32_t arg[]) {
+    uintptr_t addr = (uintptr_t)arg[0];
+    size_t len = (size_t)arg[1];
+    return do_munmap(addr, len);
+}
+
+/* sys_shmem - the shared memory segments
+ * arg[0]: SHMEM_ATTACH, arg[1]: addr_store, arg[2]: key, arg[3]: len, arg[4]: flags
+ *         SHMEM_DETACH, arg[1]: addr
+ */
+static int
+sys_shmem(uint32_t arg[]) {
+    switch (arg[0]) {
+    case SHMEM_ATTACH:
+        return do_shmem_attach((uintptr_t *)arg[1], (int)arg[2], (size_t)arg[3], (uint32_t)arg[4]);
+    case SHMEM_DETACH:
+        return do_shmem_detach((uintptr_t)arg[1]);
+    }
+    return -E_INVAL;
+}
+
 static int
 sys_lab6_set_priority(uint32_t arg[])
 {
@@ -162,12 +229,19 @@ static int (*syscalls[])(uint32_t arg[]) = {
     [SYS_fork]              sys_fork,
     [SYS_wait]              sys_wait,
     [SYS_exec]              sys_exec,
+    [SYS_clone]             sys_clone,
     [SYS_yield]             sys_yield,
     [SYS_kill]              sys_kill,
     [SYS_getpid]            sys_getpid,
+    [SYS_brk]               sys_brk,
+    [SYS_mmap]              sys_mmap,
+    [SYS_munmap]            sys_munmap,
+    [SYS_shmem]             sys_shmem,
     [SYS_putc]              sys_putc,
     [SYS_pgdir]             sys_pgdir,
     [SYS_gettime]           sys_gettime,
+    [SYS_clock_gettime]     sys_clock_gettime,
+    [SYS_nanosleep]         sys_nanosleep,
     [SYS_lab6_set_priority] sys_lab6_set_priority,
     [SYS_sleep]             sys_sleep,
     [SYS_open]              sys_open,
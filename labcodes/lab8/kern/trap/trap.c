@@ -16,6 +16,9 @@
 #include <sched.h>
 #include <sync.h>
 #include <proc.h>
+#include <spinlock.h>
+#include <lapic.h>
+#include <mp.h>
 
 #define TICK_NUM 100
 
@@ -42,21 +45,20 @@ static struct pseudodesc idt_pd = {
 /* idt_init - initialize IDT to each of the entry points in kern/trap/vectors.S */
 void
 idt_init(void) {
-     /* LAB1 YOUR CODE : STEP 2 */
-     /* (1) Where are the entry addrs of each Interrupt Service Routine (ISR)?
-      *     All ISR's entry addrs are stored in __vectors. where is uintptr_t __vectors[] ?
-      *     __vectors[] is in kern/trap/vector.S which is produced by tools/vector.c
-      *     (try "make" command in lab1, then you will find vector.S in kern/trap DIR)
-      *     You can use  "extern uintptr_t __vectors[];" to define this extern variable which will be used later.
-      * (2) Now you should setup the entries of ISR in Interrupt Description Table (IDT).
-      *     Can you see idt[256] in this file? Yes, it's IDT! you can use SETGATE macro to setup each item of IDT
-      * (3) After setup the contents of IDT, you will let CPU know where is the IDT by using 'lidt' instruction.
-      *     You don't know the meaning of this instruction? just google it! and check the libs/x86.h to know more.
-      *     Notice: the argument of lidt is idt_pd. try to find it!
-      */
-     /* LAB5 YOUR CODE */ 
-     //you should update your lab1 code (just add ONE or TWO lines of code), let user app to use syscall to get the service of ucore
-     //so you should setup the syscall interrupt gate in here
+    extern uintptr_t __vectors[];
+    int i;
+    for (i = 0; i < sizeof(idt) / sizeof(struct gatedesc); i ++) {
+        SETGATE(idt[i], 0, GD_KTEXT, __vectors[i], DPL_KERNEL);
+    }
+    // the system calls come from user mode, through a trap gate: the kernel runs them with interrupts enabled
+    SETGATE(idt[T_SYSCALL], 1, GD_KTEXT, __vectors[T_SYSCALL], DPL_USER);
+    lidt(&idt_pd);
+}
+
+/* idt_init_ap - load the IDT, which is shared by all cpus, on an application processor */
+void
+idt_init_ap(void) {
+    lidt(&idt_pd);
 }
 
 static const char *
@@ -158,6 +160,12 @@ print_pgfault(struct trapframe *tf) {
             (tf->tf_err & 1) ? "protection fault" : "no page found");
 }
 
+/* *
+ * pgfault_handler - handle the page fault on the mm of current under lock_mm: do_pgfault may
+ * sleep (disk I/O, memory reclaim), while a sibling thread could unmap the vma or fault on
+ * the same page. The kernel code which accesses the user memory, see copy_from_user, may
+ * hold the lock already.
+ * */
 static int
 pgfault_handler(struct trapframe *tf) {
     extern struct mm_struct *check_mm_struct;
@@ -165,6 +173,7 @@ pgfault_handler(struct trapframe *tf) {
             print_pgfault(tf);
         }
     struct mm_struct *mm;
+    bool locked = 0;
     if (check_mm_struct != NULL) {
         assert(current == idleproc);
         mm = check_mm_struct;
@@ -176,8 +185,16 @@ pgfault_handler(struct trapframe *tf) {
             panic("unhandled page fault.\n");
         }
         mm = current->mm;
+        if (mm != NULL && mm->locked_by != current->pid) {
+            lock_mm(mm);
+            locked = 1;
+        }
     }
-    return do_pgfault(mm, tf->tf_err, rcr2());
+    int ret = do_pgfault(mm, tf->tf_err, rcr2());
+    if (locked) {
+        unlock_mm(mm);
+    }
+    return ret;
 }
 
 static volatile int in_swap_tick_event = 0;
@@ -200,8 +217,8 @@ trap_dispatch(struct trapframe *tf) {
                 if (trap_in_kernel(tf)) {
                     panic("handle pgfault failed in kernel mode. ret=%d\n", ret);
                 }
+                // a user process which faults on a bad address or runs out of memory is killed
                 cprintf("killed by kernel.\n");
-                panic("handle user mode pgfault failed. ret=%d\n", ret); 
                 do_exit(-E_KILLED);
             }
         }
@@ -210,30 +227,16 @@ trap_dispatch(struct trapframe *tf) {
         syscall();
         break;
     case IRQ_OFFSET + IRQ_TIMER:
-#if 0
-    LAB3 : If some page replacement algorithm(such as CLOCK PRA) need tick to change the priority of pages,
-    then you can add code here. 
-#endif
-        /* LAB1 YOUR CODE : STEP 3 */
-        /* handle the timer interrupt */
-        /* (1) After a timer interrupt, you should record this event using a global variable (increase it), such as ticks in kern/driver/clock.c
-         * (2) Every TICK_NUM cycle, you can print some info using a funciton, such as print_ticks().
-         * (3) Too Simple? Yes, I think so!
-         */
-        /* LAB5 YOUR CODE */
-        /* you should upate you lab1 code (just add ONE or TWO lines of code):
-         *    Every TICK_NUM cycle, you should set current process's current->need_resched = 1
-         */
-        /* LAB6 YOUR CODE */
-        /* you should upate you lab5 code
-         * IMPORTANT FUNCTIONS:
-	     * sched_class_proc_tick
-         */         
-        /* LAB7 YOUR CODE */
-        /* you should upate you lab6 code
-         * IMPORTANT FUNCTIONS:
-	     * run_timer_list
-         */
+        // the boot cpu (8253 counter 0) counts the ticks, then runs the timer wheel and the scheduler tick
+        ticks ++;
+        run_timer_list();
+        break;
+    case IRQ_OFFSET + IRQ_APTIMER:
+        // the ticks of the application processors, only the boot cpu counts the ticks
+        run_timer_list();
+        break;
+    case IRQ_OFFSET + IRQ_ERROR:
+        cprintf("lapic error on cpu%d.\n", mycpu()->id);
         break;
     case IRQ_OFFSET + IRQ_COM1:
     case IRQ_OFFSET + IRQ_KBD:
@@ -265,6 +268,18 @@ trap_dispatch(struct trapframe *tf) {
     }
 }
 
+/* *
+ * kernel_preemptible - if the kernel code interrupted by the irq tf may be preempted: it
+ * runs as the process (not the idle loop), which has asked for it, and holds no preempt
+ * count. A process which has not slept yet (state set by wait_current_set, do_sleep, ...)
+ * is left to schedule itself, so it isn't taken off the run queue by the preemption.
+ * */
+static bool
+kernel_preemptible(struct trapframe *tf) {
+    return (tf->tf_eflags & FL_IF) && current != idleproc && current->need_resched
+        && current->preempt_count == 0 && current->state == PROC_RUNNABLE;
+}
+
 /* *
  * trap - handles or dispatches an exception/interrupt. if and when trap() returns,
  * the code in kern/trap/trapentry.S restores the old CPU state saved in the
@@ -272,6 +287,26 @@ trap_dispatch(struct trapframe *tf) {
  * */
 void
 trap(struct trapframe *tf) {
+    if (ismp) {
+        // all the irqs come from the local APIC, except the spurious one
+        if (tf->tf_trapno >= IRQ_OFFSET && tf->tf_trapno < IRQ_OFFSET + IRQ_SPURIOUS) {
+            lapic_eoi();
+        }
+        // the IPIs are handled without the kernel lock, the sender may hold it and wait
+        if (tf->tf_trapno == IRQ_OFFSET + IRQ_IPI || tf->tf_trapno == IRQ_OFFSET + IRQ_SPURIOUS) {
+            tlb_shootdown_ack();
+            return;
+        }
+    }
+
+    // only one cpu runs kernel code, take the kernel lock unless this cpu holds it. Only the
+    // kernel code which holds the lock may be preempted on the return, not the idle halt or
+    // the way to and from user mode, which run without it
+    bool locked = !kernel_locked();
+    if (locked) {
+        lock_kernel();
+    }
+
     // dispatch based on what type of trap occurred
     // used for previous projects
     if (current == NULL) {
@@ -283,8 +318,16 @@ trap(struct trapframe *tf) {
         current->tf = tf;
     
         bool in_kernel = trap_in_kernel(tf);
-    
+        bool irq = (tf->tf_trapno >= IRQ_OFFSET && tf->tf_trapno < IRQ_OFFSET + 32);
+
+        // the interrupt handlers are not preempted
+        if (irq) {
+            preempt_disable();
+        }
         trap_dispatch(tf);
+        if (irq) {
+            preempt_enable();
+        }
     
         current->tf = otf;
         if (!in_kernel) {
@@ -295,6 +338,14 @@ trap(struct trapframe *tf) {
                 schedule();
             }
         }
+        else if (irq && !locked && kernel_preemptible(tf)) {
+            schedule();
+        }
+    }
+
+    // give up the kernel lock on the way back to user mode, or if it is taken above
+    if (locked || !trap_in_kernel(tf)) {
+        unlock_kernel();
     }
 }
 
@@ -35,6 +35,8 @@
 #define IRQ_COM1                4
 #define IRQ_IDE1                14
 #define IRQ_IDE2                15
+#define IRQ_APTIMER             16  // local APIC timer of the application processors
+#define IRQ_IPI                 17  // inter-processor interrupt
 #define IRQ_ERROR               19
 #define IRQ_SPURIOUS            31
 
@@ -84,6 +86,7 @@ void idt_init(void);
 void print_trapframe(struct trapframe *tf);
 void print_regs(struct pushregs *regs);
 bool trap_in_kernel(struct trapframe *tf);
+void idt_init_ap(void);
 
 #endif /* !__KERN_TRAP_TRAP_H__ */
 
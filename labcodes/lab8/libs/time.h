@@ -0,0 +1,17 @@
+#ifndef __LIBS_TIME_H__
+#define __LIBS_TIME_H__
+
+#include <defs.h>
+
+#define NSEC_PER_SEC            1000000000
+
+/* clock ids of clock_gettime */
+#define CLOCK_MONOTONIC         1           // the time since boot, counted by the TSC
+
+struct timespec {
+    uint32_t tv_sec;                        // seconds
+    uint32_t tv_nsec;                       // nanoseconds, less than NSEC_PER_SEC
+};
+
+#endif /* !__LIBS_TIME_H__ */
+
@@ -12,8 +12,11 @@
 #define SYS_yield           10
 #define SYS_sleep           11
 #define SYS_kill            12
+#define SYS_nanosleep       15
+#define SYS_clock_gettime   16
 #define SYS_gettime         17
 #define SYS_getpid          18
+#define SYS_brk             19
 #define SYS_mmap            20
 #define SYS_munmap          21
 #define SYS_shmem           22
@@ -36,6 +39,24 @@
 #define CLONE_VM            0x00000100  // set if VM shared between processes
 #define CLONE_THREAD        0x00000200  // thread group
 #define CLONE_FS            0x00000800  // set if shared between processes
+#define CLONE_SETTLS        0x00080000  // set the tls base of the child
+
+/* the GDT entry of the user tls segment, whose base CLONE_SETTLS sets; a thread loads the
+ * selector USER_TLS into %gs. The other segments are in kern/mm/memlayout.h */
+#define SEG_UTLS            6
+#define USER_TLS            ((SEG_UTLS << 3) | 3)
+
+/* SYS_mmap flags */
+#define MMAP_WRITE          0x00000100  // the mapping is writable
+#define MMAP_STACK          0x00000200  // the mapping is used as a stack
+#define MMAP_LARGE          0x00000400  // map with 4M large pages if possible
+
+/* SYS_shmem operations & flags */
+#define SHMEM_ATTACH        1           // attach (or create) the segment of a key
+#define SHMEM_DETACH        2           // detach the segment at an address
+#define SHMEM_PRIVATE       0           // the key of a new segment shared only with children
+#define SHMEM_CREAT         0x00001000  // create the segment if it does not exist
+#define SHMEM_EXCL          0x00002000  // error if SHMEM_CREAT and the segment exists
 
 /* VFS flags */
 // flags for open: choose one of these
@@ -0,0 +1,40 @@
+#ifndef __LIBS_VDSO_H__
+#define __LIBS_VDSO_H__
+
+/* *
+ * The vdso pages are mapped read-only into every user address space by load_icode, just
+ * below the user stack (USTACKTOP - USTACKSIZE, see memlayout.h). The kernel publishes
+ * there what user programs ask for often, so gettime_msec, gettime_nsec and getpid in
+ * user/libs read it without a system call:
+ *   - the first page (struct vdso_data) is one page shared by all processes;
+ *   - the second page (struct vdso_proc) belongs to the address space.
+ * The first page also has the code which enters the kernel with SYSENTER at VDSO_SYSENTER,
+ * see __vdso_sysenter in trapentry.S.
+ * */
+#define VDSO_BASE               (0xB0000000 - 256 * 4096 - VDSO_SIZE)
+#define VDSO_SIZE               (2 * 4096)
+#define VDSO_SYSENTER           (VDSO_BASE + 2048)
+
+#ifndef __ASSEMBLER__
+
+#include <defs.h>
+
+#define VDSO_DATA               ((const struct vdso_data *)VDSO_BASE)
+#define VDSO_PROC               ((const struct vdso_proc *)(VDSO_BASE + 4096))
+
+struct vdso_data {
+    volatile uint32_t ticks;                // the ticks of the boot cpu, as sys_gettime
+    uint32_t tick_cycles;                   // the TSC cycles of a tick, 0 before the TSC is measured
+    uint64_t tsc_base;                      // the monotonic clock: ns = (TSC - tsc_base) * ns_mult >> ns_shift
+    uint32_t ns_mult;
+    uint32_t ns_shift;
+};
+
+struct vdso_proc {
+    volatile int pid;                       // the pid of the process, 0 if the address space is
+                                            // shared by threads, ask the kernel then
+};
+
+#endif /* !__ASSEMBLER__ */
+
+#endif /* !__LIBS_VDSO_H__ */
@@ -18,6 +18,17 @@
             __mod;                                                  \
         })
 
+// mul_u64_u32_shr - (a * mul) >> shift (shift <= 32), with 32 bit multiplications
+static inline uint64_t
+mul_u64_u32_shr(uint64_t a, uint32_t mul, unsigned int shift) {
+    uint32_t high = a >> 32, low = a;
+    uint64_t ret = ((uint64_t)low * mul) >> shift;
+    if (high != 0) {
+        ret += ((uint64_t)high * mul) << (32 - shift);
+    }
+    return ret;
+}
+
 #define barrier() __asm__ __volatile__ ("" ::: "memory")
 
 static inline uint8_t inb(uint16_t port) __attribute__((always_inline));
@@ -40,16 +51,34 @@ struct pseudodesc {
 static inline void lidt(struct pseudodesc *pd) __attribute__((always_inline));
 static inline void sti(void) __attribute__((always_inline));
 static inline void cli(void) __attribute__((always_inline));
+static inline void sti_hlt(void) __attribute__((always_inline));
 static inline void ltr(uint16_t sel) __attribute__((always_inline));
 static inline uint32_t read_eflags(void) __attribute__((always_inline));
 static inline void write_eflags(uint32_t eflags) __attribute__((always_inline));
 static inline void lcr0(uintptr_t cr0) __attribute__((always_inline));
 static inline void lcr3(uintptr_t cr3) __attribute__((always_inline));
+static inline void lcr4(uintptr_t cr4) __attribute__((always_inline));
 static inline uintptr_t rcr0(void) __attribute__((always_inline));
 static inline uintptr_t rcr1(void) __attribute__((always_inline));
 static inline uintptr_t rcr2(void) __attribute__((always_inline));
 static inline uintptr_t rcr3(void) __attribute__((always_inline));
+static inline uintptr_t rcr4(void) __attribute__((always_inline));
 static inline void invlpg(void *addr) __attribute__((always_inline));
+static inline uint64_t read_tsc(void) __attribute__((always_inline));
+static inline void cpuid(uint32_t info, uint32_t *eaxp, uint32_t *ebxp, uint32_t *ecxp, uint32_t *edxp) __attribute__((always_inline));
+static inline uint32_t xchg(volatile uint32_t *addr, uint32_t newval) __attribute__((always_inline));
+static inline void pause(void) __attribute__((always_inline));
+static inline void wrmsr(uint32_t msr, uint64_t val) __attribute__((always_inline));
+
+/* CPUID.1:EDX feature flags */
+#define CPUID_FEAT_PSE          0x00000008      // Page Size Extensions
+#define CPUID_FEAT_SEP          0x00000800      // SYSENTER and SYSEXIT
+#define CPUID_FEAT_PGE          0x00002000      // Page Global Enable
+
+/* model specific registers */
+#define MSR_SYSENTER_CS         0x174           // the kernel code segment of SYSENTER
+#define MSR_SYSENTER_ESP        0x175           // the kernel stack pointer of SYSENTER
+#define MSR_SYSENTER_EIP        0x176           // the kernel entry of SYSENTER
 
 static inline uint8_t
 inb(uint16_t port) {
@@ -148,6 +177,15 @@ cli(void) {
     asm volatile ("cli" ::: "memory");
 }
 
+/* *
+ * sti_hlt - enable interrupts and halt until the next interrupt. sti takes effect after
+ * the next instruction, so no interrupt can be taken between them and be missed by hlt.
+ * */
+static inline void
+sti_hlt(void) {
+    asm volatile ("sti; hlt" ::: "memory");
+}
+
 static inline void
 ltr(uint16_t sel) {
     asm volatile ("ltr %0" :: "r" (sel) : "memory");
@@ -175,6 +213,11 @@ lcr3(uintptr_t cr3) {
     asm volatile ("mov %0, %%cr3" :: "r" (cr3) : "memory");
 }
 
+static inline void
+lcr4(uintptr_t cr4) {
+    asm volatile ("mov %0, %%cr4" :: "r" (cr4) : "memory");
+}
+
 static inline uintptr_t
 rcr0(void) {
     uintptr_t cr0;
@@ -203,11 +246,64 @@ rcr3(void) {
     return cr3;
 }
 
+static inline uintptr_t
+rcr4(void) {
+    uintptr_t cr4;
+    asm volatile ("mov %%cr4, %0" : "=r" (cr4) :: "memory");
+    return cr4;
+}
+
 static inline void
 invlpg(void *addr) {
     asm volatile ("invlpg (%0)" :: "r" (addr) : "memory");
 }
 
+/* xchg - atomically exchange *addr with newval, and return the old value; a full memory barrier */
+static inline uint32_t
+xchg(volatile uint32_t *addr, uint32_t newval) {
+    uint32_t result;
+    asm volatile ("lock; xchgl %0, %1" : "+m" (*addr), "=a" (result) : "1" (newval) : "cc", "memory");
+    return result;
+}
+
+/* pause - a hint to the cpu in spin-wait loops */
+static inline void
+pause(void) {
+    asm volatile ("pause" ::: "memory");
+}
+
+static inline uint64_t
+read_tsc(void) {
+    uint64_t tsc;
+    asm volatile ("rdtsc" : "=A" (tsc));
+    return tsc;
+}
+
+static inline void
+cpuid(uint32_t info, uint32_t *eaxp, uint32_t *ebxp, uint32_t *ecxp, uint32_t *edxp) {
+    uint32_t eax, ebx, ecx, edx;
+    asm volatile ("cpuid"
+            : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+            : "a" (info));
+    if (eaxp != NULL) {
+        *eaxp = eax;
+    }
+    if (ebxp != NULL) {
+        *ebxp = ebx;
+    }
+    if (ecxp != NULL) {
+        *ecxp = ecx;
+    }
+    if (edxp != NULL) {
+        *edxp = edx;
+    }
+}
+
+static inline void
+wrmsr(uint32_t msr, uint64_t val) {
+    asm volatile ("wrmsr" :: "c" (msr), "A" (val));
+}
+
 static inline int __strcmp(const char *s1, const char *s2) __attribute__((always_inline));
 static inline char *__strcpy(char *dst, const char *src) __attribute__((always_inline));
 static inline void *__memset(void *s, char c, size_t n) __attribute__((always_inline));
@@ -0,0 +1,5836 @@
+
+obj/__user_badsegment.out:     file format elf32-i386
+
+
+Disassembly of section .text:
+
+00800020 <__clone>:
+#include <unistd.h>
+
+.text
+.globl __clone
+__clone:                        # __clone(clone_flags, stack, tls, fn, arg)
+    pushl %ebp                  # maintain ebp chain
+  800020:	55                   	push   %ebp
+    movl %esp, %ebp
+  800021:	89 e5                	mov    %esp,%ebp
+
+    pushl %ebx                  # save callee-saved registers
+  800023:	53                   	push   %ebx
+    pushl %esi
+  800024:	56                   	push   %esi
+    pushl %edi
+  800025:	57                   	push   %edi
+
+    movl 0x08(%ebp), %edx       # load clone_flags
+  800026:	8b 55 08             	mov    0x8(%ebp),%edx
+    movl 0x0c(%ebp), %ecx       # load stack
+  800029:	8b 4d 0c             	mov    0xc(%ebp),%ecx
+    movl 0x10(%ebp), %ebx       # load tls
+  80002c:	8b 5d 10             	mov    0x10(%ebp),%ebx
+    movl 0x14(%ebp), %edi       # load fn, the child inherits it in %edi
+  80002f:	8b 7d 14             	mov    0x14(%ebp),%edi
+    movl 0x18(%ebp), %esi       # load arg, the child inherits it in %esi
+  800032:	8b 75 18             	mov    0x18(%ebp),%esi
+
+    movl $SYS_clone, %eax       # load SYS_clone
+  800035:	b8 05 00 00 00       	mov    $0x5,%eax
+    int $T_SYSCALL              # syscall
+  80003a:	cd 80                	int    $0x80
+
+    cmpl $0x0, %eax             # pid ? child or parent ?
+  80003c:	83 f8 00             	cmp    $0x0,%eax
+    je 1f                       # eax == 0, goto 1;
+  80003f:	74 05                	je     800046 <__clone+0x26>
+
+    # parent
+    popl %edi                   # restore callee-saved registers
+  800041:	5f                   	pop    %edi
+    popl %esi
+  800042:	5e                   	pop    %esi
+    popl %ebx
+  800043:	5b                   	pop    %ebx
+
+    leave                       # restore ebp
+  800044:	c9                   	leave
+    ret
+  800045:	c3                   	ret
+
+    # child, running on the new stack
+1:
+    movl $0x0, %ebp             # end of the ebp chain for backtrace
+  800046:	bd 00 00 00 00       	mov    $0x0,%ebp
+    pushl %esi
+  80004b:	56                   	push   %esi
+    call *%edi                  # call fn(arg)
+  80004c:	ff d7                	call   *%edi
+    movl %eax, %edx             # save exit_code
+  80004e:	89 c2                	mov    %eax,%edx
+    movl $SYS_exit, %eax        # load SYS_exit
+  800050:	b8 01 00 00 00       	mov    $0x1,%eax
+    int $T_SYSCALL              # int SYS_exit
+  800055:	cd 80                	int    $0x80
+
+00800057 <spin>:
+
+spin:                           # error ?
+    jmp spin
+  800057:	eb fe                	jmp    800057 <spin>
+
+00800059 <opendir>:
+#include <error.h>
+#include <unistd.h>
+
+DIR dir, *dirp=&dir;
+DIR *
+opendir(const char *path) {
+  800059:	55                   	push   %ebp
+  80005a:	89 e5                	mov    %esp,%ebp
+  80005c:	83 ec 38             	sub    $0x38,%esp
+  80005f:	89 5d fc             	mov    %ebx,-0x4(%ebp)
+
+    if ((dirp->fd = open(path, O_RDONLY)) < 0) {
+  800062:	8b 1d 00 40 80 00    	mov    0x804000,%ebx
+  800068:	c7 44 24 04 00 00 00 	movl   $0x0,0x4(%esp)
+  80006f:	00 
+  800070:	8b 45 08             	mov    0x8(%ebp),%eax
+  800073:	89 04 24             	mov    %eax,(%esp)
+  800076:	e8 c2 00 00 00       	call   80013d <open>
+  80007b:	89 03                	mov    %eax,(%ebx)
+  80007d:	8b 03                	mov    (%ebx),%eax
+  80007f:	85 c0                	test   %eax,%eax
+  800081:	78 44                	js     8000c7 <opendir+0x6e>
+        goto failed;
+    }
+    struct stat __stat, *stat = &__stat;
+  800083:	8d 45 e4             	lea    -0x1c(%ebp),%eax
+  800086:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (fstat(dirp->fd, stat) != 0 || !S_ISDIR(stat->st_mode)) {
+  800089:	a1 00 40 80 00       	mov    0x804000,%eax
+  80008e:	8b 00                	mov    (%eax),%eax
+  800090:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  800093:	89 54 24 04          	mov    %edx,0x4(%esp)
+  800097:	89 04 24             	mov    %eax,(%esp)
+  80009a:	e8 38 01 00 00       	call   8001d7 <fstat>
+  80009f:	85 c0                	test   %eax,%eax
+  8000a1:	75 27                	jne    8000ca <opendir+0x71>
+  8000a3:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8000a6:	8b 00                	mov    (%eax),%eax
+  8000a8:	25 00 70 00 00       	and    $0x7000,%eax
+  8000ad:	3d 00 20 00 00       	cmp    $0x2000,%eax
+  8000b2:	75 16                	jne    8000ca <opendir+0x71>
+        goto failed;
+    }
+    dirp->dirent.offset = 0;
+  8000b4:	a1 00 40 80 00       	mov    0x804000,%eax
+  8000b9:	c7 40 04 00 00 00 00 	movl   $0x0,0x4(%eax)
+    return dirp;
+  8000c0:	a1 00 40 80 00       	mov    0x804000,%eax
+  8000c5:	eb 09                	jmp    8000d0 <opendir+0x77>
+        goto failed;
+  8000c7:	90                   	nop
+  8000c8:	eb 01                	jmp    8000cb <opendir+0x72>
+        goto failed;
+  8000ca:	90                   	nop
+
+failed:
+    return NULL;
+  8000cb:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  8000d0:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  8000d3:	89 ec                	mov    %ebp,%esp
+  8000d5:	5d                   	pop    %ebp
+  8000d6:	c3                   	ret
+
+008000d7 <readdir>:
+
+struct dirent *
+readdir(DIR *dirp) {
+  8000d7:	55                   	push   %ebp
+  8000d8:	89 e5                	mov    %esp,%ebp
+  8000da:	83 ec 18             	sub    $0x18,%esp
+    if (sys_getdirentry(dirp->fd, &(dirp->dirent)) == 0) {
+  8000dd:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000e0:	8d 50 04             	lea    0x4(%eax),%edx
+  8000e3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000e6:	8b 00                	mov    (%eax),%eax
+  8000e8:	89 54 24 04          	mov    %edx,0x4(%esp)
+  8000ec:	89 04 24             	mov    %eax,(%esp)
+  8000ef:	e8 f3 13 00 00       	call   8014e7 <sys_getdirentry>
+  8000f4:	85 c0                	test   %eax,%eax
+  8000f6:	75 08                	jne    800100 <readdir+0x29>
+        return &(dirp->dirent);
+  8000f8:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000fb:	83 c0 04             	add    $0x4,%eax
+  8000fe:	eb 05                	jmp    800105 <readdir+0x2e>
+    }
+    return NULL;
+  800100:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800105:	89 ec                	mov    %ebp,%esp
+  800107:	5d                   	pop    %ebp
+  800108:	c3                   	ret
+
+00800109 <closedir>:
+
+void
+closedir(DIR *dirp) {
+  800109:	55                   	push   %ebp
+  80010a:	89 e5                	mov    %esp,%ebp
+  80010c:	83 ec 18             	sub    $0x18,%esp
+    close(dirp->fd);
+  80010f:	8b 45 08             	mov    0x8(%ebp),%eax
+  800112:	8b 00                	mov    (%eax),%eax
+  800114:	89 04 24             	mov    %eax,(%esp)
+  800117:	e8 3d 00 00 00       	call   800159 <close>
+}
+  80011c:	90                   	nop
+  80011d:	89 ec                	mov    %ebp,%esp
+  80011f:	5d                   	pop    %ebp
+  800120:	c3                   	ret
+
+00800121 <getcwd>:
+
+int
+getcwd(char *buffer, size_t len) {
+  800121:	55                   	push   %ebp
+  800122:	89 e5                	mov    %esp,%ebp
+  800124:	83 ec 18             	sub    $0x18,%esp
+    return sys_getcwd(buffer, len);
+  800127:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80012a:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80012e:	8b 45 08             	mov    0x8(%ebp),%eax
+  800131:	89 04 24             	mov    %eax,(%esp)
+  800134:	e8 8a 13 00 00       	call   8014c3 <sys_getcwd>
+}
+  800139:	89 ec                	mov    %ebp,%esp
+  80013b:	5d                   	pop    %ebp
+  80013c:	c3                   	ret
+
+0080013d <open>:
+#include <stat.h>
+#include <error.h>
+#include <unistd.h>
+
+int
+open(const char *path, uint32_t open_flags) {
+  80013d:	55                   	push   %ebp
+  80013e:	89 e5                	mov    %esp,%ebp
+  800140:	83 ec 18             	sub    $0x18,%esp
+    return sys_open(path, open_flags);
+  800143:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800146:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80014a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80014d:	89 04 24             	mov    %eax,(%esp)
+  800150:	e8 6b 12 00 00       	call   8013c0 <sys_open>
+}
+  800155:	89 ec                	mov    %ebp,%esp
+  800157:	5d                   	pop    %ebp
+  800158:	c3                   	ret
+
+00800159 <close>:
+
+int
+close(int fd) {
+  800159:	55                   	push   %ebp
+  80015a:	89 e5                	mov    %esp,%ebp
+  80015c:	83 ec 18             	sub    $0x18,%esp
+    return sys_close(fd);
+  80015f:	8b 45 08             	mov    0x8(%ebp),%eax
+  800162:	89 04 24             	mov    %eax,(%esp)
+  800165:	e8 7a 12 00 00       	call   8013e4 <sys_close>
+}
+  80016a:	89 ec                	mov    %ebp,%esp
+  80016c:	5d                   	pop    %ebp
+  80016d:	c3                   	ret
+
+0080016e <read>:
+
+int
+read(int fd, void *base, size_t len) {
+  80016e:	55                   	push   %ebp
+  80016f:	89 e5                	mov    %esp,%ebp
+  800171:	83 ec 18             	sub    $0x18,%esp
+    return sys_read(fd, base, len);
+  800174:	8b 45 10             	mov    0x10(%ebp),%eax
+  800177:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80017b:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80017e:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800182:	8b 45 08             	mov    0x8(%ebp),%eax
+  800185:	89 04 24             	mov    %eax,(%esp)
+  800188:	e8 74 12 00 00       	call   801401 <sys_read>
+}
+  80018d:	89 ec                	mov    %ebp,%esp
+  80018f:	5d                   	pop    %ebp
+  800190:	c3                   	ret
+
+00800191 <write>:
+
+int
+write(int fd, void *base, size_t len) {
+  800191:	55                   	push   %ebp
+  800192:	89 e5                	mov    %esp,%ebp
+  800194:	83 ec 18             	sub    $0x18,%esp
+    return sys_write(fd, base, len);
+  800197:	8b 45 10             	mov    0x10(%ebp),%eax
+  80019a:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80019e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8001a1:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8001a5:	8b 45 08             	mov    0x8(%ebp),%eax
+  8001a8:	89 04 24             	mov    %eax,(%esp)
+  8001ab:	e8 7c 12 00 00       	call   80142c <sys_write>
+}
+  8001b0:	89 ec                	mov    %ebp,%esp
+  8001b2:	5d                   	pop    %ebp
+  8001b3:	c3                   	ret
+
+008001b4 <seek>:
+
+int
+seek(int fd, off_t pos, int whence) {
+  8001b4:	55                   	push   %ebp
+  8001b5:	89 e5                	mov    %esp,%ebp
+  8001b7:	83 ec 18             	sub    $0x18,%esp
+    return sys_seek(fd, pos, whence);
+  8001ba:	8b 45 10             	mov    0x10(%ebp),%eax
+  8001bd:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8001c1:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8001c4:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8001c8:	8b 45 08             	mov    0x8(%ebp),%eax
+  8001cb:	89 04 24             	mov    %eax,(%esp)
+  8001ce:	e8 84 12 00 00       	call   801457 <sys_seek>
+}
+  8001d3:	89 ec                	mov    %ebp,%esp
+  8001d5:	5d                   	pop    %ebp
+  8001d6:	c3                   	ret
+
+008001d7 <fstat>:
+
+int
+fstat(int fd, struct stat *stat) {
+  8001d7:	55                   	push   %ebp
+  8001d8:	89 e5                	mov    %esp,%ebp
+  8001da:	83 ec 18             	sub    $0x18,%esp
+    return sys_fstat(fd, stat);
+  8001dd:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8001e0:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8001e4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8001e7:	89 04 24             	mov    %eax,(%esp)
+  8001ea:	e8 93 12 00 00       	call   801482 <sys_fstat>
+}
+  8001ef:	89 ec                	mov    %ebp,%esp
+  8001f1:	5d                   	pop    %ebp
+  8001f2:	c3                   	ret
+
+008001f3 <fsync>:
+
+int
+fsync(int fd) {
+  8001f3:	55                   	push   %ebp
+  8001f4:	89 e5                	mov    %esp,%ebp
+  8001f6:	83 ec 18             	sub    $0x18,%esp
+    return sys_fsync(fd);
+  8001f9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8001fc:	89 04 24             	mov    %eax,(%esp)
+  8001ff:	e8 a2 12 00 00       	call   8014a6 <sys_fsync>
+}
+  800204:	89 ec                	mov    %ebp,%esp
+  800206:	5d                   	pop    %ebp
+  800207:	c3                   	ret
+
+00800208 <dup2>:
+
+int
+dup2(int fd1, int fd2) {
+  800208:	55                   	push   %ebp
+  800209:	89 e5                	mov    %esp,%ebp
+  80020b:	83 ec 18             	sub    $0x18,%esp
+    return sys_dup(fd1, fd2);
+  80020e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800211:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800215:	8b 45 08             	mov    0x8(%ebp),%eax
+  800218:	89 04 24             	mov    %eax,(%esp)
+  80021b:	e8 eb 12 00 00       	call   80150b <sys_dup>
+}
+  800220:	89 ec                	mov    %ebp,%esp
+  800222:	5d                   	pop    %ebp
+  800223:	c3                   	ret
+
+00800224 <transmode>:
+
+static char
+transmode(struct stat *stat) {
+  800224:	55                   	push   %ebp
+  800225:	89 e5                	mov    %esp,%ebp
+  800227:	83 ec 10             	sub    $0x10,%esp
+    uint32_t mode = stat->st_mode;
+  80022a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80022d:	8b 00                	mov    (%eax),%eax
+  80022f:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    if (S_ISREG(mode)) return 'r';
+  800232:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800235:	25 00 70 00 00       	and    $0x7000,%eax
+  80023a:	3d 00 10 00 00       	cmp    $0x1000,%eax
+  80023f:	75 04                	jne    800245 <transmode+0x21>
+  800241:	b0 72                	mov    $0x72,%al
+  800243:	eb 4e                	jmp    800293 <transmode+0x6f>
+    if (S_ISDIR(mode)) return 'd';
+  800245:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800248:	25 00 70 00 00       	and    $0x7000,%eax
+  80024d:	3d 00 20 00 00       	cmp    $0x2000,%eax
+  800252:	75 04                	jne    800258 <transmode+0x34>
+  800254:	b0 64                	mov    $0x64,%al
+  800256:	eb 3b                	jmp    800293 <transmode+0x6f>
+    if (S_ISLNK(mode)) return 'l';
+  800258:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80025b:	25 00 70 00 00       	and    $0x7000,%eax
+  800260:	3d 00 30 00 00       	cmp    $0x3000,%eax
+  800265:	75 04                	jne    80026b <transmode+0x47>
+  800267:	b0 6c                	mov    $0x6c,%al
+  800269:	eb 28                	jmp    800293 <transmode+0x6f>
+    if (S_ISCHR(mode)) return 'c';
+  80026b:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80026e:	25 00 70 00 00       	and    $0x7000,%eax
+  800273:	3d 00 40 00 00       	cmp    $0x4000,%eax
+  800278:	75 04                	jne    80027e <transmode+0x5a>
+  80027a:	b0 63                	mov    $0x63,%al
+  80027c:	eb 15                	jmp    800293 <transmode+0x6f>
+    if (S_ISBLK(mode)) return 'b';
+  80027e:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800281:	25 00 70 00 00       	and    $0x7000,%eax
+  800286:	3d 00 50 00 00       	cmp    $0x5000,%eax
+  80028b:	75 04                	jne    800291 <transmode+0x6d>
+  80028d:	b0 62                	mov    $0x62,%al
+  80028f:	eb 02                	jmp    800293 <transmode+0x6f>
+    return '-';
+  800291:	b0 2d                	mov    $0x2d,%al
+}
+  800293:	89 ec                	mov    %ebp,%esp
+  800295:	5d                   	pop    %ebp
+  800296:	c3                   	ret
+
+00800297 <print_stat>:
+
+void
+print_stat(const char *name, int fd, struct stat *stat) {
+  800297:	55                   	push   %ebp
+  800298:	89 e5                	mov    %esp,%ebp
+  80029a:	83 ec 18             	sub    $0x18,%esp
+    cprintf("[%03d] %s\n", fd, name);
+  80029d:	8b 45 08             	mov    0x8(%ebp),%eax
+  8002a0:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8002a4:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8002a7:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8002ab:	c7 04 24 c0 2b 80 00 	movl   $0x802bc0,(%esp)
+  8002b2:	e8 46 0c 00 00       	call   800efd <cprintf>
+    cprintf("    mode    : %c\n", transmode(stat));
+  8002b7:	8b 45 10             	mov    0x10(%ebp),%eax
+  8002ba:	89 04 24             	mov    %eax,(%esp)
+  8002bd:	e8 62 ff ff ff       	call   800224 <transmode>
+  8002c2:	0f be c0             	movsbl %al,%eax
+  8002c5:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8002c9:	c7 04 24 cb 2b 80 00 	movl   $0x802bcb,(%esp)
+  8002d0:	e8 28 0c 00 00       	call   800efd <cprintf>
+    cprintf("    links   : %lu\n", stat->st_nlinks);
+  8002d5:	8b 45 10             	mov    0x10(%ebp),%eax
+  8002d8:	8b 40 04             	mov    0x4(%eax),%eax
+  8002db:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8002df:	c7 04 24 dd 2b 80 00 	movl   $0x802bdd,(%esp)
+  8002e6:	e8 12 0c 00 00       	call   800efd <cprintf>
+    cprintf("    blocks  : %lu\n", stat->st_blocks);
+  8002eb:	8b 45 10             	mov    0x10(%ebp),%eax
+  8002ee:	8b 40 08             	mov    0x8(%eax),%eax
+  8002f1:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8002f5:	c7 04 24 f0 2b 80 00 	movl   $0x802bf0,(%esp)
+  8002fc:	e8 fc 0b 00 00       	call   800efd <cprintf>
+    cprintf("    size    : %lu\n", stat->st_size);
+  800301:	8b 45 10             	mov    0x10(%ebp),%eax
+  800304:	8b 40 0c             	mov    0xc(%eax),%eax
+  800307:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80030b:	c7 04 24 03 2c 80 00 	movl   $0x802c03,(%esp)
+  800312:	e8 e6 0b 00 00       	call   800efd <cprintf>
+}
+  800317:	90                   	nop
+  800318:	89 ec                	mov    %ebp,%esp
+  80031a:	5d                   	pop    %ebp
+  80031b:	c3                   	ret
+
+0080031c <_start>:
+.text
+.globl _start
+_start:
+    # set ebp for backtrace
+    movl $0x0, %ebp
+  80031c:	bd 00 00 00 00       	mov    $0x0,%ebp
+
+    # load argc and argv
+    movl (%esp), %ebx
+  800321:	8b 1c 24             	mov    (%esp),%ebx
+    lea 0x4(%esp), %ecx
+  800324:	8d 4c 24 04          	lea    0x4(%esp),%ecx
+
+
+    # move down the esp register
+    # since it may cause page fault in backtrace
+    subl $0x20, %esp
+  800328:	83 ec 20             	sub    $0x20,%esp
+
+    # save argc and argv on stack
+    pushl %ecx
+  80032b:	51                   	push   %ecx
+    pushl %ebx
+  80032c:	53                   	push   %ebx
+
+    # call user-program function
+    call umain
+  80032d:	e8 b1 1a 00 00       	call   801de3 <umain>
+1:  jmp 1b
+  800332:	eb fe                	jmp    800332 <_start+0x16>
+
+00800334 <test_and_set_bit>:
+ * test_and_set_bit - Atomically set a bit and return its old value
+ * @nr:     the bit to set
+ * @addr:   the address to count from
+ * */
+static inline bool
+test_and_set_bit(int nr, volatile void *addr) {
+  800334:	55                   	push   %ebp
+  800335:	89 e5                	mov    %esp,%ebp
+  800337:	83 ec 10             	sub    $0x10,%esp
+    int oldbit;
+    asm volatile ("btsl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  80033a:	8b 55 0c             	mov    0xc(%ebp),%edx
+  80033d:	8b 45 08             	mov    0x8(%ebp),%eax
+  800340:	0f ab 02             	bts    %eax,(%edx)
+  800343:	19 c0                	sbb    %eax,%eax
+  800345:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return oldbit != 0;
+  800348:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  80034c:	0f 95 c0             	setne  %al
+  80034f:	0f b6 c0             	movzbl %al,%eax
+}
+  800352:	89 ec                	mov    %ebp,%esp
+  800354:	5d                   	pop    %ebp
+  800355:	c3                   	ret
+
+00800356 <test_and_clear_bit>:
+ * test_and_clear_bit - Atomically clear a bit and return its old value
+ * @nr:     the bit to clear
+ * @addr:   the address to count from
+ * */
+static inline bool
+test_and_clear_bit(int nr, volatile void *addr) {
+  800356:	55                   	push   %ebp
+  800357:	89 e5                	mov    %esp,%ebp
+  800359:	83 ec 10             	sub    $0x10,%esp
+    int oldbit;
+    asm volatile ("btrl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  80035c:	8b 55 0c             	mov    0xc(%ebp),%edx
+  80035f:	8b 45 08             	mov    0x8(%ebp),%eax
+  800362:	0f b3 02             	btr    %eax,(%edx)
+  800365:	19 c0                	sbb    %eax,%eax
+  800367:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return oldbit != 0;
+  80036a:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  80036e:	0f 95 c0             	setne  %al
+  800371:	0f b6 c0             	movzbl %al,%eax
+}
+  800374:	89 ec                	mov    %ebp,%esp
+  800376:	5d                   	pop    %ebp
+  800377:	c3                   	ret
+
+00800378 <try_lock>:
+lock_init(lock_t *l) {
+    *l = 0;
+}
+
+static inline bool
+try_lock(lock_t *l) {
+  800378:	55                   	push   %ebp
+  800379:	89 e5                	mov    %esp,%ebp
+  80037b:	83 ec 08             	sub    $0x8,%esp
+    return test_and_set_bit(0, l);
+  80037e:	8b 45 08             	mov    0x8(%ebp),%eax
+  800381:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800385:	c7 04 24 00 00 00 00 	movl   $0x0,(%esp)
+  80038c:	e8 a3 ff ff ff       	call   800334 <test_and_set_bit>
+}
+  800391:	89 ec                	mov    %ebp,%esp
+  800393:	5d                   	pop    %ebp
+  800394:	c3                   	ret
+
+00800395 <lock>:
+
+static inline void
+lock(lock_t *l) {
+  800395:	55                   	push   %ebp
+  800396:	89 e5                	mov    %esp,%ebp
+  800398:	83 ec 28             	sub    $0x28,%esp
+    if (try_lock(l)) {
+  80039b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80039e:	89 04 24             	mov    %eax,(%esp)
+  8003a1:	e8 d2 ff ff ff       	call   800378 <try_lock>
+  8003a6:	85 c0                	test   %eax,%eax
+  8003a8:	74 37                	je     8003e1 <lock+0x4c>
+        int step = 0;
+  8003aa:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+        do {
+            yield();
+  8003b1:	e8 4f 16 00 00       	call   801a05 <yield>
+            if (++ step == 100) {
+  8003b6:	ff 45 f4             	incl   -0xc(%ebp)
+  8003b9:	83 7d f4 64          	cmpl   $0x64,-0xc(%ebp)
+  8003bd:	75 13                	jne    8003d2 <lock+0x3d>
+                step = 0;
+  8003bf:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+                sleep(10);
+  8003c6:	c7 04 24 0a 00 00 00 	movl   $0xa,(%esp)
+  8003cd:	e8 a2 16 00 00       	call   801a74 <sleep>
+            }
+        } while (try_lock(l));
+  8003d2:	8b 45 08             	mov    0x8(%ebp),%eax
+  8003d5:	89 04 24             	mov    %eax,(%esp)
+  8003d8:	e8 9b ff ff ff       	call   800378 <try_lock>
+  8003dd:	85 c0                	test   %eax,%eax
+  8003df:	75 d0                	jne    8003b1 <lock+0x1c>
+    }
+}
+  8003e1:	90                   	nop
+  8003e2:	89 ec                	mov    %ebp,%esp
+  8003e4:	5d                   	pop    %ebp
+  8003e5:	c3                   	ret
+
+008003e6 <unlock>:
+
+static inline void
+unlock(lock_t *l) {
+  8003e6:	55                   	push   %ebp
+  8003e7:	89 e5                	mov    %esp,%ebp
+  8003e9:	83 ec 08             	sub    $0x8,%esp
+    test_and_clear_bit(0, l);
+  8003ec:	8b 45 08             	mov    0x8(%ebp),%eax
+  8003ef:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8003f3:	c7 04 24 00 00 00 00 	movl   $0x0,(%esp)
+  8003fa:	e8 57 ff ff ff       	call   800356 <test_and_clear_bit>
+}
+  8003ff:	90                   	nop
+  800400:	89 ec                	mov    %ebp,%esp
+  800402:	5d                   	pop    %ebp
+  800403:	c3                   	ret
+
+00800404 <heap_insert>:
+static struct mhdr *heap_end;   // the sentinel at the end of heap
+static size_t heap_bytes, mmap_bytes, used_bytes;
+
+// heap_insert - make b a free block: set the footer, add to free_list and mark the next block
+static void
+heap_insert(struct mhdr *b) {
+  800404:	55                   	push   %ebp
+  800405:	89 e5                	mov    %esp,%ebp
+  800407:	83 ec 20             	sub    $0x20,%esp
+    b->flags &= M_PREV_FREE;
+  80040a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80040d:	8b 40 04             	mov    0x4(%eax),%eax
+  800410:	83 e0 02             	and    $0x2,%eax
+  800413:	89 c2                	mov    %eax,%edx
+  800415:	8b 45 08             	mov    0x8(%ebp),%eax
+  800418:	89 50 04             	mov    %edx,0x4(%eax)
+    block_footer(b) = b->size;
+  80041b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80041e:	8b 00                	mov    (%eax),%eax
+  800420:	8d 50 fc             	lea    -0x4(%eax),%edx
+  800423:	8b 45 08             	mov    0x8(%ebp),%eax
+  800426:	01 c2                	add    %eax,%edx
+  800428:	8b 45 08             	mov    0x8(%ebp),%eax
+  80042b:	8b 00                	mov    (%eax),%eax
+  80042d:	89 02                	mov    %eax,(%edx)
+    list_add(&free_list, &(((struct mfree *)b)->link));
+  80042f:	8b 45 08             	mov    0x8(%ebp),%eax
+  800432:	83 c0 08             	add    $0x8,%eax
+  800435:	c7 45 fc 04 40 80 00 	movl   $0x804004,-0x4(%ebp)
+  80043c:	89 45 f8             	mov    %eax,-0x8(%ebp)
+  80043f:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800442:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800445:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800448:	89 45 f0             	mov    %eax,-0x10(%ebp)
+ * Insert the new element @elm *after* the element @listelm which
+ * is already in the list.
+ * */
+static inline void
+list_add_after(list_entry_t *listelm, list_entry_t *elm) {
+    __list_add(elm, listelm, listelm->next);
+  80044b:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80044e:	8b 40 04             	mov    0x4(%eax),%eax
+  800451:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  800454:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  800457:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  80045a:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  80045d:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+ * This is only for internal list manipulation where we know
+ * the prev/next entries already!
+ * */
+static inline void
+__list_add(list_entry_t *elm, list_entry_t *prev, list_entry_t *next) {
+    prev->next = next->prev = elm;
+  800460:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800463:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  800466:	89 10                	mov    %edx,(%eax)
+  800468:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  80046b:	8b 10                	mov    (%eax),%edx
+  80046d:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800470:	89 50 04             	mov    %edx,0x4(%eax)
+    elm->next = next;
+  800473:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800476:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  800479:	89 50 04             	mov    %edx,0x4(%eax)
+    elm->prev = prev;
+  80047c:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  80047f:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  800482:	89 10                	mov    %edx,(%eax)
+}
+  800484:	90                   	nop
+}
+  800485:	90                   	nop
+}
+  800486:	90                   	nop
+    next_block(b)->flags |= M_PREV_FREE;
+  800487:	8b 45 08             	mov    0x8(%ebp),%eax
+  80048a:	8b 10                	mov    (%eax),%edx
+  80048c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80048f:	01 d0                	add    %edx,%eax
+  800491:	8b 50 04             	mov    0x4(%eax),%edx
+  800494:	8b 45 08             	mov    0x8(%ebp),%eax
+  800497:	8b 08                	mov    (%eax),%ecx
+  800499:	8b 45 08             	mov    0x8(%ebp),%eax
+  80049c:	01 c8                	add    %ecx,%eax
+  80049e:	83 ca 02             	or     $0x2,%edx
+  8004a1:	89 50 04             	mov    %edx,0x4(%eax)
+}
+  8004a4:	90                   	nop
+  8004a5:	89 ec                	mov    %ebp,%esp
+  8004a7:	5d                   	pop    %ebp
+  8004a8:	c3                   	ret
+
+008004a9 <heap_coalesce>:
+
+// heap_coalesce - merge the free block b (not in free_list) with its free neighbours, then insert it
+static struct mhdr *
+heap_coalesce(struct mhdr *b) {
+  8004a9:	55                   	push   %ebp
+  8004aa:	89 e5                	mov    %esp,%ebp
+  8004ac:	83 ec 24             	sub    $0x24,%esp
+    struct mhdr *next = next_block(b);
+  8004af:	8b 45 08             	mov    0x8(%ebp),%eax
+  8004b2:	8b 10                	mov    (%eax),%edx
+  8004b4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8004b7:	01 d0                	add    %edx,%eax
+  8004b9:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    if (!(next->flags & M_USED)) {
+  8004bc:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8004bf:	8b 40 04             	mov    0x4(%eax),%eax
+  8004c2:	83 e0 01             	and    $0x1,%eax
+  8004c5:	85 c0                	test   %eax,%eax
+  8004c7:	75 3e                	jne    800507 <heap_coalesce+0x5e>
+        list_del(&(((struct mfree *)next)->link));
+  8004c9:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8004cc:	83 c0 08             	add    $0x8,%eax
+  8004cf:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    __list_del(listelm->prev, listelm->next);
+  8004d2:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8004d5:	8b 40 04             	mov    0x4(%eax),%eax
+  8004d8:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  8004db:	8b 12                	mov    (%edx),%edx
+  8004dd:	89 55 f0             	mov    %edx,-0x10(%ebp)
+  8004e0:	89 45 ec             	mov    %eax,-0x14(%ebp)
+ * This is only for internal list manipulation where we know
+ * the prev/next entries already!
+ * */
+static inline void
+__list_del(list_entry_t *prev, list_entry_t *next) {
+    prev->next = next;
+  8004e3:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8004e6:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  8004e9:	89 50 04             	mov    %edx,0x4(%eax)
+    next->prev = prev;
+  8004ec:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8004ef:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  8004f2:	89 10                	mov    %edx,(%eax)
+}
+  8004f4:	90                   	nop
+}
+  8004f5:	90                   	nop
+        b->size += next->size;
+  8004f6:	8b 45 08             	mov    0x8(%ebp),%eax
+  8004f9:	8b 10                	mov    (%eax),%edx
+  8004fb:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8004fe:	8b 00                	mov    (%eax),%eax
+  800500:	01 c2                	add    %eax,%edx
+  800502:	8b 45 08             	mov    0x8(%ebp),%eax
+  800505:	89 10                	mov    %edx,(%eax)
+    }
+    if (b->flags & M_PREV_FREE) {
+  800507:	8b 45 08             	mov    0x8(%ebp),%eax
+  80050a:	8b 40 04             	mov    0x4(%eax),%eax
+  80050d:	83 e0 02             	and    $0x2,%eax
+  800510:	85 c0                	test   %eax,%eax
+  800512:	74 58                	je     80056c <heap_coalesce+0xc3>
+        struct mhdr *prev = (struct mhdr *)((char *)b - *((size_t *)b - 1));
+  800514:	8b 45 08             	mov    0x8(%ebp),%eax
+  800517:	83 e8 04             	sub    $0x4,%eax
+  80051a:	8b 00                	mov    (%eax),%eax
+  80051c:	f7 d8                	neg    %eax
+  80051e:	89 c2                	mov    %eax,%edx
+  800520:	8b 45 08             	mov    0x8(%ebp),%eax
+  800523:	01 d0                	add    %edx,%eax
+  800525:	89 45 f8             	mov    %eax,-0x8(%ebp)
+        list_del(&(((struct mfree *)prev)->link));
+  800528:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80052b:	83 c0 08             	add    $0x8,%eax
+  80052e:	89 45 e8             	mov    %eax,-0x18(%ebp)
+    __list_del(listelm->prev, listelm->next);
+  800531:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800534:	8b 40 04             	mov    0x4(%eax),%eax
+  800537:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  80053a:	8b 12                	mov    (%edx),%edx
+  80053c:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  80053f:	89 45 e0             	mov    %eax,-0x20(%ebp)
+    prev->next = next;
+  800542:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800545:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  800548:	89 50 04             	mov    %edx,0x4(%eax)
+    next->prev = prev;
+  80054b:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  80054e:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  800551:	89 10                	mov    %edx,(%eax)
+}
+  800553:	90                   	nop
+}
+  800554:	90                   	nop
+        prev->size += b->size;
+  800555:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800558:	8b 10                	mov    (%eax),%edx
+  80055a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80055d:	8b 00                	mov    (%eax),%eax
+  80055f:	01 c2                	add    %eax,%edx
+  800561:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800564:	89 10                	mov    %edx,(%eax)
+        b = prev;
+  800566:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  800569:	89 45 08             	mov    %eax,0x8(%ebp)
+    }
+    heap_insert(b);
+  80056c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80056f:	89 04 24             	mov    %eax,(%esp)
+  800572:	e8 8d fe ff ff       	call   800404 <heap_insert>
+    return b;
+  800577:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  80057a:	89 ec                	mov    %ebp,%esp
+  80057c:	5d                   	pop    %ebp
+  80057d:	c3                   	ret
+
+0080057e <heap_grow>:
+
+// heap_grow - get at least need bytes from kernel by sbrk, return the free block at the top of heap
+static struct mhdr *
+heap_grow(size_t need) {
+  80057e:	55                   	push   %ebp
+  80057f:	89 e5                	mov    %esp,%ebp
+  800581:	83 ec 38             	sub    $0x38,%esp
+    size_t grow = ROUNDUP(need + M_HDRSIZE, HEAP_GROW);
+  800584:	c7 45 f0 00 00 01 00 	movl   $0x10000,-0x10(%ebp)
+  80058b:	8b 55 08             	mov    0x8(%ebp),%edx
+  80058e:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800591:	01 d0                	add    %edx,%eax
+  800593:	83 c0 07             	add    $0x7,%eax
+  800596:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  800599:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  80059c:	ba 00 00 00 00       	mov    $0x0,%edx
+  8005a1:	f7 75 f0             	divl   -0x10(%ebp)
+  8005a4:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8005a7:	29 d0                	sub    %edx,%eax
+  8005a9:	89 45 e8             	mov    %eax,-0x18(%ebp)
+    char *p;
+    if ((p = sbrk(grow)) == (void *)-1) {
+  8005ac:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8005af:	89 04 24             	mov    %eax,(%esp)
+  8005b2:	e8 4b 16 00 00       	call   801c02 <sbrk>
+  8005b7:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  8005ba:	83 7d e4 ff          	cmpl   $0xffffffff,-0x1c(%ebp)
+  8005be:	75 0a                	jne    8005ca <heap_grow+0x4c>
+        return NULL;
+  8005c0:	b8 00 00 00 00       	mov    $0x0,%eax
+  8005c5:	e9 a8 00 00 00       	jmp    800672 <heap_grow+0xf4>
+    }
+    struct mhdr *b;
+    if (heap_end == NULL) {
+  8005ca:	a1 24 51 80 00       	mov    0x805124,%eax
+  8005cf:	85 c0                	test   %eax,%eax
+  8005d1:	75 1d                	jne    8005f0 <heap_grow+0x72>
+        b = (struct mhdr *)p;
+  8005d3:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8005d6:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        b->size = grow - M_HDRSIZE;
+  8005d9:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8005dc:	8d 50 f8             	lea    -0x8(%eax),%edx
+  8005df:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8005e2:	89 10                	mov    %edx,(%eax)
+        b->flags = 0;
+  8005e4:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8005e7:	c7 40 04 00 00 00 00 	movl   $0x0,0x4(%eax)
+  8005ee:	eb 41                	jmp    800631 <heap_grow+0xb3>
+    }
+    else {
+        // malloc is the only user of sbrk, so the heap is continuous
+        assert(p == (char *)heap_end + M_HDRSIZE);
+  8005f0:	a1 24 51 80 00       	mov    0x805124,%eax
+  8005f5:	83 c0 08             	add    $0x8,%eax
+  8005f8:	39 45 e4             	cmp    %eax,-0x1c(%ebp)
+  8005fb:	74 24                	je     800621 <heap_grow+0xa3>
+  8005fd:	c7 44 24 0c 18 2c 80 	movl   $0x802c18,0xc(%esp)
+  800604:	00 
+  800605:	c7 44 24 08 3a 2c 80 	movl   $0x802c3a,0x8(%esp)
+  80060c:	00 
+  80060d:	c7 44 24 04 72 00 00 	movl   $0x72,0x4(%esp)
+  800614:	00 
+  800615:	c7 04 24 4f 2c 80 00 	movl   $0x802c4f,(%esp)
+  80061c:	e8 e3 07 00 00       	call   800e04 <__panic>
+        b = heap_end;
+  800621:	a1 24 51 80 00       	mov    0x805124,%eax
+  800626:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        b->size = grow;
+  800629:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80062c:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  80062f:	89 10                	mov    %edx,(%eax)
+    }
+    heap_end = next_block(b);
+  800631:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800634:	8b 10                	mov    (%eax),%edx
+  800636:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800639:	01 d0                	add    %edx,%eax
+  80063b:	a3 24 51 80 00       	mov    %eax,0x805124
+    heap_end->size = 0;
+  800640:	a1 24 51 80 00       	mov    0x805124,%eax
+  800645:	c7 00 00 00 00 00    	movl   $0x0,(%eax)
+    heap_end->flags = M_USED;
+  80064b:	a1 24 51 80 00       	mov    0x805124,%eax
+  800650:	c7 40 04 01 00 00 00 	movl   $0x1,0x4(%eax)
+    heap_bytes += grow;
+  800657:	8b 15 28 51 80 00    	mov    0x805128,%edx
+  80065d:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800660:	01 d0                	add    %edx,%eax
+  800662:	a3 28 51 80 00       	mov    %eax,0x805128
+    return heap_coalesce(b);
+  800667:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80066a:	89 04 24             	mov    %eax,(%esp)
+  80066d:	e8 37 fe ff ff       	call   8004a9 <heap_coalesce>
+}
+  800672:	89 ec                	mov    %ebp,%esp
+  800674:	5d                   	pop    %ebp
+  800675:	c3                   	ret
+
+00800676 <heap_trim>:
+
+// heap_trim - give the free block b at the top of heap back to kernel, except a small tail
+static void
+heap_trim(struct mhdr *b) {
+  800676:	55                   	push   %ebp
+  800677:	89 e5                	mov    %esp,%ebp
+  800679:	83 ec 28             	sub    $0x28,%esp
+    size_t release = ROUNDDOWN(b->size - M_MINSIZE, PGSIZE);
+  80067c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80067f:	8b 00                	mov    (%eax),%eax
+  800681:	83 e8 20             	sub    $0x20,%eax
+  800684:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800687:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80068a:	25 00 f0 ff ff       	and    $0xfffff000,%eax
+  80068f:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    if (release == 0 || sbrk(-release) == (void *)-1) {
+  800692:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  800696:	74 6a                	je     800702 <heap_trim+0x8c>
+  800698:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80069b:	f7 d8                	neg    %eax
+  80069d:	89 04 24             	mov    %eax,(%esp)
+  8006a0:	e8 5d 15 00 00       	call   801c02 <sbrk>
+  8006a5:	83 f8 ff             	cmp    $0xffffffff,%eax
+  8006a8:	74 58                	je     800702 <heap_trim+0x8c>
+        return ;
+    }
+    b->size -= release;
+  8006aa:	8b 45 08             	mov    0x8(%ebp),%eax
+  8006ad:	8b 00                	mov    (%eax),%eax
+  8006af:	2b 45 f0             	sub    -0x10(%ebp),%eax
+  8006b2:	89 c2                	mov    %eax,%edx
+  8006b4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8006b7:	89 10                	mov    %edx,(%eax)
+    block_footer(b) = b->size;
+  8006b9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8006bc:	8b 00                	mov    (%eax),%eax
+  8006be:	8d 50 fc             	lea    -0x4(%eax),%edx
+  8006c1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8006c4:	01 c2                	add    %eax,%edx
+  8006c6:	8b 45 08             	mov    0x8(%ebp),%eax
+  8006c9:	8b 00                	mov    (%eax),%eax
+  8006cb:	89 02                	mov    %eax,(%edx)
+    heap_end = next_block(b);
+  8006cd:	8b 45 08             	mov    0x8(%ebp),%eax
+  8006d0:	8b 10                	mov    (%eax),%edx
+  8006d2:	8b 45 08             	mov    0x8(%ebp),%eax
+  8006d5:	01 d0                	add    %edx,%eax
+  8006d7:	a3 24 51 80 00       	mov    %eax,0x805124
+    heap_end->size = 0;
+  8006dc:	a1 24 51 80 00       	mov    0x805124,%eax
+  8006e1:	c7 00 00 00 00 00    	movl   $0x0,(%eax)
+    heap_end->flags = M_USED | M_PREV_FREE;
+  8006e7:	a1 24 51 80 00       	mov    0x805124,%eax
+  8006ec:	c7 40 04 03 00 00 00 	movl   $0x3,0x4(%eax)
+    heap_bytes -= release;
+  8006f3:	a1 28 51 80 00       	mov    0x805128,%eax
+  8006f8:	2b 45 f0             	sub    -0x10(%ebp),%eax
+  8006fb:	a3 28 51 80 00       	mov    %eax,0x805128
+  800700:	eb 01                	jmp    800703 <heap_trim+0x8d>
+        return ;
+  800702:	90                   	nop
+}
+  800703:	89 ec                	mov    %ebp,%esp
+  800705:	5d                   	pop    %ebp
+  800706:	c3                   	ret
+
+00800707 <heap_alloc>:
+
+// heap_alloc - alloc a heap block of need bytes by best-fit, split the rest if it's big enough
+static struct mhdr *
+heap_alloc(size_t need) {
+  800707:	55                   	push   %ebp
+  800708:	89 e5                	mov    %esp,%ebp
+  80070a:	83 ec 38             	sub    $0x38,%esp
+    list_entry_t *le = &free_list;
+  80070d:	c7 45 f4 04 40 80 00 	movl   $0x804004,-0xc(%ebp)
+    struct mhdr *b = NULL;
+  800714:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+    while ((le = list_next(le)) != &free_list) {
+  80071b:	eb 37                	jmp    800754 <heap_alloc+0x4d>
+        struct mhdr *f = &(le2mfree(le)->hdr);
+  80071d:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800720:	83 e8 08             	sub    $0x8,%eax
+  800723:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        if (f->size >= need && (b == NULL || f->size < b->size)) {
+  800726:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800729:	8b 00                	mov    (%eax),%eax
+  80072b:	3b 45 08             	cmp    0x8(%ebp),%eax
+  80072e:	72 24                	jb     800754 <heap_alloc+0x4d>
+  800730:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  800734:	74 0e                	je     800744 <heap_alloc+0x3d>
+  800736:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800739:	8b 10                	mov    (%eax),%edx
+  80073b:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80073e:	8b 00                	mov    (%eax),%eax
+  800740:	39 c2                	cmp    %eax,%edx
+  800742:	73 10                	jae    800754 <heap_alloc+0x4d>
+            b = f;
+  800744:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800747:	89 45 f0             	mov    %eax,-0x10(%ebp)
+            if (f->size == need) {
+  80074a:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  80074d:	8b 00                	mov    (%eax),%eax
+  80074f:	39 45 08             	cmp    %eax,0x8(%ebp)
+  800752:	74 1a                	je     80076e <heap_alloc+0x67>
+  800754:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800757:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+    return listelm->next;
+  80075a:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  80075d:	8b 40 04             	mov    0x4(%eax),%eax
+    while ((le = list_next(le)) != &free_list) {
+  800760:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800763:	81 7d f4 04 40 80 00 	cmpl   $0x804004,-0xc(%ebp)
+  80076a:	75 b1                	jne    80071d <heap_alloc+0x16>
+  80076c:	eb 01                	jmp    80076f <heap_alloc+0x68>
+                break;
+  80076e:	90                   	nop
+            }
+        }
+    }
+    if (b == NULL && (b = heap_grow(need)) == NULL) {
+  80076f:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  800773:	75 1e                	jne    800793 <heap_alloc+0x8c>
+  800775:	8b 45 08             	mov    0x8(%ebp),%eax
+  800778:	89 04 24             	mov    %eax,(%esp)
+  80077b:	e8 fe fd ff ff       	call   80057e <heap_grow>
+  800780:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  800783:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  800787:	75 0a                	jne    800793 <heap_alloc+0x8c>
+        return NULL;
+  800789:	b8 00 00 00 00       	mov    $0x0,%eax
+  80078e:	e9 9d 00 00 00       	jmp    800830 <heap_alloc+0x129>
+    }
+    list_del(&(((struct mfree *)b)->link));
+  800793:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800796:	83 c0 08             	add    $0x8,%eax
+  800799:	89 45 e0             	mov    %eax,-0x20(%ebp)
+    __list_del(listelm->prev, listelm->next);
+  80079c:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  80079f:	8b 40 04             	mov    0x4(%eax),%eax
+  8007a2:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  8007a5:	8b 12                	mov    (%edx),%edx
+  8007a7:	89 55 dc             	mov    %edx,-0x24(%ebp)
+  8007aa:	89 45 d8             	mov    %eax,-0x28(%ebp)
+    prev->next = next;
+  8007ad:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  8007b0:	8b 55 d8             	mov    -0x28(%ebp),%edx
+  8007b3:	89 50 04             	mov    %edx,0x4(%eax)
+    next->prev = prev;
+  8007b6:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  8007b9:	8b 55 dc             	mov    -0x24(%ebp),%edx
+  8007bc:	89 10                	mov    %edx,(%eax)
+}
+  8007be:	90                   	nop
+}
+  8007bf:	90                   	nop
+    if (b->size - need >= M_MINSIZE) {
+  8007c0:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8007c3:	8b 00                	mov    (%eax),%eax
+  8007c5:	2b 45 08             	sub    0x8(%ebp),%eax
+  8007c8:	83 f8 1f             	cmp    $0x1f,%eax
+  8007cb:	76 39                	jbe    800806 <heap_alloc+0xff>
+        struct mhdr *rest = (struct mhdr *)((char *)b + need);
+  8007cd:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  8007d0:	8b 45 08             	mov    0x8(%ebp),%eax
+  8007d3:	01 d0                	add    %edx,%eax
+  8007d5:	89 45 e8             	mov    %eax,-0x18(%ebp)
+        rest->size = b->size - need;
+  8007d8:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8007db:	8b 00                	mov    (%eax),%eax
+  8007dd:	2b 45 08             	sub    0x8(%ebp),%eax
+  8007e0:	89 c2                	mov    %eax,%edx
+  8007e2:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8007e5:	89 10                	mov    %edx,(%eax)
+        rest->flags = 0;
+  8007e7:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8007ea:	c7 40 04 00 00 00 00 	movl   $0x0,0x4(%eax)
+        b->size = need;
+  8007f1:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8007f4:	8b 55 08             	mov    0x8(%ebp),%edx
+  8007f7:	89 10                	mov    %edx,(%eax)
+        heap_insert(rest);
+  8007f9:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8007fc:	89 04 24             	mov    %eax,(%esp)
+  8007ff:	e8 00 fc ff ff       	call   800404 <heap_insert>
+  800804:	eb 1d                	jmp    800823 <heap_alloc+0x11c>
+    }
+    else {
+        next_block(b)->flags &= ~M_PREV_FREE;
+  800806:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800809:	8b 10                	mov    (%eax),%edx
+  80080b:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80080e:	01 d0                	add    %edx,%eax
+  800810:	8b 50 04             	mov    0x4(%eax),%edx
+  800813:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800816:	8b 08                	mov    (%eax),%ecx
+  800818:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80081b:	01 c8                	add    %ecx,%eax
+  80081d:	83 e2 fd             	and    $0xfffffffd,%edx
+  800820:	89 50 04             	mov    %edx,0x4(%eax)
+    }
+    b->flags = M_USED;
+  800823:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800826:	c7 40 04 01 00 00 00 	movl   $0x1,0x4(%eax)
+    return b;
+  80082d:	8b 45 f0             	mov    -0x10(%ebp),%eax
+}
+  800830:	89 ec                	mov    %ebp,%esp
+  800832:	5d                   	pop    %ebp
+  800833:	c3                   	ret
+
+00800834 <heap_free>:
+
+// heap_free - free the heap block b, trim the top of heap if it's too big
+static void
+heap_free(struct mhdr *b) {
+  800834:	55                   	push   %ebp
+  800835:	89 e5                	mov    %esp,%ebp
+  800837:	83 ec 18             	sub    $0x18,%esp
+    b->flags &= ~M_USED;
+  80083a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80083d:	8b 40 04             	mov    0x4(%eax),%eax
+  800840:	83 e0 fe             	and    $0xfffffffe,%eax
+  800843:	89 c2                	mov    %eax,%edx
+  800845:	8b 45 08             	mov    0x8(%ebp),%eax
+  800848:	89 50 04             	mov    %edx,0x4(%eax)
+    b = heap_coalesce(b);
+  80084b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80084e:	89 04 24             	mov    %eax,(%esp)
+  800851:	e8 53 fc ff ff       	call   8004a9 <heap_coalesce>
+  800856:	89 45 08             	mov    %eax,0x8(%ebp)
+    if (next_block(b) == heap_end && b->size >= TRIM_THRESHOLD) {
+  800859:	8b 45 08             	mov    0x8(%ebp),%eax
+  80085c:	8b 10                	mov    (%eax),%edx
+  80085e:	8b 45 08             	mov    0x8(%ebp),%eax
+  800861:	01 c2                	add    %eax,%edx
+  800863:	a1 24 51 80 00       	mov    0x805124,%eax
+  800868:	39 c2                	cmp    %eax,%edx
+  80086a:	75 17                	jne    800883 <heap_free+0x4f>
+  80086c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80086f:	8b 00                	mov    (%eax),%eax
+  800871:	3d ff ff 00 00       	cmp    $0xffff,%eax
+  800876:	76 0b                	jbe    800883 <heap_free+0x4f>
+        heap_trim(b);
+  800878:	8b 45 08             	mov    0x8(%ebp),%eax
+  80087b:	89 04 24             	mov    %eax,(%esp)
+  80087e:	e8 f3 fd ff ff       	call   800676 <heap_trim>
+    }
+}
+  800883:	90                   	nop
+  800884:	89 ec                	mov    %ebp,%esp
+  800886:	5d                   	pop    %ebp
+  800887:	c3                   	ret
+
+00800888 <small_alloc>:
+
+// small_alloc - alloc an object of size class c, refill the class from heap if needed
+static struct mhdr *
+small_alloc(int c) {
+  800888:	55                   	push   %ebp
+  800889:	89 e5                	mov    %esp,%ebp
+  80088b:	83 ec 38             	sub    $0x38,%esp
+    size_t size = (16 << c);
+  80088e:	8b 45 08             	mov    0x8(%ebp),%eax
+  800891:	ba 10 00 00 00       	mov    $0x10,%edx
+  800896:	88 c1                	mov    %al,%cl
+  800898:	d3 e2                	shl    %cl,%edx
+  80089a:	89 d0                	mov    %edx,%eax
+  80089c:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    if (small_free[c] == NULL) {
+  80089f:	8b 45 08             	mov    0x8(%ebp),%eax
+  8008a2:	8b 04 85 0c 51 80 00 	mov    0x80510c(,%eax,4),%eax
+  8008a9:	85 c0                	test   %eax,%eax
+  8008ab:	0f 85 87 00 00 00    	jne    800938 <small_alloc+0xb0>
+        struct mhdr *run;
+        if ((run = heap_alloc(SMALL_RUN)) == NULL) {
+  8008b1:	c7 04 24 00 40 00 00 	movl   $0x4000,(%esp)
+  8008b8:	e8 4a fe ff ff       	call   800707 <heap_alloc>
+  8008bd:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  8008c0:	83 7d ec 00          	cmpl   $0x0,-0x14(%ebp)
+  8008c4:	75 0a                	jne    8008d0 <small_alloc+0x48>
+            return NULL;
+  8008c6:	b8 00 00 00 00       	mov    $0x0,%eax
+  8008cb:	e9 a1 00 00 00       	jmp    800971 <small_alloc+0xe9>
+        }
+        char *p = (char *)(run + 1), *end = (char *)run + run->size;
+  8008d0:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8008d3:	83 c0 08             	add    $0x8,%eax
+  8008d6:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8008d9:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8008dc:	8b 10                	mov    (%eax),%edx
+  8008de:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8008e1:	01 d0                	add    %edx,%eax
+  8008e3:	89 45 e8             	mov    %eax,-0x18(%ebp)
+        for (; p + size <= end; p += size) {
+  8008e6:	eb 43                	jmp    80092b <small_alloc+0xa3>
+            struct mhdr *b = (struct mhdr *)p;
+  8008e8:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8008eb:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+            struct sfree *s = (struct sfree *)(b + 1);
+  8008ee:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8008f1:	83 c0 08             	add    $0x8,%eax
+  8008f4:	89 45 e0             	mov    %eax,-0x20(%ebp)
+            b->size = size;
+  8008f7:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8008fa:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  8008fd:	89 10                	mov    %edx,(%eax)
+            b->flags = M_SMALL;
+  8008ff:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800902:	c7 40 04 04 00 00 00 	movl   $0x4,0x4(%eax)
+            s->next = small_free[c];
+  800909:	8b 45 08             	mov    0x8(%ebp),%eax
+  80090c:	8b 14 85 0c 51 80 00 	mov    0x80510c(,%eax,4),%edx
+  800913:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  800916:	89 10                	mov    %edx,(%eax)
+            small_free[c] = s;
+  800918:	8b 45 08             	mov    0x8(%ebp),%eax
+  80091b:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  80091e:	89 14 85 0c 51 80 00 	mov    %edx,0x80510c(,%eax,4)
+        for (; p + size <= end; p += size) {
+  800925:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800928:	01 45 f4             	add    %eax,-0xc(%ebp)
+  80092b:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  80092e:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800931:	01 d0                	add    %edx,%eax
+  800933:	39 45 e8             	cmp    %eax,-0x18(%ebp)
+  800936:	73 b0                	jae    8008e8 <small_alloc+0x60>
+        }
+    }
+    struct sfree *s = small_free[c];
+  800938:	8b 45 08             	mov    0x8(%ebp),%eax
+  80093b:	8b 04 85 0c 51 80 00 	mov    0x80510c(,%eax,4),%eax
+  800942:	89 45 dc             	mov    %eax,-0x24(%ebp)
+    small_free[c] = s->next;
+  800945:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800948:	8b 10                	mov    (%eax),%edx
+  80094a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80094d:	89 14 85 0c 51 80 00 	mov    %edx,0x80510c(,%eax,4)
+    struct mhdr *b = (struct mhdr *)s - 1;
+  800954:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800957:	83 e8 08             	sub    $0x8,%eax
+  80095a:	89 45 d8             	mov    %eax,-0x28(%ebp)
+    b->flags |= M_USED;
+  80095d:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  800960:	8b 40 04             	mov    0x4(%eax),%eax
+  800963:	83 c8 01             	or     $0x1,%eax
+  800966:	89 c2                	mov    %eax,%edx
+  800968:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  80096b:	89 50 04             	mov    %edx,0x4(%eax)
+    return b;
+  80096e:	8b 45 d8             	mov    -0x28(%ebp),%eax
+}
+  800971:	89 ec                	mov    %ebp,%esp
+  800973:	5d                   	pop    %ebp
+  800974:	c3                   	ret
+
+00800975 <small_class>:
+
+static inline int
+small_class(size_t size) {
+  800975:	55                   	push   %ebp
+  800976:	89 e5                	mov    %esp,%ebp
+  800978:	83 ec 10             	sub    $0x10,%esp
+    int c = 0;
+  80097b:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while ((16 << c) < size) {
+  800982:	eb 03                	jmp    800987 <small_class+0x12>
+        c ++;
+  800984:	ff 45 fc             	incl   -0x4(%ebp)
+    while ((16 << c) < size) {
+  800987:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80098a:	ba 10 00 00 00       	mov    $0x10,%edx
+  80098f:	88 c1                	mov    %al,%cl
+  800991:	d3 e2                	shl    %cl,%edx
+  800993:	89 d0                	mov    %edx,%eax
+  800995:	3b 45 08             	cmp    0x8(%ebp),%eax
+  800998:	72 ea                	jb     800984 <small_class+0xf>
+    }
+    return c;
+  80099a:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  80099d:	89 ec                	mov    %ebp,%esp
+  80099f:	5d                   	pop    %ebp
+  8009a0:	c3                   	ret
+
+008009a1 <malloc>:
+
+void *
+malloc(size_t size) {
+  8009a1:	55                   	push   %ebp
+  8009a2:	89 e5                	mov    %esp,%ebp
+  8009a4:	83 ec 38             	sub    $0x38,%esp
+    if (size == 0 || size >= MAX_ALLOC) {
+  8009a7:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  8009ab:	74 09                	je     8009b6 <malloc+0x15>
+  8009ad:	81 7d 08 ff ff ff 3f 	cmpl   $0x3fffffff,0x8(%ebp)
+  8009b4:	76 0a                	jbe    8009c0 <malloc+0x1f>
+        return NULL;
+  8009b6:	b8 00 00 00 00       	mov    $0x0,%eax
+  8009bb:	e9 4c 01 00 00       	jmp    800b0c <malloc+0x16b>
+    }
+    struct mhdr *b;
+    size_t need = ROUNDUP(size + M_HDRSIZE, M_ALIGN);
+  8009c0:	c7 45 f0 08 00 00 00 	movl   $0x8,-0x10(%ebp)
+  8009c7:	8b 55 08             	mov    0x8(%ebp),%edx
+  8009ca:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8009cd:	01 d0                	add    %edx,%eax
+  8009cf:	83 c0 07             	add    $0x7,%eax
+  8009d2:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  8009d5:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8009d8:	ba 00 00 00 00       	mov    $0x0,%edx
+  8009dd:	f7 75 f0             	divl   -0x10(%ebp)
+  8009e0:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8009e3:	29 d0                	sub    %edx,%eax
+  8009e5:	89 45 e8             	mov    %eax,-0x18(%ebp)
+    if (need >= MMAP_THRESHOLD) {
+  8009e8:	81 7d e8 ff ff 00 00 	cmpl   $0xffff,-0x18(%ebp)
+  8009ef:	0f 86 a6 00 00 00    	jbe    800a9b <malloc+0xfa>
+        size_t len = ROUNDUP(need, PGSIZE);
+  8009f5:	c7 45 e4 00 10 00 00 	movl   $0x1000,-0x1c(%ebp)
+  8009fc:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  8009ff:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800a02:	01 d0                	add    %edx,%eax
+  800a04:	48                   	dec    %eax
+  800a05:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  800a08:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  800a0b:	ba 00 00 00 00       	mov    $0x0,%edx
+  800a10:	f7 75 e4             	divl   -0x1c(%ebp)
+  800a13:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  800a16:	29 d0                	sub    %edx,%eax
+  800a18:	89 45 dc             	mov    %eax,-0x24(%ebp)
+        if ((b = mmap(NULL, len, MMAP_WRITE)) == NULL) {
+  800a1b:	c7 44 24 08 00 01 00 	movl   $0x100,0x8(%esp)
+  800a22:	00 
+  800a23:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800a26:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800a2a:	c7 04 24 00 00 00 00 	movl   $0x0,(%esp)
+  800a31:	e8 69 12 00 00       	call   801c9f <mmap>
+  800a36:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800a39:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  800a3d:	75 0a                	jne    800a49 <malloc+0xa8>
+            return NULL;
+  800a3f:	b8 00 00 00 00       	mov    $0x0,%eax
+  800a44:	e9 c3 00 00 00       	jmp    800b0c <malloc+0x16b>
+        }
+        b->size = len;
+  800a49:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800a4c:	8b 55 dc             	mov    -0x24(%ebp),%edx
+  800a4f:	89 10                	mov    %edx,(%eax)
+        b->flags = M_MMAP | M_USED;
+  800a51:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800a54:	c7 40 04 09 00 00 00 	movl   $0x9,0x4(%eax)
+        lock(&malloc_lock);
+  800a5b:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800a62:	e8 2e f9 ff ff       	call   800395 <lock>
+        mmap_bytes += len, used_bytes += len;
+  800a67:	8b 15 2c 51 80 00    	mov    0x80512c,%edx
+  800a6d:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800a70:	01 d0                	add    %edx,%eax
+  800a72:	a3 2c 51 80 00       	mov    %eax,0x80512c
+  800a77:	8b 15 30 51 80 00    	mov    0x805130,%edx
+  800a7d:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800a80:	01 d0                	add    %edx,%eax
+  800a82:	a3 30 51 80 00       	mov    %eax,0x805130
+        unlock(&malloc_lock);
+  800a87:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800a8e:	e8 53 f9 ff ff       	call   8003e6 <unlock>
+        return b + 1;
+  800a93:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800a96:	83 c0 08             	add    $0x8,%eax
+  800a99:	eb 71                	jmp    800b0c <malloc+0x16b>
+    }
+    lock(&malloc_lock);
+  800a9b:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800aa2:	e8 ee f8 ff ff       	call   800395 <lock>
+    if (need <= MAX_SMALL) {
+  800aa7:	81 7d e8 00 02 00 00 	cmpl   $0x200,-0x18(%ebp)
+  800aae:	77 18                	ja     800ac8 <malloc+0x127>
+        b = small_alloc(small_class(need));
+  800ab0:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800ab3:	89 04 24             	mov    %eax,(%esp)
+  800ab6:	e8 ba fe ff ff       	call   800975 <small_class>
+  800abb:	89 04 24             	mov    %eax,(%esp)
+  800abe:	e8 c5 fd ff ff       	call   800888 <small_alloc>
+  800ac3:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800ac6:	eb 0e                	jmp    800ad6 <malloc+0x135>
+    }
+    else {
+        b = heap_alloc(need);
+  800ac8:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800acb:	89 04 24             	mov    %eax,(%esp)
+  800ace:	e8 34 fc ff ff       	call   800707 <heap_alloc>
+  800ad3:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    }
+    if (b != NULL) {
+  800ad6:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  800ada:	74 11                	je     800aed <malloc+0x14c>
+        used_bytes += b->size;
+  800adc:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800adf:	8b 10                	mov    (%eax),%edx
+  800ae1:	a1 30 51 80 00       	mov    0x805130,%eax
+  800ae6:	01 d0                	add    %edx,%eax
+  800ae8:	a3 30 51 80 00       	mov    %eax,0x805130
+    }
+    unlock(&malloc_lock);
+  800aed:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800af4:	e8 ed f8 ff ff       	call   8003e6 <unlock>
+    return (b != NULL) ? b + 1 : NULL;
+  800af9:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  800afd:	74 08                	je     800b07 <malloc+0x166>
+  800aff:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800b02:	83 c0 08             	add    $0x8,%eax
+  800b05:	eb 05                	jmp    800b0c <malloc+0x16b>
+  800b07:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800b0c:	89 ec                	mov    %ebp,%esp
+  800b0e:	5d                   	pop    %ebp
+  800b0f:	c3                   	ret
+
+00800b10 <calloc>:
+
+void *
+calloc(size_t nmemb, size_t size) {
+  800b10:	55                   	push   %ebp
+  800b11:	89 e5                	mov    %esp,%ebp
+  800b13:	83 ec 28             	sub    $0x28,%esp
+    if (size != 0 && nmemb > MAX_ALLOC / size) {
+  800b16:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  800b1a:	74 19                	je     800b35 <calloc+0x25>
+  800b1c:	b8 00 00 00 40       	mov    $0x40000000,%eax
+  800b21:	ba 00 00 00 00       	mov    $0x0,%edx
+  800b26:	f7 75 0c             	divl   0xc(%ebp)
+  800b29:	3b 45 08             	cmp    0x8(%ebp),%eax
+  800b2c:	73 07                	jae    800b35 <calloc+0x25>
+        return NULL;
+  800b2e:	b8 00 00 00 00       	mov    $0x0,%eax
+  800b33:	eb 39                	jmp    800b6e <calloc+0x5e>
+    }
+    void *ptr;
+    if ((ptr = malloc(nmemb * size)) != NULL) {
+  800b35:	8b 45 08             	mov    0x8(%ebp),%eax
+  800b38:	0f af 45 0c          	imul   0xc(%ebp),%eax
+  800b3c:	89 04 24             	mov    %eax,(%esp)
+  800b3f:	e8 5d fe ff ff       	call   8009a1 <malloc>
+  800b44:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800b47:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  800b4b:	74 1e                	je     800b6b <calloc+0x5b>
+        memset(ptr, 0, nmemb * size);
+  800b4d:	8b 45 08             	mov    0x8(%ebp),%eax
+  800b50:	0f af 45 0c          	imul   0xc(%ebp),%eax
+  800b54:	89 44 24 08          	mov    %eax,0x8(%esp)
+  800b58:	c7 44 24 04 00 00 00 	movl   $0x0,0x4(%esp)
+  800b5f:	00 
+  800b60:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800b63:	89 04 24             	mov    %eax,(%esp)
+  800b66:	e8 81 1e 00 00       	call   8029ec <memset>
+    }
+    return ptr;
+  800b6b:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800b6e:	89 ec                	mov    %ebp,%esp
+  800b70:	5d                   	pop    %ebp
+  800b71:	c3                   	ret
+
+00800b72 <realloc>:
+
+void *
+realloc(void *ptr, size_t size) {
+  800b72:	55                   	push   %ebp
+  800b73:	89 e5                	mov    %esp,%ebp
+  800b75:	83 ec 28             	sub    $0x28,%esp
+    if (ptr == NULL) {
+  800b78:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  800b7c:	75 0d                	jne    800b8b <realloc+0x19>
+        return malloc(size);
+  800b7e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800b81:	89 04 24             	mov    %eax,(%esp)
+  800b84:	e8 18 fe ff ff       	call   8009a1 <malloc>
+  800b89:	eb 74                	jmp    800bff <realloc+0x8d>
+    }
+    if (size == 0) {
+  800b8b:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  800b8f:	75 12                	jne    800ba3 <realloc+0x31>
+        free(ptr);
+  800b91:	8b 45 08             	mov    0x8(%ebp),%eax
+  800b94:	89 04 24             	mov    %eax,(%esp)
+  800b97:	e8 67 00 00 00       	call   800c03 <free>
+        return NULL;
+  800b9c:	b8 00 00 00 00       	mov    $0x0,%eax
+  800ba1:	eb 5c                	jmp    800bff <realloc+0x8d>
+    }
+    struct mhdr *b = (struct mhdr *)ptr - 1;
+  800ba3:	8b 45 08             	mov    0x8(%ebp),%eax
+  800ba6:	83 e8 08             	sub    $0x8,%eax
+  800ba9:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    size_t cap = b->size - M_HDRSIZE;
+  800bac:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800baf:	8b 00                	mov    (%eax),%eax
+  800bb1:	83 e8 08             	sub    $0x8,%eax
+  800bb4:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    if (size <= cap) {
+  800bb7:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800bba:	39 45 f0             	cmp    %eax,-0x10(%ebp)
+  800bbd:	72 05                	jb     800bc4 <realloc+0x52>
+        return ptr;
+  800bbf:	8b 45 08             	mov    0x8(%ebp),%eax
+  800bc2:	eb 3b                	jmp    800bff <realloc+0x8d>
+    }
+    void *nptr;
+    if ((nptr = malloc(size)) != NULL) {
+  800bc4:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800bc7:	89 04 24             	mov    %eax,(%esp)
+  800bca:	e8 d2 fd ff ff       	call   8009a1 <malloc>
+  800bcf:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  800bd2:	83 7d ec 00          	cmpl   $0x0,-0x14(%ebp)
+  800bd6:	74 24                	je     800bfc <realloc+0x8a>
+        memcpy(nptr, ptr, cap);
+  800bd8:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800bdb:	89 44 24 08          	mov    %eax,0x8(%esp)
+  800bdf:	8b 45 08             	mov    0x8(%ebp),%eax
+  800be2:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800be6:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800be9:	89 04 24             	mov    %eax,(%esp)
+  800bec:	e8 e0 1e 00 00       	call   802ad1 <memcpy>
+        free(ptr);
+  800bf1:	8b 45 08             	mov    0x8(%ebp),%eax
+  800bf4:	89 04 24             	mov    %eax,(%esp)
+  800bf7:	e8 07 00 00 00       	call   800c03 <free>
+    }
+    return nptr;
+  800bfc:	8b 45 ec             	mov    -0x14(%ebp),%eax
+}
+  800bff:	89 ec                	mov    %ebp,%esp
+  800c01:	5d                   	pop    %ebp
+  800c02:	c3                   	ret
+
+00800c03 <free>:
+
+void
+free(void *ptr) {
+  800c03:	55                   	push   %ebp
+  800c04:	89 e5                	mov    %esp,%ebp
+  800c06:	83 ec 28             	sub    $0x28,%esp
+    if (ptr == NULL) {
+  800c09:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  800c0d:	0f 84 4a 01 00 00    	je     800d5d <free+0x15a>
+        return ;
+    }
+    struct mhdr *b = (struct mhdr *)ptr - 1;
+  800c13:	8b 45 08             	mov    0x8(%ebp),%eax
+  800c16:	83 e8 08             	sub    $0x8,%eax
+  800c19:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    assert(b->flags & M_USED);
+  800c1c:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800c1f:	8b 40 04             	mov    0x4(%eax),%eax
+  800c22:	83 e0 01             	and    $0x1,%eax
+  800c25:	85 c0                	test   %eax,%eax
+  800c27:	75 24                	jne    800c4d <free+0x4a>
+  800c29:	c7 44 24 0c 62 2c 80 	movl   $0x802c62,0xc(%esp)
+  800c30:	00 
+  800c31:	c7 44 24 08 3a 2c 80 	movl   $0x802c3a,0x8(%esp)
+  800c38:	00 
+  800c39:	c7 44 24 04 22 01 00 	movl   $0x122,0x4(%esp)
+  800c40:	00 
+  800c41:	c7 04 24 4f 2c 80 00 	movl   $0x802c4f,(%esp)
+  800c48:	e8 b7 01 00 00       	call   800e04 <__panic>
+    if (b->flags & M_MMAP) {
+  800c4d:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800c50:	8b 40 04             	mov    0x4(%eax),%eax
+  800c53:	83 e0 08             	and    $0x8,%eax
+  800c56:	85 c0                	test   %eax,%eax
+  800c58:	74 79                	je     800cd3 <free+0xd0>
+        size_t len = b->size;
+  800c5a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800c5d:	8b 00                	mov    (%eax),%eax
+  800c5f:	89 45 e8             	mov    %eax,-0x18(%ebp)
+        assert(munmap(b, len) == 0);
+  800c62:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800c65:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800c69:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800c6c:	89 04 24             	mov    %eax,(%esp)
+  800c6f:	e8 62 10 00 00       	call   801cd6 <munmap>
+  800c74:	85 c0                	test   %eax,%eax
+  800c76:	74 24                	je     800c9c <free+0x99>
+  800c78:	c7 44 24 0c 74 2c 80 	movl   $0x802c74,0xc(%esp)
+  800c7f:	00 
+  800c80:	c7 44 24 08 3a 2c 80 	movl   $0x802c3a,0x8(%esp)
+  800c87:	00 
+  800c88:	c7 44 24 04 25 01 00 	movl   $0x125,0x4(%esp)
+  800c8f:	00 
+  800c90:	c7 04 24 4f 2c 80 00 	movl   $0x802c4f,(%esp)
+  800c97:	e8 68 01 00 00       	call   800e04 <__panic>
+        lock(&malloc_lock);
+  800c9c:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800ca3:	e8 ed f6 ff ff       	call   800395 <lock>
+        mmap_bytes -= len, used_bytes -= len;
+  800ca8:	a1 2c 51 80 00       	mov    0x80512c,%eax
+  800cad:	2b 45 e8             	sub    -0x18(%ebp),%eax
+  800cb0:	a3 2c 51 80 00       	mov    %eax,0x80512c
+  800cb5:	a1 30 51 80 00       	mov    0x805130,%eax
+  800cba:	2b 45 e8             	sub    -0x18(%ebp),%eax
+  800cbd:	a3 30 51 80 00       	mov    %eax,0x805130
+        unlock(&malloc_lock);
+  800cc2:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800cc9:	e8 18 f7 ff ff       	call   8003e6 <unlock>
+        return ;
+  800cce:	e9 8b 00 00 00       	jmp    800d5e <free+0x15b>
+    }
+    lock(&malloc_lock);
+  800cd3:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800cda:	e8 b6 f6 ff ff       	call   800395 <lock>
+    used_bytes -= b->size;
+  800cdf:	8b 15 30 51 80 00    	mov    0x805130,%edx
+  800ce5:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800ce8:	8b 00                	mov    (%eax),%eax
+  800cea:	29 c2                	sub    %eax,%edx
+  800cec:	89 15 30 51 80 00    	mov    %edx,0x805130
+    if (b->flags & M_SMALL) {
+  800cf2:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800cf5:	8b 40 04             	mov    0x4(%eax),%eax
+  800cf8:	83 e0 04             	and    $0x4,%eax
+  800cfb:	85 c0                	test   %eax,%eax
+  800cfd:	74 45                	je     800d44 <free+0x141>
+        struct sfree *s = (struct sfree *)ptr;
+  800cff:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d02:	89 45 f0             	mov    %eax,-0x10(%ebp)
+        int c = small_class(b->size);
+  800d05:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800d08:	8b 00                	mov    (%eax),%eax
+  800d0a:	89 04 24             	mov    %eax,(%esp)
+  800d0d:	e8 63 fc ff ff       	call   800975 <small_class>
+  800d12:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        b->flags &= ~M_USED;
+  800d15:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800d18:	8b 40 04             	mov    0x4(%eax),%eax
+  800d1b:	83 e0 fe             	and    $0xfffffffe,%eax
+  800d1e:	89 c2                	mov    %eax,%edx
+  800d20:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800d23:	89 50 04             	mov    %edx,0x4(%eax)
+        s->next = small_free[c];
+  800d26:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800d29:	8b 14 85 0c 51 80 00 	mov    0x80510c(,%eax,4),%edx
+  800d30:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800d33:	89 10                	mov    %edx,(%eax)
+        small_free[c] = s;
+  800d35:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  800d38:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  800d3b:	89 14 85 0c 51 80 00 	mov    %edx,0x80510c(,%eax,4)
+  800d42:	eb 0b                	jmp    800d4f <free+0x14c>
+    }
+    else {
+        heap_free(b);
+  800d44:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800d47:	89 04 24             	mov    %eax,(%esp)
+  800d4a:	e8 e5 fa ff ff       	call   800834 <heap_free>
+    }
+    unlock(&malloc_lock);
+  800d4f:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800d56:	e8 8b f6 ff ff       	call   8003e6 <unlock>
+  800d5b:	eb 01                	jmp    800d5e <free+0x15b>
+        return ;
+  800d5d:	90                   	nop
+}
+  800d5e:	89 ec                	mov    %ebp,%esp
+  800d60:	5d                   	pop    %ebp
+  800d61:	c3                   	ret
+
+00800d62 <malloc_stat>:
+
+void
+malloc_stat(struct malloc_stat *stat) {
+  800d62:	55                   	push   %ebp
+  800d63:	89 e5                	mov    %esp,%ebp
+  800d65:	83 ec 28             	sub    $0x28,%esp
+    lock(&malloc_lock);
+  800d68:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800d6f:	e8 21 f6 ff ff       	call   800395 <lock>
+    stat->heap_bytes = heap_bytes;
+  800d74:	8b 15 28 51 80 00    	mov    0x805128,%edx
+  800d7a:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d7d:	89 10                	mov    %edx,(%eax)
+    stat->mmap_bytes = mmap_bytes;
+  800d7f:	8b 15 2c 51 80 00    	mov    0x80512c,%edx
+  800d85:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d88:	89 50 04             	mov    %edx,0x4(%eax)
+    stat->used_bytes = used_bytes;
+  800d8b:	8b 15 30 51 80 00    	mov    0x805130,%edx
+  800d91:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d94:	89 50 08             	mov    %edx,0x8(%eax)
+    stat->free_bytes = stat->nr_free = 0;
+  800d97:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d9a:	c7 40 10 00 00 00 00 	movl   $0x0,0x10(%eax)
+  800da1:	8b 45 08             	mov    0x8(%ebp),%eax
+  800da4:	8b 50 10             	mov    0x10(%eax),%edx
+  800da7:	8b 45 08             	mov    0x8(%ebp),%eax
+  800daa:	89 50 0c             	mov    %edx,0xc(%eax)
+    list_entry_t *le = &free_list;
+  800dad:	c7 45 f4 04 40 80 00 	movl   $0x804004,-0xc(%ebp)
+    while ((le = list_next(le)) != &free_list) {
+  800db4:	eb 25                	jmp    800ddb <malloc_stat+0x79>
+        stat->free_bytes += le2mfree(le)->hdr.size;
+  800db6:	8b 45 08             	mov    0x8(%ebp),%eax
+  800db9:	8b 50 0c             	mov    0xc(%eax),%edx
+  800dbc:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800dbf:	83 e8 08             	sub    $0x8,%eax
+  800dc2:	8b 00                	mov    (%eax),%eax
+  800dc4:	01 c2                	add    %eax,%edx
+  800dc6:	8b 45 08             	mov    0x8(%ebp),%eax
+  800dc9:	89 50 0c             	mov    %edx,0xc(%eax)
+        stat->nr_free ++;
+  800dcc:	8b 45 08             	mov    0x8(%ebp),%eax
+  800dcf:	8b 40 10             	mov    0x10(%eax),%eax
+  800dd2:	8d 50 01             	lea    0x1(%eax),%edx
+  800dd5:	8b 45 08             	mov    0x8(%ebp),%eax
+  800dd8:	89 50 10             	mov    %edx,0x10(%eax)
+  800ddb:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800dde:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    return listelm->next;
+  800de1:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800de4:	8b 40 04             	mov    0x4(%eax),%eax
+    while ((le = list_next(le)) != &free_list) {
+  800de7:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800dea:	81 7d f4 04 40 80 00 	cmpl   $0x804004,-0xc(%ebp)
+  800df1:	75 c3                	jne    800db6 <malloc_stat+0x54>
+    }
+    unlock(&malloc_lock);
+  800df3:	c7 04 24 08 51 80 00 	movl   $0x805108,(%esp)
+  800dfa:	e8 e7 f5 ff ff       	call   8003e6 <unlock>
+}
+  800dff:	90                   	nop
+  800e00:	89 ec                	mov    %ebp,%esp
+  800e02:	5d                   	pop    %ebp
+  800e03:	c3                   	ret
+
+00800e04 <__panic>:
+#include <stdio.h>
+#include <ulib.h>
+#include <error.h>
+
+void
+__panic(const char *file, int line, const char *fmt, ...) {
+  800e04:	55                   	push   %ebp
+  800e05:	89 e5                	mov    %esp,%ebp
+  800e07:	83 ec 28             	sub    $0x28,%esp
+    // print the 'message'
+    va_list ap;
+    va_start(ap, fmt);
+  800e0a:	8d 45 14             	lea    0x14(%ebp),%eax
+  800e0d:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    cprintf("user panic at %s:%d:\n    ", file, line);
+  800e10:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800e13:	89 44 24 08          	mov    %eax,0x8(%esp)
+  800e17:	8b 45 08             	mov    0x8(%ebp),%eax
+  800e1a:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800e1e:	c7 04 24 88 2c 80 00 	movl   $0x802c88,(%esp)
+  800e25:	e8 d3 00 00 00       	call   800efd <cprintf>
+    vcprintf(fmt, ap);
+  800e2a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800e2d:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800e31:	8b 45 10             	mov    0x10(%ebp),%eax
+  800e34:	89 04 24             	mov    %eax,(%esp)
+  800e37:	e8 84 00 00 00       	call   800ec0 <vcprintf>
+    cprintf("\n");
+  800e3c:	c7 04 24 a2 2c 80 00 	movl   $0x802ca2,(%esp)
+  800e43:	e8 b5 00 00 00       	call   800efd <cprintf>
+    va_end(ap);
+    exit(-E_PANIC);
+  800e48:	c7 04 24 f6 ff ff ff 	movl   $0xfffffff6,(%esp)
+  800e4f:	e8 48 0b 00 00       	call   80199c <exit>
+
+00800e54 <__warn>:
+}
+
+void
+__warn(const char *file, int line, const char *fmt, ...) {
+  800e54:	55                   	push   %ebp
+  800e55:	89 e5                	mov    %esp,%ebp
+  800e57:	83 ec 28             	sub    $0x28,%esp
+    va_list ap;
+    va_start(ap, fmt);
+  800e5a:	8d 45 14             	lea    0x14(%ebp),%eax
+  800e5d:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    cprintf("user warning at %s:%d:\n    ", file, line);
+  800e60:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800e63:	89 44 24 08          	mov    %eax,0x8(%esp)
+  800e67:	8b 45 08             	mov    0x8(%ebp),%eax
+  800e6a:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800e6e:	c7 04 24 a4 2c 80 00 	movl   $0x802ca4,(%esp)
+  800e75:	e8 83 00 00 00       	call   800efd <cprintf>
+    vcprintf(fmt, ap);
+  800e7a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800e7d:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800e81:	8b 45 10             	mov    0x10(%ebp),%eax
+  800e84:	89 04 24             	mov    %eax,(%esp)
+  800e87:	e8 34 00 00 00       	call   800ec0 <vcprintf>
+    cprintf("\n");
+  800e8c:	c7 04 24 a2 2c 80 00 	movl   $0x802ca2,(%esp)
+  800e93:	e8 65 00 00 00       	call   800efd <cprintf>
+    va_end(ap);
+}
+  800e98:	90                   	nop
+  800e99:	89 ec                	mov    %ebp,%esp
+  800e9b:	5d                   	pop    %ebp
+  800e9c:	c3                   	ret
+
+00800e9d <cputch>:
+/* *
+ * cputch - writes a single character @c to stdout, and it will
+ * increace the value of counter pointed by @cnt.
+ * */
+static void
+cputch(int c, int *cnt) {
+  800e9d:	55                   	push   %ebp
+  800e9e:	89 e5                	mov    %esp,%ebp
+  800ea0:	83 ec 18             	sub    $0x18,%esp
+    sys_putc(c);
+  800ea3:	8b 45 08             	mov    0x8(%ebp),%eax
+  800ea6:	89 04 24             	mov    %eax,(%esp)
+  800ea9:	e8 57 03 00 00       	call   801205 <sys_putc>
+    (*cnt) ++;
+  800eae:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800eb1:	8b 00                	mov    (%eax),%eax
+  800eb3:	8d 50 01             	lea    0x1(%eax),%edx
+  800eb6:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800eb9:	89 10                	mov    %edx,(%eax)
+}
+  800ebb:	90                   	nop
+  800ebc:	89 ec                	mov    %ebp,%esp
+  800ebe:	5d                   	pop    %ebp
+  800ebf:	c3                   	ret
+
+00800ec0 <vcprintf>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want cprintf() instead.
+ * */
+int
+vcprintf(const char *fmt, va_list ap) {
+  800ec0:	55                   	push   %ebp
+  800ec1:	89 e5                	mov    %esp,%ebp
+  800ec3:	83 ec 38             	sub    $0x38,%esp
+    int cnt = 0;
+  800ec6:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    vprintfmt((void*)cputch, NO_FD, &cnt, fmt, ap);
+  800ecd:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800ed0:	89 44 24 10          	mov    %eax,0x10(%esp)
+  800ed4:	8b 45 08             	mov    0x8(%ebp),%eax
+  800ed7:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  800edb:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800ede:	89 44 24 08          	mov    %eax,0x8(%esp)
+  800ee2:	c7 44 24 04 d9 6a ff 	movl   $0xffff6ad9,0x4(%esp)
+  800ee9:	ff 
+  800eea:	c7 04 24 9d 0e 80 00 	movl   $0x800e9d,(%esp)
+  800ef1:	e8 af 11 00 00       	call   8020a5 <vprintfmt>
+    return cnt;
+  800ef6:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800ef9:	89 ec                	mov    %ebp,%esp
+  800efb:	5d                   	pop    %ebp
+  800efc:	c3                   	ret
+
+00800efd <cprintf>:
+ *
+ * The return value is the number of characters which would be
+ * written to stdout.
+ * */
+int
+cprintf(const char *fmt, ...) {
+  800efd:	55                   	push   %ebp
+  800efe:	89 e5                	mov    %esp,%ebp
+  800f00:	83 ec 28             	sub    $0x28,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  800f03:	8d 45 0c             	lea    0xc(%ebp),%eax
+  800f06:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    int cnt = vcprintf(fmt, ap);
+  800f09:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800f0c:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800f10:	8b 45 08             	mov    0x8(%ebp),%eax
+  800f13:	89 04 24             	mov    %eax,(%esp)
+  800f16:	e8 a5 ff ff ff       	call   800ec0 <vcprintf>
+  800f1b:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+
+    return cnt;
+  800f1e:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800f21:	89 ec                	mov    %ebp,%esp
+  800f23:	5d                   	pop    %ebp
+  800f24:	c3                   	ret
+
+00800f25 <cputs>:
+/* *
+ * cputs- writes the string pointed by @str to stdout and
+ * appends a newline character.
+ * */
+int
+cputs(const char *str) {
+  800f25:	55                   	push   %ebp
+  800f26:	89 e5                	mov    %esp,%ebp
+  800f28:	83 ec 28             	sub    $0x28,%esp
+    int cnt = 0;
+  800f2b:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+    char c;
+    while ((c = *str ++) != '\0') {
+  800f32:	eb 13                	jmp    800f47 <cputs+0x22>
+        cputch(c, &cnt);
+  800f34:	0f be 45 f7          	movsbl -0x9(%ebp),%eax
+  800f38:	8d 55 f0             	lea    -0x10(%ebp),%edx
+  800f3b:	89 54 24 04          	mov    %edx,0x4(%esp)
+  800f3f:	89 04 24             	mov    %eax,(%esp)
+  800f42:	e8 56 ff ff ff       	call   800e9d <cputch>
+    while ((c = *str ++) != '\0') {
+  800f47:	8b 45 08             	mov    0x8(%ebp),%eax
+  800f4a:	8d 50 01             	lea    0x1(%eax),%edx
+  800f4d:	89 55 08             	mov    %edx,0x8(%ebp)
+  800f50:	0f b6 00             	movzbl (%eax),%eax
+  800f53:	88 45 f7             	mov    %al,-0x9(%ebp)
+  800f56:	80 7d f7 00          	cmpb   $0x0,-0x9(%ebp)
+  800f5a:	75 d8                	jne    800f34 <cputs+0xf>
+    }
+    cputch('\n', &cnt);
+  800f5c:	8d 45 f0             	lea    -0x10(%ebp),%eax
+  800f5f:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800f63:	c7 04 24 0a 00 00 00 	movl   $0xa,(%esp)
+  800f6a:	e8 2e ff ff ff       	call   800e9d <cputch>
+    return cnt;
+  800f6f:	8b 45 f0             	mov    -0x10(%ebp),%eax
+}
+  800f72:	89 ec                	mov    %ebp,%esp
+  800f74:	5d                   	pop    %ebp
+  800f75:	c3                   	ret
+
+00800f76 <fputch>:
+
+
+static void
+fputch(char c, int *cnt, int fd) {
+  800f76:	55                   	push   %ebp
+  800f77:	89 e5                	mov    %esp,%ebp
+  800f79:	83 ec 28             	sub    $0x28,%esp
+  800f7c:	8b 45 08             	mov    0x8(%ebp),%eax
+  800f7f:	88 45 f4             	mov    %al,-0xc(%ebp)
+    write(fd, &c, sizeof(char));
+  800f82:	c7 44 24 08 01 00 00 	movl   $0x1,0x8(%esp)
+  800f89:	00 
+  800f8a:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800f8d:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800f91:	8b 45 10             	mov    0x10(%ebp),%eax
+  800f94:	89 04 24             	mov    %eax,(%esp)
+  800f97:	e8 f5 f1 ff ff       	call   800191 <write>
+    (*cnt) ++;
+  800f9c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800f9f:	8b 00                	mov    (%eax),%eax
+  800fa1:	8d 50 01             	lea    0x1(%eax),%edx
+  800fa4:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800fa7:	89 10                	mov    %edx,(%eax)
+}
+  800fa9:	90                   	nop
+  800faa:	89 ec                	mov    %ebp,%esp
+  800fac:	5d                   	pop    %ebp
+  800fad:	c3                   	ret
+
+00800fae <vfprintf>:
+
+int
+vfprintf(int fd, const char *fmt, va_list ap) {
+  800fae:	55                   	push   %ebp
+  800faf:	89 e5                	mov    %esp,%ebp
+  800fb1:	83 ec 38             	sub    $0x38,%esp
+    int cnt = 0;
+  800fb4:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    vprintfmt((void*)fputch, fd, &cnt, fmt, ap);
+  800fbb:	8b 45 10             	mov    0x10(%ebp),%eax
+  800fbe:	89 44 24 10          	mov    %eax,0x10(%esp)
+  800fc2:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800fc5:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  800fc9:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800fcc:	89 44 24 08          	mov    %eax,0x8(%esp)
+  800fd0:	8b 45 08             	mov    0x8(%ebp),%eax
+  800fd3:	89 44 24 04          	mov    %eax,0x4(%esp)
+  800fd7:	c7 04 24 76 0f 80 00 	movl   $0x800f76,(%esp)
+  800fde:	e8 c2 10 00 00       	call   8020a5 <vprintfmt>
+    return cnt;
+  800fe3:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800fe6:	89 ec                	mov    %ebp,%esp
+  800fe8:	5d                   	pop    %ebp
+  800fe9:	c3                   	ret
+
+00800fea <fprintf>:
+
+int
+fprintf(int fd, const char *fmt, ...) {
+  800fea:	55                   	push   %ebp
+  800feb:	89 e5                	mov    %esp,%ebp
+  800fed:	83 ec 28             	sub    $0x28,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  800ff0:	8d 45 10             	lea    0x10(%ebp),%eax
+  800ff3:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    int cnt = vfprintf(fd, fmt, ap);
+  800ff6:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800ff9:	89 44 24 08          	mov    %eax,0x8(%esp)
+  800ffd:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801000:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801004:	8b 45 08             	mov    0x8(%ebp),%eax
+  801007:	89 04 24             	mov    %eax,(%esp)
+  80100a:	e8 9f ff ff ff       	call   800fae <vfprintf>
+  80100f:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+
+    return cnt;
+  801012:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801015:	89 ec                	mov    %ebp,%esp
+  801017:	5d                   	pop    %ebp
+  801018:	c3                   	ret
+
+00801019 <sysenter_supported>:
+// 1 if the system calls enter with SYSENTER, 0 with int $T_SYSCALL, -1 if not checked yet
+static int use_sysenter = -1;
+
+// sysenter_supported - the kernel sets up SYSENTER if CPUID reports it, see sysenter_init
+static bool
+sysenter_supported(void) {
+  801019:	55                   	push   %ebp
+  80101a:	89 e5                	mov    %esp,%ebp
+  80101c:	83 ec 34             	sub    $0x34,%esp
+  80101f:	89 5d fc             	mov    %ebx,-0x4(%ebp)
+  801022:	c7 45 f8 01 00 00 00 	movl   $0x1,-0x8(%ebp)
+  801029:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+  801030:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+  801037:	c7 45 ec 00 00 00 00 	movl   $0x0,-0x14(%ebp)
+  80103e:	8d 45 d4             	lea    -0x2c(%ebp),%eax
+  801041:	89 45 e8             	mov    %eax,-0x18(%ebp)
+}
+
+static inline void
+cpuid(uint32_t info, uint32_t *eaxp, uint32_t *ebxp, uint32_t *ecxp, uint32_t *edxp) {
+    uint32_t eax, ebx, ecx, edx;
+    asm volatile ("cpuid"
+  801044:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801047:	0f a2                	cpuid
+  801049:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  80104c:	89 5d e0             	mov    %ebx,-0x20(%ebp)
+  80104f:	89 4d dc             	mov    %ecx,-0x24(%ebp)
+  801052:	89 55 d8             	mov    %edx,-0x28(%ebp)
+            : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+            : "a" (info));
+    if (eaxp != NULL) {
+  801055:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  801059:	74 08                	je     801063 <sysenter_supported+0x4a>
+        *eaxp = eax;
+  80105b:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80105e:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  801061:	89 10                	mov    %edx,(%eax)
+    }
+    if (ebxp != NULL) {
+  801063:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  801067:	74 08                	je     801071 <sysenter_supported+0x58>
+        *ebxp = ebx;
+  801069:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80106c:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  80106f:	89 10                	mov    %edx,(%eax)
+    }
+    if (ecxp != NULL) {
+  801071:	83 7d ec 00          	cmpl   $0x0,-0x14(%ebp)
+  801075:	74 08                	je     80107f <sysenter_supported+0x66>
+        *ecxp = ecx;
+  801077:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  80107a:	8b 55 dc             	mov    -0x24(%ebp),%edx
+  80107d:	89 10                	mov    %edx,(%eax)
+    }
+    if (edxp != NULL) {
+  80107f:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801083:	74 08                	je     80108d <sysenter_supported+0x74>
+        *edxp = edx;
+  801085:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801088:	8b 55 d8             	mov    -0x28(%ebp),%edx
+  80108b:	89 10                	mov    %edx,(%eax)
+    }
+}
+  80108d:	90                   	nop
+    uint32_t edx;
+    cpuid(1, NULL, NULL, NULL, &edx);
+    return (edx & CPUID_FEAT_SEP) != 0;
+  80108e:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+  801091:	25 00 08 00 00       	and    $0x800,%eax
+  801096:	85 c0                	test   %eax,%eax
+  801098:	0f 95 c0             	setne  %al
+  80109b:	0f b6 c0             	movzbl %al,%eax
+}
+  80109e:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  8010a1:	89 ec                	mov    %ebp,%esp
+  8010a3:	5d                   	pop    %ebp
+  8010a4:	c3                   	ret
+
+008010a5 <syscall>:
+
+static inline int
+syscall(int num, ...) {
+  8010a5:	55                   	push   %ebp
+  8010a6:	89 e5                	mov    %esp,%ebp
+  8010a8:	57                   	push   %edi
+  8010a9:	56                   	push   %esi
+  8010aa:	53                   	push   %ebx
+  8010ab:	83 ec 20             	sub    $0x20,%esp
+    va_list ap;
+    va_start(ap, num);
+  8010ae:	8d 45 0c             	lea    0xc(%ebp),%eax
+  8010b1:	89 45 e8             	mov    %eax,-0x18(%ebp)
+    uint32_t a[MAX_ARGS];
+    int i, ret;
+    for (i = 0; i < MAX_ARGS; i ++) {
+  8010b4:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+  8010bb:	eb 15                	jmp    8010d2 <syscall+0x2d>
+        a[i] = va_arg(ap, uint32_t);
+  8010bd:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8010c0:	8d 50 04             	lea    0x4(%eax),%edx
+  8010c3:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  8010c6:	8b 10                	mov    (%eax),%edx
+  8010c8:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8010cb:	89 54 85 d4          	mov    %edx,-0x2c(%ebp,%eax,4)
+    for (i = 0; i < MAX_ARGS; i ++) {
+  8010cf:	ff 45 f0             	incl   -0x10(%ebp)
+  8010d2:	83 7d f0 04          	cmpl   $0x4,-0x10(%ebp)
+  8010d6:	7e e5                	jle    8010bd <syscall+0x18>
+    }
+    va_end(ap);
+
+    if (use_sysenter < 0) {
+  8010d8:	a1 0c 40 80 00       	mov    0x80400c,%eax
+  8010dd:	85 c0                	test   %eax,%eax
+  8010df:	79 0a                	jns    8010eb <syscall+0x46>
+        use_sysenter = sysenter_supported();
+  8010e1:	e8 33 ff ff ff       	call   801019 <sysenter_supported>
+  8010e6:	a3 0c 40 80 00       	mov    %eax,0x80400c
+    }
+    if (use_sysenter) {
+  8010eb:	a1 0c 40 80 00       	mov    0x80400c,%eax
+  8010f0:	85 c0                	test   %eax,%eax
+  8010f2:	74 25                	je     801119 <syscall+0x74>
+        asm volatile (
+            "call %P3;"
+            : "=a" (ret), "+d" (a[0]), "+c" (a[1])
+            : "i" (VDSO_SYSENTER),
+              "a" (num),
+              "b" (a[2]),
+  8010f4:	8b 5d dc             	mov    -0x24(%ebp),%ebx
+              "D" (a[3]),
+  8010f7:	8b 7d e0             	mov    -0x20(%ebp),%edi
+              "S" (a[4])
+  8010fa:	8b 75 e4             	mov    -0x1c(%ebp),%esi
+            : "=a" (ret), "+d" (a[0]), "+c" (a[1])
+  8010fd:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+  801100:	8b 4d d8             	mov    -0x28(%ebp),%ecx
+        asm volatile (
+  801103:	8b 45 08             	mov    0x8(%ebp),%eax
+  801106:	e8 f5 d6 6f af       	call   afefe800 <cur_brk.0+0xaf6b86f8>
+  80110b:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  80110e:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  801111:	89 4d d8             	mov    %ecx,-0x28(%ebp)
+            : "cc", "memory");
+        return ret;
+  801114:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801117:	eb 1a                	jmp    801133 <syscall+0x8e>
+    asm volatile (
+        "int %1;"
+        : "=a" (ret)
+        : "i" (T_SYSCALL),
+          "a" (num),
+          "d" (a[0]),
+  801119:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+          "c" (a[1]),
+  80111c:	8b 4d d8             	mov    -0x28(%ebp),%ecx
+          "b" (a[2]),
+  80111f:	8b 5d dc             	mov    -0x24(%ebp),%ebx
+          "D" (a[3]),
+  801122:	8b 7d e0             	mov    -0x20(%ebp),%edi
+          "S" (a[4])
+  801125:	8b 75 e4             	mov    -0x1c(%ebp),%esi
+    asm volatile (
+  801128:	8b 45 08             	mov    0x8(%ebp),%eax
+  80112b:	cd 80                	int    $0x80
+  80112d:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        : "cc", "memory");
+    return ret;
+  801130:	8b 45 ec             	mov    -0x14(%ebp),%eax
+}
+  801133:	83 c4 20             	add    $0x20,%esp
+  801136:	5b                   	pop    %ebx
+  801137:	5e                   	pop    %esi
+  801138:	5f                   	pop    %edi
+  801139:	5d                   	pop    %ebp
+  80113a:	c3                   	ret
+
+0080113b <syscall_sysenter>:
+ * syscall_sysenter - choose how the system calls enter the kernel: with SYSENTER if enable
+ * and the cpu has it, or with int $T_SYSCALL, which always works.
+ * return value: 1 if SYSENTER is used
+ * */
+bool
+syscall_sysenter(bool enable) {
+  80113b:	55                   	push   %ebp
+  80113c:	89 e5                	mov    %esp,%ebp
+    use_sysenter = enable && sysenter_supported();
+  80113e:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  801142:	74 10                	je     801154 <syscall_sysenter+0x19>
+  801144:	e8 d0 fe ff ff       	call   801019 <sysenter_supported>
+  801149:	85 c0                	test   %eax,%eax
+  80114b:	74 07                	je     801154 <syscall_sysenter+0x19>
+  80114d:	b8 01 00 00 00       	mov    $0x1,%eax
+  801152:	eb 05                	jmp    801159 <syscall_sysenter+0x1e>
+  801154:	b8 00 00 00 00       	mov    $0x0,%eax
+  801159:	a3 0c 40 80 00       	mov    %eax,0x80400c
+    return use_sysenter;
+  80115e:	a1 0c 40 80 00       	mov    0x80400c,%eax
+}
+  801163:	5d                   	pop    %ebp
+  801164:	c3                   	ret
+
+00801165 <sys_exit>:
+
+int
+sys_exit(int error_code) {
+  801165:	55                   	push   %ebp
+  801166:	89 e5                	mov    %esp,%ebp
+  801168:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_exit, error_code);
+  80116b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80116e:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801172:	c7 04 24 01 00 00 00 	movl   $0x1,(%esp)
+  801179:	e8 27 ff ff ff       	call   8010a5 <syscall>
+}
+  80117e:	89 ec                	mov    %ebp,%esp
+  801180:	5d                   	pop    %ebp
+  801181:	c3                   	ret
+
+00801182 <sys_fork>:
+
+int
+sys_fork(void) {
+  801182:	55                   	push   %ebp
+  801183:	89 e5                	mov    %esp,%ebp
+  801185:	83 ec 04             	sub    $0x4,%esp
+    return syscall(SYS_fork);
+  801188:	c7 04 24 02 00 00 00 	movl   $0x2,(%esp)
+  80118f:	e8 11 ff ff ff       	call   8010a5 <syscall>
+}
+  801194:	89 ec                	mov    %ebp,%esp
+  801196:	5d                   	pop    %ebp
+  801197:	c3                   	ret
+
+00801198 <sys_wait>:
+
+int
+sys_wait(int pid, int *store) {
+  801198:	55                   	push   %ebp
+  801199:	89 e5                	mov    %esp,%ebp
+  80119b:	83 ec 0c             	sub    $0xc,%esp
+    return syscall(SYS_wait, pid, store);
+  80119e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8011a1:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8011a5:	8b 45 08             	mov    0x8(%ebp),%eax
+  8011a8:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8011ac:	c7 04 24 03 00 00 00 	movl   $0x3,(%esp)
+  8011b3:	e8 ed fe ff ff       	call   8010a5 <syscall>
+}
+  8011b8:	89 ec                	mov    %ebp,%esp
+  8011ba:	5d                   	pop    %ebp
+  8011bb:	c3                   	ret
+
+008011bc <sys_yield>:
+
+int
+sys_yield(void) {
+  8011bc:	55                   	push   %ebp
+  8011bd:	89 e5                	mov    %esp,%ebp
+  8011bf:	83 ec 04             	sub    $0x4,%esp
+    return syscall(SYS_yield);
+  8011c2:	c7 04 24 0a 00 00 00 	movl   $0xa,(%esp)
+  8011c9:	e8 d7 fe ff ff       	call   8010a5 <syscall>
+}
+  8011ce:	89 ec                	mov    %ebp,%esp
+  8011d0:	5d                   	pop    %ebp
+  8011d1:	c3                   	ret
+
+008011d2 <sys_kill>:
+
+int
+sys_kill(int pid) {
+  8011d2:	55                   	push   %ebp
+  8011d3:	89 e5                	mov    %esp,%ebp
+  8011d5:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_kill, pid);
+  8011d8:	8b 45 08             	mov    0x8(%ebp),%eax
+  8011db:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8011df:	c7 04 24 0c 00 00 00 	movl   $0xc,(%esp)
+  8011e6:	e8 ba fe ff ff       	call   8010a5 <syscall>
+}
+  8011eb:	89 ec                	mov    %ebp,%esp
+  8011ed:	5d                   	pop    %ebp
+  8011ee:	c3                   	ret
+
+008011ef <sys_getpid>:
+
+int
+sys_getpid(void) {
+  8011ef:	55                   	push   %ebp
+  8011f0:	89 e5                	mov    %esp,%ebp
+  8011f2:	83 ec 04             	sub    $0x4,%esp
+    return syscall(SYS_getpid);
+  8011f5:	c7 04 24 12 00 00 00 	movl   $0x12,(%esp)
+  8011fc:	e8 a4 fe ff ff       	call   8010a5 <syscall>
+}
+  801201:	89 ec                	mov    %ebp,%esp
+  801203:	5d                   	pop    %ebp
+  801204:	c3                   	ret
+
+00801205 <sys_putc>:
+
+int
+sys_putc(int c) {
+  801205:	55                   	push   %ebp
+  801206:	89 e5                	mov    %esp,%ebp
+  801208:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_putc, c);
+  80120b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80120e:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801212:	c7 04 24 1e 00 00 00 	movl   $0x1e,(%esp)
+  801219:	e8 87 fe ff ff       	call   8010a5 <syscall>
+}
+  80121e:	89 ec                	mov    %ebp,%esp
+  801220:	5d                   	pop    %ebp
+  801221:	c3                   	ret
+
+00801222 <sys_pgdir>:
+
+int
+sys_pgdir(void) {
+  801222:	55                   	push   %ebp
+  801223:	89 e5                	mov    %esp,%ebp
+  801225:	83 ec 04             	sub    $0x4,%esp
+    return syscall(SYS_pgdir);
+  801228:	c7 04 24 1f 00 00 00 	movl   $0x1f,(%esp)
+  80122f:	e8 71 fe ff ff       	call   8010a5 <syscall>
+}
+  801234:	89 ec                	mov    %ebp,%esp
+  801236:	5d                   	pop    %ebp
+  801237:	c3                   	ret
+
+00801238 <sys_lab6_set_priority>:
+
+void
+sys_lab6_set_priority(uint32_t priority)
+{
+  801238:	55                   	push   %ebp
+  801239:	89 e5                	mov    %esp,%ebp
+  80123b:	83 ec 08             	sub    $0x8,%esp
+    syscall(SYS_lab6_set_priority, priority);
+  80123e:	8b 45 08             	mov    0x8(%ebp),%eax
+  801241:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801245:	c7 04 24 ff 00 00 00 	movl   $0xff,(%esp)
+  80124c:	e8 54 fe ff ff       	call   8010a5 <syscall>
+}
+  801251:	90                   	nop
+  801252:	89 ec                	mov    %ebp,%esp
+  801254:	5d                   	pop    %ebp
+  801255:	c3                   	ret
+
+00801256 <sys_sleep>:
+
+int
+sys_sleep(unsigned int time) {
+  801256:	55                   	push   %ebp
+  801257:	89 e5                	mov    %esp,%ebp
+  801259:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_sleep, time);
+  80125c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80125f:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801263:	c7 04 24 0b 00 00 00 	movl   $0xb,(%esp)
+  80126a:	e8 36 fe ff ff       	call   8010a5 <syscall>
+}
+  80126f:	89 ec                	mov    %ebp,%esp
+  801271:	5d                   	pop    %ebp
+  801272:	c3                   	ret
+
+00801273 <sys_gettime>:
+
+int
+sys_gettime(void) {
+  801273:	55                   	push   %ebp
+  801274:	89 e5                	mov    %esp,%ebp
+  801276:	83 ec 04             	sub    $0x4,%esp
+    return syscall(SYS_gettime);
+  801279:	c7 04 24 11 00 00 00 	movl   $0x11,(%esp)
+  801280:	e8 20 fe ff ff       	call   8010a5 <syscall>
+}
+  801285:	89 ec                	mov    %ebp,%esp
+  801287:	5d                   	pop    %ebp
+  801288:	c3                   	ret
+
+00801289 <sys_clock_gettime>:
+
+int
+sys_clock_gettime(int clock_id, struct timespec *ts) {
+  801289:	55                   	push   %ebp
+  80128a:	89 e5                	mov    %esp,%ebp
+  80128c:	83 ec 0c             	sub    $0xc,%esp
+    return syscall(SYS_clock_gettime, clock_id, ts);
+  80128f:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801292:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801296:	8b 45 08             	mov    0x8(%ebp),%eax
+  801299:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80129d:	c7 04 24 10 00 00 00 	movl   $0x10,(%esp)
+  8012a4:	e8 fc fd ff ff       	call   8010a5 <syscall>
+}
+  8012a9:	89 ec                	mov    %ebp,%esp
+  8012ab:	5d                   	pop    %ebp
+  8012ac:	c3                   	ret
+
+008012ad <sys_nanosleep>:
+
+int
+sys_nanosleep(const struct timespec *req) {
+  8012ad:	55                   	push   %ebp
+  8012ae:	89 e5                	mov    %esp,%ebp
+  8012b0:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_nanosleep, req);
+  8012b3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8012b6:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8012ba:	c7 04 24 0f 00 00 00 	movl   $0xf,(%esp)
+  8012c1:	e8 df fd ff ff       	call   8010a5 <syscall>
+}
+  8012c6:	89 ec                	mov    %ebp,%esp
+  8012c8:	5d                   	pop    %ebp
+  8012c9:	c3                   	ret
+
+008012ca <sys_brk>:
+
+int
+sys_brk(uintptr_t *brk_store) {
+  8012ca:	55                   	push   %ebp
+  8012cb:	89 e5                	mov    %esp,%ebp
+  8012cd:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_brk, brk_store);
+  8012d0:	8b 45 08             	mov    0x8(%ebp),%eax
+  8012d3:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8012d7:	c7 04 24 13 00 00 00 	movl   $0x13,(%esp)
+  8012de:	e8 c2 fd ff ff       	call   8010a5 <syscall>
+}
+  8012e3:	89 ec                	mov    %ebp,%esp
+  8012e5:	5d                   	pop    %ebp
+  8012e6:	c3                   	ret
+
+008012e7 <sys_mmap>:
+
+int
+sys_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags) {
+  8012e7:	55                   	push   %ebp
+  8012e8:	89 e5                	mov    %esp,%ebp
+  8012ea:	83 ec 10             	sub    $0x10,%esp
+    return syscall(SYS_mmap, addr_store, len, mmap_flags);
+  8012ed:	8b 45 10             	mov    0x10(%ebp),%eax
+  8012f0:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  8012f4:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8012f7:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8012fb:	8b 45 08             	mov    0x8(%ebp),%eax
+  8012fe:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801302:	c7 04 24 14 00 00 00 	movl   $0x14,(%esp)
+  801309:	e8 97 fd ff ff       	call   8010a5 <syscall>
+}
+  80130e:	89 ec                	mov    %ebp,%esp
+  801310:	5d                   	pop    %ebp
+  801311:	c3                   	ret
+
+00801312 <sys_munmap>:
+
+int
+sys_munmap(uintptr_t addr, size_t len) {
+  801312:	55                   	push   %ebp
+  801313:	89 e5                	mov    %esp,%ebp
+  801315:	83 ec 0c             	sub    $0xc,%esp
+    return syscall(SYS_munmap, addr, len);
+  801318:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80131b:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80131f:	8b 45 08             	mov    0x8(%ebp),%eax
+  801322:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801326:	c7 04 24 15 00 00 00 	movl   $0x15,(%esp)
+  80132d:	e8 73 fd ff ff       	call   8010a5 <syscall>
+}
+  801332:	89 ec                	mov    %ebp,%esp
+  801334:	5d                   	pop    %ebp
+  801335:	c3                   	ret
+
+00801336 <sys_shmem_attach>:
+
+int
+sys_shmem_attach(uintptr_t *addr_store, int key, size_t len, uint32_t flags) {
+  801336:	55                   	push   %ebp
+  801337:	89 e5                	mov    %esp,%ebp
+  801339:	83 ec 18             	sub    $0x18,%esp
+    return syscall(SYS_shmem, SHMEM_ATTACH, addr_store, key, len, flags);
+  80133c:	8b 45 14             	mov    0x14(%ebp),%eax
+  80133f:	89 44 24 14          	mov    %eax,0x14(%esp)
+  801343:	8b 45 10             	mov    0x10(%ebp),%eax
+  801346:	89 44 24 10          	mov    %eax,0x10(%esp)
+  80134a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80134d:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  801351:	8b 45 08             	mov    0x8(%ebp),%eax
+  801354:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801358:	c7 44 24 04 01 00 00 	movl   $0x1,0x4(%esp)
+  80135f:	00 
+  801360:	c7 04 24 16 00 00 00 	movl   $0x16,(%esp)
+  801367:	e8 39 fd ff ff       	call   8010a5 <syscall>
+}
+  80136c:	89 ec                	mov    %ebp,%esp
+  80136e:	5d                   	pop    %ebp
+  80136f:	c3                   	ret
+
+00801370 <sys_shmem_detach>:
+
+int
+sys_shmem_detach(uintptr_t addr) {
+  801370:	55                   	push   %ebp
+  801371:	89 e5                	mov    %esp,%ebp
+  801373:	83 ec 0c             	sub    $0xc,%esp
+    return syscall(SYS_shmem, SHMEM_DETACH, addr);
+  801376:	8b 45 08             	mov    0x8(%ebp),%eax
+  801379:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80137d:	c7 44 24 04 02 00 00 	movl   $0x2,0x4(%esp)
+  801384:	00 
+  801385:	c7 04 24 16 00 00 00 	movl   $0x16,(%esp)
+  80138c:	e8 14 fd ff ff       	call   8010a5 <syscall>
+}
+  801391:	89 ec                	mov    %ebp,%esp
+  801393:	5d                   	pop    %ebp
+  801394:	c3                   	ret
+
+00801395 <sys_exec>:
+
+int
+sys_exec(const char *name, int argc, const char **argv) {
+  801395:	55                   	push   %ebp
+  801396:	89 e5                	mov    %esp,%ebp
+  801398:	83 ec 10             	sub    $0x10,%esp
+    return syscall(SYS_exec, name, argc, argv);
+  80139b:	8b 45 10             	mov    0x10(%ebp),%eax
+  80139e:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  8013a2:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8013a5:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8013a9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8013ac:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8013b0:	c7 04 24 04 00 00 00 	movl   $0x4,(%esp)
+  8013b7:	e8 e9 fc ff ff       	call   8010a5 <syscall>
+}
+  8013bc:	89 ec                	mov    %ebp,%esp
+  8013be:	5d                   	pop    %ebp
+  8013bf:	c3                   	ret
+
+008013c0 <sys_open>:
+
+int
+sys_open(const char *path, uint32_t open_flags) {
+  8013c0:	55                   	push   %ebp
+  8013c1:	89 e5                	mov    %esp,%ebp
+  8013c3:	83 ec 0c             	sub    $0xc,%esp
+    return syscall(SYS_open, path, open_flags);
+  8013c6:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8013c9:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8013cd:	8b 45 08             	mov    0x8(%ebp),%eax
+  8013d0:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8013d4:	c7 04 24 64 00 00 00 	movl   $0x64,(%esp)
+  8013db:	e8 c5 fc ff ff       	call   8010a5 <syscall>
+}
+  8013e0:	89 ec                	mov    %ebp,%esp
+  8013e2:	5d                   	pop    %ebp
+  8013e3:	c3                   	ret
+
+008013e4 <sys_close>:
+
+int
+sys_close(int fd) {
+  8013e4:	55                   	push   %ebp
+  8013e5:	89 e5                	mov    %esp,%ebp
+  8013e7:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_close, fd);
+  8013ea:	8b 45 08             	mov    0x8(%ebp),%eax
+  8013ed:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8013f1:	c7 04 24 65 00 00 00 	movl   $0x65,(%esp)
+  8013f8:	e8 a8 fc ff ff       	call   8010a5 <syscall>
+}
+  8013fd:	89 ec                	mov    %ebp,%esp
+  8013ff:	5d                   	pop    %ebp
+  801400:	c3                   	ret
+
+00801401 <sys_read>:
+
+int
+sys_read(int fd, void *base, size_t len) {
+  801401:	55                   	push   %ebp
+  801402:	89 e5                	mov    %esp,%ebp
+  801404:	83 ec 10             	sub    $0x10,%esp
+    return syscall(SYS_read, fd, base, len);
+  801407:	8b 45 10             	mov    0x10(%ebp),%eax
+  80140a:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  80140e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801411:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801415:	8b 45 08             	mov    0x8(%ebp),%eax
+  801418:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80141c:	c7 04 24 66 00 00 00 	movl   $0x66,(%esp)
+  801423:	e8 7d fc ff ff       	call   8010a5 <syscall>
+}
+  801428:	89 ec                	mov    %ebp,%esp
+  80142a:	5d                   	pop    %ebp
+  80142b:	c3                   	ret
+
+0080142c <sys_write>:
+
+int
+sys_write(int fd, void *base, size_t len) {
+  80142c:	55                   	push   %ebp
+  80142d:	89 e5                	mov    %esp,%ebp
+  80142f:	83 ec 10             	sub    $0x10,%esp
+    return syscall(SYS_write, fd, base, len);
+  801432:	8b 45 10             	mov    0x10(%ebp),%eax
+  801435:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  801439:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80143c:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801440:	8b 45 08             	mov    0x8(%ebp),%eax
+  801443:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801447:	c7 04 24 67 00 00 00 	movl   $0x67,(%esp)
+  80144e:	e8 52 fc ff ff       	call   8010a5 <syscall>
+}
+  801453:	89 ec                	mov    %ebp,%esp
+  801455:	5d                   	pop    %ebp
+  801456:	c3                   	ret
+
+00801457 <sys_seek>:
+
+int
+sys_seek(int fd, off_t pos, int whence) {
+  801457:	55                   	push   %ebp
+  801458:	89 e5                	mov    %esp,%ebp
+  80145a:	83 ec 10             	sub    $0x10,%esp
+    return syscall(SYS_seek, fd, pos, whence);
+  80145d:	8b 45 10             	mov    0x10(%ebp),%eax
+  801460:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  801464:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801467:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80146b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80146e:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801472:	c7 04 24 68 00 00 00 	movl   $0x68,(%esp)
+  801479:	e8 27 fc ff ff       	call   8010a5 <syscall>
+}
+  80147e:	89 ec                	mov    %ebp,%esp
+  801480:	5d                   	pop    %ebp
+  801481:	c3                   	ret
+
+00801482 <sys_fstat>:
+
+int
+sys_fstat(int fd, struct stat *stat) {
+  801482:	55                   	push   %ebp
+  801483:	89 e5                	mov    %esp,%ebp
+  801485:	83 ec 0c             	sub    $0xc,%esp
+    return syscall(SYS_fstat, fd, stat);
+  801488:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80148b:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80148f:	8b 45 08             	mov    0x8(%ebp),%eax
+  801492:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801496:	c7 04 24 6e 00 00 00 	movl   $0x6e,(%esp)
+  80149d:	e8 03 fc ff ff       	call   8010a5 <syscall>
+}
+  8014a2:	89 ec                	mov    %ebp,%esp
+  8014a4:	5d                   	pop    %ebp
+  8014a5:	c3                   	ret
+
+008014a6 <sys_fsync>:
+
+int
+sys_fsync(int fd) {
+  8014a6:	55                   	push   %ebp
+  8014a7:	89 e5                	mov    %esp,%ebp
+  8014a9:	83 ec 08             	sub    $0x8,%esp
+    return syscall(SYS_fsync, fd);
+  8014ac:	8b 45 08             	mov    0x8(%ebp),%eax
+  8014af:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8014b3:	c7 04 24 6f 00 00 00 	movl   $0x6f,(%esp)
+  8014ba:	e8 e6 fb ff ff       	call   8010a5 <syscall>
+}
+  8014bf:	89 ec                	mov    %ebp,%esp
+  8014c1:	5d                   	pop    %ebp
+  8014c2:	c3                   	ret
+
+008014c3 <sys_getcwd>:
+
+int
+sys_getcwd(char *buffer, size_t len) {
+  8014c3:	55                   	push   %ebp
+  8014c4:	89 e5                	mov    %esp,%ebp
+  8014c6:	83 ec 0c             	sub    $0xc,%esp
+    return syscall(SYS_getcwd, buffer, len);
+  8014c9:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8014cc:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8014d0:	8b 45 08             	mov    0x8(%ebp),%eax
+  8014d3:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8014d7:	c7 04 24 79 00 00 00 	movl   $0x79,(%esp)
+  8014de:	e8 c2 fb ff ff       	call   8010a5 <syscall>
+}
+  8014e3:	89 ec                	mov    %ebp,%esp
+  8014e5:	5d                   	pop    %ebp
+  8014e6:	c3                   	ret
+
+008014e7 <sys_getdirentry>:
+
+int
+sys_getdirentry(int fd, struct dirent *dirent) {
+  8014e7:	55                   	push   %ebp
+  8014e8:	89 e5                	mov    %esp,%ebp
+  8014ea:	83 ec 0c             	sub    $0xc,%esp
+    return syscall(SYS_getdirentry, fd, dirent);
+  8014ed:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8014f0:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8014f4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8014f7:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8014fb:	c7 04 24 80 00 00 00 	movl   $0x80,(%esp)
+  801502:	e8 9e fb ff ff       	call   8010a5 <syscall>
+}
+  801507:	89 ec                	mov    %ebp,%esp
+  801509:	5d                   	pop    %ebp
+  80150a:	c3                   	ret
+
+0080150b <sys_dup>:
+
+int
+sys_dup(int fd1, int fd2) {
+  80150b:	55                   	push   %ebp
+  80150c:	89 e5                	mov    %esp,%ebp
+  80150e:	83 ec 0c             	sub    $0xc,%esp
+    return syscall(SYS_dup, fd1, fd2);
+  801511:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801514:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801518:	8b 45 08             	mov    0x8(%ebp),%eax
+  80151b:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80151f:	c7 04 24 82 00 00 00 	movl   $0x82,(%esp)
+  801526:	e8 7a fb ff ff       	call   8010a5 <syscall>
+}
+  80152b:	89 ec                	mov    %ebp,%esp
+  80152d:	5d                   	pop    %ebp
+  80152e:	c3                   	ret
+
+0080152f <test_and_set_bit>:
+test_and_set_bit(int nr, volatile void *addr) {
+  80152f:	55                   	push   %ebp
+  801530:	89 e5                	mov    %esp,%ebp
+  801532:	83 ec 10             	sub    $0x10,%esp
+    asm volatile ("btsl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  801535:	8b 55 0c             	mov    0xc(%ebp),%edx
+  801538:	8b 45 08             	mov    0x8(%ebp),%eax
+  80153b:	0f ab 02             	bts    %eax,(%edx)
+  80153e:	19 c0                	sbb    %eax,%eax
+  801540:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return oldbit != 0;
+  801543:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  801547:	0f 95 c0             	setne  %al
+  80154a:	0f b6 c0             	movzbl %al,%eax
+}
+  80154d:	89 ec                	mov    %ebp,%esp
+  80154f:	5d                   	pop    %ebp
+  801550:	c3                   	ret
+
+00801551 <test_and_clear_bit>:
+test_and_clear_bit(int nr, volatile void *addr) {
+  801551:	55                   	push   %ebp
+  801552:	89 e5                	mov    %esp,%ebp
+  801554:	83 ec 10             	sub    $0x10,%esp
+    asm volatile ("btrl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  801557:	8b 55 0c             	mov    0xc(%ebp),%edx
+  80155a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80155d:	0f b3 02             	btr    %eax,(%edx)
+  801560:	19 c0                	sbb    %eax,%eax
+  801562:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return oldbit != 0;
+  801565:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  801569:	0f 95 c0             	setne  %al
+  80156c:	0f b6 c0             	movzbl %al,%eax
+}
+  80156f:	89 ec                	mov    %ebp,%esp
+  801571:	5d                   	pop    %ebp
+  801572:	c3                   	ret
+
+00801573 <try_lock>:
+try_lock(lock_t *l) {
+  801573:	55                   	push   %ebp
+  801574:	89 e5                	mov    %esp,%ebp
+  801576:	83 ec 08             	sub    $0x8,%esp
+    return test_and_set_bit(0, l);
+  801579:	8b 45 08             	mov    0x8(%ebp),%eax
+  80157c:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801580:	c7 04 24 00 00 00 00 	movl   $0x0,(%esp)
+  801587:	e8 a3 ff ff ff       	call   80152f <test_and_set_bit>
+}
+  80158c:	89 ec                	mov    %ebp,%esp
+  80158e:	5d                   	pop    %ebp
+  80158f:	c3                   	ret
+
+00801590 <lock>:
+lock(lock_t *l) {
+  801590:	55                   	push   %ebp
+  801591:	89 e5                	mov    %esp,%ebp
+  801593:	83 ec 28             	sub    $0x28,%esp
+    if (try_lock(l)) {
+  801596:	8b 45 08             	mov    0x8(%ebp),%eax
+  801599:	89 04 24             	mov    %eax,(%esp)
+  80159c:	e8 d2 ff ff ff       	call   801573 <try_lock>
+  8015a1:	85 c0                	test   %eax,%eax
+  8015a3:	74 37                	je     8015dc <lock+0x4c>
+        int step = 0;
+  8015a5:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+            yield();
+  8015ac:	e8 54 04 00 00       	call   801a05 <yield>
+            if (++ step == 100) {
+  8015b1:	ff 45 f4             	incl   -0xc(%ebp)
+  8015b4:	83 7d f4 64          	cmpl   $0x64,-0xc(%ebp)
+  8015b8:	75 13                	jne    8015cd <lock+0x3d>
+                step = 0;
+  8015ba:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+                sleep(10);
+  8015c1:	c7 04 24 0a 00 00 00 	movl   $0xa,(%esp)
+  8015c8:	e8 a7 04 00 00       	call   801a74 <sleep>
+        } while (try_lock(l));
+  8015cd:	8b 45 08             	mov    0x8(%ebp),%eax
+  8015d0:	89 04 24             	mov    %eax,(%esp)
+  8015d3:	e8 9b ff ff ff       	call   801573 <try_lock>
+  8015d8:	85 c0                	test   %eax,%eax
+  8015da:	75 d0                	jne    8015ac <lock+0x1c>
+}
+  8015dc:	90                   	nop
+  8015dd:	89 ec                	mov    %ebp,%esp
+  8015df:	5d                   	pop    %ebp
+  8015e0:	c3                   	ret
+
+008015e1 <unlock>:
+unlock(lock_t *l) {
+  8015e1:	55                   	push   %ebp
+  8015e2:	89 e5                	mov    %esp,%ebp
+  8015e4:	83 ec 08             	sub    $0x8,%esp
+    test_and_clear_bit(0, l);
+  8015e7:	8b 45 08             	mov    0x8(%ebp),%eax
+  8015ea:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8015ee:	c7 04 24 00 00 00 00 	movl   $0x0,(%esp)
+  8015f5:	e8 57 ff ff ff       	call   801551 <test_and_clear_bit>
+}
+  8015fa:	90                   	nop
+  8015fb:	89 ec                	mov    %ebp,%esp
+  8015fd:	5d                   	pop    %ebp
+  8015fe:	c3                   	ret
+
+008015ff <thread_slot_alloc>:
+static struct thread_tls thread_tlss[THREAD_MAX];
+static bool thread_used[THREAD_MAX];
+static lock_t thread_lock = INIT_LOCK;
+
+static int
+thread_slot_alloc(void) {
+  8015ff:	55                   	push   %ebp
+  801600:	89 e5                	mov    %esp,%ebp
+  801602:	83 ec 28             	sub    $0x28,%esp
+    int slot;
+    lock(&thread_lock);
+  801605:	c7 04 24 00 61 84 00 	movl   $0x846100,(%esp)
+  80160c:	e8 7f ff ff ff       	call   801590 <lock>
+    for (slot = 0; slot < THREAD_MAX; slot ++) {
+  801611:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+  801618:	eb 21                	jmp    80163b <thread_slot_alloc+0x3c>
+        if (!thread_used[slot]) {
+  80161a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80161d:	8b 04 85 c0 60 84 00 	mov    0x8460c0(,%eax,4),%eax
+  801624:	85 c0                	test   %eax,%eax
+  801626:	75 10                	jne    801638 <thread_slot_alloc+0x39>
+            thread_used[slot] = 1;
+  801628:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80162b:	c7 04 85 c0 60 84 00 	movl   $0x1,0x8460c0(,%eax,4)
+  801632:	01 00 00 00 
+            break;
+  801636:	eb 09                	jmp    801641 <thread_slot_alloc+0x42>
+    for (slot = 0; slot < THREAD_MAX; slot ++) {
+  801638:	ff 45 f4             	incl   -0xc(%ebp)
+  80163b:	83 7d f4 0f          	cmpl   $0xf,-0xc(%ebp)
+  80163f:	7e d9                	jle    80161a <thread_slot_alloc+0x1b>
+        }
+    }
+    unlock(&thread_lock);
+  801641:	c7 04 24 00 61 84 00 	movl   $0x846100,(%esp)
+  801648:	e8 94 ff ff ff       	call   8015e1 <unlock>
+    return (slot < THREAD_MAX) ? slot : -1;
+  80164d:	83 7d f4 0f          	cmpl   $0xf,-0xc(%ebp)
+  801651:	7f 05                	jg     801658 <thread_slot_alloc+0x59>
+  801653:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801656:	eb 05                	jmp    80165d <thread_slot_alloc+0x5e>
+  801658:	b8 ff ff ff ff       	mov    $0xffffffff,%eax
+}
+  80165d:	89 ec                	mov    %ebp,%esp
+  80165f:	5d                   	pop    %ebp
+  801660:	c3                   	ret
+
+00801661 <thread_slot_free>:
+
+static void
+thread_slot_free(int slot) {
+  801661:	55                   	push   %ebp
+  801662:	89 e5                	mov    %esp,%ebp
+  801664:	83 ec 18             	sub    $0x18,%esp
+    lock(&thread_lock);
+  801667:	c7 04 24 00 61 84 00 	movl   $0x846100,(%esp)
+  80166e:	e8 1d ff ff ff       	call   801590 <lock>
+    thread_used[slot] = 0;
+  801673:	8b 45 08             	mov    0x8(%ebp),%eax
+  801676:	c7 04 85 c0 60 84 00 	movl   $0x0,0x8460c0(,%eax,4)
+  80167d:	00 00 00 00 
+    unlock(&thread_lock);
+  801681:	c7 04 24 00 61 84 00 	movl   $0x846100,(%esp)
+  801688:	e8 54 ff ff ff       	call   8015e1 <unlock>
+}
+  80168d:	90                   	nop
+  80168e:	89 ec                	mov    %ebp,%esp
+  801690:	5d                   	pop    %ebp
+  801691:	c3                   	ret
+
+00801692 <thread_create>:
+
+// thread_create - create a thread running fn(arg), the exit code of thread is the return value of fn
+int
+thread_create(int (*fn)(void *), void *arg, thread_t *tidp) {
+  801692:	55                   	push   %ebp
+  801693:	89 e5                	mov    %esp,%ebp
+  801695:	83 ec 48             	sub    $0x48,%esp
+    int slot, tid;
+    if ((slot = thread_slot_alloc()) < 0) {
+  801698:	e8 62 ff ff ff       	call   8015ff <thread_slot_alloc>
+  80169d:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8016a0:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  8016a4:	79 0a                	jns    8016b0 <thread_create+0x1e>
+        return -E_NO_FREE_PROC;
+  8016a6:	b8 fb ff ff ff       	mov    $0xfffffffb,%eax
+  8016ab:	e9 b0 00 00 00       	jmp    801760 <thread_create+0xce>
+    }
+    struct thread_tls *tls = thread_tlss + slot;
+  8016b0:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  8016b3:	89 d0                	mov    %edx,%eax
+  8016b5:	01 c0                	add    %eax,%eax
+  8016b7:	01 d0                	add    %edx,%eax
+  8016b9:	c1 e0 02             	shl    $0x2,%eax
+  8016bc:	05 00 60 84 00       	add    $0x846000,%eax
+  8016c1:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    memset(tls, 0, sizeof(struct thread_tls));
+  8016c4:	c7 44 24 08 0c 00 00 	movl   $0xc,0x8(%esp)
+  8016cb:	00 
+  8016cc:	c7 44 24 04 00 00 00 	movl   $0x0,0x4(%esp)
+  8016d3:	00 
+  8016d4:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8016d7:	89 04 24             	mov    %eax,(%esp)
+  8016da:	e8 0d 13 00 00       	call   8029ec <memset>
+    tls->self = tls, tls->slot = slot;
+  8016df:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8016e2:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  8016e5:	89 10                	mov    %edx,(%eax)
+  8016e7:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8016ea:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  8016ed:	89 50 04             	mov    %edx,0x4(%eax)
+
+    uintptr_t stack = (uintptr_t)(thread_stacks[slot] + THREAD_STACKSIZE);
+  8016f0:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8016f3:	c1 e0 0e             	shl    $0xe,%eax
+  8016f6:	05 00 60 80 00       	add    $0x806000,%eax
+  8016fb:	05 00 40 00 00       	add    $0x4000,%eax
+  801700:	89 45 ec             	mov    %eax,-0x14(%ebp)
+    uint32_t clone_flags = CLONE_VM | CLONE_FS | CLONE_THREAD | CLONE_SETTLS;
+  801703:	c7 45 e8 00 0b 08 00 	movl   $0x80b00,-0x18(%ebp)
+    if ((tid = __clone(clone_flags, stack, (uintptr_t)tls, fn, arg)) < 0) {
+  80170a:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80170d:	8b 55 0c             	mov    0xc(%ebp),%edx
+  801710:	89 54 24 10          	mov    %edx,0x10(%esp)
+  801714:	8b 55 08             	mov    0x8(%ebp),%edx
+  801717:	89 54 24 0c          	mov    %edx,0xc(%esp)
+  80171b:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80171f:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801722:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801726:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801729:	89 04 24             	mov    %eax,(%esp)
+  80172c:	e8 ef e8 ff ff       	call   800020 <__clone>
+  801731:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  801734:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  801738:	79 10                	jns    80174a <thread_create+0xb8>
+        thread_slot_free(slot);
+  80173a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80173d:	89 04 24             	mov    %eax,(%esp)
+  801740:	e8 1c ff ff ff       	call   801661 <thread_slot_free>
+        return tid;
+  801745:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  801748:	eb 16                	jmp    801760 <thread_create+0xce>
+    }
+    tidp->tid = tid, tidp->slot = slot;
+  80174a:	8b 45 10             	mov    0x10(%ebp),%eax
+  80174d:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  801750:	89 10                	mov    %edx,(%eax)
+  801752:	8b 45 10             	mov    0x10(%ebp),%eax
+  801755:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  801758:	89 50 04             	mov    %edx,0x4(%eax)
+    return 0;
+  80175b:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  801760:	89 ec                	mov    %ebp,%esp
+  801762:	5d                   	pop    %ebp
+  801763:	c3                   	ret
+
+00801764 <thread_join>:
+
+// thread_join - wait the thread to exit and release its stack, only the creator can join a thread
+int
+thread_join(thread_t *tidp, int *exit_code) {
+  801764:	55                   	push   %ebp
+  801765:	89 e5                	mov    %esp,%ebp
+  801767:	83 ec 28             	sub    $0x28,%esp
+    int ret;
+    if ((ret = sys_wait(tidp->tid, exit_code)) == 0) {
+  80176a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80176d:	8b 00                	mov    (%eax),%eax
+  80176f:	8b 55 0c             	mov    0xc(%ebp),%edx
+  801772:	89 54 24 04          	mov    %edx,0x4(%esp)
+  801776:	89 04 24             	mov    %eax,(%esp)
+  801779:	e8 1a fa ff ff       	call   801198 <sys_wait>
+  80177e:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801781:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  801785:	75 0e                	jne    801795 <thread_join+0x31>
+        thread_slot_free(tidp->slot);
+  801787:	8b 45 08             	mov    0x8(%ebp),%eax
+  80178a:	8b 40 04             	mov    0x4(%eax),%eax
+  80178d:	89 04 24             	mov    %eax,(%esp)
+  801790:	e8 cc fe ff ff       	call   801661 <thread_slot_free>
+    }
+    return ret;
+  801795:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801798:	89 ec                	mov    %ebp,%esp
+  80179a:	5d                   	pop    %ebp
+  80179b:	c3                   	ret
+
+0080179c <thread_exit>:
+
+void
+thread_exit(int exit_code) {
+  80179c:	55                   	push   %ebp
+  80179d:	89 e5                	mov    %esp,%ebp
+  80179f:	83 ec 18             	sub    $0x18,%esp
+    sys_exit(exit_code);
+  8017a2:	8b 45 08             	mov    0x8(%ebp),%eax
+  8017a5:	89 04 24             	mov    %eax,(%esp)
+  8017a8:	e8 b8 f9 ff ff       	call   801165 <sys_exit>
+    cprintf("BUG: thread_exit failed.\n");
+  8017ad:	c7 04 24 c0 2c 80 00 	movl   $0x802cc0,(%esp)
+  8017b4:	e8 44 f7 ff ff       	call   800efd <cprintf>
+    while (1);
+  8017b9:	90                   	nop
+  8017ba:	eb fd                	jmp    8017b9 <thread_exit+0x1d>
+
+008017bc <thread_self>:
+}
+
+// thread_self - the tls of current thread, NULL for the main thread of process
+struct thread_tls *
+thread_self(void) {
+  8017bc:	55                   	push   %ebp
+  8017bd:	89 e5                	mov    %esp,%ebp
+  8017bf:	83 ec 10             	sub    $0x10,%esp
+    uint16_t gs;
+    asm volatile ("movw %%gs, %0" : "=r" (gs));
+  8017c2:	66 8c e8             	mov    %gs,%ax
+  8017c5:	66 89 45 fe          	mov    %ax,-0x2(%ebp)
+    if (gs != USER_TLS) {
+  8017c9:	0f b7 45 fe          	movzwl -0x2(%ebp),%eax
+  8017cd:	83 f8 33             	cmp    $0x33,%eax
+  8017d0:	74 07                	je     8017d9 <thread_self+0x1d>
+        return NULL;
+  8017d2:	b8 00 00 00 00       	mov    $0x0,%eax
+  8017d7:	eb 0c                	jmp    8017e5 <thread_self+0x29>
+    }
+    struct thread_tls *tls;
+    asm volatile ("movl %%gs:0, %0" : "=r" (tls));
+  8017d9:	65 a1 00 00 00 00    	mov    %gs:0x0,%eax
+  8017df:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    return tls;
+  8017e2:	8b 45 f8             	mov    -0x8(%ebp),%eax
+}
+  8017e5:	89 ec                	mov    %ebp,%esp
+  8017e7:	5d                   	pop    %ebp
+  8017e8:	c3                   	ret
+
+008017e9 <test_and_set_bit>:
+test_and_set_bit(int nr, volatile void *addr) {
+  8017e9:	55                   	push   %ebp
+  8017ea:	89 e5                	mov    %esp,%ebp
+  8017ec:	83 ec 10             	sub    $0x10,%esp
+    asm volatile ("btsl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  8017ef:	8b 55 0c             	mov    0xc(%ebp),%edx
+  8017f2:	8b 45 08             	mov    0x8(%ebp),%eax
+  8017f5:	0f ab 02             	bts    %eax,(%edx)
+  8017f8:	19 c0                	sbb    %eax,%eax
+  8017fa:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return oldbit != 0;
+  8017fd:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  801801:	0f 95 c0             	setne  %al
+  801804:	0f b6 c0             	movzbl %al,%eax
+}
+  801807:	89 ec                	mov    %ebp,%esp
+  801809:	5d                   	pop    %ebp
+  80180a:	c3                   	ret
+
+0080180b <test_and_clear_bit>:
+test_and_clear_bit(int nr, volatile void *addr) {
+  80180b:	55                   	push   %ebp
+  80180c:	89 e5                	mov    %esp,%ebp
+  80180e:	83 ec 10             	sub    $0x10,%esp
+    asm volatile ("btrl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  801811:	8b 55 0c             	mov    0xc(%ebp),%edx
+  801814:	8b 45 08             	mov    0x8(%ebp),%eax
+  801817:	0f b3 02             	btr    %eax,(%edx)
+  80181a:	19 c0                	sbb    %eax,%eax
+  80181c:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return oldbit != 0;
+  80181f:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  801823:	0f 95 c0             	setne  %al
+  801826:	0f b6 c0             	movzbl %al,%eax
+}
+  801829:	89 ec                	mov    %ebp,%esp
+  80182b:	5d                   	pop    %ebp
+  80182c:	c3                   	ret
+
+0080182d <try_lock>:
+try_lock(lock_t *l) {
+  80182d:	55                   	push   %ebp
+  80182e:	89 e5                	mov    %esp,%ebp
+  801830:	83 ec 08             	sub    $0x8,%esp
+    return test_and_set_bit(0, l);
+  801833:	8b 45 08             	mov    0x8(%ebp),%eax
+  801836:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80183a:	c7 04 24 00 00 00 00 	movl   $0x0,(%esp)
+  801841:	e8 a3 ff ff ff       	call   8017e9 <test_and_set_bit>
+}
+  801846:	89 ec                	mov    %ebp,%esp
+  801848:	5d                   	pop    %ebp
+  801849:	c3                   	ret
+
+0080184a <lock>:
+lock(lock_t *l) {
+  80184a:	55                   	push   %ebp
+  80184b:	89 e5                	mov    %esp,%ebp
+  80184d:	83 ec 28             	sub    $0x28,%esp
+    if (try_lock(l)) {
+  801850:	8b 45 08             	mov    0x8(%ebp),%eax
+  801853:	89 04 24             	mov    %eax,(%esp)
+  801856:	e8 d2 ff ff ff       	call   80182d <try_lock>
+  80185b:	85 c0                	test   %eax,%eax
+  80185d:	74 37                	je     801896 <lock+0x4c>
+        int step = 0;
+  80185f:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+            yield();
+  801866:	e8 9a 01 00 00       	call   801a05 <yield>
+            if (++ step == 100) {
+  80186b:	ff 45 f4             	incl   -0xc(%ebp)
+  80186e:	83 7d f4 64          	cmpl   $0x64,-0xc(%ebp)
+  801872:	75 13                	jne    801887 <lock+0x3d>
+                step = 0;
+  801874:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+                sleep(10);
+  80187b:	c7 04 24 0a 00 00 00 	movl   $0xa,(%esp)
+  801882:	e8 ed 01 00 00       	call   801a74 <sleep>
+        } while (try_lock(l));
+  801887:	8b 45 08             	mov    0x8(%ebp),%eax
+  80188a:	89 04 24             	mov    %eax,(%esp)
+  80188d:	e8 9b ff ff ff       	call   80182d <try_lock>
+  801892:	85 c0                	test   %eax,%eax
+  801894:	75 d0                	jne    801866 <lock+0x1c>
+}
+  801896:	90                   	nop
+  801897:	89 ec                	mov    %ebp,%esp
+  801899:	5d                   	pop    %ebp
+  80189a:	c3                   	ret
+
+0080189b <unlock>:
+unlock(lock_t *l) {
+  80189b:	55                   	push   %ebp
+  80189c:	89 e5                	mov    %esp,%ebp
+  80189e:	83 ec 08             	sub    $0x8,%esp
+    test_and_clear_bit(0, l);
+  8018a1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8018a4:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8018a8:	c7 04 24 00 00 00 00 	movl   $0x0,(%esp)
+  8018af:	e8 57 ff ff ff       	call   80180b <test_and_clear_bit>
+}
+  8018b4:	90                   	nop
+  8018b5:	89 ec                	mov    %ebp,%esp
+  8018b7:	5d                   	pop    %ebp
+  8018b8:	c3                   	ret
+
+008018b9 <mul_u64_u32_shr>:
+mul_u64_u32_shr(uint64_t a, uint32_t mul, unsigned int shift) {
+  8018b9:	55                   	push   %ebp
+  8018ba:	89 e5                	mov    %esp,%ebp
+  8018bc:	57                   	push   %edi
+  8018bd:	56                   	push   %esi
+  8018be:	53                   	push   %ebx
+  8018bf:	83 ec 1c             	sub    $0x1c,%esp
+  8018c2:	8b 45 08             	mov    0x8(%ebp),%eax
+  8018c5:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  8018c8:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8018cb:	89 45 dc             	mov    %eax,-0x24(%ebp)
+    uint32_t high = a >> 32, low = a;
+  8018ce:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  8018d1:	8b 55 dc             	mov    -0x24(%ebp),%edx
+  8018d4:	89 d0                	mov    %edx,%eax
+  8018d6:	31 d2                	xor    %edx,%edx
+  8018d8:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  8018db:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  8018de:	89 45 e0             	mov    %eax,-0x20(%ebp)
+    uint64_t ret = ((uint64_t)low * mul) >> shift;
+  8018e1:	8b 4d e0             	mov    -0x20(%ebp),%ecx
+  8018e4:	bb 00 00 00 00       	mov    $0x0,%ebx
+  8018e9:	8b 45 10             	mov    0x10(%ebp),%eax
+  8018ec:	ba 00 00 00 00       	mov    $0x0,%edx
+  8018f1:	89 df                	mov    %ebx,%edi
+  8018f3:	0f af f8             	imul   %eax,%edi
+  8018f6:	89 d6                	mov    %edx,%esi
+  8018f8:	0f af f1             	imul   %ecx,%esi
+  8018fb:	01 fe                	add    %edi,%esi
+  8018fd:	f7 e1                	mul    %ecx
+  8018ff:	8d 0c 16             	lea    (%esi,%edx,1),%ecx
+  801902:	89 ca                	mov    %ecx,%edx
+  801904:	8b 4d 14             	mov    0x14(%ebp),%ecx
+  801907:	0f ad d0             	shrd   %cl,%edx,%eax
+  80190a:	d3 ea                	shr    %cl,%edx
+  80190c:	f6 c1 20             	test   $0x20,%cl
+  80190f:	74 04                	je     801915 <mul_u64_u32_shr+0x5c>
+  801911:	89 d0                	mov    %edx,%eax
+  801913:	31 d2                	xor    %edx,%edx
+  801915:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  801918:	89 55 ec             	mov    %edx,-0x14(%ebp)
+    if (high != 0) {
+  80191b:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  80191f:	74 3f                	je     801960 <mul_u64_u32_shr+0xa7>
+        ret += ((uint64_t)high * mul) << (32 - shift);
+  801921:	8b 4d e4             	mov    -0x1c(%ebp),%ecx
+  801924:	bb 00 00 00 00       	mov    $0x0,%ebx
+  801929:	8b 45 10             	mov    0x10(%ebp),%eax
+  80192c:	ba 00 00 00 00       	mov    $0x0,%edx
+  801931:	89 df                	mov    %ebx,%edi
+  801933:	0f af f8             	imul   %eax,%edi
+  801936:	89 d6                	mov    %edx,%esi
+  801938:	0f af f1             	imul   %ecx,%esi
+  80193b:	01 fe                	add    %edi,%esi
+  80193d:	f7 e1                	mul    %ecx
+  80193f:	8d 0c 16             	lea    (%esi,%edx,1),%ecx
+  801942:	89 ca                	mov    %ecx,%edx
+  801944:	b9 20 00 00 00       	mov    $0x20,%ecx
+  801949:	2b 4d 14             	sub    0x14(%ebp),%ecx
+  80194c:	0f a5 c2             	shld   %cl,%eax,%edx
+  80194f:	d3 e0                	shl    %cl,%eax
+  801951:	f6 c1 20             	test   $0x20,%cl
+  801954:	74 04                	je     80195a <mul_u64_u32_shr+0xa1>
+  801956:	89 c2                	mov    %eax,%edx
+  801958:	31 c0                	xor    %eax,%eax
+  80195a:	01 45 e8             	add    %eax,-0x18(%ebp)
+  80195d:	11 55 ec             	adc    %edx,-0x14(%ebp)
+    return ret;
+  801960:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801963:	8b 55 ec             	mov    -0x14(%ebp),%edx
+}
+  801966:	83 c4 1c             	add    $0x1c,%esp
+  801969:	5b                   	pop    %ebx
+  80196a:	5e                   	pop    %esi
+  80196b:	5f                   	pop    %edi
+  80196c:	5d                   	pop    %ebp
+  80196d:	c3                   	ret
+
+0080196e <lock_fork>:
+#include <vdso.h>
+
+static lock_t fork_lock = INIT_LOCK;
+
+void
+lock_fork(void) {
+  80196e:	55                   	push   %ebp
+  80196f:	89 e5                	mov    %esp,%ebp
+  801971:	83 ec 18             	sub    $0x18,%esp
+    lock(&fork_lock);
+  801974:	c7 04 24 04 61 84 00 	movl   $0x846104,(%esp)
+  80197b:	e8 ca fe ff ff       	call   80184a <lock>
+}
+  801980:	90                   	nop
+  801981:	89 ec                	mov    %ebp,%esp
+  801983:	5d                   	pop    %ebp
+  801984:	c3                   	ret
+
+00801985 <unlock_fork>:
+
+void
+unlock_fork(void) {
+  801985:	55                   	push   %ebp
+  801986:	89 e5                	mov    %esp,%ebp
+  801988:	83 ec 04             	sub    $0x4,%esp
+    unlock(&fork_lock);
+  80198b:	c7 04 24 04 61 84 00 	movl   $0x846104,(%esp)
+  801992:	e8 04 ff ff ff       	call   80189b <unlock>
+}
+  801997:	90                   	nop
+  801998:	89 ec                	mov    %ebp,%esp
+  80199a:	5d                   	pop    %ebp
+  80199b:	c3                   	ret
+
+0080199c <exit>:
+
+void
+exit(int error_code) {
+  80199c:	55                   	push   %ebp
+  80199d:	89 e5                	mov    %esp,%ebp
+  80199f:	83 ec 18             	sub    $0x18,%esp
+    sys_exit(error_code);
+  8019a2:	8b 45 08             	mov    0x8(%ebp),%eax
+  8019a5:	89 04 24             	mov    %eax,(%esp)
+  8019a8:	e8 b8 f7 ff ff       	call   801165 <sys_exit>
+    cprintf("BUG: exit failed.\n");
+  8019ad:	c7 04 24 da 2c 80 00 	movl   $0x802cda,(%esp)
+  8019b4:	e8 44 f5 ff ff       	call   800efd <cprintf>
+    while (1);
+  8019b9:	90                   	nop
+  8019ba:	eb fd                	jmp    8019b9 <exit+0x1d>
+
+008019bc <fork>:
+}
+
+int
+fork(void) {
+  8019bc:	55                   	push   %ebp
+  8019bd:	89 e5                	mov    %esp,%ebp
+  8019bf:	83 ec 08             	sub    $0x8,%esp
+    return sys_fork();
+  8019c2:	e8 bb f7 ff ff       	call   801182 <sys_fork>
+}
+  8019c7:	89 ec                	mov    %ebp,%esp
+  8019c9:	5d                   	pop    %ebp
+  8019ca:	c3                   	ret
+
+008019cb <wait>:
+
+int
+wait(void) {
+  8019cb:	55                   	push   %ebp
+  8019cc:	89 e5                	mov    %esp,%ebp
+  8019ce:	83 ec 18             	sub    $0x18,%esp
+    return sys_wait(0, NULL);
+  8019d1:	c7 44 24 04 00 00 00 	movl   $0x0,0x4(%esp)
+  8019d8:	00 
+  8019d9:	c7 04 24 00 00 00 00 	movl   $0x0,(%esp)
+  8019e0:	e8 b3 f7 ff ff       	call   801198 <sys_wait>
+}
+  8019e5:	89 ec                	mov    %ebp,%esp
+  8019e7:	5d                   	pop    %ebp
+  8019e8:	c3                   	ret
+
+008019e9 <waitpid>:
+
+int
+waitpid(int pid, int *store) {
+  8019e9:	55                   	push   %ebp
+  8019ea:	89 e5                	mov    %esp,%ebp
+  8019ec:	83 ec 18             	sub    $0x18,%esp
+    return sys_wait(pid, store);
+  8019ef:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8019f2:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8019f6:	8b 45 08             	mov    0x8(%ebp),%eax
+  8019f9:	89 04 24             	mov    %eax,(%esp)
+  8019fc:	e8 97 f7 ff ff       	call   801198 <sys_wait>
+}
+  801a01:	89 ec                	mov    %ebp,%esp
+  801a03:	5d                   	pop    %ebp
+  801a04:	c3                   	ret
+
+00801a05 <yield>:
+
+void
+yield(void) {
+  801a05:	55                   	push   %ebp
+  801a06:	89 e5                	mov    %esp,%ebp
+  801a08:	83 ec 08             	sub    $0x8,%esp
+    sys_yield();
+  801a0b:	e8 ac f7 ff ff       	call   8011bc <sys_yield>
+}
+  801a10:	90                   	nop
+  801a11:	89 ec                	mov    %ebp,%esp
+  801a13:	5d                   	pop    %ebp
+  801a14:	c3                   	ret
+
+00801a15 <kill>:
+
+int
+kill(int pid) {
+  801a15:	55                   	push   %ebp
+  801a16:	89 e5                	mov    %esp,%ebp
+  801a18:	83 ec 18             	sub    $0x18,%esp
+    return sys_kill(pid);
+  801a1b:	8b 45 08             	mov    0x8(%ebp),%eax
+  801a1e:	89 04 24             	mov    %eax,(%esp)
+  801a21:	e8 ac f7 ff ff       	call   8011d2 <sys_kill>
+}
+  801a26:	89 ec                	mov    %ebp,%esp
+  801a28:	5d                   	pop    %ebp
+  801a29:	c3                   	ret
+
+00801a2a <getpid>:
+
+// getpid - read the pid from the vdso page, the threads sharing an mm ask the kernel
+int
+getpid(void) {
+  801a2a:	55                   	push   %ebp
+  801a2b:	89 e5                	mov    %esp,%ebp
+  801a2d:	83 ec 18             	sub    $0x18,%esp
+    int pid = VDSO_PROC->pid;
+  801a30:	b8 00 f0 ef af       	mov    $0xafeff000,%eax
+  801a35:	8b 00                	mov    (%eax),%eax
+  801a37:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    return (pid != 0) ? pid : sys_getpid();
+  801a3a:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  801a3e:	75 07                	jne    801a47 <getpid+0x1d>
+  801a40:	e8 aa f7 ff ff       	call   8011ef <sys_getpid>
+  801a45:	eb 03                	jmp    801a4a <getpid+0x20>
+  801a47:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801a4a:	89 ec                	mov    %ebp,%esp
+  801a4c:	5d                   	pop    %ebp
+  801a4d:	c3                   	ret
+
+00801a4e <print_pgdir>:
+
+//print_pgdir - print the PDT&PT
+void
+print_pgdir(void) {
+  801a4e:	55                   	push   %ebp
+  801a4f:	89 e5                	mov    %esp,%ebp
+  801a51:	83 ec 08             	sub    $0x8,%esp
+    sys_pgdir();
+  801a54:	e8 c9 f7 ff ff       	call   801222 <sys_pgdir>
+}
+  801a59:	90                   	nop
+  801a5a:	89 ec                	mov    %ebp,%esp
+  801a5c:	5d                   	pop    %ebp
+  801a5d:	c3                   	ret
+
+00801a5e <lab6_set_priority>:
+
+void
+lab6_set_priority(uint32_t priority)
+{
+  801a5e:	55                   	push   %ebp
+  801a5f:	89 e5                	mov    %esp,%ebp
+  801a61:	83 ec 18             	sub    $0x18,%esp
+    sys_lab6_set_priority(priority);
+  801a64:	8b 45 08             	mov    0x8(%ebp),%eax
+  801a67:	89 04 24             	mov    %eax,(%esp)
+  801a6a:	e8 c9 f7 ff ff       	call   801238 <sys_lab6_set_priority>
+}
+  801a6f:	90                   	nop
+  801a70:	89 ec                	mov    %ebp,%esp
+  801a72:	5d                   	pop    %ebp
+  801a73:	c3                   	ret
+
+00801a74 <sleep>:
+
+int
+sleep(unsigned int time) {
+  801a74:	55                   	push   %ebp
+  801a75:	89 e5                	mov    %esp,%ebp
+  801a77:	83 ec 18             	sub    $0x18,%esp
+    return sys_sleep(time);
+  801a7a:	8b 45 08             	mov    0x8(%ebp),%eax
+  801a7d:	89 04 24             	mov    %eax,(%esp)
+  801a80:	e8 d1 f7 ff ff       	call   801256 <sys_sleep>
+}
+  801a85:	89 ec                	mov    %ebp,%esp
+  801a87:	5d                   	pop    %ebp
+  801a88:	c3                   	ret
+
+00801a89 <gettime_msec>:
+
+// gettime_msec - the ticks of the kernel, read from the vdso page
+unsigned int
+gettime_msec(void) {
+  801a89:	55                   	push   %ebp
+  801a8a:	89 e5                	mov    %esp,%ebp
+    return VDSO_DATA->ticks;
+  801a8c:	b8 00 e0 ef af       	mov    $0xafefe000,%eax
+  801a91:	8b 00                	mov    (%eax),%eax
+}
+  801a93:	5d                   	pop    %ebp
+  801a94:	c3                   	ret
+
+00801a95 <clock_gettime>:
+
+// clock_gettime - CLOCK_MONOTONIC is counted from the TSC with the vdso page, without
+//               - trapping into the kernel
+int
+clock_gettime(int clock_id, struct timespec *ts) {
+  801a95:	55                   	push   %ebp
+  801a96:	89 e5                	mov    %esp,%ebp
+  801a98:	83 ec 48             	sub    $0x48,%esp
+    const struct vdso_data *vd = VDSO_DATA;
+  801a9b:	c7 45 ec 00 e0 ef af 	movl   $0xafefe000,-0x14(%ebp)
+    if (clock_id != CLOCK_MONOTONIC || vd->ns_mult == 0) {
+  801aa2:	83 7d 08 01          	cmpl   $0x1,0x8(%ebp)
+  801aa6:	75 0a                	jne    801ab2 <clock_gettime+0x1d>
+  801aa8:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801aab:	8b 40 10             	mov    0x10(%eax),%eax
+  801aae:	85 c0                	test   %eax,%eax
+  801ab0:	75 14                	jne    801ac6 <clock_gettime+0x31>
+        return sys_clock_gettime(clock_id, ts);
+  801ab2:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801ab5:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801ab9:	8b 45 08             	mov    0x8(%ebp),%eax
+  801abc:	89 04 24             	mov    %eax,(%esp)
+  801abf:	e8 c5 f7 ff ff       	call   801289 <sys_clock_gettime>
+  801ac4:	eb 77                	jmp    801b3d <clock_gettime+0xa8>
+    }
+    uint64_t ns = gettime_nsec();
+  801ac6:	e8 8b 00 00 00       	call   801b56 <gettime_nsec>
+  801acb:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801ace:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+    ts->tv_nsec = do_div(ns, NSEC_PER_SEC);
+  801ad1:	c7 45 dc 00 ca 9a 3b 	movl   $0x3b9aca00,-0x24(%ebp)
+  801ad8:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  801adb:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  801ade:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  801ae1:	89 55 f0             	mov    %edx,-0x10(%ebp)
+  801ae4:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801ae7:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801aea:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  801aee:	74 1c                	je     801b0c <clock_gettime+0x77>
+  801af0:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801af3:	ba 00 00 00 00       	mov    $0x0,%edx
+  801af8:	f7 75 dc             	divl   -0x24(%ebp)
+  801afb:	89 55 f4             	mov    %edx,-0xc(%ebp)
+  801afe:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801b01:	ba 00 00 00 00       	mov    $0x0,%edx
+  801b06:	f7 75 dc             	divl   -0x24(%ebp)
+  801b09:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801b0c:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801b0f:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  801b12:	f7 75 dc             	divl   -0x24(%ebp)
+  801b15:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  801b18:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  801b1b:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801b1e:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  801b21:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801b24:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  801b27:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+  801b2a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801b2d:	89 50 04             	mov    %edx,0x4(%eax)
+    ts->tv_sec = ns;
+  801b30:	8b 55 e0             	mov    -0x20(%ebp),%edx
+  801b33:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801b36:	89 10                	mov    %edx,(%eax)
+    return 0;
+  801b38:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  801b3d:	89 ec                	mov    %ebp,%esp
+  801b3f:	5d                   	pop    %ebp
+  801b40:	c3                   	ret
+
+00801b41 <nanosleep>:
+
+int
+nanosleep(const struct timespec *req) {
+  801b41:	55                   	push   %ebp
+  801b42:	89 e5                	mov    %esp,%ebp
+  801b44:	83 ec 18             	sub    $0x18,%esp
+    return sys_nanosleep(req);
+  801b47:	8b 45 08             	mov    0x8(%ebp),%eax
+  801b4a:	89 04 24             	mov    %eax,(%esp)
+  801b4d:	e8 5b f7 ff ff       	call   8012ad <sys_nanosleep>
+}
+  801b52:	89 ec                	mov    %ebp,%esp
+  801b54:	5d                   	pop    %ebp
+  801b55:	c3                   	ret
+
+00801b56 <gettime_nsec>:
+
+// gettime_nsec - the nanoseconds of CLOCK_MONOTONIC
+uint64_t
+gettime_nsec(void) {
+  801b56:	55                   	push   %ebp
+  801b57:	89 e5                	mov    %esp,%ebp
+  801b59:	57                   	push   %edi
+  801b5a:	56                   	push   %esi
+  801b5b:	53                   	push   %ebx
+  801b5c:	83 ec 3c             	sub    $0x3c,%esp
+    const struct vdso_data *vd = VDSO_DATA;
+  801b5f:	c7 45 e4 00 e0 ef af 	movl   $0xafefe000,-0x1c(%ebp)
+    if (vd->ns_mult == 0) {
+  801b66:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  801b69:	8b 40 10             	mov    0x10(%eax),%eax
+  801b6c:	85 c0                	test   %eax,%eax
+  801b6e:	75 4f                	jne    801bbf <gettime_nsec+0x69>
+        struct timespec ts;
+        if (sys_clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+  801b70:	8d 45 d0             	lea    -0x30(%ebp),%eax
+  801b73:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801b77:	c7 04 24 01 00 00 00 	movl   $0x1,(%esp)
+  801b7e:	e8 06 f7 ff ff       	call   801289 <sys_clock_gettime>
+  801b83:	85 c0                	test   %eax,%eax
+  801b85:	74 0c                	je     801b93 <gettime_nsec+0x3d>
+            return 0;
+  801b87:	b8 00 00 00 00       	mov    $0x0,%eax
+  801b8c:	ba 00 00 00 00       	mov    $0x0,%edx
+  801b91:	eb 67                	jmp    801bfa <gettime_nsec+0xa4>
+        }
+        return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+  801b93:	8b 45 d0             	mov    -0x30(%ebp),%eax
+  801b96:	ba 00 00 00 00       	mov    $0x0,%edx
+  801b9b:	69 da 00 ca 9a 3b    	imul   $0x3b9aca00,%edx,%ebx
+  801ba1:	6b c8 00             	imul   $0x0,%eax,%ecx
+  801ba4:	01 d9                	add    %ebx,%ecx
+  801ba6:	bb 00 ca 9a 3b       	mov    $0x3b9aca00,%ebx
+  801bab:	f7 e3                	mul    %ebx
+  801bad:	01 d1                	add    %edx,%ecx
+  801baf:	89 ca                	mov    %ecx,%edx
+  801bb1:	8b 4d d4             	mov    -0x2c(%ebp),%ecx
+  801bb4:	bb 00 00 00 00       	mov    $0x0,%ebx
+  801bb9:	01 c8                	add    %ecx,%eax
+  801bbb:	11 da                	adc    %ebx,%edx
+  801bbd:	eb 3b                	jmp    801bfa <gettime_nsec+0xa4>
+    }
+    return mul_u64_u32_shr(read_tsc() - vd->tsc_base, vd->ns_mult, vd->ns_shift);
+  801bbf:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  801bc2:	8b 78 14             	mov    0x14(%eax),%edi
+  801bc5:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  801bc8:	8b 70 10             	mov    0x10(%eax),%esi
+    asm volatile ("rdtsc" : "=A" (tsc));
+  801bcb:	0f 31                	rdtsc
+  801bcd:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  801bd0:	89 55 dc             	mov    %edx,-0x24(%ebp)
+    return tsc;
+  801bd3:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801bd6:	8b 55 dc             	mov    -0x24(%ebp),%edx
+  801bd9:	8b 4d e4             	mov    -0x1c(%ebp),%ecx
+  801bdc:	8b 59 0c             	mov    0xc(%ecx),%ebx
+  801bdf:	8b 49 08             	mov    0x8(%ecx),%ecx
+  801be2:	29 c8                	sub    %ecx,%eax
+  801be4:	19 da                	sbb    %ebx,%edx
+  801be6:	89 7c 24 0c          	mov    %edi,0xc(%esp)
+  801bea:	89 74 24 08          	mov    %esi,0x8(%esp)
+  801bee:	89 04 24             	mov    %eax,(%esp)
+  801bf1:	89 54 24 04          	mov    %edx,0x4(%esp)
+  801bf5:	e8 bf fc ff ff       	call   8018b9 <mul_u64_u32_shr>
+}
+  801bfa:	83 c4 3c             	add    $0x3c,%esp
+  801bfd:	5b                   	pop    %ebx
+  801bfe:	5e                   	pop    %esi
+  801bff:	5f                   	pop    %edi
+  801c00:	5d                   	pop    %ebp
+  801c01:	c3                   	ret
+
+00801c02 <sbrk>:
+
+// sbrk - move the program break by increment bytes, the kernel keeps the heap page aligned
+//      - return the old break, or (void *)-1 if failed
+void *
+sbrk(intptr_t increment) {
+  801c02:	55                   	push   %ebp
+  801c03:	89 e5                	mov    %esp,%ebp
+  801c05:	83 ec 28             	sub    $0x28,%esp
+    static uintptr_t cur_brk = 0;
+    uintptr_t brk = 0, old_brk;
+  801c08:	c7 45 e8 00 00 00 00 	movl   $0x0,-0x18(%ebp)
+    if (cur_brk == 0) {
+  801c0f:	a1 08 61 84 00       	mov    0x846108,%eax
+  801c14:	85 c0                	test   %eax,%eax
+  801c16:	75 13                	jne    801c2b <sbrk+0x29>
+        sys_brk(&brk);
+  801c18:	8d 45 e8             	lea    -0x18(%ebp),%eax
+  801c1b:	89 04 24             	mov    %eax,(%esp)
+  801c1e:	e8 a7 f6 ff ff       	call   8012ca <sys_brk>
+        cur_brk = brk;
+  801c23:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801c26:	a3 08 61 84 00       	mov    %eax,0x846108
+    }
+    old_brk = cur_brk;
+  801c2b:	a1 08 61 84 00       	mov    0x846108,%eax
+  801c30:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (increment != 0) {
+  801c33:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  801c37:	74 5f                	je     801c98 <sbrk+0x96>
+        brk = old_brk + increment;
+  801c39:	8b 55 08             	mov    0x8(%ebp),%edx
+  801c3c:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801c3f:	01 d0                	add    %edx,%eax
+  801c41:	89 45 e8             	mov    %eax,-0x18(%ebp)
+        if (sys_brk(&brk) != 0 || brk != ROUNDUP(old_brk + increment, PGSIZE)) {
+  801c44:	8d 45 e8             	lea    -0x18(%ebp),%eax
+  801c47:	89 04 24             	mov    %eax,(%esp)
+  801c4a:	e8 7b f6 ff ff       	call   8012ca <sys_brk>
+  801c4f:	85 c0                	test   %eax,%eax
+  801c51:	75 31                	jne    801c84 <sbrk+0x82>
+  801c53:	c7 45 f0 00 10 00 00 	movl   $0x1000,-0x10(%ebp)
+  801c5a:	8b 55 08             	mov    0x8(%ebp),%edx
+  801c5d:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801c60:	01 c2                	add    %eax,%edx
+  801c62:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801c65:	01 d0                	add    %edx,%eax
+  801c67:	48                   	dec    %eax
+  801c68:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  801c6b:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801c6e:	ba 00 00 00 00       	mov    $0x0,%edx
+  801c73:	f7 75 f0             	divl   -0x10(%ebp)
+  801c76:	89 d0                	mov    %edx,%eax
+  801c78:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  801c7b:	29 c2                	sub    %eax,%edx
+  801c7d:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801c80:	39 c2                	cmp    %eax,%edx
+  801c82:	74 07                	je     801c8b <sbrk+0x89>
+            return (void *)-1;
+  801c84:	b8 ff ff ff ff       	mov    $0xffffffff,%eax
+  801c89:	eb 10                	jmp    801c9b <sbrk+0x99>
+        }
+        cur_brk = old_brk + increment;
+  801c8b:	8b 55 08             	mov    0x8(%ebp),%edx
+  801c8e:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801c91:	01 d0                	add    %edx,%eax
+  801c93:	a3 08 61 84 00       	mov    %eax,0x846108
+    }
+    return (void *)old_brk;
+  801c98:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801c9b:	89 ec                	mov    %ebp,%esp
+  801c9d:	5d                   	pop    %ebp
+  801c9e:	c3                   	ret
+
+00801c9f <mmap>:
+
+// mmap - map len bytes of anonymous memory at addr (NULL means anywhere)
+//      - return the start address, or NULL if failed
+void *
+mmap(void *addr, size_t len, uint32_t mmap_flags) {
+  801c9f:	55                   	push   %ebp
+  801ca0:	89 e5                	mov    %esp,%ebp
+  801ca2:	83 ec 28             	sub    $0x28,%esp
+    uintptr_t addr_store = (uintptr_t)addr;
+  801ca5:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ca8:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (sys_mmap(&addr_store, len, mmap_flags) != 0) {
+  801cab:	8b 45 10             	mov    0x10(%ebp),%eax
+  801cae:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801cb2:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801cb5:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801cb9:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  801cbc:	89 04 24             	mov    %eax,(%esp)
+  801cbf:	e8 23 f6 ff ff       	call   8012e7 <sys_mmap>
+  801cc4:	85 c0                	test   %eax,%eax
+  801cc6:	74 07                	je     801ccf <mmap+0x30>
+        return NULL;
+  801cc8:	b8 00 00 00 00       	mov    $0x0,%eax
+  801ccd:	eb 03                	jmp    801cd2 <mmap+0x33>
+    }
+    return (void *)addr_store;
+  801ccf:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801cd2:	89 ec                	mov    %ebp,%esp
+  801cd4:	5d                   	pop    %ebp
+  801cd5:	c3                   	ret
+
+00801cd6 <munmap>:
+
+int
+munmap(void *addr, size_t len) {
+  801cd6:	55                   	push   %ebp
+  801cd7:	89 e5                	mov    %esp,%ebp
+  801cd9:	83 ec 18             	sub    $0x18,%esp
+    return sys_munmap((uintptr_t)addr, len);
+  801cdc:	8b 45 08             	mov    0x8(%ebp),%eax
+  801cdf:	8b 55 0c             	mov    0xc(%ebp),%edx
+  801ce2:	89 54 24 04          	mov    %edx,0x4(%esp)
+  801ce6:	89 04 24             	mov    %eax,(%esp)
+  801ce9:	e8 24 f6 ff ff       	call   801312 <sys_munmap>
+}
+  801cee:	89 ec                	mov    %ebp,%esp
+  801cf0:	5d                   	pop    %ebp
+  801cf1:	c3                   	ret
+
+00801cf2 <shmat>:
+
+// shmat - attach the shared memory segment of key, SHMEM_CREAT creates it with len bytes
+//       - return the start address, or NULL if failed
+void *
+shmat(int key, size_t len, uint32_t flags) {
+  801cf2:	55                   	push   %ebp
+  801cf3:	89 e5                	mov    %esp,%ebp
+  801cf5:	83 ec 28             	sub    $0x28,%esp
+    uintptr_t addr_store;
+    if (sys_shmem_attach(&addr_store, key, len, flags) != 0) {
+  801cf8:	8b 45 10             	mov    0x10(%ebp),%eax
+  801cfb:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  801cff:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801d02:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801d06:	8b 45 08             	mov    0x8(%ebp),%eax
+  801d09:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801d0d:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  801d10:	89 04 24             	mov    %eax,(%esp)
+  801d13:	e8 1e f6 ff ff       	call   801336 <sys_shmem_attach>
+  801d18:	85 c0                	test   %eax,%eax
+  801d1a:	74 07                	je     801d23 <shmat+0x31>
+        return NULL;
+  801d1c:	b8 00 00 00 00       	mov    $0x0,%eax
+  801d21:	eb 03                	jmp    801d26 <shmat+0x34>
+    }
+    return (void *)addr_store;
+  801d23:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801d26:	89 ec                	mov    %ebp,%esp
+  801d28:	5d                   	pop    %ebp
+  801d29:	c3                   	ret
+
+00801d2a <shmdt>:
+
+int
+shmdt(void *addr) {
+  801d2a:	55                   	push   %ebp
+  801d2b:	89 e5                	mov    %esp,%ebp
+  801d2d:	83 ec 18             	sub    $0x18,%esp
+    return sys_shmem_detach((uintptr_t)addr);
+  801d30:	8b 45 08             	mov    0x8(%ebp),%eax
+  801d33:	89 04 24             	mov    %eax,(%esp)
+  801d36:	e8 35 f6 ff ff       	call   801370 <sys_shmem_detach>
+}
+  801d3b:	89 ec                	mov    %ebp,%esp
+  801d3d:	5d                   	pop    %ebp
+  801d3e:	c3                   	ret
+
+00801d3f <__exec>:
+
+int
+__exec(const char *name, const char **argv) {
+  801d3f:	55                   	push   %ebp
+  801d40:	89 e5                	mov    %esp,%ebp
+  801d42:	83 ec 28             	sub    $0x28,%esp
+    int argc = 0;
+  801d45:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    while (argv[argc] != NULL) {
+  801d4c:	eb 03                	jmp    801d51 <__exec+0x12>
+        argc ++;
+  801d4e:	ff 45 f4             	incl   -0xc(%ebp)
+    while (argv[argc] != NULL) {
+  801d51:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801d54:	8d 14 85 00 00 00 00 	lea    0x0(,%eax,4),%edx
+  801d5b:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801d5e:	01 d0                	add    %edx,%eax
+  801d60:	8b 00                	mov    (%eax),%eax
+  801d62:	85 c0                	test   %eax,%eax
+  801d64:	75 e8                	jne    801d4e <__exec+0xf>
+    }
+    return sys_exec(name, argc, argv);
+  801d66:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801d69:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801d6d:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801d70:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801d74:	8b 45 08             	mov    0x8(%ebp),%eax
+  801d77:	89 04 24             	mov    %eax,(%esp)
+  801d7a:	e8 16 f6 ff ff       	call   801395 <sys_exec>
+}
+  801d7f:	89 ec                	mov    %ebp,%esp
+  801d81:	5d                   	pop    %ebp
+  801d82:	c3                   	ret
+
+00801d83 <initfd>:
+#include <stat.h>
+
+int main(int argc, char *argv[]);
+
+static int
+initfd(int fd2, const char *path, uint32_t open_flags) {
+  801d83:	55                   	push   %ebp
+  801d84:	89 e5                	mov    %esp,%ebp
+  801d86:	83 ec 28             	sub    $0x28,%esp
+    int fd1, ret;
+    if ((fd1 = open(path, open_flags)) < 0) {
+  801d89:	8b 45 10             	mov    0x10(%ebp),%eax
+  801d8c:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801d90:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801d93:	89 04 24             	mov    %eax,(%esp)
+  801d96:	e8 a2 e3 ff ff       	call   80013d <open>
+  801d9b:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801d9e:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  801da2:	79 05                	jns    801da9 <initfd+0x26>
+        return fd1;
+  801da4:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801da7:	eb 36                	jmp    801ddf <initfd+0x5c>
+    }
+    if (fd1 != fd2) {
+  801da9:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801dac:	3b 45 08             	cmp    0x8(%ebp),%eax
+  801daf:	74 2b                	je     801ddc <initfd+0x59>
+        close(fd2);
+  801db1:	8b 45 08             	mov    0x8(%ebp),%eax
+  801db4:	89 04 24             	mov    %eax,(%esp)
+  801db7:	e8 9d e3 ff ff       	call   800159 <close>
+        ret = dup2(fd1, fd2);
+  801dbc:	8b 45 08             	mov    0x8(%ebp),%eax
+  801dbf:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801dc3:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801dc6:	89 04 24             	mov    %eax,(%esp)
+  801dc9:	e8 3a e4 ff ff       	call   800208 <dup2>
+  801dce:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        close(fd1);
+  801dd1:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801dd4:	89 04 24             	mov    %eax,(%esp)
+  801dd7:	e8 7d e3 ff ff       	call   800159 <close>
+    }
+    return ret;
+  801ddc:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801ddf:	89 ec                	mov    %ebp,%esp
+  801de1:	5d                   	pop    %ebp
+  801de2:	c3                   	ret
+
+00801de3 <umain>:
+
+void
+umain(int argc, char *argv[]) {
+  801de3:	55                   	push   %ebp
+  801de4:	89 e5                	mov    %esp,%ebp
+  801de6:	83 ec 28             	sub    $0x28,%esp
+    int fd;
+    if ((fd = initfd(0, "stdin:", O_RDONLY)) < 0) {
+  801de9:	c7 44 24 08 00 00 00 	movl   $0x0,0x8(%esp)
+  801df0:	00 
+  801df1:	c7 44 24 04 ed 2c 80 	movl   $0x802ced,0x4(%esp)
+  801df8:	00 
+  801df9:	c7 04 24 00 00 00 00 	movl   $0x0,(%esp)
+  801e00:	e8 7e ff ff ff       	call   801d83 <initfd>
+  801e05:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801e08:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  801e0c:	79 23                	jns    801e31 <umain+0x4e>
+        warn("open <stdin> failed: %e.\n", fd);
+  801e0e:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801e11:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  801e15:	c7 44 24 08 f4 2c 80 	movl   $0x802cf4,0x8(%esp)
+  801e1c:	00 
+  801e1d:	c7 44 24 04 1a 00 00 	movl   $0x1a,0x4(%esp)
+  801e24:	00 
+  801e25:	c7 04 24 0e 2d 80 00 	movl   $0x802d0e,(%esp)
+  801e2c:	e8 23 f0 ff ff       	call   800e54 <__warn>
+    }
+    if ((fd = initfd(1, "stdout:", O_WRONLY)) < 0) {
+  801e31:	c7 44 24 08 01 00 00 	movl   $0x1,0x8(%esp)
+  801e38:	00 
+  801e39:	c7 44 24 04 20 2d 80 	movl   $0x802d20,0x4(%esp)
+  801e40:	00 
+  801e41:	c7 04 24 01 00 00 00 	movl   $0x1,(%esp)
+  801e48:	e8 36 ff ff ff       	call   801d83 <initfd>
+  801e4d:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801e50:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  801e54:	79 23                	jns    801e79 <umain+0x96>
+        warn("open <stdout> failed: %e.\n", fd);
+  801e56:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801e59:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  801e5d:	c7 44 24 08 28 2d 80 	movl   $0x802d28,0x8(%esp)
+  801e64:	00 
+  801e65:	c7 44 24 04 1d 00 00 	movl   $0x1d,0x4(%esp)
+  801e6c:	00 
+  801e6d:	c7 04 24 0e 2d 80 00 	movl   $0x802d0e,(%esp)
+  801e74:	e8 db ef ff ff       	call   800e54 <__warn>
+    }
+    int ret = main(argc, argv);
+  801e79:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801e7c:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801e80:	8b 45 08             	mov    0x8(%ebp),%eax
+  801e83:	89 04 24             	mov    %eax,(%esp)
+  801e86:	e8 ed 0c 00 00       	call   802b78 <main>
+  801e8b:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    exit(ret);
+  801e8e:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801e91:	89 04 24             	mov    %eax,(%esp)
+  801e94:	e8 03 fb ff ff       	call   80199c <exit>
+
+00801e99 <hash32>:
+ * @bits:   the number of bits in a return value
+ *
+ * High bits are more random, so we use them.
+ * */
+uint32_t
+hash32(uint32_t val, unsigned int bits) {
+  801e99:	55                   	push   %ebp
+  801e9a:	89 e5                	mov    %esp,%ebp
+  801e9c:	83 ec 10             	sub    $0x10,%esp
+    uint32_t hash = val * GOLDEN_RATIO_PRIME_32;
+  801e9f:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ea2:	69 c0 01 00 37 9e    	imul   $0x9e370001,%eax,%eax
+  801ea8:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return (hash >> (32 - bits));
+  801eab:	b8 20 00 00 00       	mov    $0x20,%eax
+  801eb0:	2b 45 0c             	sub    0xc(%ebp),%eax
+  801eb3:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  801eb6:	88 c1                	mov    %al,%cl
+  801eb8:	d3 ea                	shr    %cl,%edx
+  801eba:	89 d0                	mov    %edx,%eax
+}
+  801ebc:	89 ec                	mov    %ebp,%esp
+  801ebe:	5d                   	pop    %ebp
+  801ebf:	c3                   	ret
+
+00801ec0 <printnum>:
+ * @width:      maximum number of digits, if the actual width is less than @width, use @padc instead
+ * @padc:       character that padded on the left if the actual width is less than @width
+ * */
+static void
+printnum(void (*putch)(int, void*, int), int fd, void *putdat,
+        unsigned long long num, unsigned base, int width, int padc) {
+  801ec0:	55                   	push   %ebp
+  801ec1:	89 e5                	mov    %esp,%ebp
+  801ec3:	83 ec 58             	sub    $0x58,%esp
+  801ec6:	8b 45 14             	mov    0x14(%ebp),%eax
+  801ec9:	89 45 d0             	mov    %eax,-0x30(%ebp)
+  801ecc:	8b 45 18             	mov    0x18(%ebp),%eax
+  801ecf:	89 45 d4             	mov    %eax,-0x2c(%ebp)
+    unsigned long long result = num;
+  801ed2:	8b 45 d0             	mov    -0x30(%ebp),%eax
+  801ed5:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+  801ed8:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  801edb:	89 55 ec             	mov    %edx,-0x14(%ebp)
+    unsigned mod = do_div(result, base);
+  801ede:	8b 45 1c             	mov    0x1c(%ebp),%eax
+  801ee1:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  801ee4:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801ee7:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  801eea:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801eed:	89 55 f0             	mov    %edx,-0x10(%ebp)
+  801ef0:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801ef3:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801ef6:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  801efa:	74 1c                	je     801f18 <printnum+0x58>
+  801efc:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801eff:	ba 00 00 00 00       	mov    $0x0,%edx
+  801f04:	f7 75 e4             	divl   -0x1c(%ebp)
+  801f07:	89 55 f4             	mov    %edx,-0xc(%ebp)
+  801f0a:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801f0d:	ba 00 00 00 00       	mov    $0x0,%edx
+  801f12:	f7 75 e4             	divl   -0x1c(%ebp)
+  801f15:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801f18:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  801f1b:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  801f1e:	f7 75 e4             	divl   -0x1c(%ebp)
+  801f21:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801f24:	89 55 dc             	mov    %edx,-0x24(%ebp)
+  801f27:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  801f2a:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  801f2d:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  801f30:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  801f33:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  801f36:	89 45 d8             	mov    %eax,-0x28(%ebp)
+
+    // first recursively print all preceding (more significant) digits
+    if (num >= base) {
+  801f39:	8b 45 1c             	mov    0x1c(%ebp),%eax
+  801f3c:	ba 00 00 00 00       	mov    $0x0,%edx
+  801f41:	8b 4d d4             	mov    -0x2c(%ebp),%ecx
+  801f44:	39 45 d0             	cmp    %eax,-0x30(%ebp)
+  801f47:	19 d1                	sbb    %edx,%ecx
+  801f49:	72 5a                	jb     801fa5 <printnum+0xe5>
+        printnum(putch, fd, putdat, result, base, width - 1, padc);
+  801f4b:	8b 45 20             	mov    0x20(%ebp),%eax
+  801f4e:	8d 50 ff             	lea    -0x1(%eax),%edx
+  801f51:	8b 45 24             	mov    0x24(%ebp),%eax
+  801f54:	89 44 24 1c          	mov    %eax,0x1c(%esp)
+  801f58:	89 54 24 18          	mov    %edx,0x18(%esp)
+  801f5c:	8b 45 1c             	mov    0x1c(%ebp),%eax
+  801f5f:	89 44 24 14          	mov    %eax,0x14(%esp)
+  801f63:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801f66:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  801f69:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  801f6d:	89 54 24 10          	mov    %edx,0x10(%esp)
+  801f71:	8b 45 10             	mov    0x10(%ebp),%eax
+  801f74:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801f78:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801f7b:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801f7f:	8b 45 08             	mov    0x8(%ebp),%eax
+  801f82:	89 04 24             	mov    %eax,(%esp)
+  801f85:	e8 36 ff ff ff       	call   801ec0 <printnum>
+  801f8a:	eb 22                	jmp    801fae <printnum+0xee>
+    } else {
+        // print any needed pad characters before first digit
+        while (-- width > 0)
+            putch(padc, putdat, fd);
+  801f8c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801f8f:	89 44 24 08          	mov    %eax,0x8(%esp)
+  801f93:	8b 45 10             	mov    0x10(%ebp),%eax
+  801f96:	89 44 24 04          	mov    %eax,0x4(%esp)
+  801f9a:	8b 45 24             	mov    0x24(%ebp),%eax
+  801f9d:	89 04 24             	mov    %eax,(%esp)
+  801fa0:	8b 45 08             	mov    0x8(%ebp),%eax
+  801fa3:	ff d0                	call   *%eax
+        while (-- width > 0)
+  801fa5:	ff 4d 20             	decl   0x20(%ebp)
+  801fa8:	83 7d 20 00          	cmpl   $0x0,0x20(%ebp)
+  801fac:	7f de                	jg     801f8c <printnum+0xcc>
+    }
+    // then print this (the least significant) digit
+    putch("0123456789abcdef"[mod], putdat, fd);
+  801fae:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801fb1:	05 64 2f 80 00       	add    $0x802f64,%eax
+  801fb6:	0f b6 00             	movzbl (%eax),%eax
+  801fb9:	0f be c0             	movsbl %al,%eax
+  801fbc:	8b 55 0c             	mov    0xc(%ebp),%edx
+  801fbf:	89 54 24 08          	mov    %edx,0x8(%esp)
+  801fc3:	8b 55 10             	mov    0x10(%ebp),%edx
+  801fc6:	89 54 24 04          	mov    %edx,0x4(%esp)
+  801fca:	89 04 24             	mov    %eax,(%esp)
+  801fcd:	8b 45 08             	mov    0x8(%ebp),%eax
+  801fd0:	ff d0                	call   *%eax
+}
+  801fd2:	90                   	nop
+  801fd3:	89 ec                	mov    %ebp,%esp
+  801fd5:	5d                   	pop    %ebp
+  801fd6:	c3                   	ret
+
+00801fd7 <getuint>:
+ * getuint - get an unsigned int of various possible sizes from a varargs list
+ * @ap:         a varargs list pointer
+ * @lflag:      determines the size of the vararg that @ap points to
+ * */
+static unsigned long long
+getuint(va_list *ap, int lflag) {
+  801fd7:	55                   	push   %ebp
+  801fd8:	89 e5                	mov    %esp,%ebp
+    if (lflag >= 2) {
+  801fda:	83 7d 0c 01          	cmpl   $0x1,0xc(%ebp)
+  801fde:	7e 14                	jle    801ff4 <getuint+0x1d>
+        return va_arg(*ap, unsigned long long);
+  801fe0:	8b 45 08             	mov    0x8(%ebp),%eax
+  801fe3:	8b 00                	mov    (%eax),%eax
+  801fe5:	8d 48 08             	lea    0x8(%eax),%ecx
+  801fe8:	8b 55 08             	mov    0x8(%ebp),%edx
+  801feb:	89 0a                	mov    %ecx,(%edx)
+  801fed:	8b 50 04             	mov    0x4(%eax),%edx
+  801ff0:	8b 00                	mov    (%eax),%eax
+  801ff2:	eb 30                	jmp    802024 <getuint+0x4d>
+    }
+    else if (lflag) {
+  801ff4:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  801ff8:	74 16                	je     802010 <getuint+0x39>
+        return va_arg(*ap, unsigned long);
+  801ffa:	8b 45 08             	mov    0x8(%ebp),%eax
+  801ffd:	8b 00                	mov    (%eax),%eax
+  801fff:	8d 48 04             	lea    0x4(%eax),%ecx
+  802002:	8b 55 08             	mov    0x8(%ebp),%edx
+  802005:	89 0a                	mov    %ecx,(%edx)
+  802007:	8b 00                	mov    (%eax),%eax
+  802009:	ba 00 00 00 00       	mov    $0x0,%edx
+  80200e:	eb 14                	jmp    802024 <getuint+0x4d>
+    }
+    else {
+        return va_arg(*ap, unsigned int);
+  802010:	8b 45 08             	mov    0x8(%ebp),%eax
+  802013:	8b 00                	mov    (%eax),%eax
+  802015:	8d 48 04             	lea    0x4(%eax),%ecx
+  802018:	8b 55 08             	mov    0x8(%ebp),%edx
+  80201b:	89 0a                	mov    %ecx,(%edx)
+  80201d:	8b 00                	mov    (%eax),%eax
+  80201f:	ba 00 00 00 00       	mov    $0x0,%edx
+    }
+}
+  802024:	5d                   	pop    %ebp
+  802025:	c3                   	ret
+
+00802026 <getint>:
+ * getint - same as getuint but signed, we can't use getuint because of sign extension
+ * @ap:         a varargs list pointer
+ * @lflag:      determines the size of the vararg that @ap points to
+ * */
+static long long
+getint(va_list *ap, int lflag) {
+  802026:	55                   	push   %ebp
+  802027:	89 e5                	mov    %esp,%ebp
+    if (lflag >= 2) {
+  802029:	83 7d 0c 01          	cmpl   $0x1,0xc(%ebp)
+  80202d:	7e 14                	jle    802043 <getint+0x1d>
+        return va_arg(*ap, long long);
+  80202f:	8b 45 08             	mov    0x8(%ebp),%eax
+  802032:	8b 00                	mov    (%eax),%eax
+  802034:	8d 48 08             	lea    0x8(%eax),%ecx
+  802037:	8b 55 08             	mov    0x8(%ebp),%edx
+  80203a:	89 0a                	mov    %ecx,(%edx)
+  80203c:	8b 50 04             	mov    0x4(%eax),%edx
+  80203f:	8b 00                	mov    (%eax),%eax
+  802041:	eb 28                	jmp    80206b <getint+0x45>
+    }
+    else if (lflag) {
+  802043:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  802047:	74 12                	je     80205b <getint+0x35>
+        return va_arg(*ap, long);
+  802049:	8b 45 08             	mov    0x8(%ebp),%eax
+  80204c:	8b 00                	mov    (%eax),%eax
+  80204e:	8d 48 04             	lea    0x4(%eax),%ecx
+  802051:	8b 55 08             	mov    0x8(%ebp),%edx
+  802054:	89 0a                	mov    %ecx,(%edx)
+  802056:	8b 00                	mov    (%eax),%eax
+  802058:	99                   	cltd
+  802059:	eb 10                	jmp    80206b <getint+0x45>
+    }
+    else {
+        return va_arg(*ap, int);
+  80205b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80205e:	8b 00                	mov    (%eax),%eax
+  802060:	8d 48 04             	lea    0x4(%eax),%ecx
+  802063:	8b 55 08             	mov    0x8(%ebp),%edx
+  802066:	89 0a                	mov    %ecx,(%edx)
+  802068:	8b 00                	mov    (%eax),%eax
+  80206a:	99                   	cltd
+    }
+}
+  80206b:	5d                   	pop    %ebp
+  80206c:	c3                   	ret
+
+0080206d <printfmt>:
+ * @fd:         file descriptor
+ * @putdat:     used by @putch function
+ * @fmt:        the format string to use
+ * */
+void
+printfmt(void (*putch)(int, void*, int), int fd, void *putdat, const char *fmt, ...) {
+  80206d:	55                   	push   %ebp
+  80206e:	89 e5                	mov    %esp,%ebp
+  802070:	83 ec 38             	sub    $0x38,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  802073:	8d 45 18             	lea    0x18(%ebp),%eax
+  802076:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    vprintfmt(putch, fd, putdat, fmt, ap);
+  802079:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  80207c:	89 44 24 10          	mov    %eax,0x10(%esp)
+  802080:	8b 45 14             	mov    0x14(%ebp),%eax
+  802083:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  802087:	8b 45 10             	mov    0x10(%ebp),%eax
+  80208a:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80208e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802091:	89 44 24 04          	mov    %eax,0x4(%esp)
+  802095:	8b 45 08             	mov    0x8(%ebp),%eax
+  802098:	89 04 24             	mov    %eax,(%esp)
+  80209b:	e8 05 00 00 00       	call   8020a5 <vprintfmt>
+    va_end(ap);
+}
+  8020a0:	90                   	nop
+  8020a1:	89 ec                	mov    %ebp,%esp
+  8020a3:	5d                   	pop    %ebp
+  8020a4:	c3                   	ret
+
+008020a5 <vprintfmt>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want printfmt() instead.
+ * */
+void
+vprintfmt(void (*putch)(int, void*, int), int fd, void *putdat, const char *fmt, va_list ap) {
+  8020a5:	55                   	push   %ebp
+  8020a6:	89 e5                	mov    %esp,%ebp
+  8020a8:	56                   	push   %esi
+  8020a9:	53                   	push   %ebx
+  8020aa:	83 ec 40             	sub    $0x40,%esp
+    register int ch, err;
+    unsigned long long num;
+    int base, width, precision, lflag, altflag;
+
+    while (1) {
+        while ((ch = *(unsigned char *)fmt ++) != '%') {
+  8020ad:	eb 1e                	jmp    8020cd <vprintfmt+0x28>
+            if (ch == '\0') {
+  8020af:	85 db                	test   %ebx,%ebx
+  8020b1:	0f 84 2d 04 00 00    	je     8024e4 <vprintfmt+0x43f>
+                return;
+            }
+            putch(ch, putdat, fd);
+  8020b7:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8020ba:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8020be:	8b 45 10             	mov    0x10(%ebp),%eax
+  8020c1:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8020c5:	89 1c 24             	mov    %ebx,(%esp)
+  8020c8:	8b 45 08             	mov    0x8(%ebp),%eax
+  8020cb:	ff d0                	call   *%eax
+        while ((ch = *(unsigned char *)fmt ++) != '%') {
+  8020cd:	8b 45 14             	mov    0x14(%ebp),%eax
+  8020d0:	8d 50 01             	lea    0x1(%eax),%edx
+  8020d3:	89 55 14             	mov    %edx,0x14(%ebp)
+  8020d6:	0f b6 00             	movzbl (%eax),%eax
+  8020d9:	0f b6 d8             	movzbl %al,%ebx
+  8020dc:	83 fb 25             	cmp    $0x25,%ebx
+  8020df:	75 ce                	jne    8020af <vprintfmt+0xa>
+        }
+
+        // Process a %-escape sequence
+        char padc = ' ';
+  8020e1:	c6 45 db 20          	movb   $0x20,-0x25(%ebp)
+        width = precision = -1;
+  8020e5:	c7 45 e4 ff ff ff ff 	movl   $0xffffffff,-0x1c(%ebp)
+  8020ec:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8020ef:	89 45 e8             	mov    %eax,-0x18(%ebp)
+        lflag = altflag = 0;
+  8020f2:	c7 45 dc 00 00 00 00 	movl   $0x0,-0x24(%ebp)
+  8020f9:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  8020fc:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  8020ff:	eb 04                	jmp    802105 <vprintfmt+0x60>
+            goto process_precision;
+
+        case '.':
+            if (width < 0)
+                width = 0;
+            goto reswitch;
+  802101:	90                   	nop
+  802102:	eb 01                	jmp    802105 <vprintfmt+0x60>
+            goto reswitch;
+
+        process_precision:
+            if (width < 0)
+                width = precision, precision = -1;
+            goto reswitch;
+  802104:	90                   	nop
+        switch (ch = *(unsigned char *)fmt ++) {
+  802105:	8b 45 14             	mov    0x14(%ebp),%eax
+  802108:	8d 50 01             	lea    0x1(%eax),%edx
+  80210b:	89 55 14             	mov    %edx,0x14(%ebp)
+  80210e:	0f b6 00             	movzbl (%eax),%eax
+  802111:	0f b6 d8             	movzbl %al,%ebx
+  802114:	8d 43 dd             	lea    -0x23(%ebx),%eax
+  802117:	83 f8 55             	cmp    $0x55,%eax
+  80211a:	0f 87 91 03 00 00    	ja     8024b1 <vprintfmt+0x40c>
+  802120:	8b 04 85 88 2f 80 00 	mov    0x802f88(,%eax,4),%eax
+  802127:	ff e0                	jmp    *%eax
+            padc = '-';
+  802129:	c6 45 db 2d          	movb   $0x2d,-0x25(%ebp)
+            goto reswitch;
+  80212d:	eb d6                	jmp    802105 <vprintfmt+0x60>
+            padc = '0';
+  80212f:	c6 45 db 30          	movb   $0x30,-0x25(%ebp)
+            goto reswitch;
+  802133:	eb d0                	jmp    802105 <vprintfmt+0x60>
+            for (precision = 0; ; ++ fmt) {
+  802135:	c7 45 e4 00 00 00 00 	movl   $0x0,-0x1c(%ebp)
+                precision = precision * 10 + ch - '0';
+  80213c:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  80213f:	89 d0                	mov    %edx,%eax
+  802141:	c1 e0 02             	shl    $0x2,%eax
+  802144:	01 d0                	add    %edx,%eax
+  802146:	01 c0                	add    %eax,%eax
+  802148:	01 d8                	add    %ebx,%eax
+  80214a:	83 e8 30             	sub    $0x30,%eax
+  80214d:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+                ch = *fmt;
+  802150:	8b 45 14             	mov    0x14(%ebp),%eax
+  802153:	0f b6 00             	movzbl (%eax),%eax
+  802156:	0f be d8             	movsbl %al,%ebx
+                if (ch < '0' || ch > '9') {
+  802159:	83 fb 2f             	cmp    $0x2f,%ebx
+  80215c:	7e 38                	jle    802196 <vprintfmt+0xf1>
+  80215e:	83 fb 39             	cmp    $0x39,%ebx
+  802161:	7f 33                	jg     802196 <vprintfmt+0xf1>
+            for (precision = 0; ; ++ fmt) {
+  802163:	ff 45 14             	incl   0x14(%ebp)
+                precision = precision * 10 + ch - '0';
+  802166:	eb d4                	jmp    80213c <vprintfmt+0x97>
+            precision = va_arg(ap, int);
+  802168:	8b 45 18             	mov    0x18(%ebp),%eax
+  80216b:	8d 50 04             	lea    0x4(%eax),%edx
+  80216e:	89 55 18             	mov    %edx,0x18(%ebp)
+  802171:	8b 00                	mov    (%eax),%eax
+  802173:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+            goto process_precision;
+  802176:	eb 1f                	jmp    802197 <vprintfmt+0xf2>
+            if (width < 0)
+  802178:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  80217c:	79 83                	jns    802101 <vprintfmt+0x5c>
+                width = 0;
+  80217e:	c7 45 e8 00 00 00 00 	movl   $0x0,-0x18(%ebp)
+            goto reswitch;
+  802185:	e9 77 ff ff ff       	jmp    802101 <vprintfmt+0x5c>
+            altflag = 1;
+  80218a:	c7 45 dc 01 00 00 00 	movl   $0x1,-0x24(%ebp)
+            goto reswitch;
+  802191:	e9 6f ff ff ff       	jmp    802105 <vprintfmt+0x60>
+            goto process_precision;
+  802196:	90                   	nop
+            if (width < 0)
+  802197:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  80219b:	0f 89 63 ff ff ff    	jns    802104 <vprintfmt+0x5f>
+                width = precision, precision = -1;
+  8021a1:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  8021a4:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  8021a7:	c7 45 e4 ff ff ff ff 	movl   $0xffffffff,-0x1c(%ebp)
+            goto reswitch;
+  8021ae:	e9 51 ff ff ff       	jmp    802104 <vprintfmt+0x5f>
+
+        // long flag (doubled for long long)
+        case 'l':
+            lflag ++;
+  8021b3:	ff 45 e0             	incl   -0x20(%ebp)
+            goto reswitch;
+  8021b6:	e9 4a ff ff ff       	jmp    802105 <vprintfmt+0x60>
+
+        // character
+        case 'c':
+            putch(va_arg(ap, int), putdat, fd);
+  8021bb:	8b 45 18             	mov    0x18(%ebp),%eax
+  8021be:	8d 50 04             	lea    0x4(%eax),%edx
+  8021c1:	89 55 18             	mov    %edx,0x18(%ebp)
+  8021c4:	8b 00                	mov    (%eax),%eax
+  8021c6:	8b 55 0c             	mov    0xc(%ebp),%edx
+  8021c9:	89 54 24 08          	mov    %edx,0x8(%esp)
+  8021cd:	8b 55 10             	mov    0x10(%ebp),%edx
+  8021d0:	89 54 24 04          	mov    %edx,0x4(%esp)
+  8021d4:	89 04 24             	mov    %eax,(%esp)
+  8021d7:	8b 45 08             	mov    0x8(%ebp),%eax
+  8021da:	ff d0                	call   *%eax
+            break;
+  8021dc:	e9 fe 02 00 00       	jmp    8024df <vprintfmt+0x43a>
+
+        // error message
+        case 'e':
+            err = va_arg(ap, int);
+  8021e1:	8b 45 18             	mov    0x18(%ebp),%eax
+  8021e4:	8d 50 04             	lea    0x4(%eax),%edx
+  8021e7:	89 55 18             	mov    %edx,0x18(%ebp)
+  8021ea:	8b 18                	mov    (%eax),%ebx
+            if (err < 0) {
+  8021ec:	85 db                	test   %ebx,%ebx
+  8021ee:	79 02                	jns    8021f2 <vprintfmt+0x14d>
+                err = -err;
+  8021f0:	f7 db                	neg    %ebx
+            }
+            if (err > MAXERROR || (p = error_string[err]) == NULL) {
+  8021f2:	83 fb 18             	cmp    $0x18,%ebx
+  8021f5:	7f 0b                	jg     802202 <vprintfmt+0x15d>
+  8021f7:	8b 34 9d 00 2f 80 00 	mov    0x802f00(,%ebx,4),%esi
+  8021fe:	85 f6                	test   %esi,%esi
+  802200:	75 2a                	jne    80222c <vprintfmt+0x187>
+                printfmt(putch, fd, putdat, "error %d", err);
+  802202:	89 5c 24 10          	mov    %ebx,0x10(%esp)
+  802206:	c7 44 24 0c 75 2f 80 	movl   $0x802f75,0xc(%esp)
+  80220d:	00 
+  80220e:	8b 45 10             	mov    0x10(%ebp),%eax
+  802211:	89 44 24 08          	mov    %eax,0x8(%esp)
+  802215:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802218:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80221c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80221f:	89 04 24             	mov    %eax,(%esp)
+  802222:	e8 46 fe ff ff       	call   80206d <printfmt>
+            }
+            else {
+                printfmt(putch, fd, putdat, "%s", p);
+            }
+            break;
+  802227:	e9 b3 02 00 00       	jmp    8024df <vprintfmt+0x43a>
+                printfmt(putch, fd, putdat, "%s", p);
+  80222c:	89 74 24 10          	mov    %esi,0x10(%esp)
+  802230:	c7 44 24 0c 7e 2f 80 	movl   $0x802f7e,0xc(%esp)
+  802237:	00 
+  802238:	8b 45 10             	mov    0x10(%ebp),%eax
+  80223b:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80223f:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802242:	89 44 24 04          	mov    %eax,0x4(%esp)
+  802246:	8b 45 08             	mov    0x8(%ebp),%eax
+  802249:	89 04 24             	mov    %eax,(%esp)
+  80224c:	e8 1c fe ff ff       	call   80206d <printfmt>
+            break;
+  802251:	e9 89 02 00 00       	jmp    8024df <vprintfmt+0x43a>
+
+        // string
+        case 's':
+            if ((p = va_arg(ap, char *)) == NULL) {
+  802256:	8b 45 18             	mov    0x18(%ebp),%eax
+  802259:	8d 50 04             	lea    0x4(%eax),%edx
+  80225c:	89 55 18             	mov    %edx,0x18(%ebp)
+  80225f:	8b 30                	mov    (%eax),%esi
+  802261:	85 f6                	test   %esi,%esi
+  802263:	75 05                	jne    80226a <vprintfmt+0x1c5>
+                p = "(null)";
+  802265:	be 81 2f 80 00       	mov    $0x802f81,%esi
+            }
+            if (width > 0 && padc != '-') {
+  80226a:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  80226e:	0f 8e 8d 00 00 00    	jle    802301 <vprintfmt+0x25c>
+  802274:	80 7d db 2d          	cmpb   $0x2d,-0x25(%ebp)
+  802278:	0f 84 83 00 00 00    	je     802301 <vprintfmt+0x25c>
+                for (width -= strnlen(p, precision); width > 0; width --) {
+  80227e:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  802281:	89 44 24 04          	mov    %eax,0x4(%esp)
+  802285:	89 34 24             	mov    %esi,(%esp)
+  802288:	e8 35 04 00 00       	call   8026c2 <strnlen>
+  80228d:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  802290:	29 c2                	sub    %eax,%edx
+  802292:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  802295:	eb 1d                	jmp    8022b4 <vprintfmt+0x20f>
+                    putch(padc, putdat, fd);
+  802297:	0f be 45 db          	movsbl -0x25(%ebp),%eax
+  80229b:	8b 55 0c             	mov    0xc(%ebp),%edx
+  80229e:	89 54 24 08          	mov    %edx,0x8(%esp)
+  8022a2:	8b 55 10             	mov    0x10(%ebp),%edx
+  8022a5:	89 54 24 04          	mov    %edx,0x4(%esp)
+  8022a9:	89 04 24             	mov    %eax,(%esp)
+  8022ac:	8b 45 08             	mov    0x8(%ebp),%eax
+  8022af:	ff d0                	call   *%eax
+                for (width -= strnlen(p, precision); width > 0; width --) {
+  8022b1:	ff 4d e8             	decl   -0x18(%ebp)
+  8022b4:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  8022b8:	7f dd                	jg     802297 <vprintfmt+0x1f2>
+                }
+            }
+            for (; (ch = *p ++) != '\0' && (precision < 0 || -- precision >= 0); width --) {
+  8022ba:	eb 45                	jmp    802301 <vprintfmt+0x25c>
+                if (altflag && (ch < ' ' || ch > '~')) {
+  8022bc:	83 7d dc 00          	cmpl   $0x0,-0x24(%ebp)
+  8022c0:	74 26                	je     8022e8 <vprintfmt+0x243>
+  8022c2:	83 fb 1f             	cmp    $0x1f,%ebx
+  8022c5:	7e 05                	jle    8022cc <vprintfmt+0x227>
+  8022c7:	83 fb 7e             	cmp    $0x7e,%ebx
+  8022ca:	7e 1c                	jle    8022e8 <vprintfmt+0x243>
+                    putch('?', putdat, fd);
+  8022cc:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8022cf:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8022d3:	8b 45 10             	mov    0x10(%ebp),%eax
+  8022d6:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8022da:	c7 04 24 3f 00 00 00 	movl   $0x3f,(%esp)
+  8022e1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8022e4:	ff d0                	call   *%eax
+  8022e6:	eb 16                	jmp    8022fe <vprintfmt+0x259>
+                }
+                else {
+                    putch(ch, putdat, fd);
+  8022e8:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8022eb:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8022ef:	8b 45 10             	mov    0x10(%ebp),%eax
+  8022f2:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8022f6:	89 1c 24             	mov    %ebx,(%esp)
+  8022f9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8022fc:	ff d0                	call   *%eax
+            for (; (ch = *p ++) != '\0' && (precision < 0 || -- precision >= 0); width --) {
+  8022fe:	ff 4d e8             	decl   -0x18(%ebp)
+  802301:	89 f0                	mov    %esi,%eax
+  802303:	8d 70 01             	lea    0x1(%eax),%esi
+  802306:	0f b6 00             	movzbl (%eax),%eax
+  802309:	0f be d8             	movsbl %al,%ebx
+  80230c:	85 db                	test   %ebx,%ebx
+  80230e:	74 2e                	je     80233e <vprintfmt+0x299>
+  802310:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  802314:	78 a6                	js     8022bc <vprintfmt+0x217>
+  802316:	ff 4d e4             	decl   -0x1c(%ebp)
+  802319:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  80231d:	79 9d                	jns    8022bc <vprintfmt+0x217>
+                }
+            }
+            for (; width > 0; width --) {
+  80231f:	eb 1d                	jmp    80233e <vprintfmt+0x299>
+                putch(' ', putdat, fd);
+  802321:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802324:	89 44 24 08          	mov    %eax,0x8(%esp)
+  802328:	8b 45 10             	mov    0x10(%ebp),%eax
+  80232b:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80232f:	c7 04 24 20 00 00 00 	movl   $0x20,(%esp)
+  802336:	8b 45 08             	mov    0x8(%ebp),%eax
+  802339:	ff d0                	call   *%eax
+            for (; width > 0; width --) {
+  80233b:	ff 4d e8             	decl   -0x18(%ebp)
+  80233e:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  802342:	7f dd                	jg     802321 <vprintfmt+0x27c>
+            }
+            break;
+  802344:	e9 96 01 00 00       	jmp    8024df <vprintfmt+0x43a>
+
+        // (signed) decimal
+        case 'd':
+            num = getint(&ap, lflag);
+  802349:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  80234c:	89 44 24 04          	mov    %eax,0x4(%esp)
+  802350:	8d 45 18             	lea    0x18(%ebp),%eax
+  802353:	89 04 24             	mov    %eax,(%esp)
+  802356:	e8 cb fc ff ff       	call   802026 <getint>
+  80235b:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  80235e:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            if ((long long)num < 0) {
+  802361:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802364:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  802367:	85 d2                	test   %edx,%edx
+  802369:	79 2d                	jns    802398 <vprintfmt+0x2f3>
+                putch('-', putdat, fd);
+  80236b:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80236e:	89 44 24 08          	mov    %eax,0x8(%esp)
+  802372:	8b 45 10             	mov    0x10(%ebp),%eax
+  802375:	89 44 24 04          	mov    %eax,0x4(%esp)
+  802379:	c7 04 24 2d 00 00 00 	movl   $0x2d,(%esp)
+  802380:	8b 45 08             	mov    0x8(%ebp),%eax
+  802383:	ff d0                	call   *%eax
+                num = -(long long)num;
+  802385:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802388:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  80238b:	f7 d8                	neg    %eax
+  80238d:	83 d2 00             	adc    $0x0,%edx
+  802390:	f7 da                	neg    %edx
+  802392:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  802395:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            }
+            base = 10;
+  802398:	c7 45 ec 0a 00 00 00 	movl   $0xa,-0x14(%ebp)
+            goto number;
+  80239f:	e9 b6 00 00 00       	jmp    80245a <vprintfmt+0x3b5>
+
+        // unsigned decimal
+        case 'u':
+            num = getuint(&ap, lflag);
+  8023a4:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  8023a7:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8023ab:	8d 45 18             	lea    0x18(%ebp),%eax
+  8023ae:	89 04 24             	mov    %eax,(%esp)
+  8023b1:	e8 21 fc ff ff       	call   801fd7 <getuint>
+  8023b6:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8023b9:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 10;
+  8023bc:	c7 45 ec 0a 00 00 00 	movl   $0xa,-0x14(%ebp)
+            goto number;
+  8023c3:	e9 92 00 00 00       	jmp    80245a <vprintfmt+0x3b5>
+
+        // (unsigned) octal
+        case 'o':
+            num = getuint(&ap, lflag);
+  8023c8:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  8023cb:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8023cf:	8d 45 18             	lea    0x18(%ebp),%eax
+  8023d2:	89 04 24             	mov    %eax,(%esp)
+  8023d5:	e8 fd fb ff ff       	call   801fd7 <getuint>
+  8023da:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8023dd:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 8;
+  8023e0:	c7 45 ec 08 00 00 00 	movl   $0x8,-0x14(%ebp)
+            goto number;
+  8023e7:	eb 71                	jmp    80245a <vprintfmt+0x3b5>
+
+        // pointer
+        case 'p':
+            putch('0', putdat, fd);
+  8023e9:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8023ec:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8023f0:	8b 45 10             	mov    0x10(%ebp),%eax
+  8023f3:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8023f7:	c7 04 24 30 00 00 00 	movl   $0x30,(%esp)
+  8023fe:	8b 45 08             	mov    0x8(%ebp),%eax
+  802401:	ff d0                	call   *%eax
+            putch('x', putdat, fd);
+  802403:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802406:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80240a:	8b 45 10             	mov    0x10(%ebp),%eax
+  80240d:	89 44 24 04          	mov    %eax,0x4(%esp)
+  802411:	c7 04 24 78 00 00 00 	movl   $0x78,(%esp)
+  802418:	8b 45 08             	mov    0x8(%ebp),%eax
+  80241b:	ff d0                	call   *%eax
+            num = (unsigned long long)(uintptr_t)va_arg(ap, void *);
+  80241d:	8b 45 18             	mov    0x18(%ebp),%eax
+  802420:	8d 50 04             	lea    0x4(%eax),%edx
+  802423:	89 55 18             	mov    %edx,0x18(%ebp)
+  802426:	8b 00                	mov    (%eax),%eax
+  802428:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  80242b:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+            base = 16;
+  802432:	c7 45 ec 10 00 00 00 	movl   $0x10,-0x14(%ebp)
+            goto number;
+  802439:	eb 1f                	jmp    80245a <vprintfmt+0x3b5>
+
+        // (unsigned) hexadecimal
+        case 'x':
+            num = getuint(&ap, lflag);
+  80243b:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  80243e:	89 44 24 04          	mov    %eax,0x4(%esp)
+  802442:	8d 45 18             	lea    0x18(%ebp),%eax
+  802445:	89 04 24             	mov    %eax,(%esp)
+  802448:	e8 8a fb ff ff       	call   801fd7 <getuint>
+  80244d:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  802450:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 16;
+  802453:	c7 45 ec 10 00 00 00 	movl   $0x10,-0x14(%ebp)
+        number:
+            printnum(putch, fd, putdat, num, base, width, padc);
+  80245a:	0f be 55 db          	movsbl -0x25(%ebp),%edx
+  80245e:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  802461:	89 54 24 1c          	mov    %edx,0x1c(%esp)
+  802465:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  802468:	89 54 24 18          	mov    %edx,0x18(%esp)
+  80246c:	89 44 24 14          	mov    %eax,0x14(%esp)
+  802470:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802473:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  802476:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  80247a:	89 54 24 10          	mov    %edx,0x10(%esp)
+  80247e:	8b 45 10             	mov    0x10(%ebp),%eax
+  802481:	89 44 24 08          	mov    %eax,0x8(%esp)
+  802485:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802488:	89 44 24 04          	mov    %eax,0x4(%esp)
+  80248c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80248f:	89 04 24             	mov    %eax,(%esp)
+  802492:	e8 29 fa ff ff       	call   801ec0 <printnum>
+            break;
+  802497:	eb 46                	jmp    8024df <vprintfmt+0x43a>
+
+        // escaped '%' character
+        case '%':
+            putch(ch, putdat, fd);
+  802499:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80249c:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8024a0:	8b 45 10             	mov    0x10(%ebp),%eax
+  8024a3:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8024a7:	89 1c 24             	mov    %ebx,(%esp)
+  8024aa:	8b 45 08             	mov    0x8(%ebp),%eax
+  8024ad:	ff d0                	call   *%eax
+            break;
+  8024af:	eb 2e                	jmp    8024df <vprintfmt+0x43a>
+
+        // unrecognized escape sequence - just print it literally
+        default:
+            putch('%', putdat, fd);
+  8024b1:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8024b4:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8024b8:	8b 45 10             	mov    0x10(%ebp),%eax
+  8024bb:	89 44 24 04          	mov    %eax,0x4(%esp)
+  8024bf:	c7 04 24 25 00 00 00 	movl   $0x25,(%esp)
+  8024c6:	8b 45 08             	mov    0x8(%ebp),%eax
+  8024c9:	ff d0                	call   *%eax
+            for (fmt --; fmt[-1] != '%'; fmt --)
+  8024cb:	ff 4d 14             	decl   0x14(%ebp)
+  8024ce:	eb 03                	jmp    8024d3 <vprintfmt+0x42e>
+  8024d0:	ff 4d 14             	decl   0x14(%ebp)
+  8024d3:	8b 45 14             	mov    0x14(%ebp),%eax
+  8024d6:	48                   	dec    %eax
+  8024d7:	0f b6 00             	movzbl (%eax),%eax
+  8024da:	3c 25                	cmp    $0x25,%al
+  8024dc:	75 f2                	jne    8024d0 <vprintfmt+0x42b>
+                /* do nothing */;
+            break;
+  8024de:	90                   	nop
+    while (1) {
+  8024df:	e9 c9 fb ff ff       	jmp    8020ad <vprintfmt+0x8>
+                return;
+  8024e4:	90                   	nop
+        }
+    }
+}
+  8024e5:	83 c4 40             	add    $0x40,%esp
+  8024e8:	5b                   	pop    %ebx
+  8024e9:	5e                   	pop    %esi
+  8024ea:	5d                   	pop    %ebp
+  8024eb:	c3                   	ret
+
+008024ec <sprintputch>:
+ * sprintputch - 'print' a single character in a buffer
+ * @ch:         the character will be printed
+ * @b:          the buffer to place the character @ch
+ * */
+static void
+sprintputch(int ch, struct sprintbuf *b) {
+  8024ec:	55                   	push   %ebp
+  8024ed:	89 e5                	mov    %esp,%ebp
+    b->cnt ++;
+  8024ef:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8024f2:	8b 40 08             	mov    0x8(%eax),%eax
+  8024f5:	8d 50 01             	lea    0x1(%eax),%edx
+  8024f8:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8024fb:	89 50 08             	mov    %edx,0x8(%eax)
+    if (b->buf < b->ebuf) {
+  8024fe:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802501:	8b 10                	mov    (%eax),%edx
+  802503:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802506:	8b 40 04             	mov    0x4(%eax),%eax
+  802509:	39 c2                	cmp    %eax,%edx
+  80250b:	73 12                	jae    80251f <sprintputch+0x33>
+        *b->buf ++ = ch;
+  80250d:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802510:	8b 00                	mov    (%eax),%eax
+  802512:	8d 48 01             	lea    0x1(%eax),%ecx
+  802515:	8b 55 0c             	mov    0xc(%ebp),%edx
+  802518:	89 0a                	mov    %ecx,(%edx)
+  80251a:	8b 55 08             	mov    0x8(%ebp),%edx
+  80251d:	88 10                	mov    %dl,(%eax)
+    }
+}
+  80251f:	90                   	nop
+  802520:	5d                   	pop    %ebp
+  802521:	c3                   	ret
+
+00802522 <snprintf>:
+ * @str:        the buffer to place the result into
+ * @size:       the size of buffer, including the trailing null space
+ * @fmt:        the format string to use
+ * */
+int
+snprintf(char *str, size_t size, const char *fmt, ...) {
+  802522:	55                   	push   %ebp
+  802523:	89 e5                	mov    %esp,%ebp
+  802525:	83 ec 28             	sub    $0x28,%esp
+    va_list ap;
+    int cnt;
+    va_start(ap, fmt);
+  802528:	8d 45 14             	lea    0x14(%ebp),%eax
+  80252b:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    cnt = vsnprintf(str, size, fmt, ap);
+  80252e:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802531:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  802535:	8b 45 10             	mov    0x10(%ebp),%eax
+  802538:	89 44 24 08          	mov    %eax,0x8(%esp)
+  80253c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80253f:	89 44 24 04          	mov    %eax,0x4(%esp)
+  802543:	8b 45 08             	mov    0x8(%ebp),%eax
+  802546:	89 04 24             	mov    %eax,(%esp)
+  802549:	e8 0a 00 00 00       	call   802558 <vsnprintf>
+  80254e:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+    return cnt;
+  802551:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  802554:	89 ec                	mov    %ebp,%esp
+  802556:	5d                   	pop    %ebp
+  802557:	c3                   	ret
+
+00802558 <vsnprintf>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want snprintf() instead.
+ * */
+int
+vsnprintf(char *str, size_t size, const char *fmt, va_list ap) {
+  802558:	55                   	push   %ebp
+  802559:	89 e5                	mov    %esp,%ebp
+  80255b:	83 ec 38             	sub    $0x38,%esp
+    struct sprintbuf b = {str, str + size - 1, 0};
+  80255e:	8b 45 08             	mov    0x8(%ebp),%eax
+  802561:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  802564:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802567:	8d 50 ff             	lea    -0x1(%eax),%edx
+  80256a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80256d:	01 d0                	add    %edx,%eax
+  80256f:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  802572:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    if (str == NULL || b.buf > b.ebuf) {
+  802579:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  80257d:	74 0a                	je     802589 <vsnprintf+0x31>
+  80257f:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  802582:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  802585:	39 c2                	cmp    %eax,%edx
+  802587:	73 07                	jae    802590 <vsnprintf+0x38>
+        return -E_INVAL;
+  802589:	b8 fd ff ff ff       	mov    $0xfffffffd,%eax
+  80258e:	eb 32                	jmp    8025c2 <vsnprintf+0x6a>
+    }
+    // print the string to the buffer
+    vprintfmt((void*)sprintputch, NO_FD, &b, fmt, ap);
+  802590:	8b 45 14             	mov    0x14(%ebp),%eax
+  802593:	89 44 24 10          	mov    %eax,0x10(%esp)
+  802597:	8b 45 10             	mov    0x10(%ebp),%eax
+  80259a:	89 44 24 0c          	mov    %eax,0xc(%esp)
+  80259e:	8d 45 ec             	lea    -0x14(%ebp),%eax
+  8025a1:	89 44 24 08          	mov    %eax,0x8(%esp)
+  8025a5:	c7 44 24 04 d9 6a ff 	movl   $0xffff6ad9,0x4(%esp)
+  8025ac:	ff 
+  8025ad:	c7 04 24 ec 24 80 00 	movl   $0x8024ec,(%esp)
+  8025b4:	e8 ec fa ff ff       	call   8020a5 <vprintfmt>
+    // null terminate the buffer
+    *b.buf = '\0';
+  8025b9:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8025bc:	c6 00 00             	movb   $0x0,(%eax)
+    return b.cnt;
+  8025bf:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  8025c2:	89 ec                	mov    %ebp,%esp
+  8025c4:	5d                   	pop    %ebp
+  8025c5:	c3                   	ret
+
+008025c6 <rand>:
+ * rand - returns a pseudo-random integer
+ *
+ * The rand() function return a value in the range [0, RAND_MAX].
+ * */
+int
+rand(void) {
+  8025c6:	55                   	push   %ebp
+  8025c7:	89 e5                	mov    %esp,%ebp
+  8025c9:	57                   	push   %edi
+  8025ca:	56                   	push   %esi
+  8025cb:	53                   	push   %ebx
+  8025cc:	83 ec 24             	sub    $0x24,%esp
+    next = (next * 0x5DEECE66DLL + 0xBLL) & ((1LL << 48) - 1);
+  8025cf:	a1 10 40 80 00       	mov    0x804010,%eax
+  8025d4:	8b 15 14 40 80 00    	mov    0x804014,%edx
+  8025da:	69 fa 6d e6 ec de    	imul   $0xdeece66d,%edx,%edi
+  8025e0:	6b f0 05             	imul   $0x5,%eax,%esi
+  8025e3:	01 fe                	add    %edi,%esi
+  8025e5:	bf 6d e6 ec de       	mov    $0xdeece66d,%edi
+  8025ea:	f7 e7                	mul    %edi
+  8025ec:	01 d6                	add    %edx,%esi
+  8025ee:	89 f2                	mov    %esi,%edx
+  8025f0:	83 c0 0b             	add    $0xb,%eax
+  8025f3:	83 d2 00             	adc    $0x0,%edx
+  8025f6:	89 c1                	mov    %eax,%ecx
+  8025f8:	0f b7 da             	movzwl %dx,%ebx
+  8025fb:	89 0d 10 40 80 00    	mov    %ecx,0x804010
+  802601:	89 1d 14 40 80 00    	mov    %ebx,0x804014
+    unsigned long long result = (next >> 12);
+  802607:	a1 10 40 80 00       	mov    0x804010,%eax
+  80260c:	8b 15 14 40 80 00    	mov    0x804014,%edx
+  802612:	0f ac d0 0c          	shrd   $0xc,%edx,%eax
+  802616:	c1 ea 0c             	shr    $0xc,%edx
+  802619:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  80261c:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+    return (int)do_div(result, RAND_MAX + 1);
+  80261f:	c7 45 dc 00 00 00 80 	movl   $0x80000000,-0x24(%ebp)
+  802626:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  802629:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  80262c:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  80262f:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  802632:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802635:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  802638:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  80263c:	74 1c                	je     80265a <rand+0x94>
+  80263e:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802641:	ba 00 00 00 00       	mov    $0x0,%edx
+  802646:	f7 75 dc             	divl   -0x24(%ebp)
+  802649:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  80264c:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80264f:	ba 00 00 00 00       	mov    $0x0,%edx
+  802654:	f7 75 dc             	divl   -0x24(%ebp)
+  802657:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  80265a:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  80265d:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  802660:	f7 75 dc             	divl   -0x24(%ebp)
+  802663:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  802666:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  802669:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  80266c:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  80266f:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  802672:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  802675:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+}
+  802678:	83 c4 24             	add    $0x24,%esp
+  80267b:	5b                   	pop    %ebx
+  80267c:	5e                   	pop    %esi
+  80267d:	5f                   	pop    %edi
+  80267e:	5d                   	pop    %ebp
+  80267f:	c3                   	ret
+
+00802680 <srand>:
+/* *
+ * srand - seed the random number generator with the given number
+ * @seed:   the required seed number
+ * */
+void
+srand(unsigned int seed) {
+  802680:	55                   	push   %ebp
+  802681:	89 e5                	mov    %esp,%ebp
+    next = seed;
+  802683:	8b 45 08             	mov    0x8(%ebp),%eax
+  802686:	ba 00 00 00 00       	mov    $0x0,%edx
+  80268b:	a3 10 40 80 00       	mov    %eax,0x804010
+  802690:	89 15 14 40 80 00    	mov    %edx,0x804014
+}
+  802696:	90                   	nop
+  802697:	5d                   	pop    %ebp
+  802698:	c3                   	ret
+
+00802699 <strlen>:
+ * @s:      the input string
+ *
+ * The strlen() function returns the length of string @s.
+ * */
+size_t
+strlen(const char *s) {
+  802699:	55                   	push   %ebp
+  80269a:	89 e5                	mov    %esp,%ebp
+  80269c:	83 ec 10             	sub    $0x10,%esp
+    size_t cnt = 0;
+  80269f:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while (*s ++ != '\0') {
+  8026a6:	eb 03                	jmp    8026ab <strlen+0x12>
+        cnt ++;
+  8026a8:	ff 45 fc             	incl   -0x4(%ebp)
+    while (*s ++ != '\0') {
+  8026ab:	8b 45 08             	mov    0x8(%ebp),%eax
+  8026ae:	8d 50 01             	lea    0x1(%eax),%edx
+  8026b1:	89 55 08             	mov    %edx,0x8(%ebp)
+  8026b4:	0f b6 00             	movzbl (%eax),%eax
+  8026b7:	84 c0                	test   %al,%al
+  8026b9:	75 ed                	jne    8026a8 <strlen+0xf>
+    }
+    return cnt;
+  8026bb:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  8026be:	89 ec                	mov    %ebp,%esp
+  8026c0:	5d                   	pop    %ebp
+  8026c1:	c3                   	ret
+
+008026c2 <strnlen>:
+ * The return value is strlen(s), if that is less than @len, or
+ * @len if there is no '\0' character among the first @len characters
+ * pointed by @s.
+ * */
+size_t
+strnlen(const char *s, size_t len) {
+  8026c2:	55                   	push   %ebp
+  8026c3:	89 e5                	mov    %esp,%ebp
+  8026c5:	83 ec 10             	sub    $0x10,%esp
+    size_t cnt = 0;
+  8026c8:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while (cnt < len && *s ++ != '\0') {
+  8026cf:	eb 03                	jmp    8026d4 <strnlen+0x12>
+        cnt ++;
+  8026d1:	ff 45 fc             	incl   -0x4(%ebp)
+    while (cnt < len && *s ++ != '\0') {
+  8026d4:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8026d7:	3b 45 0c             	cmp    0xc(%ebp),%eax
+  8026da:	73 10                	jae    8026ec <strnlen+0x2a>
+  8026dc:	8b 45 08             	mov    0x8(%ebp),%eax
+  8026df:	8d 50 01             	lea    0x1(%eax),%edx
+  8026e2:	89 55 08             	mov    %edx,0x8(%ebp)
+  8026e5:	0f b6 00             	movzbl (%eax),%eax
+  8026e8:	84 c0                	test   %al,%al
+  8026ea:	75 e5                	jne    8026d1 <strnlen+0xf>
+    }
+    return cnt;
+  8026ec:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  8026ef:	89 ec                	mov    %ebp,%esp
+  8026f1:	5d                   	pop    %ebp
+  8026f2:	c3                   	ret
+
+008026f3 <strcat>:
+ * @dst:    pointer to the @dst array, which should be large enough to contain the concatenated
+ *          resulting string.
+ * @src:    string to be appended, this should not overlap @dst
+ * */
+char *
+strcat(char *dst, const char *src) {
+  8026f3:	55                   	push   %ebp
+  8026f4:	89 e5                	mov    %esp,%ebp
+  8026f6:	83 ec 18             	sub    $0x18,%esp
+    return strcpy(dst + strlen(dst), src);
+  8026f9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8026fc:	89 04 24             	mov    %eax,(%esp)
+  8026ff:	e8 95 ff ff ff       	call   802699 <strlen>
+  802704:	8b 55 08             	mov    0x8(%ebp),%edx
+  802707:	01 c2                	add    %eax,%edx
+  802709:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80270c:	89 44 24 04          	mov    %eax,0x4(%esp)
+  802710:	89 14 24             	mov    %edx,(%esp)
+  802713:	e8 04 00 00 00       	call   80271c <strcpy>
+}
+  802718:	89 ec                	mov    %ebp,%esp
+  80271a:	5d                   	pop    %ebp
+  80271b:	c3                   	ret
+
+0080271c <strcpy>:
+ * To avoid overflows, the size of array pointed by @dst should be long enough to
+ * contain the same string as @src (including the terminating null character), and
+ * should not overlap in memory with @src.
+ * */
+char *
+strcpy(char *dst, const char *src) {
+  80271c:	55                   	push   %ebp
+  80271d:	89 e5                	mov    %esp,%ebp
+  80271f:	57                   	push   %edi
+  802720:	56                   	push   %esi
+  802721:	83 ec 20             	sub    $0x20,%esp
+  802724:	8b 45 08             	mov    0x8(%ebp),%eax
+  802727:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80272a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80272d:	89 45 f0             	mov    %eax,-0x10(%ebp)
+#ifndef __HAVE_ARCH_STRCPY
+#define __HAVE_ARCH_STRCPY
+static inline char *
+__strcpy(char *dst, const char *src) {
+    int d0, d1, d2;
+    asm volatile (
+  802730:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  802733:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  802736:	89 d1                	mov    %edx,%ecx
+  802738:	89 c2                	mov    %eax,%edx
+  80273a:	89 ce                	mov    %ecx,%esi
+  80273c:	89 d7                	mov    %edx,%edi
+  80273e:	ac                   	lods   %ds:(%esi),%al
+  80273f:	aa                   	stos   %al,%es:(%edi)
+  802740:	84 c0                	test   %al,%al
+  802742:	75 fa                	jne    80273e <strcpy+0x22>
+  802744:	89 fa                	mov    %edi,%edx
+  802746:	89 f1                	mov    %esi,%ecx
+  802748:	89 4d ec             	mov    %ecx,-0x14(%ebp)
+  80274b:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  80274e:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+        "stosb;"
+        "testb %%al, %%al;"
+        "jne 1b;"
+        : "=&S" (d0), "=&D" (d1), "=&a" (d2)
+        : "0" (src), "1" (dst) : "memory");
+    return dst;
+  802751:	8b 45 f4             	mov    -0xc(%ebp),%eax
+    char *p = dst;
+    while ((*p ++ = *src ++) != '\0')
+        /* nothing */;
+    return dst;
+#endif /* __HAVE_ARCH_STRCPY */
+}
+  802754:	83 c4 20             	add    $0x20,%esp
+  802757:	5e                   	pop    %esi
+  802758:	5f                   	pop    %edi
+  802759:	5d                   	pop    %ebp
+  80275a:	c3                   	ret
+
+0080275b <strncpy>:
+ * @len:    maximum number of characters to be copied from @src
+ *
+ * The return value is @dst
+ * */
+char *
+strncpy(char *dst, const char *src, size_t len) {
+  80275b:	55                   	push   %ebp
+  80275c:	89 e5                	mov    %esp,%ebp
+  80275e:	83 ec 10             	sub    $0x10,%esp
+    char *p = dst;
+  802761:	8b 45 08             	mov    0x8(%ebp),%eax
+  802764:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    while (len > 0) {
+  802767:	eb 1e                	jmp    802787 <strncpy+0x2c>
+        if ((*p = *src) != '\0') {
+  802769:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80276c:	0f b6 10             	movzbl (%eax),%edx
+  80276f:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802772:	88 10                	mov    %dl,(%eax)
+  802774:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802777:	0f b6 00             	movzbl (%eax),%eax
+  80277a:	84 c0                	test   %al,%al
+  80277c:	74 03                	je     802781 <strncpy+0x26>
+            src ++;
+  80277e:	ff 45 0c             	incl   0xc(%ebp)
+        }
+        p ++, len --;
+  802781:	ff 45 fc             	incl   -0x4(%ebp)
+  802784:	ff 4d 10             	decl   0x10(%ebp)
+    while (len > 0) {
+  802787:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  80278b:	75 dc                	jne    802769 <strncpy+0xe>
+    }
+    return dst;
+  80278d:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  802790:	89 ec                	mov    %ebp,%esp
+  802792:	5d                   	pop    %ebp
+  802793:	c3                   	ret
+
+00802794 <strcmp>:
+ * - A value greater than zero indicates that the first character that does
+ *   not match has a greater value in @s1 than in @s2;
+ * - And a value less than zero indicates the opposite.
+ * */
+int
+strcmp(const char *s1, const char *s2) {
+  802794:	55                   	push   %ebp
+  802795:	89 e5                	mov    %esp,%ebp
+  802797:	57                   	push   %edi
+  802798:	56                   	push   %esi
+  802799:	83 ec 20             	sub    $0x20,%esp
+  80279c:	8b 45 08             	mov    0x8(%ebp),%eax
+  80279f:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8027a2:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8027a5:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    asm volatile (
+  8027a8:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  8027ab:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8027ae:	89 d1                	mov    %edx,%ecx
+  8027b0:	89 c2                	mov    %eax,%edx
+  8027b2:	89 ce                	mov    %ecx,%esi
+  8027b4:	89 d7                	mov    %edx,%edi
+  8027b6:	ac                   	lods   %ds:(%esi),%al
+  8027b7:	ae                   	scas   %es:(%edi),%al
+  8027b8:	75 08                	jne    8027c2 <strcmp+0x2e>
+  8027ba:	84 c0                	test   %al,%al
+  8027bc:	75 f8                	jne    8027b6 <strcmp+0x22>
+  8027be:	31 c0                	xor    %eax,%eax
+  8027c0:	eb 04                	jmp    8027c6 <strcmp+0x32>
+  8027c2:	19 c0                	sbb    %eax,%eax
+  8027c4:	0c 01                	or     $0x1,%al
+  8027c6:	89 fa                	mov    %edi,%edx
+  8027c8:	89 f1                	mov    %esi,%ecx
+  8027ca:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  8027cd:	89 4d e8             	mov    %ecx,-0x18(%ebp)
+  8027d0:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+    return ret;
+  8027d3:	8b 45 ec             	mov    -0x14(%ebp),%eax
+    while (*s1 != '\0' && *s1 == *s2) {
+        s1 ++, s2 ++;
+    }
+    return (int)((unsigned char)*s1 - (unsigned char)*s2);
+#endif /* __HAVE_ARCH_STRCMP */
+}
+  8027d6:	83 c4 20             	add    $0x20,%esp
+  8027d9:	5e                   	pop    %esi
+  8027da:	5f                   	pop    %edi
+  8027db:	5d                   	pop    %ebp
+  8027dc:	c3                   	ret
+
+008027dd <strncmp>:
+ * they are equal to each other, it continues with the following pairs until
+ * the characters differ, until a terminating null-character is reached, or
+ * until @n characters match in both strings, whichever happens first.
+ * */
+int
+strncmp(const char *s1, const char *s2, size_t n) {
+  8027dd:	55                   	push   %ebp
+  8027de:	89 e5                	mov    %esp,%ebp
+    while (n > 0 && *s1 != '\0' && *s1 == *s2) {
+  8027e0:	eb 09                	jmp    8027eb <strncmp+0xe>
+        n --, s1 ++, s2 ++;
+  8027e2:	ff 4d 10             	decl   0x10(%ebp)
+  8027e5:	ff 45 08             	incl   0x8(%ebp)
+  8027e8:	ff 45 0c             	incl   0xc(%ebp)
+    while (n > 0 && *s1 != '\0' && *s1 == *s2) {
+  8027eb:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  8027ef:	74 1a                	je     80280b <strncmp+0x2e>
+  8027f1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8027f4:	0f b6 00             	movzbl (%eax),%eax
+  8027f7:	84 c0                	test   %al,%al
+  8027f9:	74 10                	je     80280b <strncmp+0x2e>
+  8027fb:	8b 45 08             	mov    0x8(%ebp),%eax
+  8027fe:	0f b6 10             	movzbl (%eax),%edx
+  802801:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802804:	0f b6 00             	movzbl (%eax),%eax
+  802807:	38 c2                	cmp    %al,%dl
+  802809:	74 d7                	je     8027e2 <strncmp+0x5>
+    }
+    return (n == 0) ? 0 : (int)((unsigned char)*s1 - (unsigned char)*s2);
+  80280b:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  80280f:	74 16                	je     802827 <strncmp+0x4a>
+  802811:	8b 45 08             	mov    0x8(%ebp),%eax
+  802814:	0f b6 00             	movzbl (%eax),%eax
+  802817:	0f b6 d0             	movzbl %al,%edx
+  80281a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80281d:	0f b6 00             	movzbl (%eax),%eax
+  802820:	0f b6 c0             	movzbl %al,%eax
+  802823:	29 c2                	sub    %eax,%edx
+  802825:	eb 05                	jmp    80282c <strncmp+0x4f>
+  802827:	ba 00 00 00 00       	mov    $0x0,%edx
+  80282c:	89 d0                	mov    %edx,%eax
+}
+  80282e:	5d                   	pop    %ebp
+  80282f:	c3                   	ret
+
+00802830 <strchr>:
+ *
+ * The strchr() function returns a pointer to the first occurrence of
+ * character in @s. If the value is not found, the function returns 'NULL'.
+ * */
+char *
+strchr(const char *s, char c) {
+  802830:	55                   	push   %ebp
+  802831:	89 e5                	mov    %esp,%ebp
+  802833:	83 ec 04             	sub    $0x4,%esp
+  802836:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802839:	88 45 fc             	mov    %al,-0x4(%ebp)
+    while (*s != '\0') {
+  80283c:	eb 13                	jmp    802851 <strchr+0x21>
+        if (*s == c) {
+  80283e:	8b 45 08             	mov    0x8(%ebp),%eax
+  802841:	0f b6 00             	movzbl (%eax),%eax
+  802844:	38 45 fc             	cmp    %al,-0x4(%ebp)
+  802847:	75 05                	jne    80284e <strchr+0x1e>
+            return (char *)s;
+  802849:	8b 45 08             	mov    0x8(%ebp),%eax
+  80284c:	eb 12                	jmp    802860 <strchr+0x30>
+        }
+        s ++;
+  80284e:	ff 45 08             	incl   0x8(%ebp)
+    while (*s != '\0') {
+  802851:	8b 45 08             	mov    0x8(%ebp),%eax
+  802854:	0f b6 00             	movzbl (%eax),%eax
+  802857:	84 c0                	test   %al,%al
+  802859:	75 e3                	jne    80283e <strchr+0xe>
+    }
+    return NULL;
+  80285b:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  802860:	89 ec                	mov    %ebp,%esp
+  802862:	5d                   	pop    %ebp
+  802863:	c3                   	ret
+
+00802864 <strfind>:
+ * The strfind() function is like strchr() except that if @c is
+ * not found in @s, then it returns a pointer to the null byte at the
+ * end of @s, rather than 'NULL'.
+ * */
+char *
+strfind(const char *s, char c) {
+  802864:	55                   	push   %ebp
+  802865:	89 e5                	mov    %esp,%ebp
+  802867:	83 ec 04             	sub    $0x4,%esp
+  80286a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80286d:	88 45 fc             	mov    %al,-0x4(%ebp)
+    while (*s != '\0') {
+  802870:	eb 0e                	jmp    802880 <strfind+0x1c>
+        if (*s == c) {
+  802872:	8b 45 08             	mov    0x8(%ebp),%eax
+  802875:	0f b6 00             	movzbl (%eax),%eax
+  802878:	38 45 fc             	cmp    %al,-0x4(%ebp)
+  80287b:	74 0f                	je     80288c <strfind+0x28>
+            break;
+        }
+        s ++;
+  80287d:	ff 45 08             	incl   0x8(%ebp)
+    while (*s != '\0') {
+  802880:	8b 45 08             	mov    0x8(%ebp),%eax
+  802883:	0f b6 00             	movzbl (%eax),%eax
+  802886:	84 c0                	test   %al,%al
+  802888:	75 e8                	jne    802872 <strfind+0xe>
+  80288a:	eb 01                	jmp    80288d <strfind+0x29>
+            break;
+  80288c:	90                   	nop
+    }
+    return (char *)s;
+  80288d:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  802890:	89 ec                	mov    %ebp,%esp
+  802892:	5d                   	pop    %ebp
+  802893:	c3                   	ret
+
+00802894 <strtol>:
+ * an optional "0x" or "0X" prefix.
+ *
+ * The strtol() function returns the converted integral number as a long int value.
+ * */
+long
+strtol(const char *s, char **endptr, int base) {
+  802894:	55                   	push   %ebp
+  802895:	89 e5                	mov    %esp,%ebp
+  802897:	83 ec 10             	sub    $0x10,%esp
+    int neg = 0;
+  80289a:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    long val = 0;
+  8028a1:	c7 45 f8 00 00 00 00 	movl   $0x0,-0x8(%ebp)
+
+    // gobble initial whitespace
+    while (*s == ' ' || *s == '\t') {
+  8028a8:	eb 03                	jmp    8028ad <strtol+0x19>
+        s ++;
+  8028aa:	ff 45 08             	incl   0x8(%ebp)
+    while (*s == ' ' || *s == '\t') {
+  8028ad:	8b 45 08             	mov    0x8(%ebp),%eax
+  8028b0:	0f b6 00             	movzbl (%eax),%eax
+  8028b3:	3c 20                	cmp    $0x20,%al
+  8028b5:	74 f3                	je     8028aa <strtol+0x16>
+  8028b7:	8b 45 08             	mov    0x8(%ebp),%eax
+  8028ba:	0f b6 00             	movzbl (%eax),%eax
+  8028bd:	3c 09                	cmp    $0x9,%al
+  8028bf:	74 e9                	je     8028aa <strtol+0x16>
+    }
+
+    // plus/minus sign
+    if (*s == '+') {
+  8028c1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8028c4:	0f b6 00             	movzbl (%eax),%eax
+  8028c7:	3c 2b                	cmp    $0x2b,%al
+  8028c9:	75 05                	jne    8028d0 <strtol+0x3c>
+        s ++;
+  8028cb:	ff 45 08             	incl   0x8(%ebp)
+  8028ce:	eb 14                	jmp    8028e4 <strtol+0x50>
+    }
+    else if (*s == '-') {
+  8028d0:	8b 45 08             	mov    0x8(%ebp),%eax
+  8028d3:	0f b6 00             	movzbl (%eax),%eax
+  8028d6:	3c 2d                	cmp    $0x2d,%al
+  8028d8:	75 0a                	jne    8028e4 <strtol+0x50>
+        s ++, neg = 1;
+  8028da:	ff 45 08             	incl   0x8(%ebp)
+  8028dd:	c7 45 fc 01 00 00 00 	movl   $0x1,-0x4(%ebp)
+    }
+
+    // hex or octal base prefix
+    if ((base == 0 || base == 16) && (s[0] == '0' && s[1] == 'x')) {
+  8028e4:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  8028e8:	74 06                	je     8028f0 <strtol+0x5c>
+  8028ea:	83 7d 10 10          	cmpl   $0x10,0x10(%ebp)
+  8028ee:	75 22                	jne    802912 <strtol+0x7e>
+  8028f0:	8b 45 08             	mov    0x8(%ebp),%eax
+  8028f3:	0f b6 00             	movzbl (%eax),%eax
+  8028f6:	3c 30                	cmp    $0x30,%al
+  8028f8:	75 18                	jne    802912 <strtol+0x7e>
+  8028fa:	8b 45 08             	mov    0x8(%ebp),%eax
+  8028fd:	40                   	inc    %eax
+  8028fe:	0f b6 00             	movzbl (%eax),%eax
+  802901:	3c 78                	cmp    $0x78,%al
+  802903:	75 0d                	jne    802912 <strtol+0x7e>
+        s += 2, base = 16;
+  802905:	83 45 08 02          	addl   $0x2,0x8(%ebp)
+  802909:	c7 45 10 10 00 00 00 	movl   $0x10,0x10(%ebp)
+  802910:	eb 29                	jmp    80293b <strtol+0xa7>
+    }
+    else if (base == 0 && s[0] == '0') {
+  802912:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  802916:	75 16                	jne    80292e <strtol+0x9a>
+  802918:	8b 45 08             	mov    0x8(%ebp),%eax
+  80291b:	0f b6 00             	movzbl (%eax),%eax
+  80291e:	3c 30                	cmp    $0x30,%al
+  802920:	75 0c                	jne    80292e <strtol+0x9a>
+        s ++, base = 8;
+  802922:	ff 45 08             	incl   0x8(%ebp)
+  802925:	c7 45 10 08 00 00 00 	movl   $0x8,0x10(%ebp)
+  80292c:	eb 0d                	jmp    80293b <strtol+0xa7>
+    }
+    else if (base == 0) {
+  80292e:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  802932:	75 07                	jne    80293b <strtol+0xa7>
+        base = 10;
+  802934:	c7 45 10 0a 00 00 00 	movl   $0xa,0x10(%ebp)
+
+    // digits
+    while (1) {
+        int dig;
+
+        if (*s >= '0' && *s <= '9') {
+  80293b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80293e:	0f b6 00             	movzbl (%eax),%eax
+  802941:	3c 2f                	cmp    $0x2f,%al
+  802943:	7e 1b                	jle    802960 <strtol+0xcc>
+  802945:	8b 45 08             	mov    0x8(%ebp),%eax
+  802948:	0f b6 00             	movzbl (%eax),%eax
+  80294b:	3c 39                	cmp    $0x39,%al
+  80294d:	7f 11                	jg     802960 <strtol+0xcc>
+            dig = *s - '0';
+  80294f:	8b 45 08             	mov    0x8(%ebp),%eax
+  802952:	0f b6 00             	movzbl (%eax),%eax
+  802955:	0f be c0             	movsbl %al,%eax
+  802958:	83 e8 30             	sub    $0x30,%eax
+  80295b:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80295e:	eb 48                	jmp    8029a8 <strtol+0x114>
+        }
+        else if (*s >= 'a' && *s <= 'z') {
+  802960:	8b 45 08             	mov    0x8(%ebp),%eax
+  802963:	0f b6 00             	movzbl (%eax),%eax
+  802966:	3c 60                	cmp    $0x60,%al
+  802968:	7e 1b                	jle    802985 <strtol+0xf1>
+  80296a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80296d:	0f b6 00             	movzbl (%eax),%eax
+  802970:	3c 7a                	cmp    $0x7a,%al
+  802972:	7f 11                	jg     802985 <strtol+0xf1>
+            dig = *s - 'a' + 10;
+  802974:	8b 45 08             	mov    0x8(%ebp),%eax
+  802977:	0f b6 00             	movzbl (%eax),%eax
+  80297a:	0f be c0             	movsbl %al,%eax
+  80297d:	83 e8 57             	sub    $0x57,%eax
+  802980:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  802983:	eb 23                	jmp    8029a8 <strtol+0x114>
+        }
+        else if (*s >= 'A' && *s <= 'Z') {
+  802985:	8b 45 08             	mov    0x8(%ebp),%eax
+  802988:	0f b6 00             	movzbl (%eax),%eax
+  80298b:	3c 40                	cmp    $0x40,%al
+  80298d:	7e 3b                	jle    8029ca <strtol+0x136>
+  80298f:	8b 45 08             	mov    0x8(%ebp),%eax
+  802992:	0f b6 00             	movzbl (%eax),%eax
+  802995:	3c 5a                	cmp    $0x5a,%al
+  802997:	7f 31                	jg     8029ca <strtol+0x136>
+            dig = *s - 'A' + 10;
+  802999:	8b 45 08             	mov    0x8(%ebp),%eax
+  80299c:	0f b6 00             	movzbl (%eax),%eax
+  80299f:	0f be c0             	movsbl %al,%eax
+  8029a2:	83 e8 37             	sub    $0x37,%eax
+  8029a5:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        }
+        else {
+            break;
+        }
+        if (dig >= base) {
+  8029a8:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8029ab:	3b 45 10             	cmp    0x10(%ebp),%eax
+  8029ae:	7d 19                	jge    8029c9 <strtol+0x135>
+            break;
+        }
+        s ++, val = (val * base) + dig;
+  8029b0:	ff 45 08             	incl   0x8(%ebp)
+  8029b3:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8029b6:	0f af 45 10          	imul   0x10(%ebp),%eax
+  8029ba:	89 c2                	mov    %eax,%edx
+  8029bc:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8029bf:	01 d0                	add    %edx,%eax
+  8029c1:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    while (1) {
+  8029c4:	e9 72 ff ff ff       	jmp    80293b <strtol+0xa7>
+            break;
+  8029c9:	90                   	nop
+        // we don't properly detect overflow!
+    }
+
+    if (endptr) {
+  8029ca:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  8029ce:	74 08                	je     8029d8 <strtol+0x144>
+        *endptr = (char *) s;
+  8029d0:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8029d3:	8b 55 08             	mov    0x8(%ebp),%edx
+  8029d6:	89 10                	mov    %edx,(%eax)
+    }
+    return (neg ? -val : val);
+  8029d8:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  8029dc:	74 07                	je     8029e5 <strtol+0x151>
+  8029de:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8029e1:	f7 d8                	neg    %eax
+  8029e3:	eb 03                	jmp    8029e8 <strtol+0x154>
+  8029e5:	8b 45 f8             	mov    -0x8(%ebp),%eax
+}
+  8029e8:	89 ec                	mov    %ebp,%esp
+  8029ea:	5d                   	pop    %ebp
+  8029eb:	c3                   	ret
+
+008029ec <memset>:
+ * @n:      number of bytes to be set to the value
+ *
+ * The memset() function returns @s.
+ * */
+void *
+memset(void *s, char c, size_t n) {
+  8029ec:	55                   	push   %ebp
+  8029ed:	89 e5                	mov    %esp,%ebp
+  8029ef:	83 ec 28             	sub    $0x28,%esp
+  8029f2:	89 7d fc             	mov    %edi,-0x4(%ebp)
+  8029f5:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8029f8:	88 45 d8             	mov    %al,-0x28(%ebp)
+#ifdef __HAVE_ARCH_MEMSET
+    return __memset(s, c, n);
+  8029fb:	0f be 55 d8          	movsbl -0x28(%ebp),%edx
+  8029ff:	8b 45 08             	mov    0x8(%ebp),%eax
+  802a02:	89 45 f8             	mov    %eax,-0x8(%ebp)
+  802a05:	88 55 f7             	mov    %dl,-0x9(%ebp)
+  802a08:	8b 45 10             	mov    0x10(%ebp),%eax
+  802a0b:	89 45 f0             	mov    %eax,-0x10(%ebp)
+#ifndef __HAVE_ARCH_MEMSET
+#define __HAVE_ARCH_MEMSET
+static inline void *
+__memset(void *s, char c, size_t n) {
+    int d0, d1;
+    asm volatile (
+  802a0e:	8b 4d f0             	mov    -0x10(%ebp),%ecx
+  802a11:	0f b6 45 f7          	movzbl -0x9(%ebp),%eax
+  802a15:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  802a18:	89 d7                	mov    %edx,%edi
+  802a1a:	f3 aa                	rep stos %al,%es:(%edi)
+  802a1c:	89 fa                	mov    %edi,%edx
+  802a1e:	89 4d ec             	mov    %ecx,-0x14(%ebp)
+  802a21:	89 55 e8             	mov    %edx,-0x18(%ebp)
+        "rep; stosb;"
+        : "=&c" (d0), "=&D" (d1)
+        : "0" (n), "a" (c), "1" (s)
+        : "memory");
+    return s;
+  802a24:	8b 45 f8             	mov    -0x8(%ebp),%eax
+    while (n -- > 0) {
+        *p ++ = c;
+    }
+    return s;
+#endif /* __HAVE_ARCH_MEMSET */
+}
+  802a27:	8b 7d fc             	mov    -0x4(%ebp),%edi
+  802a2a:	89 ec                	mov    %ebp,%esp
+  802a2c:	5d                   	pop    %ebp
+  802a2d:	c3                   	ret
+
+00802a2e <memmove>:
+ * @n:      number of bytes to copy
+ *
+ * The memmove() function returns @dst.
+ * */
+void *
+memmove(void *dst, const void *src, size_t n) {
+  802a2e:	55                   	push   %ebp
+  802a2f:	89 e5                	mov    %esp,%ebp
+  802a31:	57                   	push   %edi
+  802a32:	56                   	push   %esi
+  802a33:	53                   	push   %ebx
+  802a34:	83 ec 30             	sub    $0x30,%esp
+  802a37:	8b 45 08             	mov    0x8(%ebp),%eax
+  802a3a:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  802a3d:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802a40:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  802a43:	8b 45 10             	mov    0x10(%ebp),%eax
+  802a46:	89 45 e8             	mov    %eax,-0x18(%ebp)
+
+#ifndef __HAVE_ARCH_MEMMOVE
+#define __HAVE_ARCH_MEMMOVE
+static inline void *
+__memmove(void *dst, const void *src, size_t n) {
+    if (dst < src) {
+  802a49:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802a4c:	3b 45 ec             	cmp    -0x14(%ebp),%eax
+  802a4f:	73 42                	jae    802a93 <memmove+0x65>
+  802a51:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802a54:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  802a57:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  802a5a:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  802a5d:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802a60:	89 45 dc             	mov    %eax,-0x24(%ebp)
+        "andl $3, %%ecx;"
+        "jz 1f;"
+        "rep; movsb;"
+        "1:"
+        : "=&c" (d0), "=&D" (d1), "=&S" (d2)
+        : "0" (n / 4), "g" (n), "1" (dst), "2" (src)
+  802a63:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  802a66:	c1 e8 02             	shr    $0x2,%eax
+  802a69:	89 c1                	mov    %eax,%ecx
+    asm volatile (
+  802a6b:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  802a6e:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  802a71:	89 d7                	mov    %edx,%edi
+  802a73:	89 c6                	mov    %eax,%esi
+  802a75:	f3 a5                	rep movsl %ds:(%esi),%es:(%edi)
+  802a77:	8b 4d dc             	mov    -0x24(%ebp),%ecx
+  802a7a:	83 e1 03             	and    $0x3,%ecx
+  802a7d:	74 02                	je     802a81 <memmove+0x53>
+  802a7f:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  802a81:	89 f0                	mov    %esi,%eax
+  802a83:	89 fa                	mov    %edi,%edx
+  802a85:	89 4d d8             	mov    %ecx,-0x28(%ebp)
+  802a88:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  802a8b:	89 45 d0             	mov    %eax,-0x30(%ebp)
+        : "memory");
+    return dst;
+  802a8e:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+        return __memcpy(dst, src, n);
+  802a91:	eb 36                	jmp    802ac9 <memmove+0x9b>
+        : "0" (n), "1" (n - 1 + src), "2" (n - 1 + dst)
+  802a93:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802a96:	8d 50 ff             	lea    -0x1(%eax),%edx
+  802a99:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  802a9c:	01 c2                	add    %eax,%edx
+  802a9e:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802aa1:	8d 48 ff             	lea    -0x1(%eax),%ecx
+  802aa4:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802aa7:	8d 1c 01             	lea    (%ecx,%eax,1),%ebx
+    asm volatile (
+  802aaa:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  802aad:	89 c1                	mov    %eax,%ecx
+  802aaf:	89 d8                	mov    %ebx,%eax
+  802ab1:	89 d6                	mov    %edx,%esi
+  802ab3:	89 c7                	mov    %eax,%edi
+  802ab5:	fd                   	std
+  802ab6:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  802ab8:	fc                   	cld
+  802ab9:	89 f8                	mov    %edi,%eax
+  802abb:	89 f2                	mov    %esi,%edx
+  802abd:	89 4d cc             	mov    %ecx,-0x34(%ebp)
+  802ac0:	89 55 c8             	mov    %edx,-0x38(%ebp)
+  802ac3:	89 45 c4             	mov    %eax,-0x3c(%ebp)
+    return dst;
+  802ac6:	8b 45 f0             	mov    -0x10(%ebp),%eax
+            *d ++ = *s ++;
+        }
+    }
+    return dst;
+#endif /* __HAVE_ARCH_MEMMOVE */
+}
+  802ac9:	83 c4 30             	add    $0x30,%esp
+  802acc:	5b                   	pop    %ebx
+  802acd:	5e                   	pop    %esi
+  802ace:	5f                   	pop    %edi
+  802acf:	5d                   	pop    %ebp
+  802ad0:	c3                   	ret
+
+00802ad1 <memcpy>:
+ * it always copies exactly @n bytes. To avoid overflows, the size of arrays pointed
+ * by both @src and @dst, should be at least @n bytes, and should not overlap
+ * (for overlapping memory area, memmove is a safer approach).
+ * */
+void *
+memcpy(void *dst, const void *src, size_t n) {
+  802ad1:	55                   	push   %ebp
+  802ad2:	89 e5                	mov    %esp,%ebp
+  802ad4:	57                   	push   %edi
+  802ad5:	56                   	push   %esi
+  802ad6:	83 ec 20             	sub    $0x20,%esp
+  802ad9:	8b 45 08             	mov    0x8(%ebp),%eax
+  802adc:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  802adf:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802ae2:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  802ae5:	8b 45 10             	mov    0x10(%ebp),%eax
+  802ae8:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        : "0" (n / 4), "g" (n), "1" (dst), "2" (src)
+  802aeb:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  802aee:	c1 e8 02             	shr    $0x2,%eax
+  802af1:	89 c1                	mov    %eax,%ecx
+    asm volatile (
+  802af3:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  802af6:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  802af9:	89 d7                	mov    %edx,%edi
+  802afb:	89 c6                	mov    %eax,%esi
+  802afd:	f3 a5                	rep movsl %ds:(%esi),%es:(%edi)
+  802aff:	8b 4d ec             	mov    -0x14(%ebp),%ecx
+  802b02:	83 e1 03             	and    $0x3,%ecx
+  802b05:	74 02                	je     802b09 <memcpy+0x38>
+  802b07:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  802b09:	89 f0                	mov    %esi,%eax
+  802b0b:	89 fa                	mov    %edi,%edx
+  802b0d:	89 4d e8             	mov    %ecx,-0x18(%ebp)
+  802b10:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  802b13:	89 45 e0             	mov    %eax,-0x20(%ebp)
+    return dst;
+  802b16:	8b 45 f4             	mov    -0xc(%ebp),%eax
+    while (n -- > 0) {
+        *d ++ = *s ++;
+    }
+    return dst;
+#endif /* __HAVE_ARCH_MEMCPY */
+}
+  802b19:	83 c4 20             	add    $0x20,%esp
+  802b1c:	5e                   	pop    %esi
+  802b1d:	5f                   	pop    %edi
+  802b1e:	5d                   	pop    %ebp
+  802b1f:	c3                   	ret
+
+00802b20 <memcmp>:
+ *   match in both memory blocks has a greater value in @v1 than in @v2
+ *   as if evaluated as unsigned char values;
+ * - And a value less than zero indicates the opposite.
+ * */
+int
+memcmp(const void *v1, const void *v2, size_t n) {
+  802b20:	55                   	push   %ebp
+  802b21:	89 e5                	mov    %esp,%ebp
+  802b23:	83 ec 10             	sub    $0x10,%esp
+    const char *s1 = (const char *)v1;
+  802b26:	8b 45 08             	mov    0x8(%ebp),%eax
+  802b29:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    const char *s2 = (const char *)v2;
+  802b2c:	8b 45 0c             	mov    0xc(%ebp),%eax
+  802b2f:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    while (n -- > 0) {
+  802b32:	eb 2c                	jmp    802b60 <memcmp+0x40>
+        if (*s1 != *s2) {
+  802b34:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802b37:	0f b6 10             	movzbl (%eax),%edx
+  802b3a:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802b3d:	0f b6 00             	movzbl (%eax),%eax
+  802b40:	38 c2                	cmp    %al,%dl
+  802b42:	74 16                	je     802b5a <memcmp+0x3a>
+            return (int)((unsigned char)*s1 - (unsigned char)*s2);
+  802b44:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  802b47:	0f b6 00             	movzbl (%eax),%eax
+  802b4a:	0f b6 d0             	movzbl %al,%edx
+  802b4d:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  802b50:	0f b6 00             	movzbl (%eax),%eax
+  802b53:	0f b6 c0             	movzbl %al,%eax
+  802b56:	29 c2                	sub    %eax,%edx
+  802b58:	eb 18                	jmp    802b72 <memcmp+0x52>
+        }
+        s1 ++, s2 ++;
+  802b5a:	ff 45 fc             	incl   -0x4(%ebp)
+  802b5d:	ff 45 f8             	incl   -0x8(%ebp)
+    while (n -- > 0) {
+  802b60:	8b 45 10             	mov    0x10(%ebp),%eax
+  802b63:	8d 50 ff             	lea    -0x1(%eax),%edx
+  802b66:	89 55 10             	mov    %edx,0x10(%ebp)
+  802b69:	85 c0                	test   %eax,%eax
+  802b6b:	75 c7                	jne    802b34 <memcmp+0x14>
+    }
+    return 0;
+  802b6d:	ba 00 00 00 00       	mov    $0x0,%edx
+}
+  802b72:	89 d0                	mov    %edx,%eax
+  802b74:	89 ec                	mov    %ebp,%esp
+  802b76:	5d                   	pop    %ebp
+  802b77:	c3                   	ret
+
+00802b78 <main>:
+#include <ulib.h>
+
+/* try to load the kernel's TSS selector into the DS register */
+
+int
+main(void) {
+  802b78:	55                   	push   %ebp
+  802b79:	89 e5                	mov    %esp,%ebp
+  802b7b:	83 e4 f0             	and    $0xfffffff0,%esp
+  802b7e:	83 ec 10             	sub    $0x10,%esp
+    asm volatile("movw $0x28,%ax; movw %ax,%ds");
+  802b81:	66 b8 28 00          	mov    $0x28,%ax
+  802b85:	8e d8                	mov    %eax,%ds
+    panic("FAIL: T.T\n");
+  802b87:	c7 44 24 08 e0 30 80 	movl   $0x8030e0,0x8(%esp)
+  802b8e:	00 
+  802b8f:	c7 44 24 04 09 00 00 	movl   $0x9,0x4(%esp)
+  802b96:	00 
+  802b97:	c7 04 24 eb 30 80 00 	movl   $0x8030eb,(%esp)
+  802b9e:	e8 61 e2 ff ff       	call   800e04 <__panic>
@@ -338,19 +338,22 @@ default_check() {
 
     pts=3
     quick_check 'check output'                                  \
-    'memory management: default_pmm_manager'                      \
+    'memory management: buddy_pmm_manager'                        \
     'check_alloc_page() succeeded!'                             \
     'check_pgdir() succeeded!'                                  \
+    'check_large_page() succeeded!'                             \
     'check_boot_pgdir() succeeded!'				\
-    'PDE(0e0) c0000000-f8000000 38000000 urw'                   \
-    '  |-- PTE(38000) c0000000-f8000000 38000000 -rw'           \
+    'PDE(0e0) c0000000-f8000000 38000000 -rw 4M'                \
     'PDE(001) fac00000-fb000000 00400000 -rw'                   \
     '  |-- PTE(000e0) faf00000-fafe0000 000e0000 urw'           \
     '  |-- PTE(00001) fafeb000-fafec000 00001000 -rw'		\
+    'check_slab() succeeded!'                                   \
+    'check_zero_pool() succeeded!'                              \
     'check_vma_struct() succeeded!'                             \
     'page fault at 0x00000100: K/W [no page found].'            \
     'check_pgfault() succeeded!'                                \
     'check_vmm() succeeded.'					\
+    'check_timer() succeeded!'                                  \
     'page fault at 0x00001000: K/W [no page found].'            \
     'page fault at 0x00002000: K/W [no page found].'            \
     'page fault at 0x00003000: K/W [no page found].'            \
@@ -362,7 +365,9 @@ default_check() {
     'page fault at 0x00003000: K/W [no page found].'		\
     'page fault at 0x00004000: K/W [no page found].'		\
     'check_swap() succeeded!'					\
-    '++ setup timer interrupts'
+    'check_reclaim() succeeded!'                                \
+    '++ setup timer interrupts'                                 \
+    'check_mutex() succeeded!'
 }
 
 ## check now!!
@@ -443,8 +448,7 @@ run_test -prog 'pgdir' -check default_check
         '  |-- PTE(00001) 00802000-00803000 00001000 urw'       \
         'PDE(001) afc00000-b0000000 00400000 urw'               \
         '  |-- PTE(00004) afffc000-b0000000 00004000 urw'       \
-        'PDE(0e0) c0000000-f8000000 38000000 urw'               \
-        '  |-- PTE(38000) c0000000-f8000000 38000000 -rw'       \
+        'PDE(0e0) c0000000-f8000000 38000000 -rw 4M'            \
         'pgdir pass.'
 
 run_test -prog 'yield' -check default_check                                          \
@@ -493,6 +497,87 @@ run_test -prog 'spin'  -check default_check
         'init check memory pass.'                               \
     ! - 'user panic at .*'
 
+run_test -prog 'threadtest'  -check default_check                                    \
+      - 'kernel_execve: pid = ., name = "threadtest".*'          \
+        'thread 0 (pid [0-9]+) sum [0-9]+.'                     \
+        'thread 7 (pid [0-9]+) sum [0-9]+.'                     \
+        'threadtest pass.'                                      \
+        'all user-mode processes have quit.'                    \
+        'init check memory pass.'                               \
+    ! - 'user panic at .*'
+
+run_test -prog 'mmaptest'  -check default_check                                      \
+      - 'kernel_execve: pid = ., name = "mmaptest".*'            \
+        'sbrk ok.'                                              \
+        'mmap ok.'                                              \
+        'mmap large ok.'                                        \
+        'mmaptest pass.'                                        \
+        'all user-mode processes have quit.'                    \
+        'init check memory pass.'                               \
+    ! - 'user panic at .*'
+
+run_test -prog 'mallocbench'  -check default_check                                   \
+      - 'kernel_execve: pid = ., name = "mallocbench".*'         \
+        'check_malloc ok.'                                      \
+      - 'small: [0-9]+ ops of \[1, 256\] bytes in [0-9]+ msec.'   \
+      - 'large: [0-9]+ ops of \[65536, 262144\] bytes in [0-9]+ msec.' \
+        'mallocbench pass.'                                     \
+        'all user-mode processes have quit.'                    \
+        'init check memory pass.'                               \
+    ! - 'user panic at .*'
+
+run_test -prog 'shmemtest'  -check default_check                                     \
+      - 'kernel_execve: pid = ., name = "shmemtest".*'           \
+        'shmem key ok.'                                         \
+        'shmem private ok.'                                     \
+        'shmemtest pass.'                                       \
+        'all user-mode processes have quit.'                    \
+        'init check memory pass.'                               \
+    ! - 'user panic at .*'
+
+run_test -prog 'schedlat'  -check default_check                                      \
+      - 'kernel_execve: pid = ., name = "schedlat".*'            \
+      - 'schedlat: 8 spinners, wakeup latency avg [0-9]+ max [0-9]+ msecs.' \
+        'schedlat pass.'                                        \
+        'all user-mode processes have quit.'                    \
+        'init check memory pass.'                               \
+    ! - 'user panic at .*'
+
+run_test -prog 'preemptlat'  -check default_check                                    \
+      - 'kernel_execve: pid = ., name = "preemptlat".*'          \
+      - 'preemptlat: wakeup latency max [0-9]+ usecs, with a process forking 1024 pages.' \
+        'preemptlat pass.'                                      \
+        'all user-mode processes have quit.'                    \
+        'init check memory pass.'                               \
+    ! - 'user panic at .*'
+
+run_test -prog 'clocktest'  -check default_check                                     \
+      - 'kernel_execve: pid = ., name = "clocktest".*'           \
+      - 'clock_gettime: monotonic, [0-9]+ nsecs apart at least.' \
+      - 'nanosleep 2500 usecs: [0-9]+ usecs.'                    \
+      - 'nanosleep 55000 usecs: [0-9]+ usecs.'                   \
+        'clocktest pass.'                                       \
+        'all user-mode processes have quit.'                    \
+        'init check memory pass.'                               \
+    ! - 'user panic at .*'
+
+run_test -prog 'vdsotest'  -check default_check                                      \
+      - 'kernel_execve: pid = ., name = "vdsotest".*'            \
+      - 'vdsotest: getpid [0-9]+ cycles, sys_getpid [0-9]+ cycles.' \
+        'vdsotest: the vdso page is read-only.'                 \
+        'vdsotest pass.'                                        \
+        'all user-mode processes have quit.'                    \
+        'init check memory pass.'                               \
+    ! - 'user panic at .*'
+
+run_test -prog 'syscallbench'  -check default_check                                  \
+      - 'kernel_execve: pid = ., name = "syscallbench".*'        \
+      - 'syscallbench: int 0x80 [0-9]+ cycles, sysenter [0-9]+ cycles.' \
+        'syscallbench pass.'                                    \
+        'all user-mode processes have quit.'                    \
+        'init check memory pass.'                               \
+    ! - 'user panic at .*'
+
 run_test -prog 'waitkill'  -check default_check                                      \
       - 'kernel_execve: pid = ., name = "waitkill".*'            \
         'wait child 1.'                                         \
@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <error.h>
+#include <x86.h>
+
+// usec - the microseconds of ns
+static unsigned int
+usec(uint64_t ns) {
+    do_div(ns, 1000);
+    return ns;
+}
+
+// check_sleep - nanosleep for usecs, which must not end early
+static void
+check_sleep(unsigned int usecs) {
+    struct timespec req = {usecs / 1000000, usecs % 1000000 * 1000};
+    uint64_t start = gettime_nsec();
+    assert(nanosleep(&req) == 0);
+    unsigned int slept = usec(gettime_nsec() - start);
+    assert(slept >= usecs);
+    cprintf("nanosleep %u usecs: %u usecs.\n", usecs, slept);
+}
+
+int
+main(void) {
+    struct timespec ts;
+    assert(clock_gettime(CLOCK_MONOTONIC, &ts) == 0 && ts.tv_nsec < NSEC_PER_SEC);
+    assert(clock_gettime(0, &ts) == -E_INVAL);
+
+    // monotonic, and much finer than the 10ms ticks
+    int i;
+    uint64_t last = gettime_nsec(), now, min = (uint64_t)-1;
+    for (i = 0; i < 1000; i ++) {
+        now = gettime_nsec();
+        assert(now >= last);
+        if (now - last < min) {
+            min = now - last;
+        }
+        last = now;
+    }
+    assert(min < 1000000);
+    cprintf("clock_gettime: monotonic, %u nsecs apart at least.\n", (unsigned int)min);
+
+    check_sleep(2500);
+    check_sleep(55000);
+
+    struct timespec bad = {0, NSEC_PER_SEC};
+    assert(nanosleep(&bad) == -E_INVAL);
+
+    cprintf("clocktest pass.\n");
+    return 0;
+}
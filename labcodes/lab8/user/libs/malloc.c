@@ -0,0 +1,328 @@
+#include <defs.h>
+#include <list.h>
+#include <unistd.h>
+#include <string.h>
+#include <ulib.h>
+#include <lock.h>
+#include <malloc.h>
+
+/* *
+ * User-level memory allocator, the memory comes from the heap (sbrk) & mmap.
+ *
+ * Every block starts with a struct mhdr, the payload follows it (8 bytes aligned).
+ *  - small objects (block size <= MAX_SMALL) are kept in the free list of their size
+ *    class, a class gets a run of objects from the heap when its list is empty.
+ *    The runs are never given back to the heap.
+ *  - the other blocks below MMAP_THRESHOLD are allocated from the heap by best-fit.
+ *    A free heap block is in free_list and has its size at the end (footer), the next
+ *    block marks it by M_PREV_FREE, so a freed block is merged with both neighbours.
+ *    The heap ends with a sentinel header (size 0, always used). If the free block at
+ *    the top of heap is bigger than TRIM_THRESHOLD, it is given back by sbrk.
+ *  - large blocks are mapped by mmap, and unmapped by free at once.
+ * */
+
+#define M_USED              0x1                 // the block is in use
+#define M_PREV_FREE         0x2                 // the block before this one in heap is free
+#define M_SMALL             0x4                 // a small object of a size class
+#define M_MMAP              0x8                 // a large block mapped by mmap
+
+#define M_ALIGN             8
+#define M_HDRSIZE           sizeof(struct mhdr)
+#define M_MINSIZE           32                  // header, free list link and footer of a free heap block
+
+#define NR_CLASS            6                   // size classes: 16, 32, ..., 512
+#define MAX_SMALL           (16 << (NR_CLASS - 1))
+#define SMALL_RUN           (4 * PGSIZE)        // bytes of heap carved into small objects at once
+
+#define HEAP_GROW           (16 * PGSIZE)       // the heap grows by multiple of it
+#define MAX_ALLOC           0x40000000          // the biggest size malloc tries
+#define MMAP_THRESHOLD      (64 * 1024)
+#define TRIM_THRESHOLD      (64 * 1024)
+
+struct mhdr {
+    size_t size;                // bytes of the block, including the header
+    uint32_t flags;
+};
+
+struct mfree {
+    struct mhdr hdr;
+    list_entry_t link;          // the link in free_list
+};
+
+struct sfree {
+    struct sfree *next;         // the next free object of the same size class
+};
+
+#define le2mfree(le)                        \
+    to_struct((le), struct mfree, link)
+
+#define next_block(b)                       \
+    ((struct mhdr *)((char *)(b) + (b)->size))
+
+#define block_footer(b)                     \
+    (*(size_t *)((char *)(b) + (b)->size - sizeof(size_t)))
+
+static lock_t malloc_lock = INIT_LOCK;
+static list_entry_t free_list = {&free_list, &free_list};
+static struct sfree *small_free[NR_CLASS];
+static struct mhdr *heap_end;   // the sentinel at the end of heap
+static size_t heap_bytes, mmap_bytes, used_bytes;
+
+// heap_insert - make b a free block: set the footer, add to free_list and mark the next block
+static void
+heap_insert(struct mhdr *b) {
+    b->flags &= M_PREV_FREE;
+    block_footer(b) = b->size;
+    list_add(&free_list, &(((struct mfree *)b)->link));
+    next_block(b)->flags |= M_PREV_FREE;
+}
+
+// heap_coalesce - merge the free block b (not in free_list) with its free neighbours, then insert it
+static struct mhdr *
+heap_coalesce(struct mhdr *b) {
+    struct mhdr *next = next_block(b);
+    if (!(next->flags & M_USED)) {
+        list_del(&(((struct mfree *)next)->link));
+        b->size += next->size;
+    }
+    if (b->flags & M_PREV_FREE) {
+        struct mhdr *prev = (struct mhdr *)((char *)b - *((size_t *)b - 1));
+        list_del(&(((struct mfree *)prev)->link));
+        prev->size += b->size;
+        b = prev;
+    }
+    heap_insert(b);
+    return b;
+}
+
+// heap_grow - get at least need bytes from kernel by sbrk, return the free block at the top of heap
+static struct mhdr *
+heap_grow(size_t need) {
+    size_t grow = ROUNDUP(need + M_HDRSIZE, HEAP_GROW);
+    char *p;
+    if ((p = sbrk(grow)) == (void *)-1) {
+        return NULL;
+    }
+    struct mhdr *b;
+    if (heap_end == NULL) {
+        b = (struct mhdr *)p;
+        b->size = grow - M_HDRSIZE;
+        b->flags = 0;
+    }
+    else {
+        // malloc is the only user of sbrk, so the heap is continuous
+        assert(p == (char *)heap_end + M_HDRSIZE);
+        b = heap_end;
+        b->size = grow;
+    }
+    heap_end = next_block(b);
+    heap_end->size = 0;
+    heap_end->flags = M_USED;
+    heap_bytes += grow;
+    return heap_coalesce(b);
+}
+
+// heap_trim - give the free block b at the top of heap back to kernel, except a small tail
+static void
+heap_trim(struct mhdr *b) {
+    size_t release = ROUNDDOWN(b->size - M_MINSIZE, PGSIZE);
+    if (release == 0 || sbrk(-release) == (void *)-1) {
+        return ;
+    }
+    b->size -= release;
+    block_footer(b) = b->size;
+    heap_end = next_block(b);
+    heap_end->size = 0;
+    heap_end->flags = M_USED | M_PREV_FREE;
+    heap_bytes -= release;
+}
+
+// heap_alloc - alloc a heap block of need bytes by best-fit, split the rest if it's big enough
+static struct mhdr *
+heap_alloc(size_t need) {
+    list_entry_t *le = &free_list;
+    struct mhdr *b = NULL;
+    while ((le = list_next(le)) != &free_list) {
+        struct mhdr *f = &(le2mfree(le)->hdr);
+        if (f->size >= need && (b == NULL || f->size < b->size)) {
+            b = f;
+            if (f->size == need) {
+                break;
+            }
+        }
+    }
+    if (b == NULL && (b = heap_grow(need)) == NULL) {
+        return NULL;
+    }
+    list_del(&(((struct mfree *)b)->link));
+    if (b->size - need >= M_MINSIZE) {
+        struct mhdr *rest = (struct mhdr *)((char *)b + need);
+        rest->size = b->size - need;
+        rest->flags = 0;
+        b->size = need;
+        heap_insert(rest);
+    }
+    else {
+        next_block(b)->flags &= ~M_PREV_FREE;
+    }
+    b->flags = M_USED;
+    return b;
+}
+
+// heap_free - free the heap block b, trim the top of heap if it's too big
+static void
+heap_free(struct mhdr *b) {
+    b->flags &= ~M_USED;
+    b = heap_coalesce(b);
+    if (next_block(b) == heap_end && b->size >= TRIM_THRESHOLD) {
+        heap_trim(b);
+    }
+}
+
+// small_alloc - alloc an object of size class c, refill the class from heap if needed
+static struct mhdr *
+small_alloc(int c) {
+    size_t size = (16 << c);
+    if (small_free[c] == NULL) {
+        struct mhdr *run;
+        if ((run = heap_alloc(SMALL_RUN)) == NULL) {
+            return NULL;
+        }
+        char *p = (char *)(run + 1), *end = (char *)run + run->size;
+        for (; p + size <= end; p += size) {
+            struct mhdr *b = (struct mhdr *)p;
+            struct sfree *s = (struct sfree *)(b + 1);
+            b->size = size;
+            b->flags = M_SMALL;
+            s->next = small_free[c];
+            small_free[c] = s;
+        }
+    }
+    struct sfree *s = small_free[c];
+    small_free[c] = s->next;
+    struct mhdr *b = (struct mhdr *)s - 1;
+    b->flags |= M_USED;
+    return b;
+}
+
+static inline int
+small_class(size_t size) {
+    int c = 0;
+    while ((16 << c) < size) {
+        c ++;
+    }
+    return c;
+}
+
+void *
+malloc(size_t size) {
+    if (size == 0 || size >= MAX_ALLOC) {
+        return NULL;
+    }
+    struct mhdr *b;
+    size_t need = ROUNDUP(size + M_HDRSIZE, M_ALIGN);
+    if (need >= MMAP_THRESHOLD) {
+        size_t len = ROUNDUP(need, PGSIZE);
+        if ((b = mmap(NULL, len, MMAP_WRITE)) == NULL) {
+            return NULL;
+        }
+        b->size = len;
+        b->flags = M_MMAP | M_USED;
+        lock(&malloc_lock);
+        mmap_bytes += len, used_bytes += len;
+        unlock(&malloc_lock);
+        return b + 1;
+    }
+    lock(&malloc_lock);
+    if (need <= MAX_SMALL) {
+        b = small_alloc(small_class(need));
+    }
+    else {
+        b = heap_alloc(need);
+    }
+    if (b != NULL) {
+        used_bytes += b->size;
+    }
+    unlock(&malloc_lock);
+    return (b != NULL) ? b + 1 : NULL;
+}
+
+void *
+calloc(size_t nmemb, size_t size) {
+    if (size != 0 && nmemb > MAX_ALLOC / size) {
+        return NULL;
+    }
+    void *ptr;
+    if ((ptr = malloc(nmemb * size)) != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+
+void *
+realloc(void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return malloc(size);
+    }
+    if (size == 0) {
+        free(ptr);
+        return NULL;
+    }
+    struct mhdr *b = (struct mhdr *)ptr - 1;
+    size_t cap = b->size - M_HDRSIZE;
+    if (size <= cap) {
+        return ptr;
+    }
+    void *nptr;
+    if ((nptr = malloc(size)) != NULL) {
+        memcpy(nptr, ptr, cap);
+        free(ptr);
+    }
+    return nptr;
+}
+
+void
+free(void *ptr) {
+    if (ptr == NULL) {
+        return ;
+    }
+    struct mhdr *b = (struct mhdr *)ptr - 1;
+    assert(b->flags & M_USED);
+    if (b->flags & M_MMAP) {
+        size_t len = b->size;
+        assert(munmap(b, len) == 0);
+        lock(&malloc_lock);
+        mmap_bytes -= len, used_bytes -= len;
+        unlock(&malloc_lock);
+        return ;
+    }
+    lock(&malloc_lock);
+    used_bytes -= b->size;
+    if (b->flags & M_SMALL) {
+        struct sfree *s = (struct sfree *)ptr;
+        int c = small_class(b->size);
+        b->flags &= ~M_USED;
+        s->next = small_free[c];
+        small_free[c] = s;
+    }
+    else {
+        heap_free(b);
+    }
+    unlock(&malloc_lock);
+}
+
+void
+malloc_stat(struct malloc_stat *stat) {
+    lock(&malloc_lock);
+    stat->heap_bytes = heap_bytes;
+    stat->mmap_bytes = mmap_bytes;
+    stat->used_bytes = used_bytes;
+    stat->free_bytes = stat->nr_free = 0;
+    list_entry_t *le = &free_list;
+    while ((le = list_next(le)) != &free_list) {
+        stat->free_bytes += le2mfree(le)->hdr.size;
+        stat->nr_free ++;
+    }
+    unlock(&malloc_lock);
+}
+
@@ -0,0 +1,22 @@
+#ifndef __USER_LIBS_MALLOC_H__
+#define __USER_LIBS_MALLOC_H__
+
+#include <defs.h>
+
+void *malloc(size_t size);
+void *calloc(size_t nmemb, size_t size);
+void *realloc(void *ptr, size_t size);
+void free(void *ptr);
+
+struct malloc_stat {
+    size_t heap_bytes;      // bytes of heap got by sbrk
+    size_t mmap_bytes;      // bytes of large blocks got by mmap
+    size_t used_bytes;      // bytes of the blocks in use, including headers
+    size_t free_bytes;      // bytes of the free blocks in heap
+    size_t nr_free;         // number of the free blocks in heap
+};
+
+void malloc_stat(struct malloc_stat *stat);
+
+#endif /* !__USER_LIBS_MALLOC_H__ */
+
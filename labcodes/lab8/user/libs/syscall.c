@@ -4,10 +4,23 @@
 #include <syscall.h>
 #include <stat.h>
 #include <dirent.h>
+#include <x86.h>
+#include <vdso.h>
 
 
 #define MAX_ARGS            5
 
+// 1 if the system calls enter with SYSENTER, 0 with int $T_SYSCALL, -1 if not checked yet
+static int use_sysenter = -1;
+
+// sysenter_supported - the kernel sets up SYSENTER if CPUID reports it, see sysenter_init
+static bool
+sysenter_supported(void) {
+    uint32_t edx;
+    cpuid(1, NULL, NULL, NULL, &edx);
+    return (edx & CPUID_FEAT_SEP) != 0;
+}
+
 static inline int
 syscall(int num, ...) {
     va_list ap;
@@ -19,6 +32,22 @@ syscall(int num, ...) {
     }
     va_end(ap);
 
+    if (use_sysenter < 0) {
+        use_sysenter = sysenter_supported();
+    }
+    if (use_sysenter) {
+        // the vdso code of SYSENTER, which returns with %ecx and %edx changed
+        asm volatile (
+            "call %P3;"
+            : "=a" (ret), "+d" (a[0]), "+c" (a[1])
+            : "i" (VDSO_SYSENTER),
+              "a" (num),
+              "b" (a[2]),
+              "D" (a[3]),
+              "S" (a[4])
+            : "cc", "memory");
+        return ret;
+    }
     asm volatile (
         "int %1;"
         : "=a" (ret)
@@ -33,6 +62,17 @@ syscall(int num, ...) {
     return ret;
 }
 
+/* *
+ * syscall_sysenter - choose how the system calls enter the kernel: with SYSENTER if enable
+ * and the cpu has it, or with int $T_SYSCALL, which always works.
+ * return value: 1 if SYSENTER is used
+ * */
+bool
+syscall_sysenter(bool enable) {
+    use_sysenter = enable && sysenter_supported();
+    return use_sysenter;
+}
+
 int
 sys_exit(int error_code) {
     return syscall(SYS_exit, error_code);
@@ -89,6 +129,41 @@ sys_gettime(void) {
     return syscall(SYS_gettime);
 }
 
+int
+sys_clock_gettime(int clock_id, struct timespec *ts) {
+    return syscall(SYS_clock_gettime, clock_id, ts);
+}
+
+int
+sys_nanosleep(const struct timespec *req) {
+    return syscall(SYS_nanosleep, req);
+}
+
+int
+sys_brk(uintptr_t *brk_store) {
+    return syscall(SYS_brk, brk_store);
+}
+
+int
+sys_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags) {
+    return syscall(SYS_mmap, addr_store, len, mmap_flags);
+}
+
+int
+sys_munmap(uintptr_t addr, size_t len) {
+    return syscall(SYS_munmap, addr, len);
+}
+
+int
+sys_shmem_attach(uintptr_t *addr_store, int key, size_t len, uint32_t flags) {
+    return syscall(SYS_shmem, SHMEM_ATTACH, addr_store, key, len, flags);
+}
+
+int
+sys_shmem_detach(uintptr_t addr) {
+    return syscall(SYS_shmem, SHMEM_DETACH, addr);
+}
+
 int
 sys_exec(const char *name, int argc, const char **argv) {
     return syscall(SYS_exec, name, argc, argv);
@@ -1,8 +1,11 @@
 #ifndef __USER_LIBS_SYSCALL_H__
 #define __USER_LIBS_SYSCALL_H__
 
+bool syscall_sysenter(bool enable);
+
 int sys_exit(int error_code);
 int sys_fork(void);
+int __clone(uint32_t clone_flags, uintptr_t stack, uintptr_t tls, int (*fn)(void *), void *arg);
 int sys_wait(int pid, int *store);
 int sys_exec(const char *name, int argc, const char **argv);
 int sys_yield(void);
@@ -12,6 +15,14 @@ int sys_putc(int c);
 int sys_pgdir(void);
 int sys_sleep(unsigned int time);
 int sys_gettime(void);
+struct timespec;
+int sys_clock_gettime(int clock_id, struct timespec *ts);
+int sys_nanosleep(const struct timespec *req);
+int sys_brk(uintptr_t *brk_store);
+int sys_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags);
+int sys_munmap(uintptr_t addr, size_t len);
+int sys_shmem_attach(uintptr_t *addr_store, int key, size_t len, uint32_t flags);
+int sys_shmem_detach(uintptr_t addr);
 
 struct stat;
 struct dirent;
@@ -0,0 +1,94 @@
+#include <defs.h>
+#include <unistd.h>
+#include <syscall.h>
+#include <string.h>
+#include <stdio.h>
+#include <ulib.h>
+#include <lock.h>
+#include <error.h>
+#include <thread.h>
+
+/* *
+ * thread - the user threads share the address space & the files of the process
+ * (SYS_clone with CLONE_VM | CLONE_FS), and are scheduled by the kernel like processes.
+ * The stacks & tls of threads come from a static pool, whose pages are only allocated
+ * when a thread touches them.
+ * */
+
+static char thread_stacks[THREAD_MAX][THREAD_STACKSIZE] __attribute__((aligned(4096)));
+static struct thread_tls thread_tlss[THREAD_MAX];
+static bool thread_used[THREAD_MAX];
+static lock_t thread_lock = INIT_LOCK;
+
+static int
+thread_slot_alloc(void) {
+    int slot;
+    lock(&thread_lock);
+    for (slot = 0; slot < THREAD_MAX; slot ++) {
+        if (!thread_used[slot]) {
+            thread_used[slot] = 1;
+            break;
+        }
+    }
+    unlock(&thread_lock);
+    return (slot < THREAD_MAX) ? slot : -1;
+}
+
+static void
+thread_slot_free(int slot) {
+    lock(&thread_lock);
+    thread_used[slot] = 0;
+    unlock(&thread_lock);
+}
+
+// thread_create - create a thread running fn(arg), the exit code of thread is the return value of fn
+int
+thread_create(int (*fn)(void *), void *arg, thread_t *tidp) {
+    int slot, tid;
+    if ((slot = thread_slot_alloc()) < 0) {
+        return -E_NO_FREE_PROC;
+    }
+    struct thread_tls *tls = thread_tlss + slot;
+    memset(tls, 0, sizeof(struct thread_tls));
+    tls->self = tls, tls->slot = slot;
+
+    uintptr_t stack = (uintptr_t)(thread_stacks[slot] + THREAD_STACKSIZE);
+    uint32_t clone_flags = CLONE_VM | CLONE_FS | CLONE_THREAD | CLONE_SETTLS;
+    if ((tid = __clone(clone_flags, stack, (uintptr_t)tls, fn, arg)) < 0) {
+        thread_slot_free(slot);
+        return tid;
+    }
+    tidp->tid = tid, tidp->slot = slot;
+    return 0;
+}
+
+// thread_join - wait the thread to exit and release its stack, only the creator can join a thread
+int
+thread_join(thread_t *tidp, int *exit_code) {
+    int ret;
+    if ((ret = sys_wait(tidp->tid, exit_code)) == 0) {
+        thread_slot_free(tidp->slot);
+    }
+    return ret;
+}
+
+void
+thread_exit(int exit_code) {
+    sys_exit(exit_code);
+    cprintf("BUG: thread_exit failed.\n");
+    while (1);
+}
+
+// thread_self - the tls of current thread, NULL for the main thread of process
+struct thread_tls *
+thread_self(void) {
+    uint16_t gs;
+    asm volatile ("movw %%gs, %0" : "=r" (gs));
+    if (gs != USER_TLS) {
+        return NULL;
+    }
+    struct thread_tls *tls;
+    asm volatile ("movl %%gs:0, %0" : "=r" (tls));
+    return tls;
+}
+
@@ -0,0 +1,30 @@
+#ifndef __USER_LIBS_THREAD_H__
+#define __USER_LIBS_THREAD_H__
+
+#include <defs.h>
+
+#define THREAD_MAX              16                  // max # of live threads created by thread_create
+#define THREAD_STACKSIZE        (4 * 4096)          // size of the user stack of a thread
+
+/* *
+ * The thread local storage of a thread, the kernel points %gs at it (CLONE_SETTLS),
+ * so a thread can find it with thread_self().
+ * */
+struct thread_tls {
+    struct thread_tls *self;    // must be the first field, thread_self reads %gs:0
+    int slot;                   // the index of the stack & tls of this thread
+    void *specific;             // a pointer for user's per-thread data
+};
+
+typedef struct {
+    int tid;
+    int slot;
+} thread_t;
+
+int thread_create(int (*fn)(void *), void *arg, thread_t *tidp);
+int thread_join(thread_t *tidp, int *exit_code);
+void thread_exit(int exit_code) __attribute__((noreturn));
+struct thread_tls *thread_self(void);
+
+#endif /* !__USER_LIBS_THREAD_H__ */
+
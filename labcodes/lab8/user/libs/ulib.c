@@ -5,6 +5,8 @@
 #include <stat.h>
 #include <string.h>
 #include <lock.h>
+#include <x86.h>
+#include <vdso.h>
 
 static lock_t fork_lock = INIT_LOCK;
 
@@ -50,9 +52,11 @@ kill(int pid) {
     return sys_kill(pid);
 }
 
+// getpid - read the pid from the vdso page, the threads sharing an mm ask the kernel
 int
 getpid(void) {
-    return sys_getpid();
+    int pid = VDSO_PROC->pid;
+    return (pid != 0) ? pid : sys_getpid();
 }
 
 //print_pgdir - print the PDT&PT
@@ -72,9 +76,96 @@ sleep(unsigned int time) {
     return sys_sleep(time);
 }
 
+// gettime_msec - the ticks of the kernel, read from the vdso page
 unsigned int
 gettime_msec(void) {
-    return (unsigned int)sys_gettime();
+    return VDSO_DATA->ticks;
+}
+
+// clock_gettime - CLOCK_MONOTONIC is counted from the TSC with the vdso page, without
+//               - trapping into the kernel
+int
+clock_gettime(int clock_id, struct timespec *ts) {
+    const struct vdso_data *vd = VDSO_DATA;
+    if (clock_id != CLOCK_MONOTONIC || vd->ns_mult == 0) {
+        return sys_clock_gettime(clock_id, ts);
+    }
+    uint64_t ns = gettime_nsec();
+    ts->tv_nsec = do_div(ns, NSEC_PER_SEC);
+    ts->tv_sec = ns;
+    return 0;
+}
+
+int
+nanosleep(const struct timespec *req) {
+    return sys_nanosleep(req);
+}
+
+// gettime_nsec - the nanoseconds of CLOCK_MONOTONIC
+uint64_t
+gettime_nsec(void) {
+    const struct vdso_data *vd = VDSO_DATA;
+    if (vd->ns_mult == 0) {
+        struct timespec ts;
+        if (sys_clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+            return 0;
+        }
+        return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+    }
+    return mul_u64_u32_shr(read_tsc() - vd->tsc_base, vd->ns_mult, vd->ns_shift);
+}
+
+// sbrk - move the program break by increment bytes, the kernel keeps the heap page aligned
+//      - return the old break, or (void *)-1 if failed
+void *
+sbrk(intptr_t increment) {
+    static uintptr_t cur_brk = 0;
+    uintptr_t brk = 0, old_brk;
+    if (cur_brk == 0) {
+        sys_brk(&brk);
+        cur_brk = brk;
+    }
+    old_brk = cur_brk;
+    if (increment != 0) {
+        brk = old_brk + increment;
+        if (sys_brk(&brk) != 0 || brk != ROUNDUP(old_brk + increment, PGSIZE)) {
+            return (void *)-1;
+        }
+        cur_brk = old_brk + increment;
+    }
+    return (void *)old_brk;
+}
+
+// mmap - map len bytes of anonymous memory at addr (NULL means anywhere)
+//      - return the start address, or NULL if failed
+void *
+mmap(void *addr, size_t len, uint32_t mmap_flags) {
+    uintptr_t addr_store = (uintptr_t)addr;
+    if (sys_mmap(&addr_store, len, mmap_flags) != 0) {
+        return NULL;
+    }
+    return (void *)addr_store;
+}
+
+int
+munmap(void *addr, size_t len) {
+    return sys_munmap((uintptr_t)addr, len);
+}
+
+// shmat - attach the shared memory segment of key, SHMEM_CREAT creates it with len bytes
+//       - return the start address, or NULL if failed
+void *
+shmat(int key, size_t len, uint32_t flags) {
+    uintptr_t addr_store;
+    if (sys_shmem_attach(&addr_store, key, len, flags) != 0) {
+        return NULL;
+    }
+    return (void *)addr_store;
+}
+
+int
+shmdt(void *addr) {
+    return sys_shmem_detach((uintptr_t)addr);
 }
 
 int
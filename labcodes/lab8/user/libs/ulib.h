@@ -2,6 +2,9 @@
 #define __USER_LIBS_ULIB_H__
 
 #include <defs.h>
+#include <time.h>
+
+#define PGSIZE          4096    // bytes of a page, the unit of sbrk & mmap in kernel
 
 void __warn(const char *file, int line, const char *fmt, ...);
 void __noreturn __panic(const char *file, int line, const char *fmt, ...);
@@ -35,7 +38,15 @@ int getpid(void);
 void print_pgdir(void);
 int sleep(unsigned int time);
 unsigned int gettime_msec(void);
+int clock_gettime(int clock_id, struct timespec *ts);
+int nanosleep(const struct timespec *req);
+uint64_t gettime_nsec(void);
 int __exec(const char *name, const char **argv);
+void *sbrk(intptr_t increment);
+void *mmap(void *addr, size_t len, uint32_t mmap_flags);
+int munmap(void *addr, size_t len);
+void *shmat(int key, size_t len, uint32_t flags);
+int shmdt(void *addr);
 
 #define __exec0(name, path, ...)                \
 ({ const char *argv[] = {path, ##__VA_ARGS__, NULL}; __exec(name, argv); })
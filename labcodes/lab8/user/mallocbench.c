@@ -0,0 +1,109 @@
+#include <ulib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+
+#define NSLOT           512
+#define NROUND          8
+
+static char *slots[NSLOT];
+static size_t sizes[NSLOT];
+
+static size_t
+rand_size(size_t min, size_t max) {
+    return min + ((unsigned int)rand()) % (max - min + 1);
+}
+
+static void
+fill(char *p, size_t size, int i) {
+    memset(p, (char)i, size);
+}
+
+static void
+verify(char *p, size_t size, int i) {
+    size_t j;
+    for (j = 0; j < size; j += 64) {
+        assert(p[j] == (char)i);
+    }
+    assert(p[size - 1] == (char)i);
+}
+
+static void
+print_stat(const char *name) {
+    struct malloc_stat stat;
+    malloc_stat(&stat);
+    size_t total = stat.heap_bytes + stat.mmap_bytes;
+    cprintf("%s: heap %d KB, mmap %d KB, used %d KB, %d free blocks (%d KB), used %d%%.\n",
+            name, stat.heap_bytes / 1024, stat.mmap_bytes / 1024, stat.used_bytes / 1024,
+            stat.nr_free, stat.free_bytes / 1024, (total == 0) ? 100 : stat.used_bytes / (total / 100));
+}
+
+// bench - alloc & free randomly in NSLOT slots with size in [min, max], return the time in msec
+static unsigned int
+bench(const char *name, size_t min, size_t max) {
+    unsigned int start = gettime_msec();
+    int i, j, ops = 0;
+    for (j = 0; j < NROUND; j ++) {
+        for (i = 0; i < NSLOT; i ++) {
+            int k = ((unsigned int)rand()) % NSLOT;
+            if (slots[k] != NULL) {
+                verify(slots[k], sizes[k], k);
+                free(slots[k]);
+                slots[k] = NULL;
+            }
+            else {
+                sizes[k] = rand_size(min, max);
+                assert((slots[k] = malloc(sizes[k])) != NULL);
+                fill(slots[k], sizes[k], k);
+            }
+            ops ++;
+        }
+    }
+    unsigned int msec = gettime_msec() - start;
+    cprintf("%s: %d ops of [%d, %d] bytes in %d msec.\n", name, ops, min, max, msec);
+    print_stat(name);
+    for (i = 0; i < NSLOT; i ++) {
+        if (slots[i] != NULL) {
+            verify(slots[i], sizes[i], i);
+            free(slots[i]);
+            slots[i] = NULL;
+        }
+    }
+    return msec;
+}
+
+static void
+check_malloc(void) {
+    char *p, *q;
+    assert(malloc(0) == NULL);
+    assert((p = calloc(100, 4)) != NULL);
+    int i;
+    for (i = 0; i < 400; i ++) {
+        assert(p[i] == 0);
+    }
+    strcpy(p, "malloc");
+    assert((q = realloc(p, 4000)) != NULL && strcmp(q, "malloc") == 0);
+    free(q);
+
+    // the freed neighbours are merged, so the same memory can hold a bigger block
+    char *a = malloc(2000), *b = malloc(2000), *c = malloc(2000);
+    assert(a != NULL && b != NULL && c != NULL);
+    free(a), free(c), free(b);
+    assert((p = malloc(5000)) != NULL);
+    free(p);
+    cprintf("check_malloc ok.\n");
+}
+
+int
+main(void) {
+    check_malloc();
+    bench("small", 1, 256);
+    bench("medium", 512, 16 * 1024);
+    bench("mixed", 1, 32 * 1024);
+    bench("large", 64 * 1024, 256 * 1024);
+    print_stat("end");
+    cprintf("mallocbench pass.\n");
+    return 0;
+}
+
@@ -0,0 +1,78 @@
+#include <ulib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NPAGE           8
+#define LARGESIZE       (1024 * PGSIZE)
+
+static void
+check_sbrk(void) {
+    char *base = sbrk(0), *p;
+    assert((p = sbrk(3 * PGSIZE)) == base);
+    memset(p, 0x5a, 3 * PGSIZE);
+    assert(sbrk(0) == base + 3 * PGSIZE);
+
+    assert(sbrk(-2 * PGSIZE) == base + 3 * PGSIZE);
+    assert(p[PGSIZE - 1] == 0x5a);
+    // the freed heap comes back zero-filled
+    assert(sbrk(2 * PGSIZE) == base + PGSIZE);
+    assert(p[PGSIZE] == 0 && p[3 * PGSIZE - 1] == 0);
+    assert(sbrk(-3 * PGSIZE) == base + 3 * PGSIZE && sbrk(0) == base);
+    cprintf("sbrk ok.\n");
+}
+
+static void
+check_mmap(void) {
+    char *p, *q;
+    int i, pid, exit_code;
+    assert((p = mmap(NULL, NPAGE * PGSIZE, MMAP_WRITE)) != NULL);
+    for (i = 0; i < NPAGE; i ++) {
+        assert(p[i * PGSIZE] == 0);
+        p[i * PGSIZE] = i;
+    }
+
+    // an adjacent mapping is merged with p, then unmapping a hole splits it again
+    assert((q = mmap(p + NPAGE * PGSIZE, PGSIZE, MMAP_WRITE)) == p + NPAGE * PGSIZE);
+    q[0] = NPAGE;
+    assert(munmap(p + 2 * PGSIZE, 2 * PGSIZE) == 0);
+    assert(mmap(p + 2 * PGSIZE, PGSIZE, MMAP_WRITE) == p + 2 * PGSIZE && p[2 * PGSIZE] == 0);
+    for (i = 4; i <= NPAGE; i ++) {
+        assert(p[i * PGSIZE] == i);
+    }
+
+    if ((pid = fork()) == 0) {
+        assert(p[5 * PGSIZE] == 5);
+        p[5 * PGSIZE] = 55;
+        exit(0);
+    }
+    assert(pid > 0 && waitpid(pid, &exit_code) == 0 && exit_code == 0);
+    assert(p[5 * PGSIZE] == 5);
+
+    assert(munmap(p, (NPAGE + 1) * PGSIZE) == 0);
+    assert(mmap(p, PGSIZE, MMAP_WRITE) == p && p[0] == 0);
+    assert(munmap(p, PGSIZE) == 0);
+    cprintf("mmap ok.\n");
+}
+
+static void
+check_mmap_large(void) {
+    char *p;
+    assert((p = mmap(NULL, 2 * LARGESIZE, MMAP_WRITE | MMAP_LARGE)) != NULL);
+    assert((uintptr_t)p % LARGESIZE == 0);
+    p[0] = 1, p[LARGESIZE - 1] = 2, p[LARGESIZE] = 3;
+    // unmap a part of the first large page
+    assert(munmap(p + PGSIZE, PGSIZE) == 0);
+    assert(p[0] == 1 && p[LARGESIZE - 1] == 2 && p[LARGESIZE] == 3);
+    assert(munmap(p, 2 * LARGESIZE) == 0);
+    cprintf("mmap large ok.\n");
+}
+
+int
+main(void) {
+    check_sbrk();
+    check_mmap();
+    check_mmap_large();
+    cprintf("mmaptest pass.\n");
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <unistd.h>
+#include <x86.h>
+
+/* *
+ * preemptlat - the wakeup latency of a process while another one stays in the kernel for
+ * long: it forks with HOG_PAGES pages of memory, which copy_range copies page by page, and
+ * nothing else runs on the cpu meanwhile unless the kernel code is preempted. The process
+ * sleeps for a tick ROUNDS times, the time past the tick is the wait for the cpu.
+ * */
+
+#define HOG_PAGES       1024
+#define ROUNDS          20
+#define TICK_USEC       10000
+#define MAX_LATENCY     (10 * TICK_USEC)        // a time slice of the hog, with some room
+
+// usec - the microseconds of ns
+static unsigned int
+usec(uint64_t ns) {
+    do_div(ns, 1000);
+    return ns;
+}
+
+static void
+hog(void) {
+    char *mem = mmap(NULL, HOG_PAGES * PGSIZE, MMAP_WRITE);
+    int i, pid;
+    assert(mem != NULL);
+    for (i = 0; i < HOG_PAGES; i ++) {
+        mem[i * PGSIZE] = i;
+    }
+    while (1) {
+        if ((pid = fork()) == 0) {
+            exit(0);
+        }
+        assert(pid > 0 && waitpid(pid, NULL) == 0);
+    }
+}
+
+int
+main(void) {
+    int pid, i;
+    if ((pid = fork()) == 0) {
+        hog();
+    }
+    assert(pid > 0);
+    // let the hog map its memory
+    sleep(10);
+
+    unsigned int max = 0;
+    for (i = 0; i < ROUNDS; i ++) {
+        uint64_t start = gettime_nsec();
+        sleep(1);
+        unsigned int latency = usec(gettime_nsec() - start);
+        latency = (latency > TICK_USEC) ? latency - TICK_USEC : 0;
+        if (max < latency) {
+            max = latency;
+        }
+    }
+
+    assert(kill(pid) == 0 && waitpid(pid, NULL) == 0);
+    cprintf("preemptlat: wakeup latency max %u usecs, with a process forking %d pages.\n", max, HOG_PAGES);
+    assert(max < MAX_LATENCY);
+    cprintf("preemptlat pass.\n");
+    return 0;
+}
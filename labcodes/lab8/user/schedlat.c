@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <ulib.h>
+
+/* *
+ * schedlat - the wakeup latency of an interactive process among cpu-bound ones. It sleeps
+ * for a tick ROUNDS times, the time past the tick is the wait for the cpu after the timer
+ * has woken it up. Compare the scheduler classes with make SCHED=...
+ * */
+
+#define SPINNERS        8
+#define ROUNDS          20
+#define TICK_MSEC       10
+
+int pids[SPINNERS];
+
+int
+main(void) {
+    int i;
+    for (i = 0; i < SPINNERS; i ++) {
+        if ((pids[i] = fork()) == 0) {
+            while (1) {
+                /* spin */;
+            }
+        }
+        assert(pids[i] > 0);
+    }
+
+    unsigned int total = 0, max = 0;
+    for (i = 0; i < ROUNDS; i ++) {
+        unsigned int start = gettime_msec(), latency;
+        sleep(1);
+        latency = gettime_msec() - start;
+        latency = (latency > TICK_MSEC) ? latency - TICK_MSEC : 0;
+        total += latency;
+        if (max < latency) {
+            max = latency;
+        }
+    }
+
+    for (i = 0; i < SPINNERS; i ++) {
+        assert(kill(pids[i]) == 0 && waitpid(pids[i], NULL) == 0);
+    }
+    cprintf("schedlat: %d spinners, wakeup latency avg %d max %d msecs.\n", SPINNERS, total / ROUNDS, max);
+    cprintf("schedlat pass.\n");
+    return 0;
+}
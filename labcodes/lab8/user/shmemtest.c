@@ -0,0 +1,81 @@
+#include <ulib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SHM_KEY         0x5348
+#define SHM_SIZE        (16 * PGSIZE)
+#define NCHILD          4
+
+static void
+check_key(void) {
+    int *buf, i, j, pid, exit_code;
+    assert(shmat(SHM_KEY, SHM_SIZE, MMAP_WRITE) == NULL);
+    assert((buf = shmat(SHM_KEY, SHM_SIZE, MMAP_WRITE | SHMEM_CREAT | SHMEM_EXCL)) != NULL);
+    assert(shmat(SHM_KEY, SHM_SIZE, MMAP_WRITE | SHMEM_CREAT | SHMEM_EXCL) == NULL);
+
+    int n = SHM_SIZE / sizeof(int) / NCHILD;
+    for (i = 0; i < NCHILD; i ++) {
+        if ((pid = fork()) == 0) {
+            // attach the segment by key again, both attachments see the same pages
+            int *p = shmat(SHM_KEY, SHM_SIZE, MMAP_WRITE);
+            assert(p != NULL && p != buf);
+            for (j = i * n; j < (i + 1) * n; j ++) {
+                p[j] = j;
+            }
+            assert(buf[i * n + 1] == i * n + 1);
+            assert(shmdt(p) == 0);
+            exit(0);
+        }
+        assert(pid > 0);
+    }
+    for (i = 0; i < NCHILD; i ++) {
+        assert(wait() == 0);
+    }
+    for (j = 0; j < n * NCHILD; j ++) {
+        assert(buf[j] == j);
+    }
+
+    // a child inherits the attachment by fork, its writes are seen by the parent
+    if ((pid = fork()) == 0) {
+        buf[0] = -1;
+        exit(0);
+    }
+    assert(pid > 0 && waitpid(pid, &exit_code) == 0 && exit_code == 0);
+    assert(buf[0] == -1);
+
+    assert(shmdt(buf) == 0);
+    assert(shmdt(buf) != 0);
+    // the last detach destroys the segment
+    assert(shmat(SHM_KEY, SHM_SIZE, MMAP_WRITE) == NULL);
+    cprintf("shmem key ok.\n");
+}
+
+static void
+check_private(void) {
+    char *buf;
+    int pid, exit_code;
+    assert((buf = shmat(SHMEM_PRIVATE, SHM_SIZE, MMAP_WRITE)) != NULL);
+    strcpy(buf, "parent");
+    if ((pid = fork()) == 0) {
+        assert(strcmp(buf, "parent") == 0);
+        strcpy(buf + PGSIZE, "child");
+        exit(0);
+    }
+    assert(pid > 0 && waitpid(pid, &exit_code) == 0 && exit_code == 0);
+    assert(strcmp(buf + PGSIZE, "child") == 0);
+    // unmap a part of the attachment, the rest is still shared
+    assert(munmap(buf, PGSIZE) == 0);
+    assert(strcmp(buf + PGSIZE, "child") == 0);
+    assert(shmdt(buf + PGSIZE) == 0);
+    cprintf("shmem private ok.\n");
+}
+
+int
+main(void) {
+    check_key();
+    check_private();
+    cprintf("shmemtest pass.\n");
+    return 0;
+}
+
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <x86.h>
+#include <syscall.h>
+
+#define NLOOP           2000
+
+// bench - the average TSC cycles of sys_getpid, a system call which does nothing
+static unsigned int
+bench(int pid) {
+    int i;
+    uint64_t start = read_tsc();
+    for (i = 0; i < NLOOP; i ++) {
+        assert(sys_getpid() == pid);
+    }
+    return (uint32_t)(read_tsc() - start) / NLOOP;
+}
+
+int
+main(void) {
+    int pid = getpid(), exit_code;
+    bool sysenter = syscall_sysenter(1);
+
+    syscall_sysenter(0);
+    unsigned int int_cycles = bench(pid);
+    if (!sysenter) {
+        cprintf("syscallbench: no sysenter, int 0x80 %u cycles.\n", int_cycles);
+        return 0;
+    }
+    syscall_sysenter(1);
+    unsigned int sysenter_cycles = bench(pid);
+    cprintf("syscallbench: int 0x80 %u cycles, sysenter %u cycles.\n", int_cycles, sysenter_cycles);
+
+    // a process forked by SYSENTER returns with iret, its arguments are all there
+    if ((pid = fork()) == 0) {
+        syscall_sysenter(0);
+        assert(sys_getpid() == getpid());
+        exit(0x5e);
+    }
+    assert(pid > 0 && waitpid(pid, &exit_code) == 0 && exit_code == 0x5e);
+
+    cprintf("syscallbench pass.\n");
+    return 0;
+}
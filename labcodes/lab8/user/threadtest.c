@@ -0,0 +1,48 @@
+#include <ulib.h>
+#include <stdio.h>
+#include <thread.h>
+
+#define NTHREAD         8
+#define NSLICE          1024
+
+static int data[NTHREAD * NSLICE];
+static int sums[NTHREAD];
+
+static int
+worker(void *arg) {
+    int n = (int)arg, i, sum = 0;
+    struct thread_tls *tls = thread_self();
+    assert(tls != NULL && tls->self == tls);
+    tls->specific = arg;
+    for (i = n * NSLICE; i < (n + 1) * NSLICE; i ++) {
+        sum += data[i];
+    }
+    yield();
+    assert(thread_self()->specific == arg);
+    sums[n] = sum;
+    cprintf("thread %d (pid %d) sum %d.\n", n, getpid(), sum);
+    return n;
+}
+
+int
+main(void) {
+    thread_t threads[NTHREAD];
+    int i, total = 0, expect = 0, exit_code;
+    for (i = 0; i < NTHREAD * NSLICE; i ++) {
+        data[i] = i;
+        expect += i;
+    }
+    assert(thread_self() == NULL);
+
+    for (i = 0; i < NTHREAD; i ++) {
+        assert(thread_create(worker, (void *)i, threads + i) == 0);
+    }
+    for (i = 0; i < NTHREAD; i ++) {
+        assert(thread_join(threads + i, &exit_code) == 0 && exit_code == i);
+        total += sums[i];
+    }
+    assert(total == expect);
+    cprintf("threadtest pass.\n");
+    return 0;
+}
+
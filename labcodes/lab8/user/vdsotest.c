@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <ulib.h>
+#include <error.h>
+#include <x86.h>
+#include <vdso.h>
+#include <syscall.h>
+#include <thread.h>
+
+#define NLOOP           1000
+
+static int
+worker(void *arg) {
+    // the threads share the vdso page of the mm, the kernel tells the pid
+    assert(VDSO_PROC->pid == 0 && getpid() == sys_getpid());
+    return 0;
+}
+
+int
+main(void) {
+    int pid = getpid(), i, exit_code;
+    assert(pid != 0 && pid == sys_getpid());
+
+    // the ticks are those of sys_gettime
+    unsigned int ticks = gettime_msec(), kticks = sys_gettime();
+    assert(kticks - ticks <= 1);
+
+    // the vdso is much cheaper than a system call
+    uint64_t start = read_tsc();
+    for (i = 0; i < NLOOP; i ++) {
+        assert(getpid() == pid);
+    }
+    unsigned int vdso_cycles = (uint32_t)(read_tsc() - start) / NLOOP;
+    start = read_tsc();
+    for (i = 0; i < NLOOP; i ++) {
+        assert(sys_getpid() == pid);
+    }
+    unsigned int sys_cycles = (uint32_t)(read_tsc() - start) / NLOOP;
+    cprintf("vdsotest: getpid %u cycles, sys_getpid %u cycles.\n", vdso_cycles, sys_cycles);
+
+    // a child has its own pid in its own vdso page
+    if ((i = fork()) == 0) {
+        assert(getpid() != pid && getpid() == sys_getpid());
+        exit(0);
+    }
+    assert(i > 0 && waitpid(i, &exit_code) == 0 && exit_code == 0);
+    assert(getpid() == pid);
+
+    // the vdso pages are read-only
+    if ((i = fork()) == 0) {
+        *(volatile int *)VDSO_BASE = 0;
+        exit(0);
+    }
+    assert(i > 0 && waitpid(i, &exit_code) == 0 && exit_code == -E_KILLED);
+    cprintf("vdsotest: the vdso page is read-only.\n");
+
+    thread_t thread;
+    assert(thread_create(worker, NULL, &thread) == 0);
+    assert(thread_join(&thread, &exit_code) == 0 && exit_code == 0);
+    assert(getpid() == pid);
+
+    cprintf("vdsotest pass.\n");
+    return 0;
+}